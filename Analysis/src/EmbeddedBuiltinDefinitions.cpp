@@ -3,6 +3,9 @@
 
 LUAU_FASTFLAGVARIABLE(LuauTypeCheckerVectorLerp)
 LUAU_FASTFLAGVARIABLE(LuauRawGetHandlesNil)
+LUAU_FASTFLAG(LuauSerializeLibrary)
+LUAU_FASTFLAG(LuauJsonLibrary)
+LUAU_FASTFLAG(LuauStrbufLibrary)
 
 namespace Luau
 {
@@ -316,6 +319,49 @@ declare buffer: {
 
 )BUILTIN_SRC";
 
+static constexpr const char* kBuiltinDefinitionSerializeSrc = R"BUILTIN_SRC(
+
+declare serialize: {
+    encode: (value: any, hook: ((any) -> any)?) -> buffer,
+    decode: (b: buffer, hook: ((any) -> any)?) -> any,
+}
+
+)BUILTIN_SRC";
+
+static constexpr const char* kBuiltinDefinitionJsonSrc = R"BUILTIN_SRC(
+
+declare json: {
+    encode: (value: any) -> string,
+    decode: @checked (str: string) -> any,
+}
+
+)BUILTIN_SRC";
+
+static constexpr const char* kBuiltinDefinitionStrbufSrc = R"BUILTIN_SRC(
+
+declare extern type strbuf with
+    function append(self, ...: string | number): strbuf
+    function appendf(self, fmt: string, ...: any): strbuf
+    function reserve(self, size: number): strbuf
+    function reset(self, release: boolean?): strbuf
+    function len(self): number
+    function tostring(self): string
+    function tobuffer(self): buffer
+end
+
+declare strbuf: {
+    create: @checked (capacity: number?) -> strbuf,
+    append: @checked (sb: strbuf, ...(string | number)) -> strbuf,
+    appendf: @checked (sb: strbuf, fmt: string, ...any) -> strbuf,
+    reserve: @checked (sb: strbuf, size: number) -> strbuf,
+    reset: @checked (sb: strbuf, release: boolean?) -> strbuf,
+    len: @checked (sb: strbuf) -> number,
+    tostring: @checked (sb: strbuf) -> string,
+    tobuffer: @checked (sb: strbuf) -> buffer,
+}
+
+)BUILTIN_SRC";
+
 static const char* const kBuiltinDefinitionVectorSrc = R"BUILTIN_SRC(
 
 -- While vector would have been better represented as a built-in primitive type, type solver extern type handling covers most of the properties
@@ -389,6 +435,22 @@ std::string getBuiltinDefinitionSource()
     result += kBuiltinDefinitionDebugSrc;
     result += kBuiltinDefinitionUtf8Src;
     result += kBuiltinDefinitionBufferSrc;
+
+    if (FFlag::LuauSerializeLibrary)
+    {
+        result += kBuiltinDefinitionSerializeSrc;
+    }
+
+    if (FFlag::LuauJsonLibrary)
+    {
+        result += kBuiltinDefinitionJsonSrc;
+    }
+
+    if (FFlag::LuauStrbufLibrary)
+    {
+        result += kBuiltinDefinitionStrbufSrc;
+    }
+
     if (FFlag::LuauTypeCheckerVectorLerp)
     {
         result += kBuiltinDefinitionVectorSrc;
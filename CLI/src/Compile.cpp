@@ -3,19 +3,37 @@
 #include "lualib.h"
 
 #include "Luau/CodeGen.h"
+#include "Luau/CodeGenCommon.h"
 #include "Luau/Compiler.h"
 #include "Luau/BytecodeBuilder.h"
 #include "Luau/Parser.h"
+#include "Luau/StringUtils.h"
 #include "Luau/TimeTrace.h"
 
 #include "Luau/FileUtils.h"
 #include "Luau/Flags.h"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #ifdef _WIN32
 #include <io.h>
 #include <fcntl.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <limits.h>
+#include <mach-o/dyld.h>
 #endif
 
 LUAU_FASTFLAG(DebugLuauTimeTracing)
@@ -50,8 +68,27 @@ struct GlobalOptions
     const char* vectorLib = nullptr;
     const char* vectorCtor = nullptr;
     const char* vectorType = nullptr;
+
+    // directory with outputs of previous compilations, keyed by the hash of the source and everything that affects the output
+    std::string cacheDir;
+    uint64_t buildFingerprint = 0;
 } globalOptions;
 
+namespace Luau
+{
+namespace CodeGen
+{
+
+// From CodeGen.cpp
+#if defined(CODEGEN_TARGET_A64)
+unsigned int getCpuFeaturesA64();
+#elif defined(CODEGEN_TARGET_X64)
+unsigned int getCpuFeaturesX64();
+#endif
+
+} // namespace CodeGen
+} // namespace Luau
+
 static Luau::CompileOptions copts()
 {
     Luau::CompileOptions result = {};
@@ -92,26 +129,27 @@ static std::optional<CompileFormat> getCompileFormat(const char* name)
         return std::nullopt;
 }
 
-static void report(const char* name, const Luau::Location& location, const char* type, const char* message)
+static void report(std::string& errors, const char* name, const Luau::Location& location, const char* type, const char* message)
 {
-    fprintf(stderr, "%s(%d,%d): %s: %s\n", name, location.begin.line + 1, location.begin.column + 1, type, message);
+    Luau::formatAppend(errors, "%s(%d,%d): %s: %s\n", name, location.begin.line + 1, location.begin.column + 1, type, message);
 }
 
-static void reportError(const char* name, const Luau::ParseError& error)
+static void reportError(std::string& errors, const char* name, const Luau::ParseError& error)
 {
-    report(name, error.getLocation(), "SyntaxError", error.what());
+    report(errors, name, error.getLocation(), "SyntaxError", error.what());
 }
 
-static void reportError(const char* name, const Luau::CompileError& error)
+static void reportError(std::string& errors, const char* name, const Luau::CompileError& error)
 {
-    report(name, error.getLocation(), "CompileError", error.what());
+    report(errors, name, error.getLocation(), "CompileError", error.what());
 }
 
 static std::string getCodegenAssembly(
     const char* name,
     const std::string& bytecode,
     Luau::CodeGen::AssemblyOptions options,
-    Luau::CodeGen::LoweringStats* stats
+    Luau::CodeGen::LoweringStats* stats,
+    std::string& errors
 )
 {
     std::unique_ptr<lua_State, void (*)(lua_State*)> globalState(luaL_newstate(), lua_close);
@@ -120,7 +158,7 @@ static std::string getCodegenAssembly(
     if (luau_load(L, name, bytecode.data(), bytecode.size(), 0) == 0)
         return Luau::CodeGen::getAssembly(L, -1, options, stats);
 
-    fprintf(stderr, "Error loading bytecode %s\n", name);
+    Luau::formatAppend(errors, "Error loading bytecode %s\n", name);
     return "";
 }
 
@@ -230,6 +268,7 @@ void serializeLoweringStats(FILE* fp, const Luau::CodeGen::LoweringStats& stats)
     WRITE_PAIR("            ", skippedFunctions, "%u,\n");
     WRITE_PAIR("            ", spillsToSlot, "%d,\n");
     WRITE_PAIR("            ", spillsToRestore, "%d,\n");
+    WRITE_PAIR("            ", spillsToExistingSlot, "%d,\n");
     WRITE_PAIR("            ", maxSpillSlotsUsed, "%u,\n");
     WRITE_PAIR("            ", blocksPreOpt, "%u,\n");
     WRITE_PAIR("            ", blocksPostOpt, "%u,\n");
@@ -293,19 +332,169 @@ static double recordDeltaTime(double& timer)
     return delta;
 }
 
-static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::AssemblyOptions::Target assemblyTarget, CompileStats& stats)
+struct CompileResult
+{
+    CompileStats stats = {};
+    std::string output;
+    std::string errors;
+    bool succeeded = false;
+};
+
+// FNV-1a
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<const unsigned char*>(data)[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+static uint64_t hashString(uint64_t hash, const char* str)
+{
+    // the terminator is included so that adjacent strings can't be confused
+    return str ? hashBytes(hash, str, strlen(str) + 1) : hashBytes(hash, "", 1);
+}
+
+template<typename T>
+static uint64_t hashValue(uint64_t hash, T value)
+{
+    return hashBytes(hash, &value, sizeof(value));
+}
+
+// the compiler and the code generator are linked into the executable, so its contents identify the build that produced an output
+static std::optional<uint64_t> getBuildFingerprint()
+{
+#if defined(_WIN32)
+    wchar_t path[MAX_PATH];
+    DWORD length = GetModuleFileNameW(nullptr, path, MAX_PATH);
+    FILE* file = length != 0 && length < MAX_PATH ? _wfopen(path, L"rb") : nullptr;
+#elif defined(__APPLE__)
+    char path[PATH_MAX];
+    uint32_t size = sizeof(path);
+    FILE* file = _NSGetExecutablePath(path, &size) == 0 ? fopen(path, "rb") : nullptr;
+#else
+    FILE* file = fopen("/proc/self/exe", "rb");
+#endif
+
+    if (!file)
+        return std::nullopt;
+
+    uint64_t hash = 14695981039346656037ull;
+
+    char buffer[65536];
+
+    while (size_t read = fread(buffer, 1, sizeof(buffer), file))
+        hash = hashBytes(hash, buffer, read);
+
+    bool failed = ferror(file) != 0;
+    fclose(file);
+
+    if (failed)
+        return std::nullopt;
+
+    return hash;
+}
+
+static bool isCodegenFormat(CompileFormat format)
+{
+    return format == CompileFormat::Codegen || format == CompileFormat::CodegenAsm || format == CompileFormat::CodegenIr ||
+           format == CompileFormat::CodegenVerbose || format == CompileFormat::CodegenNull;
+}
+
+static std::string getCacheKey(const std::string& source, CompileFormat format, Luau::CodeGen::AssemblyOptions::Target assemblyTarget)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    hash = hashBytes(hash, source.data(), source.size());
+    hash = hashValue(hash, globalOptions.buildFingerprint);
+
+    Luau::CompileOptions options = copts();
+    hash = hashValue(hash, options.optimizationLevel);
+    hash = hashValue(hash, options.debugLevel);
+    hash = hashValue(hash, options.typeInfoLevel);
+    hash = hashString(hash, options.vectorLib);
+    hash = hashString(hash, options.vectorCtor);
+    hash = hashString(hash, options.vectorType);
+
+    hash = hashValue(hash, format);
+    hash = hashValue(hash, assemblyTarget);
+    hash = hashValue(hash, uint8_t(LBC_VERSION_MAX));
+
+    // native code for the host depends on the features of the processor that runs the compiler
+    if (assemblyTarget == Luau::CodeGen::AssemblyOptions::Host && isCodegenFormat(format))
+    {
+#if defined(CODEGEN_TARGET_A64)
+        static unsigned int cpuFeatures = Luau::CodeGen::getCpuFeaturesA64();
+        hash = hashValue(hash, cpuFeatures);
+#elif defined(CODEGEN_TARGET_X64)
+        static unsigned int cpuFeatures = Luau::CodeGen::getCpuFeaturesX64();
+        hash = hashValue(hash, cpuFeatures);
+#endif
+    }
+
+    // flags can change the output as well
+    for (Luau::FValue<bool>* flag = Luau::FValue<bool>::list; flag; flag = flag->next)
+        hash = hashValue(hashString(hash, flag->name), flag->value);
+
+    for (Luau::FValue<int>* flag = Luau::FValue<int>::list; flag; flag = flag->next)
+        hash = hashValue(hashString(hash, flag->name), flag->value);
+
+    std::string result;
+    Luau::formatAppend(result, "%016llx", (unsigned long long)hash);
+    return result;
+}
+
+static void writeCacheEntry(const std::string& path, const std::string& output)
+{
+    // the entry is written to a temporary file first so that concurrent compilations never observe a partial entry
+    std::string temp = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    FILE* fp = fopen(temp.c_str(), "wb");
+    if (!fp)
+        return;
+
+    bool written = fwrite(output.data(), 1, output.size(), fp) == output.size();
+
+    if (fclose(fp) != 0 || !written || rename(temp.c_str(), path.c_str()) != 0)
+        remove(temp.c_str());
+}
+
+static bool compileFile(
+    const char* name,
+    CompileFormat format,
+    Luau::CodeGen::AssemblyOptions::Target assemblyTarget,
+    CompileStats& stats,
+    std::string& output,
+    std::string& errors
+)
 {
     double currts = Luau::TimeTrace::getClock();
 
     std::optional<std::string> source = readFile(name);
     if (!source)
     {
-        fprintf(stderr, "Error opening %s\n", name);
+        Luau::formatAppend(errors, "Error opening %s\n", name);
         return false;
     }
 
     stats.readTime += recordDeltaTime(currts);
 
+    std::string cachePath;
+
+    if (!globalOptions.cacheDir.empty())
+    {
+        cachePath = joinPaths(globalOptions.cacheDir, getCacheKey(*source, format, assemblyTarget));
+
+        if (std::optional<std::string> cached = readFile(cachePath))
+        {
+            output = std::move(*cached);
+            return true;
+        }
+    }
+
     // NOTE: Normally, you should use Luau::compile or luau_compile (see lua_require as an example)
     // This function is much more complicated because it supports many output human-readable formats through internal interfaces
 
@@ -371,43 +560,155 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
         switch (format)
         {
         case CompileFormat::Text:
-            printf("%s", bcb.dumpEverything().c_str());
+            output = bcb.dumpEverything();
             break;
         case CompileFormat::Remarks:
-            printf("%s", bcb.dumpSourceRemarks().c_str());
+            output = bcb.dumpSourceRemarks();
             break;
         case CompileFormat::Binary:
-            fwrite(bcb.getBytecode().data(), 1, bcb.getBytecode().size(), stdout);
+            output = bcb.getBytecode();
             break;
         case CompileFormat::Codegen:
         case CompileFormat::CodegenAsm:
         case CompileFormat::CodegenIr:
         case CompileFormat::CodegenVerbose:
-            printf("%s", getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats).c_str());
+            output = getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats, errors);
             break;
         case CompileFormat::CodegenNull:
-            stats.codegen += getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats).size();
+            stats.codegen += getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats, errors).size();
             stats.codegenTime += recordDeltaTime(currts);
             break;
         case CompileFormat::Null:
             break;
         }
 
+        if (!cachePath.empty() && errors.empty())
+            writeCacheEntry(cachePath, output);
+
         return true;
     }
     catch (Luau::ParseErrors& e)
     {
         for (auto& error : e.getErrors())
-            reportError(name, error);
+            reportError(errors, name, error);
         return false;
     }
     catch (Luau::CompileError& e)
     {
-        reportError(name, e);
+        reportError(errors, name, e);
         return false;
     }
 }
 
+// Runs tasks on a pool of worker threads; every worker starts with its own share of the tasks and steals from other workers once it runs out
+struct TaskScheduler
+{
+    TaskScheduler(size_t taskCount, unsigned threadCount, std::function<void(size_t)> run)
+        : queues(threadCount)
+        , finished(taskCount)
+        , run(std::move(run))
+    {
+        // tasks are distributed round-robin so that the workers start with the tasks that are needed first
+        for (size_t i = 0; i < taskCount; i++)
+            queues[i % threadCount].tasks.push_back(i);
+
+        for (unsigned i = 0; i < threadCount; i++)
+        {
+            workers.emplace_back(
+                [this, i]
+                {
+                    workerFunction(i);
+                }
+            );
+        }
+    }
+
+    ~TaskScheduler()
+    {
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    void wait(size_t task)
+    {
+        std::unique_lock guard(finishedMtx);
+
+        finishedCv.wait(
+            guard,
+            [this, task]
+            {
+                return finished[task];
+            }
+        );
+    }
+
+    static unsigned getThreadCount()
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mtx;
+        std::deque<size_t> tasks;
+    };
+
+    bool pop(unsigned worker, size_t& task)
+    {
+        // own tasks are taken from the front, stolen tasks from the back where they are needed last
+        for (size_t i = 0; i < queues.size(); i++)
+        {
+            Queue& queue = queues[(worker + i) % queues.size()];
+            std::unique_lock guard(queue.mtx);
+
+            if (queue.tasks.empty())
+                continue;
+
+            if (i == 0)
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            else
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void workerFunction(unsigned worker)
+    {
+        size_t task = 0;
+
+        while (pop(worker, task))
+        {
+            run(task);
+
+            {
+                std::unique_lock guard(finishedMtx);
+                finished[task] = true;
+            }
+
+            finishedCv.notify_all();
+        }
+    }
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex finishedMtx;
+    std::condition_variable finishedCv;
+    std::vector<bool> finished;
+
+    std::function<void(size_t)> run;
+};
+
 static void displayHelp(const char* argv0)
 {
     printf("Usage: %s [--mode] [options] [file list]\n", argv0);
@@ -427,6 +728,8 @@ static void displayHelp(const char* argv0)
     printf("  --vector-lib=<name>: name of the library providing vector type operations.\n");
     printf("  --vector-ctor=<name>: name of the function constructing a vector value.\n");
     printf("  --vector-type=<name>: name of the vector type.\n");
+    printf("  -j<n>: compile files on n threads (default 1, 0 uses all hardware threads); the output order matches the file list.\n");
+    printf("  --cache=<dir>: reuse the output of files that were compiled with the same options before, and store new outputs in dir.\n");
 }
 
 static int assertionHandler(const char* expr, const char* file, int line, const char* function)
@@ -470,6 +773,7 @@ int main(int argc, char** argv)
     RecordStats recordStats = RecordStats::None;
     std::string statsFile("stats.json");
     bool bytecodeSummary = false;
+    int threadCount = 1;
 
     for (int i = 1; i < argc; i++)
     {
@@ -508,6 +812,25 @@ int main(int argc, char** argv)
             }
             globalOptions.typeInfoLevel = level;
         }
+        else if (strncmp(argv[i], "-j", 2) == 0)
+        {
+            threadCount = atoi(argv[i] + 2);
+            if (threadCount < 0)
+            {
+                fprintf(stderr, "Error: Thread count can't be negative.\n");
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--cache=", 8) == 0)
+        {
+            globalOptions.cacheDir = argv[i] + 8;
+
+            if (!isDirectory(globalOptions.cacheDir))
+            {
+                fprintf(stderr, "Error: cache directory '%s' doesn't exist.\n", globalOptions.cacheDir.c_str());
+                return 1;
+            }
+        }
         else if (strncmp(argv[i], "--target=", 9) == 0)
         {
             const char* value = argv[i] + 9;
@@ -594,6 +917,26 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // formats without output are used to measure the compiler, and the stats need every file to be compiled
+    if (compileFormat == CompileFormat::Null || compileFormat == CompileFormat::CodegenNull || recordStats != RecordStats::None)
+        globalOptions.cacheDir.clear();
+
+    if (!globalOptions.cacheDir.empty())
+    {
+        if (std::optional<uint64_t> fingerprint = getBuildFingerprint())
+        {
+            globalOptions.buildFingerprint = *fingerprint;
+        }
+        else
+        {
+            fprintf(stderr, "Warning: cache is not used, as the executable can't be read to identify the build.\n");
+            globalOptions.cacheDir.clear();
+        }
+    }
+
+    if (threadCount == 0)
+        threadCount = int(TaskScheduler::getThreadCount());
+
 #if !defined(LUAU_ENABLE_TIME_TRACE)
     if (FFlag::DebugLuauTimeTracing)
     {
@@ -612,21 +955,53 @@ int main(int argc, char** argv)
     const size_t fileCount = files.size();
     CompileStats stats = {};
 
-    std::vector<CompileStats> fileStats;
-    if (recordStats == RecordStats::File || recordStats == RecordStats::Function)
-        fileStats.reserve(fileCount);
+    std::vector<CompileResult> results(fileCount);
 
-    int failed = 0;
     unsigned functionStats = (recordStats == RecordStats::Function ? Luau::CodeGen::FunctionStats_Enable : 0) |
                              (bytecodeSummary ? Luau::CodeGen::FunctionStats_BytecodeSummary : 0);
-    for (const std::string& path : files)
+
+    auto compileTask = [&](size_t i)
+    {
+        CompileResult& result = results[i];
+
+        result.stats.lowerStats.functionStatsFlags = functionStats;
+        result.succeeded = compileFile(files[i].c_str(), compileFormat, assemblyTarget, result.stats, result.output, result.errors);
+    };
+
+    int failed = 0;
+
+    // results are written in the order of the file list, as soon as all preceding files are done
+    auto finishTask = [&](size_t i)
+    {
+        CompileResult& result = results[i];
+
+        fputs(result.errors.c_str(), stderr);
+        fwrite(result.output.data(), 1, result.output.size(), stdout);
+
+        result.errors = std::string();
+        result.output = std::string();
+
+        failed += !result.succeeded;
+        stats += result.stats;
+    };
+
+    if (threadCount > 1 && fileCount > 1)
+    {
+        TaskScheduler scheduler(fileCount, unsigned(std::min(size_t(threadCount), fileCount)), compileTask);
+
+        for (size_t i = 0; i < fileCount; i++)
+        {
+            scheduler.wait(i);
+            finishTask(i);
+        }
+    }
+    else
     {
-        CompileStats fileStat = {};
-        fileStat.lowerStats.functionStatsFlags = functionStats;
-        failed += !compileFile(path.c_str(), compileFormat, assemblyTarget, fileStat);
-        stats += fileStat;
-        if (recordStats == RecordStats::File || recordStats == RecordStats::Function)
-            fileStats.push_back(fileStat);
+        for (size_t i = 0; i < fileCount; i++)
+        {
+            compileTask(i);
+            finishTask(i);
+        }
     }
 
     if (compileFormat == CompileFormat::Null)
@@ -655,11 +1030,13 @@ int main(int argc, char** argv)
         );
 
         printf(
-            "Lowering: regalloc failed: %d, lowering failed %d; spills to stack: %d, spills to restore: %d, max spill slot %u\n",
+            "Lowering: regalloc failed: %d, lowering failed %d; spills to stack: %d, spills to restore: %d, spills to existing slot: %d, max spill "
+            "slot %u\n",
             stats.lowerStats.regAllocErrors,
             stats.lowerStats.loweringErrors,
             stats.lowerStats.spillsToSlot,
             stats.lowerStats.spillsToRestore,
+            stats.lowerStats.spillsToExistingSlot,
             stats.lowerStats.maxSpillSlotsUsed
         );
     }
@@ -685,7 +1062,7 @@ int main(int argc, char** argv)
             {
                 std::string escaped(escapeFilename(files[i]));
                 fprintf(fp, "    \"%s\": ", escaped.c_str());
-                serializeCompileStats(fp, fileStats[i]);
+                serializeCompileStats(fp, results[i].stats);
                 fprintf(fp, i == (fileCount - 1) ? "\n" : ",\n");
             }
             fprintf(fp, "}");
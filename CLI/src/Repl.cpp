@@ -48,6 +48,9 @@ LUAU_FASTFLAG(DebugLuauTimeTracing)
 constexpr int MaxTraversalLimit = 50;
 
 static bool codegen = false;
+static std::string codegenCacheDir;
+static bool codegenStats = false;
+static std::vector<int> codegenStatsFunctions;
 static int program_argc = 0;
 char** program_argv = nullptr;
 
@@ -565,6 +568,42 @@ static void runRepl()
     runReplImpl(L);
 }
 
+// Native code of the script is loaded from the cache directory when it was generated for the current bytecode and options, and is stored
+// there otherwise
+static void compileWithNativeCache(lua_State* L, const std::string& chunkname, const Luau::CodeGen::CompilationOptions& nativeOptions)
+{
+    std::string path = codegenCacheDir + "/";
+
+    for (char ch : chunkname.substr(1))
+        path += isalnum((unsigned char)ch) ? ch : '_';
+
+    path += ".ncache";
+
+    if (std::optional<std::string> cache = readFile(path))
+    {
+        Luau::CodeGen::CompilationResult result = Luau::CodeGen::loadFromCache(L, -1, nativeOptions, cache->data(), cache->size());
+
+        if (result.result != Luau::CodeGen::CodeGenCompilationResult::CacheMismatch)
+            return;
+    }
+
+    std::string cache;
+    Luau::CodeGen::compileToCache(L, -1, nativeOptions, cache);
+
+    if (cache.empty())
+        return;
+
+    if (FILE* f = fopen(path.c_str(), "wb"))
+    {
+        fwrite(cache.data(), 1, cache.size(), f);
+        fclose(f);
+    }
+    else
+    {
+        fprintf(stderr, "Warning: failed to write native code cache %s\n", path.c_str());
+    }
+}
+
 // `repl` is used it indicate if a repl should be started after executing the file.
 static bool runFile(const char* name, lua_State* GL, bool repl)
 {
@@ -591,7 +630,17 @@ static bool runFile(const char* name, lua_State* GL, bool repl)
         if (codegen)
         {
             Luau::CodeGen::CompilationOptions nativeOptions;
-            Luau::CodeGen::compile(L, -1, nativeOptions);
+
+            if (codegenStats)
+            {
+                nativeOptions.flags |= Luau::CodeGen::CodeGen_Instrumentation;
+                codegenStatsFunctions.push_back(lua_ref(L, -1));
+            }
+
+            if (!codegenCacheDir.empty())
+                compileWithNativeCache(L, chunkname, nativeOptions);
+            else
+                Luau::CodeGen::compile(L, -1, nativeOptions);
         }
 
         if (coverageActive())
@@ -632,6 +681,87 @@ static bool runFile(const char* name, lua_State* GL, bool repl)
     return status == 0;
 }
 
+static void writeJsonString(FILE* f, const std::string& str)
+{
+    fputc('"', f);
+
+    for (char ch : str)
+    {
+        if (ch == '"' || ch == '\\')
+            fprintf(f, "\\%c", ch);
+        else if ((unsigned char)ch < ' ')
+            fprintf(f, "\\u%04x", ch);
+        else
+            fputc(ch, f);
+    }
+
+    fputc('"', f);
+}
+
+// Writes execution counters of the native code of each script; code loaded from the native code cache is not instrumented
+static void codegenStatsDump(lua_State* L, const char* path)
+{
+    FILE* f = fopen(path, "w");
+    if (!f)
+    {
+        fprintf(stderr, "Error opening native code stats %s\n", path);
+        return;
+    }
+
+    fprintf(f, "{\n");
+
+    for (size_t i = 0; i < codegenStatsFunctions.size(); ++i)
+    {
+        lua_getref(L, codegenStatsFunctions[i]);
+
+        lua_Debug ar = {};
+        lua_getinfo(L, -1, "s", &ar);
+
+        std::vector<Luau::CodeGen::NativeFunctionStats> stats = Luau::CodeGen::getNativeFunctionStats(L, -1);
+
+        fprintf(f, "    ");
+        writeJsonString(f, ar.short_src);
+        fprintf(f, ": [");
+
+        for (size_t j = 0; j < stats.size(); ++j)
+        {
+            const Luau::CodeGen::NativeFunctionStats& function = stats[j];
+
+            fprintf(f, "%s\n        {\"name\": ", j == 0 ? "" : ",");
+            writeJsonString(f, function.name);
+            fprintf(
+                f,
+                ", \"line\": %d, \"entries\": %llu, \"fallbacks\": %llu, \"exits\": %llu, \"exitLocations\": [",
+                function.line,
+                (unsigned long long)function.entries,
+                (unsigned long long)function.fallbacks,
+                (unsigned long long)function.exits
+            );
+
+            for (size_t k = 0; k < function.exitLocations.size(); ++k)
+            {
+                const Luau::CodeGen::NativeExitStats& exit = function.exitLocations[k];
+
+                fprintf(
+                    f, "%s{\"pc\": %u, \"line\": %d, \"count\": %llu}", k == 0 ? "" : ", ", exit.pcpos, exit.line, (unsigned long long)exit.count
+                );
+            }
+
+            fprintf(f, "]}");
+        }
+
+        fprintf(f, stats.empty() ? "]" : "\n    ]");
+        fprintf(f, i + 1 == codegenStatsFunctions.size() ? "\n" : ",\n");
+
+        lua_pop(L, 1);
+    }
+
+    fprintf(f, "}\n");
+    fclose(f);
+
+    printf("Native code stats written to %s (%d scripts)\n", path, int(codegenStatsFunctions.size()));
+}
+
 static void displayHelp(const char* argv0)
 {
     printf("Usage: %s [options] [file list] [-a] [arg list]\n", argv0);
@@ -647,6 +777,10 @@ static void displayHelp(const char* argv0)
     printf("  --profile[=N]: profile the code using N Hz sampling (default 10000) and output results to profile.out\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
     printf("  --codegen: execute code using native code generation\n");
+    printf("  --codegen-cache=<dir>: with --codegen, store native code of scripts in a directory and reuse it in later runs\n");
+    printf("  --codegen-jitdump: execute code using native code generation and write /tmp/jit-<pid>.dump for 'perf inject --jit'\n");
+    printf("  --codegen-gdb: execute code using native code generation and register it with the GDB JIT interface\n");
+    printf("  --codegen-stats: execute code using instrumented native code and output its execution counters to codegen-stats.json\n");
     printf("  --program-args,-a: declare start of arguments to be passed to the Luau program\n");
 }
 
@@ -668,6 +802,8 @@ int replMain(int argc, char** argv)
     bool coverage = false;
     bool interactive = false;
     bool codegenPerf = false;
+    bool codegenJitDump = false;
+    bool codegenGdb = false;
     int program_args = argc;
 
     for (int i = 1; i < argc; i++)
@@ -713,11 +849,30 @@ int replMain(int argc, char** argv)
         {
             codegen = true;
         }
+        else if (strncmp(argv[i], "--codegen-cache=", 16) == 0)
+        {
+            codegenCacheDir = argv[i] + 16;
+        }
         else if (strcmp(argv[i], "--codegen-perf") == 0)
         {
             codegen = true;
             codegenPerf = true;
         }
+        else if (strcmp(argv[i], "--codegen-jitdump") == 0)
+        {
+            codegen = true;
+            codegenJitDump = true;
+        }
+        else if (strcmp(argv[i], "--codegen-gdb") == 0)
+        {
+            codegen = true;
+            codegenGdb = true;
+        }
+        else if (strcmp(argv[i], "--codegen-stats") == 0)
+        {
+            codegen = true;
+            codegenStats = true;
+        }
         else if (strcmp(argv[i], "--coverage") == 0)
         {
             coverage = true;
@@ -777,6 +932,30 @@ int replMain(int argc, char** argv)
 #endif
     }
 
+    if (codegenJitDump)
+    {
+#if __linux__
+        char path[128];
+        snprintf(path, sizeof(path), "/tmp/jit-%d.dump", getpid());
+
+        // note, the dump is finished by the operating system when the process exits, which perf accepts
+        if (!Luau::CodeGen::startJitDump(path))
+        {
+            fprintf(stderr, "Error: failed to create %s (the file must not exist yet)\n", path);
+            return 1;
+        }
+#else
+        fprintf(stderr, "--codegen-jitdump option is only supported on Linux\n");
+        return 1;
+#endif
+    }
+
+    if (codegenGdb && !Luau::CodeGen::setGdbJitRegistration(true))
+    {
+        fprintf(stderr, "--codegen-gdb option is only supported on Linux\n");
+        return 1;
+    }
+
     if (codegen && !Luau::CodeGen::isSupported())
         fprintf(stderr, "Warning: Native code generation is not supported in current configuration\n");
 
@@ -817,6 +996,9 @@ int replMain(int argc, char** argv)
         if (coverage)
             coverageDump("coverage.out");
 
+        if (codegenStats)
+            codegenStatsDump(L, "codegen-stats.json");
+
         return failed ? 1 : 0;
     }
 }
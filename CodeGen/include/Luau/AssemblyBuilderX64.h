@@ -18,6 +18,11 @@ namespace CodeGen
 namespace X64
 {
 
+enum FeaturesX64
+{
+    Feature_FMA3 = 1 << 0,
+};
+
 enum class RoundingModeX64
 {
     RoundToNearestEven = 0b00,
@@ -42,8 +47,8 @@ enum class ABIX64
 class AssemblyBuilderX64
 {
 public:
-    explicit AssemblyBuilderX64(bool logText, ABIX64 abi);
-    explicit AssemblyBuilderX64(bool logText);
+    explicit AssemblyBuilderX64(bool logText, ABIX64 abi, unsigned int features = 0);
+    explicit AssemblyBuilderX64(bool logText, unsigned int features = 0);
     ~AssemblyBuilderX64();
 
     // Base two operand instructions with 9 opcode selection
@@ -173,6 +178,10 @@ public:
 
     void vdpps(OperandX64 dst, OperandX64 src1, OperandX64 src2, uint8_t mask);
 
+    // Fused multiply-add, dst = src1 * src2 + dst (requires Feature_FMA3)
+    void vfmadd231sd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+    void vfmadd231ps(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+
     // Run final checks
     bool finalize();
 
@@ -215,6 +224,7 @@ public:
     const bool logText = false;
 
     const ABIX64 abi;
+    const unsigned int features = 0;
 
 private:
     // Instruction archetypes
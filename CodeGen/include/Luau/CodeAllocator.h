@@ -3,6 +3,7 @@
 
 #include "Luau/CodeGenOptions.h"
 
+#include <map>
 #include <vector>
 
 #include <stddef.h>
@@ -34,6 +35,13 @@ struct CodeAllocator
         uint8_t*& resultCodeStart
     );
 
+    // Each allocation starts with a single reference that belongs to the caller; 'address' can point anywhere inside of the allocation
+    // Once the last reference is released the allocation is dead, and a block without live allocations is reclaimed for new code
+    void addAllocationRefs(const uint8_t* address, size_t count);
+    void releaseAllocation(const uint8_t* address);
+
+    [[nodiscard]] CodeMemoryStats getMemoryStats() const;
+
     // Provided to unwind info callbacks
     void* context = nullptr;
 
@@ -49,7 +57,26 @@ private:
     // But to simplify block space checks, we limit the max size of all that data
     static const size_t kMaxReservedDataSize = 256;
 
+    struct Block
+    {
+        uint8_t* memory = nullptr;
+        void* unwindInfo = nullptr;
+
+        size_t liveAllocations = 0;
+        size_t liveBytes = 0;
+        size_t deadBytes = 0;
+    };
+
+    struct Allocation
+    {
+        size_t size = 0;
+        size_t refs = 0;
+    };
+
     bool allocateNewBlock(size_t& unwindInfoSize);
+    void reclaimBlock(size_t blockIndex);
+    size_t getMappedBlockCount() const;
+    size_t findBlock(const uint8_t* address) const;
 
     uint8_t* allocatePages(size_t size) const;
     void freePages(uint8_t* mem, size_t size) const;
@@ -59,8 +86,16 @@ private:
     uint8_t* blockEnd = nullptr;
 
     // All allocated blocks
-    std::vector<uint8_t*> blocks;
-    std::vector<void*> unwindInfos;
+    std::vector<Block> blocks;
+
+    // Live allocations by start address
+    std::map<uintptr_t, Allocation> allocations;
+
+    // Block without live code that is kept around to avoid going back to the system for the next one
+    uint8_t* spareBlock = nullptr;
+
+    size_t blocksReclaimed = 0;
+    size_t reclaimedBytes = 0;
 
     size_t blockSize = 0;
     size_t maxTotalSize = 0;
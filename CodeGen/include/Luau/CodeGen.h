@@ -35,8 +35,9 @@ enum class CodeGenCompilationResult
     CodeGenAssemblerFinalizationFailure = 7,  // Failure during assembler finalization
     CodeGenLoweringFailure = 8,               // Lowering failed
     AllocationFailed = 9,                     // Native codegen failed due to an allocation error
+    CacheMismatch = 10,                       // Cached native code is malformed or was generated for different bytecode or options
 
-    Count = 10,
+    Count = 11,
 };
 
 std::string toString(const CodeGenCompilationResult& result);
@@ -73,6 +74,38 @@ struct CompilationStats
     uint32_t functionsBound = 0;
 };
 
+// Functions compiled on demand when running with CodeGen_TierUp
+struct TierUpStats
+{
+    uint32_t functionsMarked = 0;     // functions that were set up to be compiled once they become hot
+    uint32_t functionsCompiled = 0;   // hot functions that were compiled to native code
+    uint32_t functionsSkipped = 0;    // hot functions that could not be compiled and remain in the interpreter
+    uint32_t functionsRecompiled = 0; // compiled functions that were compiled again without type feedback, as the types it predicted didn't hold
+    uint32_t callsInlined = 0;        // calls to small Luau functions that were inlined into the native code of their callers
+
+    size_t nativeCodeSizeBytes = 0;
+};
+
+struct NativeExitStats
+{
+    uint32_t pcpos = 0; // bytecode instruction that continued in the interpreter
+    int line = 0;
+    uint64_t count = 0;
+};
+
+// Execution counters of a function that was compiled with CodeGen_Instrumentation
+struct NativeFunctionStats
+{
+    std::string name;
+    int line = 0;
+
+    uint64_t entries = 0;   // calls that started running the native code
+    uint64_t fallbacks = 0; // instructions that called into the VM to be completed
+    uint64_t exits = 0;     // exits to the interpreter, which are broken down by the instruction in exitLocations
+
+    std::vector<NativeExitStats> exitLocations;
+};
+
 bool isSupported();
 
 class SharedCodeGenContext;
@@ -138,6 +171,54 @@ CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, unsig
 CompilationResult compile(lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats = nullptr);
 CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats = nullptr);
 
+// Builds target function and all inner functions like compile, and appends their native code to 'cache', from which a later process can
+// load it with loadFromCache instead of compiling them again.  CodeGen_TierUp and CodeGen_Instrumentation are not supported and are ignored.
+// Nothing is appended if the executable can't be read to identify the build that generated the code.
+CompilationResult compileToCache(lua_State* L, int idx, const CompilationOptions& options, std::string& cache, CompilationStats* stats = nullptr);
+
+// Binds native code stored by compileToCache to target function and all inner functions without compiling them.  The code is only used when
+// it was generated from the same bytecode, with the same options and flags, for the same CPU and by the same version of the code generator;
+// otherwise nothing is bound and CacheMismatch is returned, after which the functions can be compiled as usual
+CompilationResult loadFromCache(
+    lua_State* L,
+    int idx,
+    const CompilationOptions& options,
+    const char* cache,
+    size_t cacheSize,
+    CompilationStats* stats = nullptr
+);
+CompilationResult loadFromCache(
+    const ModuleId& moduleId,
+    lua_State* L,
+    int idx,
+    const CompilationOptions& options,
+    const char* cache,
+    size_t cacheSize,
+    CompilationStats* stats = nullptr
+);
+
+// Starts building target function and all inner functions on background threads and returns without waiting for the result.
+// The functions keep running in the interpreter until their native code is installed, which happens on the VM thread when one of
+// them is called, or when installAsyncCompilations is called.  Options are copied, and hooks are invoked on the background threads.
+// CodeGen_TierUp is not supported and is ignored.
+CompilationResult compileAsync(lua_State* L, int idx, const CompilationOptions& options = {});
+
+// Installs native code of the background compilations started by compileAsync on this VM that have finished; when wait is set,
+// waits for all of them to finish first.  Returns the number of functions that are still being compiled
+uint32_t installAsyncCompilations(lua_State* L, bool wait, CompilationStats* stats = nullptr);
+
+// Returns statistics of functions compiled on demand in the code-gen context of the VM; when the context is shared, the
+// statistics cover all VMs that use it
+TierUpStats getTierUpStats(lua_State* L);
+
+// Returns usage of executable memory in the code-gen context of the VM; code of collected functions and unloaded modules is dead
+// until all code in its block is dead as well, at which point the block is reclaimed
+CodeMemoryStats getCodeMemoryStats(lua_State* L);
+
+// Returns execution counters of target function and all inner functions that have native code compiled with CodeGen_Instrumentation.
+// Counters are not synchronized, so they are approximate when the native code is shared by VMs that run concurrently
+std::vector<NativeFunctionStats> getNativeFunctionStats(lua_State* L, int idx);
+
 // Generates assembly for target function and all inner functions
 std::string getAssembly(lua_State* L, int idx, AssemblyOptions options = {}, LoweringStats* stats = nullptr);
 
@@ -145,5 +226,15 @@ using PerfLogFn = void (*)(void* context, uintptr_t addr, unsigned size, const c
 
 void setPerfLog(void* context, PerfLogFn logFn);
 
+// Starts writing a jitdump file with the code of native functions and the Luau source lines it was generated from, which 'perf inject --jit'
+// uses to attribute samples to Luau functions and lines; perf only finds the file if it's named jit-<pid>.dump, and samples have to be
+// recorded with '-k mono'.  Only supported on Linux; returns false if the file already exists, can't be created or a dump is already being written
+bool startJitDump(const char* path);
+void stopJitDump();
+
+// Registers native code with the GDB JIT interface, so that a debugger can show Luau function names and source lines of native frames.
+// Only supported on Linux; returns false if it's not supported
+bool setGdbJitRegistration(bool enabled);
+
 } // namespace CodeGen
 } // namespace Luau
@@ -17,10 +17,28 @@ enum CodeGenFlags
     CodeGen_OnlyNativeModules = 1 << 0,
     // Run native codegen for functions that the compiler considers not profitable
     CodeGen_ColdFunctions = 1 << 1,
+    // Instead of compiling functions right away, compile each function once it has been called or has looped often enough in the interpreter
+    CodeGen_TierUp = 1 << 2,
+    // Compute multiplications followed by additions with a single rounding step when the CPU supports it (x64 with FMA3)
+    // Results can differ from the interpreter in the last bit
+    CodeGen_FusedMultiplyAdd = 1 << 3,
+    // Count calls that enter native code, exits to the VM and fallback calls of each function; see getNativeFunctionStats
+    CodeGen_Instrumentation = 1 << 4,
 };
 
 using AllocationCallback = void(void* context, void* oldPointer, size_t oldSize, void* newPointer, size_t newSize);
 
+// Executable memory used by native code; sizes include the data that is placed in front of the code of each module
+struct CodeMemoryStats
+{
+    size_t blockCount = 0;      // executable blocks that are currently allocated
+    size_t blocksReclaimed = 0; // blocks that were released or reused after all of their code became dead
+
+    size_t liveCodeBytes = 0;      // code of modules that are still bound to functions
+    size_t deadCodeBytes = 0;      // code of unloaded modules that shares a block with live code and can't be reclaimed yet
+    size_t reclaimedCodeBytes = 0; // code of unloaded modules in blocks that were reclaimed
+};
+
 struct IrBuilder;
 struct IrOp;
 
@@ -50,6 +50,14 @@ struct BlockOrdering
     bool visited = false;
 };
 
+struct CfgLoop
+{
+    uint32_t header = ~0u;
+
+    // Blocks of the loop body in ascending index order, including the header and the fallback blocks that rejoin the loop
+    std::vector<uint32_t> blocks;
+};
+
 struct CfgInfo
 {
     std::vector<uint32_t> predecessors;
@@ -67,6 +75,9 @@ struct CfgInfo
 
     std::vector<BlockOrdering> domOrdering;
 
+    // Natural loops, outer loops are placed before the loops nested inside them
+    std::vector<CfgLoop> loops;
+
     // VM registers that are live when the block is entered
     // Additionally, an active variadic sequence can exist at the entry of the block
     std::vector<RegisterSet> in;
@@ -97,6 +108,14 @@ struct CfgInfo
 void computeCfgImmediateDominators(IrFunction& function);
 void computeCfgDominanceTreeChildren(IrFunction& function);
 
+// Check if block 'a' dominates block 'b', dominance tree has to be computed
+bool dominates(const CfgInfo& cfg, uint32_t a, uint32_t b);
+
+// A natural loop is defined by a back edge from a block to the loop header that dominates it
+// Loop body is made from the blocks that can reach the back edge without passing through the header
+// Loops that share the same header are merged together
+void computeCfgLoops(IrFunction& function);
+
 struct IdfContext
 {
     struct BlockAndOrdering
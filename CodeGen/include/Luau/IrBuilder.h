@@ -44,6 +44,7 @@ struct IrBuilder
     IrOp constImport(unsigned value);
     IrOp constDouble(double value);
     IrOp constTag(uint8_t value);
+    IrOp constPointer(const void* value);
     IrOp constAny(IrConst constant, uint64_t asCommonKey);
 
     IrOp cond(IrCondition cond);
@@ -39,7 +39,7 @@ enum class IrCmd : uint8_t
     NOP,
 
     // Load a tag from TValue
-    // A: Rn or Kn
+    // A: Rn or Kn or pointer (TValue)
     LOAD_TAG,
 
     // Load a pointer (*) from TValue
@@ -47,7 +47,7 @@ enum class IrCmd : uint8_t
     LOAD_POINTER,
 
     // Load a double number from TValue
-    // A: Rn or Kn
+    // A: Rn or Kn or pointer (TValue)
     LOAD_DOUBLE,
 
     // Load an int from TValue
@@ -159,6 +159,11 @@ enum class IrCmd : uint8_t
     MIN_NUM,
     MAX_NUM,
 
+    // Compute A * B + C with a single rounding step
+    // A, B, C: double
+    // Only created by final x64 lowering when the CPU supports FMA3, where B can also be Rn or Kn
+    MULADD_NUM,
+
     // Negate a double number
     // A: double
     UNM_NUM,
@@ -204,6 +209,11 @@ enum class IrCmd : uint8_t
     MUL_VEC,
     DIV_VEC,
 
+    // Compute A * B + C for each lane with a single rounding step
+    // A, B, C: TValue
+    // Only created by final x64 lowering when the CPU supports FMA3
+    MULADD_VEC,
+
     // Negate a vector
     // A: TValue
     UNM_VEC,
@@ -292,6 +302,17 @@ enum class IrCmd : uint8_t
     // A: pointer (string)
     STRING_LEN,
 
+    // Get a single-character string from the cache of the VM or jump if it hasn't been created yet
+    // A: int (character code, 0..255)
+    // B: block
+    STRING_CHAR,
+
+    // Create a string from a part of another string
+    // A: pointer (string)
+    // B: int (offset)
+    // C: int (length)
+    STRING_SUB,
+
     // Allocate new table
     // A: unsigned int (array element count)
     // B: unsigned int (node element count)
@@ -317,11 +338,24 @@ enum class IrCmd : uint8_t
     // C: block
     TRY_CALL_FASTGETTM,
 
+    // Get pointer (TValue) to the value of a userdata field or method that was cached for the instruction, or jump if the cache entry
+    // doesn't match the metatable of the userdata or was invalidated
+    // A: pointer (userdata)
+    // B: unsigned int (pcpos)
+    // C: block
+    // D: Kn (method name to store in lua_State::namecall) or undef
+    GET_USERDATA_CACHE_ADDR,
+
     // Create new tagged userdata
     // A: int (size)
     // B: int (tag)
     NEW_USERDATA,
 
+    // Append string contents to the storage of a string builder (userdata tagged with UTAG_STRBUF)
+    // A: pointer (userdata)
+    // B: pointer (string)
+    STRBUF_APPEND,
+
     // Convert integer into a double number
     // A: int
     INT_TO_NUM,
@@ -475,7 +509,7 @@ enum class IrCmd : uint8_t
 
     // Guard against cached table node slot not matching the actual table node slot for a key
     // A: pointer (LuaNode)
-    // B: Kn
+    // B: Kn or pointer constant (TString)
     // C: block/undef
     // When undef is specified instead of a block, execution is aborted on check failure
     CHECK_SLOT_MATCH,
@@ -492,6 +526,13 @@ enum class IrCmd : uint8_t
     // When undef is specified instead of a block, execution is aborted on check failure
     CHECK_NODE_VALUE,
 
+    // Guard against a function that is not a Luau closure of the specified prototype, or has breakpoints in it
+    // A: pointer (Closure)
+    // B: pointer constant (Proto)
+    // C: block/vmexit/undef
+    // When undef is specified instead of a block, execution is aborted on check failure
+    CHECK_CLOSURE_PROTO,
+
     // Guard against access at specified offset/size overflowing the buffer length
     // A: pointer (buffer)
     // B: int (offset)
@@ -511,6 +552,7 @@ enum class IrCmd : uint8_t
 
     // Check interrupt handler
     // A: unsigned int (pcpos)
+    // B: block (optional, execution continues in that block if the handler has been called)
     INTERRUPT,
 
     // Check and run GC assist if necessary
@@ -593,6 +635,10 @@ enum class IrCmd : uint8_t
     // A: unsigned int (bytecode instruction index)
     COVERAGE,
 
+    // Increment an execution counter of a function compiled with CodeGen_Instrumentation
+    // A: unsigned int (counter index, see NativeExecCounter)
+    INC_EXEC_COUNTER,
+
     // Operations that have a translation, but use a full instruction fallback
 
     // Load a value from global table at specified key
@@ -782,6 +828,7 @@ enum class IrConstKind : uint8_t
     Double,
     Tag,
     Import,
+    Pointer,
 };
 
 struct IrConst
@@ -794,6 +841,7 @@ struct IrConst
         unsigned valueUint;
         double valueDouble;
         uint8_t valueTag;
+        const void* valuePointer;
     };
 };
 
@@ -1055,6 +1103,21 @@ struct IrFunction
     std::vector<BytecodeBlock> bcBlocks;
     std::vector<BytecodeTypes> bcTypes;
 
+    // Number of instructions that were specialized using the operand types observed by the interpreter
+    uint32_t speculativeInstCount = 0;
+
+    // For each call instruction, a Luau function that it was observed to call, which can be inlined under an identity guard
+    std::vector<Proto*> callTargets;
+
+    // For each call that was inlined, the function prototype that it calls
+    std::vector<Proto*> inlinedCalls;
+
+    // Number of userdata field and method accesses that read the inline cache of the function prototype
+    uint32_t userdataCacheSiteCount = 0;
+
+    // Execution counters of an instrumented function; owned by the native function once it is created
+    uint64_t* executionCounters = nullptr;
+
     std::vector<BytecodeMapping> bcMapping;
     uint32_t entryBlock = 0;
     uint32_t entryLocation = 0;
@@ -1156,6 +1219,14 @@ struct IrFunction
         return value.valueUint;
     }
 
+    const void* pointerOp(IrOp op)
+    {
+        IrConst& value = constOp(op);
+
+        CODEGEN_ASSERT(value.kind == IrConstKind::Pointer);
+        return value.valuePointer;
+    }
+
     std::optional<unsigned> asUintOp(IrOp op)
     {
         if (op.kind != IrOpKind::Constant)
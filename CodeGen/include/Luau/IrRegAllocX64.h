@@ -65,6 +65,11 @@ struct IrRegAllocX64
 
     void preserveAndFreeInstValues();
 
+    // Once stored, a value keeps its spill slot until the end of its live range, so that it doesn't have to be stored again
+    uint8_t findSpillHome(uint32_t instIdx) const;
+    void releaseSpillHome(uint32_t instIdx);
+    bool releaseSpillHomes(unsigned startSpillId);
+
     uint32_t findInstructionWithFurthestNextUse(const std::array<uint32_t, 16>& regInstUsers) const;
 
     void assertFree(RegisterX64 reg) const;
@@ -87,6 +92,9 @@ struct IrRegAllocX64
     unsigned maxUsedSlot = 0;
     unsigned nextSpillId = 1;
     std::vector<IrSpillX64> spills;
+
+    // Spill slots that hold a copy of a value which might currently be in a register
+    std::vector<IrSpillX64> spillHomes;
 };
 
 struct ScopedRegX64
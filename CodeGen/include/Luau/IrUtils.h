@@ -51,6 +51,8 @@ inline bool isNonTerminatingJump(IrCmd cmd)
     {
     case IrCmd::TRY_NUM_TO_INDEX:
     case IrCmd::TRY_CALL_FASTGETTM:
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
+    case IrCmd::STRING_CHAR:
     case IrCmd::CHECK_FASTCALL_RES:
     case IrCmd::CHECK_TAG:
     case IrCmd::CHECK_TRUTHY:
@@ -61,6 +63,7 @@ inline bool isNonTerminatingJump(IrCmd cmd)
     case IrCmd::CHECK_SLOT_MATCH:
     case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::CHECK_CLOSURE_PROTO:
     case IrCmd::CHECK_BUFFER_LEN:
     case IrCmd::CHECK_USERDATA_TAG:
         return true;
@@ -96,6 +99,7 @@ inline bool hasResult(IrCmd cmd)
     case IrCmd::MOD_NUM:
     case IrCmd::MIN_NUM:
     case IrCmd::MAX_NUM:
+    case IrCmd::MULADD_NUM:
     case IrCmd::UNM_NUM:
     case IrCmd::FLOOR_NUM:
     case IrCmd::CEIL_NUM:
@@ -108,6 +112,7 @@ inline bool hasResult(IrCmd cmd)
     case IrCmd::SUB_VEC:
     case IrCmd::MUL_VEC:
     case IrCmd::DIV_VEC:
+    case IrCmd::MULADD_VEC:
     case IrCmd::DOT_VEC:
     case IrCmd::UNM_VEC:
     case IrCmd::NOT_ANY:
@@ -116,10 +121,13 @@ inline bool hasResult(IrCmd cmd)
     case IrCmd::TABLE_LEN:
     case IrCmd::TABLE_SETNUM:
     case IrCmd::STRING_LEN:
+    case IrCmd::STRING_CHAR:
+    case IrCmd::STRING_SUB:
     case IrCmd::NEW_TABLE:
     case IrCmd::DUP_TABLE:
     case IrCmd::TRY_NUM_TO_INDEX:
     case IrCmd::TRY_CALL_FASTGETTM:
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
     case IrCmd::NEW_USERDATA:
     case IrCmd::INT_TO_NUM:
     case IrCmd::UINT_TO_NUM:
@@ -176,10 +184,35 @@ inline bool isPseudo(IrCmd cmd)
     return cmd == IrCmd::NOP || cmd == IrCmd::SUBSTITUTE;
 }
 
+inline bool isFullFallback(IrCmd cmd)
+{
+    // Instructions that are completed by the VM implementation of the bytecode instruction
+    switch (cmd)
+    {
+    case IrCmd::FALLBACK_GETGLOBAL:
+    case IrCmd::FALLBACK_SETGLOBAL:
+    case IrCmd::FALLBACK_GETTABLEKS:
+    case IrCmd::FALLBACK_SETTABLEKS:
+    case IrCmd::FALLBACK_NAMECALL:
+    case IrCmd::FALLBACK_PREPVARARGS:
+    case IrCmd::FALLBACK_GETVARARGS:
+    case IrCmd::FALLBACK_DUPCLOSURE:
+    case IrCmd::FALLBACK_FORGPREP:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
 IrValueKind getCmdValueKind(IrCmd cmd);
 
 bool isGCO(uint8_t tag);
 
+// Instructions that cannot invalidate table state (metatable, readonly flag, array size) and the environment
+bool isTableStateNeutral(IrCmd cmd);
+
 // Optional bit has to be cleared at call site, otherwise, this will return 'false' for 'userdata?'
 bool isUserdataBytecodeType(uint8_t ty);
 bool isCustomUserdataBytecodeType(uint8_t ty);
@@ -235,5 +268,8 @@ std::vector<uint32_t> getSortedBlockOrder(IrFunction& function);
 // 'dummy' block is returned if the end of array was reached
 IrBlock& getNextBlock(IrFunction& function, const std::vector<uint32_t>& sortedBlocks, IrBlock& dummy, size_t i);
 
+// Returns true if the only way to enter block 'next' is through the terminator of block 'curr'
+bool isBlockContinuation(const IrFunction& function, const IrBlock& curr, const IrBlock& next);
+
 } // namespace CodeGen
 } // namespace Luau
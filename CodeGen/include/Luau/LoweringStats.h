@@ -56,10 +56,13 @@ struct LoweringStats
     unsigned skippedFunctions = 0;
     int spillsToSlot = 0;
     int spillsToRestore = 0;
+    int spillsToExistingSlot = 0;
     unsigned maxSpillSlotsUsed = 0;
     unsigned blocksPreOpt = 0;
     unsigned blocksPostOpt = 0;
     unsigned maxBlockInstructions = 0;
+    unsigned inlinedCalls = 0;
+    unsigned scalarReplacedTables = 0;
 
     int regAllocErrors = 0;
     int loweringErrors = 0;
@@ -82,10 +85,13 @@ struct LoweringStats
         this->skippedFunctions += that.skippedFunctions;
         this->spillsToSlot += that.spillsToSlot;
         this->spillsToRestore += that.spillsToRestore;
+        this->spillsToExistingSlot += that.spillsToExistingSlot;
         this->maxSpillSlotsUsed = std::max(this->maxSpillSlotsUsed, that.maxSpillSlotsUsed);
         this->blocksPreOpt += that.blocksPreOpt;
         this->blocksPostOpt += that.blocksPostOpt;
         this->maxBlockInstructions = std::max(this->maxBlockInstructions, that.maxBlockInstructions);
+        this->inlinedCalls += that.inlinedCalls;
+        this->scalarReplacedTables += that.scalarReplacedTables;
 
         this->regAllocErrors += that.regAllocErrors;
         this->loweringErrors += that.loweringErrors;
@@ -4,6 +4,8 @@
 #include <memory>
 #include <stdint.h>
 
+struct Proto;
+
 namespace Luau
 {
 namespace CodeGen
@@ -15,6 +17,19 @@ namespace CodeGen
 
 class NativeModule;
 
+// Counters of native code compiled with CodeGen_Instrumentation; they are
+// followed by a counter of exits to the VM for each bytecode instruction.
+enum NativeExecCounter : uint32_t
+{
+    NativeExecCounter_Entry,    // calls that started running the native code
+    NativeExecCounter_Fallback, // instructions that called into the VM to be completed
+    NativeExecCounter_Exit,     // first of the exit counters
+};
+
+// The instruction offset of bytecode instructions that don't have native code,
+// such as instructions that were removed as unreachable.
+constexpr uint32_t kNativeInstructionOffsetNone = ~0u;
+
 struct NativeProtoExecDataHeader
 {
     // The NativeModule that owns this NativeProto.  This is initialized
@@ -34,6 +49,28 @@ struct NativeProtoExecDataHeader
 
     // The size of the native code for this NativeProto, in bytes.
     size_t nativeCodeSize = 0;
+
+    // The number of bytecode instructions that were specialized using the type
+    // feedback of the interpreter, and the number of exits to the VM from them
+    // that were observed so far.
+    uint32_t speculativeInstructionCount = 0;
+    uint32_t speculationFailureCount = 0;
+
+    // The number of calls to other Luau functions that were inlined, and the
+    // prototype of the function for each of them, or null when there are none.
+    // The array is owned by the NativeProto; the code refers to the inlined
+    // prototypes, so the VM keeps them alive with the proto that runs the code.
+    uint32_t inlinedCallCount = 0;
+    Proto** inlinedCalls = nullptr;
+
+    // The number of userdata field and method accesses that read the inline
+    // cache of the proto; the cache is only allocated when this is not zero.
+    uint32_t userdataCacheSiteCount = 0;
+
+    // The execution counters that the native code increments when it was
+    // compiled with CodeGen_Instrumentation, or null; see NativeExecCounter.
+    // The array is owned by the NativeProto.
+    uint64_t* executionCounters = nullptr;
 };
 
 // Make sure that the instruction offsets array following the header will be
@@ -0,0 +1,17 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/IrData.h"
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+struct IrBuilder;
+
+// Requires up-to-date CFG information; returns the number of table allocations that were removed
+unsigned scalarReplaceTablesInBlockChains(IrBuilder& build);
+
+} // namespace CodeGen
+} // namespace Luau
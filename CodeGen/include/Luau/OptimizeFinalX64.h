@@ -10,5 +10,8 @@ namespace CodeGen
 
 void optimizeMemoryOperandsX64(IrFunction& function);
 
+// Replaces additions of single-use products with MULADD_NUM/MULADD_VEC, has to be performed before last use locations are computed
+void fuseMultiplyAddX64(IrFunction& function);
+
 } // namespace CodeGen
 } // namespace Luau
@@ -0,0 +1,17 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/IrData.h"
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+struct IrBuilder;
+
+// Requires up-to-date CFG information, CFG has to be recomputed if the function returns true
+bool versionLoops(IrBuilder& build);
+
+} // namespace CodeGen
+} // namespace Luau
@@ -159,6 +159,8 @@ public:
     // count becomes zero
     void eraseNativeModuleIfUnreferenced(const NativeModule& nativeModule);
 
+    [[nodiscard]] CodeMemoryStats getMemoryStats() const;
+
 private:
     struct ModuleIdHash
     {
@@ -60,7 +60,7 @@ static_assert(sizeof(cmovTextForCondition) / sizeof(cmovTextForCondition[0]) ==
 #define SIB(scale, index, base) ((getScaleEncoding(scale) << 6) | (((index) & 0x7) << 3) | ((base) & 0x7))
 
 const unsigned AVX_0F = 0b0001;
-[[maybe_unused]] const unsigned AVX_0F38 = 0b0010;
+const unsigned AVX_0F38 = 0b0010;
 [[maybe_unused]] const unsigned AVX_0F3A = 0b0011;
 
 const unsigned AVX_NP = 0b00;
@@ -82,9 +82,10 @@ static ABIX64 getCurrentX64ABI()
 #endif
 }
 
-AssemblyBuilderX64::AssemblyBuilderX64(bool logText, ABIX64 abi)
+AssemblyBuilderX64::AssemblyBuilderX64(bool logText, ABIX64 abi, unsigned int features)
     : logText(logText)
     , abi(abi)
+    , features(features)
     , constCache32(~0u)
     , constCache64(~0ull)
 {
@@ -96,8 +97,8 @@ AssemblyBuilderX64::AssemblyBuilderX64(bool logText, ABIX64 abi)
     codeEnd = code.data() + code.size();
 }
 
-AssemblyBuilderX64::AssemblyBuilderX64(bool logText)
-    : AssemblyBuilderX64(logText, getCurrentX64ABI())
+AssemblyBuilderX64::AssemblyBuilderX64(bool logText, unsigned int features)
+    : AssemblyBuilderX64(logText, getCurrentX64ABI(), features)
 {
 }
 
@@ -887,7 +888,10 @@ void AssemblyBuilderX64::vmovapd(OperandX64 dst, OperandX64 src)
 
 void AssemblyBuilderX64::vmovaps(OperandX64 dst, OperandX64 src)
 {
-    placeAvx("vmovaps", dst, src, 0x28, 0x29, false, AVX_0F, AVX_NP);
+    if (dst.cat == CategoryX64::reg && src.cat == CategoryX64::reg)
+        placeAvx("vmovaps", dst, src, 0x28, false, AVX_0F, AVX_NP);
+    else
+        placeAvx("vmovaps", dst, src, 0x28, 0x29, false, AVX_0F, AVX_NP);
 }
 
 void AssemblyBuilderX64::vmovupd(OperandX64 dst, OperandX64 src)
@@ -978,6 +982,20 @@ void AssemblyBuilderX64::vdpps(OperandX64 dst, OperandX64 src1, OperandX64 src2,
     placeAvx("vdpps", dst, src1, src2, mask, 0x40, false, AVX_0F3A, AVX_66);
 }
 
+void AssemblyBuilderX64::vfmadd231sd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    CODEGEN_ASSERT(features & Feature_FMA3);
+
+    placeAvx("vfmadd231sd", dst, src1, src2, 0xb9, true, AVX_0F38, AVX_66);
+}
+
+void AssemblyBuilderX64::vfmadd231ps(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    CODEGEN_ASSERT(features & Feature_FMA3);
+
+    placeAvx("vfmadd231ps", dst, src1, src2, 0xb8, false, AVX_0F38, AVX_66);
+}
+
 bool AssemblyBuilderX64::finalize()
 {
     code.resize(codePos - code.data());
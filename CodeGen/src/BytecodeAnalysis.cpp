@@ -5,6 +5,7 @@
 #include "Luau/IrData.h"
 #include "Luau/IrUtils.h"
 
+#include "lfunc.h"
 #include "lobject.h"
 #include "lstate.h"
 
@@ -236,6 +237,43 @@ static uint8_t getBytecodeConstantTag(Proto* proto, unsigned ki)
     return LBC_TYPE_ANY;
 }
 
+static uint8_t getFeedbackType(uint8_t mask)
+{
+    if (mask == luaF_feedbackbit(LUA_TNUMBER))
+        return LBC_TYPE_NUMBER;
+    else if (mask == luaF_feedbackbit(LUA_TVECTOR))
+        return LBC_TYPE_VECTOR;
+
+    return LBC_TYPE_ANY;
+}
+
+// Operands without a known type take the single type that the interpreter has observed for them, if any; translation treats such
+// operand types like known ones, which specializes the instruction and guards the types with VM exits
+static void applyTypeFeedback(IrFunction& function, int pcpos, BytecodeTypes& types)
+{
+    const uint8_t* feedback = function.proto->typefeedback;
+
+    if (!feedback)
+        return;
+
+    bool speculative = false;
+
+    if (types.a == LBC_TYPE_ANY && getFeedbackType(feedback[pcpos * 2]) != LBC_TYPE_ANY)
+    {
+        types.a = getFeedbackType(feedback[pcpos * 2]);
+        speculative = true;
+    }
+
+    if (types.b == LBC_TYPE_ANY && getFeedbackType(feedback[pcpos * 2 + 1]) != LBC_TYPE_ANY)
+    {
+        types.b = getFeedbackType(feedback[pcpos * 2 + 1]);
+        speculative = true;
+    }
+
+    if (speculative)
+        function.speculativeInstCount++;
+}
+
 static void applyBuiltinCall(LuauBuiltinFunction bfid, BytecodeTypes& types)
 {
     switch (bfid)
@@ -562,6 +600,10 @@ static void applyBuiltinCall(LuauBuiltinFunction bfid, BytecodeTypes& types)
         types.b = LBC_TYPE_NUMBER;
         types.c = LBC_TYPE_NUMBER;
         break;
+    case LBF_STRBUF_APPEND:
+        types.result = LBC_TYPE_USERDATA;
+        types.a = LBC_TYPE_USERDATA;
+        break;
     }
 }
 
@@ -772,6 +814,24 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 refineRegType(bcTypeInfo, ra, i, bcType.result);
                 break;
             }
+            case LOP_MOVE2:
+            {
+                int ra = LUAU_INSN_A(*pc);
+                int rb = LUAU_INSN_B(*pc);
+                int rc = pc[1] & 0xff;
+                int rd = (pc[1] >> 8) & 0xff;
+
+                // the recorded types describe the second copy, which is the last one to write a register
+                regTags[ra] = regTags[rb];
+                refineRegType(bcTypeInfo, ra, i, regTags[ra]);
+
+                bcType.a = regTags[rd];
+                regTags[rc] = regTags[rd];
+                bcType.result = regTags[rc];
+
+                refineRegType(bcTypeInfo, rc, i, bcType.result);
+                break;
+            }
             case LOP_GETTABLE:
             {
                 if (FFlag::LuauCodeGenBetterBytecodeAnalysis)
@@ -813,6 +873,8 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 bcType.a = regTags[rb];
                 bcType.b = getBytecodeConstantTag(proto, kc);
 
+                applyTypeFeedback(function, i, bcType);
+
                 regTags[ra] = LBC_TYPE_ANY;
 
                 TString* str = gco2ts(function.proto->k[kc].value.gc);
@@ -890,6 +952,8 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 bcType.a = regTags[rb];
                 bcType.b = regTags[rc];
 
+                applyTypeFeedback(function, i, bcType);
+
                 regTags[ra] = LBC_TYPE_ANY;
 
                 if (bcType.a == LBC_TYPE_NUMBER && bcType.b == LBC_TYPE_NUMBER)
@@ -914,6 +978,8 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 bcType.a = regTags[rb];
                 bcType.b = regTags[rc];
 
+                applyTypeFeedback(function, i, bcType);
+
                 regTags[ra] = LBC_TYPE_ANY;
 
                 if (bcType.a == LBC_TYPE_NUMBER)
@@ -992,6 +1058,8 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 bcType.a = regTags[rb];
                 bcType.b = getBytecodeConstantTag(proto, kc);
 
+                applyTypeFeedback(function, i, bcType);
+
                 regTags[ra] = LBC_TYPE_ANY;
 
                 if (bcType.a == LBC_TYPE_NUMBER)
@@ -1108,6 +1176,8 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
 
                 bcType.a = regTags[rb];
 
+                applyTypeFeedback(function, i, bcType);
+
                 regTags[ra] = LBC_TYPE_ANY;
 
                 if (bcType.a == LBC_TYPE_NUMBER)
@@ -1285,6 +1355,8 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 bcType.a = regTags[rb];
                 bcType.b = getBytecodeConstantTag(proto, kc);
 
+                applyTypeFeedback(function, i, bcType);
+
                 // While namecall might result in a callable table, we assume the function fast path
                 regTags[ra] = LBC_TYPE_FUNCTION;
 
@@ -3,6 +3,8 @@
 
 #include "Luau/CodeGenCommon.h"
 
+#include "NativeDebugInfo.h"
+
 #include <string.h>
 
 #if defined(_WIN32)
@@ -61,6 +63,15 @@ static void freePagesImpl(uint8_t* mem, size_t size)
     return VirtualProtect(mem, size, PAGE_EXECUTE_READ, &oldProtect) != 0;
 }
 
+[[nodiscard]] static bool makePagesWritable(uint8_t* mem, size_t size)
+{
+    CODEGEN_ASSERT((uintptr_t(mem) & (kPageSize - 1)) == 0);
+    CODEGEN_ASSERT(size == alignToPageSize(size));
+
+    DWORD oldProtect;
+    return VirtualProtect(mem, size, PAGE_READWRITE, &oldProtect) != 0;
+}
+
 static void flushInstructionCache(uint8_t* mem, size_t size)
 {
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_APP | WINAPI_PARTITION_SYSTEM)
@@ -98,6 +109,14 @@ static void freePagesImpl(uint8_t* mem, size_t size)
     return mprotect(mem, size, PROT_READ | PROT_EXEC) == 0;
 }
 
+[[nodiscard]] static bool makePagesWritable(uint8_t* mem, size_t size)
+{
+    CODEGEN_ASSERT((uintptr_t(mem) & (kPageSize - 1)) == 0);
+    CODEGEN_ASSERT(size == alignToPageSize(size));
+
+    return mprotect(mem, size, PROT_READ | PROT_WRITE) == 0;
+}
+
 static void flushInstructionCache(uint8_t* mem, size_t size)
 {
 #ifdef __APPLE__
@@ -132,12 +151,21 @@ CodeAllocator::~CodeAllocator()
 {
     if (destroyBlockUnwindInfo)
     {
-        for (void* unwindInfo : unwindInfos)
-            destroyBlockUnwindInfo(context, unwindInfo);
+        for (const Block& block : blocks)
+        {
+            if (block.unwindInfo)
+                destroyBlockUnwindInfo(context, block.unwindInfo);
+        }
     }
 
-    for (uint8_t* block : blocks)
-        freePages(block, blockSize);
+    for (const Block& block : blocks)
+    {
+        releaseNativeDebugInfo(block.memory, blockSize);
+        freePages(block.memory, blockSize);
+    }
+
+    if (spareBlock)
+        freePages(spareBlock, blockSize);
 }
 
 bool CodeAllocator::allocate(
@@ -155,19 +183,22 @@ bool CodeAllocator::allocate(
 
     size_t totalSize = alignedDataSize + codeSize;
 
+    // Allocations are found by any address inside of them, so even without code the allocation has to cover the code start
+    size_t reservedSize = codeSize != 0 ? totalSize : totalSize + 1;
+
     // Function has to fit into a single block with unwinding information
-    if (totalSize > blockSize - kMaxReservedDataSize)
+    if (reservedSize > blockSize - kMaxReservedDataSize)
         return false;
 
     size_t startOffset = 0;
 
     // We might need a new block
-    if (totalSize > size_t(blockEnd - blockPos))
+    if (reservedSize > size_t(blockEnd - blockPos))
     {
         if (!allocateNewBlock(startOffset))
             return false;
 
-        CODEGEN_ASSERT(totalSize <= size_t(blockEnd - blockPos));
+        CODEGEN_ASSERT(reservedSize <= size_t(blockEnd - blockPos));
     }
 
     CODEGEN_ASSERT((uintptr_t(blockPos) & (kPageSize - 1)) == 0); // Allocation starts on page boundary
@@ -180,7 +211,7 @@ bool CodeAllocator::allocate(
     if (codeSize)
         memcpy(blockPos + codeOffset, code, codeSize);
 
-    size_t pageAlignedSize = alignToPageSize(startOffset + totalSize);
+    size_t pageAlignedSize = alignToPageSize(startOffset + reservedSize);
 
     if (!makePagesExecutable(blockPos, pageAlignedSize))
         return false;
@@ -191,6 +222,14 @@ bool CodeAllocator::allocate(
     resultSize = totalSize;
     resultCodeStart = blockPos + codeOffset;
 
+    Block& block = blocks.back();
+    CODEGEN_ASSERT(result >= block.memory && result < block.memory + blockSize);
+
+    block.liveAllocations++;
+    block.liveBytes += reservedSize;
+
+    allocations[uintptr_t(result)] = {reservedSize, 1};
+
     // Ensure that future allocations from the block start from a page boundary.
     // This is important since we use W^X, and writing to the previous page would require briefly removing
     // executable bit from it, which may result in access violations if that code is being executed concurrently.
@@ -209,21 +248,93 @@ bool CodeAllocator::allocate(
     return true;
 }
 
+void CodeAllocator::addAllocationRefs(const uint8_t* address, size_t count)
+{
+    auto it = allocations.upper_bound(uintptr_t(address));
+    CODEGEN_ASSERT(it != allocations.begin());
+    --it;
+
+    CODEGEN_ASSERT(uintptr_t(address) < it->first + it->second.size);
+    CODEGEN_ASSERT(it->second.refs != 0);
+
+    it->second.refs += count;
+}
+
+void CodeAllocator::releaseAllocation(const uint8_t* address)
+{
+    auto it = allocations.upper_bound(uintptr_t(address));
+    CODEGEN_ASSERT(it != allocations.begin());
+    --it;
+
+    CODEGEN_ASSERT(uintptr_t(address) < it->first + it->second.size);
+    CODEGEN_ASSERT(it->second.refs != 0);
+
+    if (--it->second.refs != 0)
+        return;
+
+    size_t blockIndex = findBlock(address);
+    Block& block = blocks[blockIndex];
+
+    CODEGEN_ASSERT(block.liveAllocations != 0);
+    block.liveAllocations--;
+    block.liveBytes -= it->second.size;
+    block.deadBytes += it->second.size;
+
+    releaseNativeDebugInfo(reinterpret_cast<const uint8_t*>(it->first), it->second.size);
+
+    allocations.erase(it);
+
+    if (block.liveAllocations == 0)
+        reclaimBlock(blockIndex);
+}
+
+CodeMemoryStats CodeAllocator::getMemoryStats() const
+{
+    CodeMemoryStats stats;
+
+    stats.blockCount = getMappedBlockCount();
+    stats.blocksReclaimed = blocksReclaimed;
+
+    for (const Block& block : blocks)
+    {
+        stats.liveCodeBytes += block.liveBytes;
+        stats.deadCodeBytes += block.deadBytes;
+    }
+
+    stats.reclaimedCodeBytes = reclaimedBytes;
+
+    return stats;
+}
+
 bool CodeAllocator::allocateNewBlock(size_t& unwindInfoSize)
 {
-    // Stop allocating once we reach a global limit
-    if ((blocks.size() + 1) * blockSize > maxTotalSize)
+    uint8_t* block = nullptr;
+
+    // Stop allocating once we reach a global limit; the spare block is mapped memory as well and is counted against it
+    if (!spareBlock && (getMappedBlockCount() + 1) * blockSize > maxTotalSize)
         return false;
 
-    uint8_t* block = allocatePages(blockSize);
+    if (spareBlock)
+    {
+        // Code in the spare block is dead, but its pages were executable
+        if (!makePagesWritable(spareBlock, alignToPageSize(blockSize)))
+            return false;
 
-    if (!block)
-        return false;
+        block = spareBlock;
+        spareBlock = nullptr;
+    }
+    else
+    {
+        block = allocatePages(blockSize);
+
+        if (!block)
+            return false;
+    }
 
     blockPos = block;
     blockEnd = block + blockSize;
 
-    blocks.push_back(block);
+    blocks.push_back({block});
 
     if (createBlockUnwindInfo)
     {
@@ -237,12 +348,57 @@ bool CodeAllocator::allocateNewBlock(size_t& unwindInfoSize)
         if (!unwindInfo)
             return false;
 
-        unwindInfos.push_back(unwindInfo);
+        blocks.back().unwindInfo = unwindInfo;
     }
 
     return true;
 }
 
+void CodeAllocator::reclaimBlock(size_t blockIndex)
+{
+    Block block = blocks[blockIndex];
+    CODEGEN_ASSERT(block.liveAllocations == 0 && block.liveBytes == 0);
+
+    if (destroyBlockUnwindInfo && block.unwindInfo)
+        destroyBlockUnwindInfo(context, block.unwindInfo);
+
+    // If this was the current block, following allocations will get a new one
+    if (blockEnd == block.memory + blockSize)
+    {
+        blockPos = nullptr;
+        blockEnd = nullptr;
+    }
+
+    blocks.erase(blocks.begin() + blockIndex);
+
+    // A single dead block is kept for reuse, which avoids remapping memory when modules are reloaded one at a time
+    // It is only kept while all mapped blocks stay within the global limit
+    if (!spareBlock && (getMappedBlockCount() + 1) * blockSize <= maxTotalSize)
+        spareBlock = block.memory;
+    else
+        freePages(block.memory, blockSize);
+
+    blocksReclaimed++;
+    reclaimedBytes += block.deadBytes;
+}
+
+size_t CodeAllocator::getMappedBlockCount() const
+{
+    return blocks.size() + (spareBlock ? 1 : 0);
+}
+
+size_t CodeAllocator::findBlock(const uint8_t* address) const
+{
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        if (address >= blocks[i].memory && address < blocks[i].memory + blockSize)
+            return i;
+    }
+
+    CODEGEN_ASSERT(!"Address doesn't belong to any block");
+    return 0;
+}
+
 uint8_t* CodeAllocator::allocatePages(size_t size) const
 {
     const size_t pageAlignedSize = alignToPageSize(size);
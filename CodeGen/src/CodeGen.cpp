@@ -43,6 +43,9 @@
 
 LUAU_FASTFLAGVARIABLE(DebugCodegenOptSize)
 LUAU_FASTFLAGVARIABLE(DebugCodegenSkipNumbering)
+LUAU_FASTFLAGVARIABLE(DebugCodegenSkipSpillSlotReuse)
+LUAU_FASTFLAGVARIABLE(DebugCodegenSkipScalarReplacement)
+LUAU_FASTFLAGVARIABLE(DebugCodegenSkipLoopVersioning)
 
 // Per-module IR instruction count limit
 LUAU_FASTINTVARIABLE(CodegenHeuristicsInstructionLimit, 1'048'576) // 1 M
@@ -86,6 +89,8 @@ std::string toString(const CodeGenCompilationResult& result)
         return "CodeGenLoweringFailure";
     case CodeGenCompilationResult::AllocationFailed:
         return "AllocationFailed";
+    case CodeGenCompilationResult::CacheMismatch:
+        return "CacheMismatch";
     case CodeGenCompilationResult::Count:
         return "Count";
     }
@@ -154,6 +159,26 @@ unsigned int getCpuFeaturesA64()
 }
 #endif
 
+#if defined(CODEGEN_TARGET_X64)
+unsigned int getCpuFeaturesX64()
+{
+    unsigned int result = 0;
+
+    int cpuinfo[4] = {};
+#ifdef _MSC_VER
+    __cpuid(cpuinfo, 1);
+#else
+    __cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+#endif
+
+    // FMA3 operates on the same VEX encoded XMM state that is already required by isSupported
+    if ((cpuinfo[2] & (1 << 12)) != 0)
+        result |= X64::Feature_FMA3;
+
+    return result;
+}
+#endif
+
 bool isSupported()
 {
     if (LUA_EXTRA_SIZE != 1)
@@ -3,6 +3,7 @@
 #include "Luau/BytecodeSummary.h"
 #include "Luau/IrDump.h"
 #include "Luau/IrUtils.h"
+#include "Luau/NativeProtoExecData.h"
 
 #include "CodeGenLower.h"
 
@@ -187,6 +188,16 @@ static std::string getAssemblyImpl(AssemblyBuilder& build, const TValue* func, A
     for (Proto* p : protos)
     {
         IrBuilder ir(options.compilationOptions.hooks);
+
+        // counters of instrumented code are never incremented here, but their addresses are a part of the code
+        std::unique_ptr<uint64_t[]> executionCounters;
+
+        if (options.compilationOptions.flags & CodeGen_Instrumentation)
+        {
+            executionCounters = std::make_unique<uint64_t[]>(NativeExecCounter_Exit + p->sizecode);
+            ir.function.executionCounters = executionCounters.get();
+        }
+
         ir.buildFunctionIr(p);
         unsigned asmSize = build.getCodeSize();
         unsigned asmCount = build.getInstructionCount();
@@ -252,6 +263,8 @@ static std::string getAssemblyImpl(AssemblyBuilder& build, const TValue* func, A
 
 #if defined(CODEGEN_TARGET_A64)
 unsigned int getCpuFeaturesA64();
+#elif defined(CODEGEN_TARGET_X64)
+unsigned int getCpuFeaturesX64();
 #endif
 
 std::string getAssembly(lua_State* L, int idx, AssemblyOptions options, LoweringStats* stats)
@@ -266,6 +279,9 @@ std::string getAssembly(lua_State* L, int idx, AssemblyOptions options, Lowering
 #if defined(CODEGEN_TARGET_A64)
         static unsigned int cpuFeatures = getCpuFeaturesA64();
         A64::AssemblyBuilderA64 build(/* logText= */ options.includeAssembly, cpuFeatures);
+#elif defined(CODEGEN_TARGET_X64)
+        static unsigned int cpuFeatures = getCpuFeaturesX64();
+        X64::AssemblyBuilderX64 build(/* logText= */ options.includeAssembly, cpuFeatures);
 #else
         X64::AssemblyBuilderX64 build(/* logText= */ options.includeAssembly);
 #endif
@@ -289,14 +305,14 @@ std::string getAssembly(lua_State* L, int idx, AssemblyOptions options, Lowering
 
     case AssemblyOptions::X64_Windows:
     {
-        X64::AssemblyBuilderX64 build(/* logText= */ options.includeAssembly, X64::ABIX64::Windows);
+        X64::AssemblyBuilderX64 build(/* logText= */ options.includeAssembly, X64::ABIX64::Windows, /* features= */ X64::Feature_FMA3);
 
         return getAssemblyImpl(build, func, options, stats);
     }
 
     case AssemblyOptions::X64_SystemV:
     {
-        X64::AssemblyBuilderX64 build(/* logText= */ options.includeAssembly, X64::ABIX64::SystemV);
+        X64::AssemblyBuilderX64 build(/* logText= */ options.includeAssembly, X64::ABIX64::SystemV, /* features= */ X64::Feature_FMA3);
 
         return getAssemblyImpl(build, func, options, stats);
     }
@@ -4,7 +4,11 @@
 #include "CodeGenA64.h"
 #include "CodeGenLower.h"
 #include "CodeGenX64.h"
+#include "IrTranslation.h"
+#include "NativeCache.h"
+#include "NativeDebugInfo.h"
 
+#include "Luau/BytecodeAnalysis.h"
 #include "Luau/CodeGenCommon.h"
 #include "Luau/CodeBlockUnwind.h"
 #include "Luau/UnwindBuilder.h"
@@ -12,9 +16,15 @@
 #include "Luau/UnwindBuilderWin.h"
 
 #include "lapi.h"
+#include "lfunc.h"
+#include "ltable.h"
 
 LUAU_FASTINTVARIABLE(LuauCodeGenBlockSize, 4 * 1024 * 1024)
 LUAU_FASTINTVARIABLE(LuauCodeGenMaxTotalSize, 256 * 1024 * 1024)
+LUAU_FASTINTVARIABLE(LuauCodeGenTierUpCalls, 200)        // calls before a function marked with CodeGen_TierUp is compiled
+LUAU_FASTINTVARIABLE(LuauCodeGenTierUpLoops, 2000)       // loop iterations before a function marked with CodeGen_TierUp is compiled; 0 disables
+LUAU_FASTINTVARIABLE(LuauCodeGenAsyncThreads, 0)         // threads used by compileAsync; 0 uses half of the hardware threads
+LUAU_FASTINTVARIABLE(LuauCodeGenSpeculationFailures, 16) // exits from code specialized with type feedback before the function is recompiled without it
 
 namespace Luau
 {
@@ -23,11 +33,19 @@ namespace CodeGen
 
 static const Instruction kCodeEntryInsn = LOP_NATIVECALL;
 
+// Functions are grouped into background compilation batches until a batch has this many bytecode instructions, which amortizes the
+// helper code that every batch includes
+static const int kAsyncBatchInstructions = 4096;
+
+// Calls between checks for the native code of a function that is compiled in the background
+static const int kAsyncPollCalls = 16;
+
 // From CodeGen.cpp
 static void* gPerfLogContext = nullptr;
 static PerfLogFn gPerfLogFn = nullptr;
 
 unsigned int getCpuFeaturesA64();
+unsigned int getCpuFeaturesX64();
 
 void setPerfLog(void* context, PerfLogFn logFn)
 {
@@ -35,18 +53,12 @@ void setPerfLog(void* context, PerfLogFn logFn)
     gPerfLogFn = logFn;
 }
 
-static void logPerfFunction(Proto* p, uintptr_t addr, unsigned size)
+static std::string getPerfFunctionSource(Proto* p)
 {
     CODEGEN_ASSERT(p->source);
 
     const char* source = getstr(p->source);
-    source = (source[0] == '=' || source[0] == '@') ? source + 1 : "[string]";
-
-    char name[256];
-    snprintf(name, sizeof(name), "<luau> %s:%d %s", source, p->linedefined, p->debugname ? getstr(p->debugname) : "");
-
-    if (gPerfLogFn)
-        gPerfLogFn(gPerfLogContext, addr, size, name);
+    return (source[0] == '=' || source[0] == '@') ? source + 1 : "[string]";
 }
 
 static void logPerfFunctions(
@@ -55,15 +67,40 @@ static void logPerfFunctions(
     const std::vector<NativeProtoExecDataPtr>& nativeProtos
 )
 {
-    if (gPerfLogFn == nullptr)
+    bool debugInfo = isNativeDebugInfoEnabled();
+
+    if (gPerfLogFn == nullptr && !debugInfo)
         return;
 
+    std::vector<NativeDebugFunction> debugFunctions;
+
+    auto logFunction = [&](uintptr_t addr, unsigned size, const char* name, Proto* p, const uint32_t* instOffsets)
+    {
+        if (gPerfLogFn)
+            gPerfLogFn(gPerfLogContext, addr, size, name);
+
+        if (!debugInfo)
+            return;
+
+        NativeDebugFunction& function = debugFunctions.emplace_back();
+        function.name = name;
+        function.address = addr;
+        function.size = size;
+
+        if (p)
+        {
+            function.source = getPerfFunctionSource(p);
+            buildNativeLineTable(p, instOffsets, getNativeProtoExecDataHeader(instOffsets).bytecodeInstructionCount, size, function.lines);
+        }
+    };
+
     if (nativeProtos.size() > 0)
-        gPerfLogFn(
-            gPerfLogContext,
+        logFunction(
             uintptr_t(nativeModuleBaseAddress),
             unsigned(getNativeProtoExecDataHeader(nativeProtos[0].get()).entryOffsetOrAddress - nativeModuleBaseAddress),
-            "<luau helpers>"
+            "<luau helpers>",
+            nullptr,
+            nullptr
         );
 
     auto protoIt = moduleProtos.begin();
@@ -79,8 +116,16 @@ static void logPerfFunctions(
 
         CODEGEN_ASSERT(protoIt != moduleProtos.end());
 
-        logPerfFunction(*protoIt, uintptr_t(header.entryOffsetOrAddress), uint32_t(header.nativeCodeSize));
+        Proto* p = *protoIt;
+
+        char name[256];
+        snprintf(name, sizeof(name), "<luau> %s:%d %s", getPerfFunctionSource(p).c_str(), p->linedefined, p->debugname ? getstr(p->debugname) : "");
+
+        logFunction(uintptr_t(header.entryOffsetOrAddress), uint32_t(header.nativeCodeSize), name, p, nativeProto.get());
     }
+
+    if (debugInfo)
+        emitNativeDebugInfo(debugFunctions);
 }
 
 // If Release is true, the native proto will be removed from the vector and
@@ -121,6 +166,10 @@ template<bool Release, typename NativeProtosVector>
         proto->exectarget = reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress);
         proto->codeentry = &kCodeEntryInsn;
 
+        // functions marked for tier-up might get compiled explicitly before they become hot
+        proto->tiercalls = 0;
+        proto->tierloops = 0;
+
         ++protosBound;
     }
 
@@ -145,6 +194,20 @@ BaseCodeGenContext::BaseCodeGenContext(size_t blockSize, size_t maxTotalSize, Al
     initFunctions(context);
 }
 
+BaseCodeGenContext::~BaseCodeGenContext()
+{
+    // by now, all VMs have dropped their batches on close, so the threads are idle or finishing a batch
+    {
+        std::unique_lock guard(asyncMutex);
+        asyncShutdown = true;
+    }
+
+    asyncQueueChanged.notify_all();
+
+    for (std::thread& thread : asyncThreads)
+        thread.join();
+}
+
 [[nodiscard]] bool BaseCodeGenContext::initHeaderFunctions()
 {
 #if defined(CODEGEN_TARGET_X64)
@@ -158,6 +221,16 @@ BaseCodeGenContext::BaseCodeGenContext(size_t blockSize, size_t maxTotalSize, Al
     if (gPerfLogFn)
         gPerfLogFn(gPerfLogContext, uintptr_t(context.gateEntry), 4096, "<luau gate>");
 
+    if (isNativeDebugInfoEnabled())
+    {
+        NativeDebugFunction gate;
+        gate.name = "<luau gate>";
+        gate.address = uintptr_t(context.gateEntry);
+        gate.size = 4096;
+
+        emitNativeDebugInfo({gate});
+    }
+
     return true;
 }
 
@@ -208,6 +281,10 @@ StandaloneCodeGenContext::StandaloneCodeGenContext(
 
     const uint32_t protosBound = bindNativeProtos<true>(moduleProtos, nativeProtos);
 
+    // Each bound function keeps the code of the module alive until it's destroyed
+    codeAllocator.addAllocationRefs(codeStart, protosBound);
+    codeAllocator.releaseAllocation(codeStart);
+
     return {CodeGenCompilationResult::Success, protosBound};
 }
 
@@ -220,7 +297,16 @@ void StandaloneCodeGenContext::onCloseState() noexcept
 
 void StandaloneCodeGenContext::onDestroyFunction(void* execdata) noexcept
 {
+    const uint8_t* entry = getNativeProtoExecDataHeader(static_cast<const uint32_t*>(execdata)).entryOffsetOrAddress;
+
     destroyNativeProtoExecData(static_cast<uint32_t*>(execdata));
+
+    codeAllocator.releaseAllocation(entry);
+}
+
+[[nodiscard]] CodeMemoryStats StandaloneCodeGenContext::getCodeMemoryStats() const
+{
+    return codeAllocator.getMemoryStats();
 }
 
 
@@ -302,6 +388,11 @@ void SharedCodeGenContext::onDestroyFunction(void* execdata) noexcept
     getNativeProtoExecDataHeader(static_cast<const uint32_t*>(execdata)).nativeModule->release();
 }
 
+[[nodiscard]] CodeMemoryStats SharedCodeGenContext::getCodeMemoryStats() const
+{
+    return sharedAllocator.getMemoryStats();
+}
+
 
 [[nodiscard]] UniqueSharedCodeGenContext createSharedCodeGenContext()
 {
@@ -360,6 +451,9 @@ static void onDestroyFunction(lua_State* L, Proto* proto)
     proto->codeentry = proto->code;
 }
 
+// Defined below, next to the compilation pipeline
+static void onExit(lua_State* L);
+
 static int onEnter(lua_State* L, Proto* proto)
 {
     BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
@@ -370,7 +464,12 @@ static int onEnter(lua_State* L, Proto* proto)
     uintptr_t target = proto->exectarget + static_cast<uint32_t*>(proto->execdata)[L->ci->savedpc - proto->code];
 
     // Returns 1 to finish the function in the VM
-    return GateFn(codeGenContext->context.gateEntry)(L, proto, target, &codeGenContext->context);
+    int result = GateFn(codeGenContext->context.gateEntry)(L, proto, target, &codeGenContext->context);
+
+    if (result == 1)
+        onExit(L);
+
+    return result;
 }
 
 static int onEnterDisabled(lua_State* L, Proto* proto)
@@ -381,6 +480,9 @@ static int onEnterDisabled(lua_State* L, Proto* proto)
 // Defined in CodeGen.cpp
 void onDisable(lua_State* L, Proto* proto);
 
+static void onTierUp(lua_State* L, Proto* proto);
+static void onPreCloseState(lua_State* L);
+
 static size_t getMemorySize(lua_State* L, Proto* proto)
 {
     const NativeProtoExecDataHeader& execDataHeader = getNativeProtoExecDataHeader(static_cast<const uint32_t*>(proto->execdata));
@@ -405,6 +507,8 @@ static void initializeExecutionCallbacks(lua_State* L, BaseCodeGenContext* codeG
     ecb->enter = onEnter;
     ecb->disable = onDisable;
     ecb->getmemorysize = getMemorySize;
+    ecb->tierup = onTierUp;
+    ecb->preclose = onPreCloseState;
 }
 
 void create(lua_State* L)
@@ -441,9 +545,10 @@ void create(lua_State* L, SharedCodeGenContext* codeGenContext)
 
     for (int i = 0; i < proto->sizecode; ++i)
     {
-        CODEGEN_ASSERT(ir.function.bcMapping[i].asmLocation >= instTarget);
+        uint32_t asmLocation = ir.function.bcMapping[i].asmLocation;
+        CODEGEN_ASSERT(asmLocation >= instTarget);
 
-        nativeExecData[i] = ir.function.bcMapping[i].asmLocation - instTarget;
+        nativeExecData[i] = asmLocation == ~0u ? kNativeInstructionOffsetNone : asmLocation - instTarget;
     }
 
     // Set first instruction offset to 0 so that entering this function still
@@ -454,6 +559,16 @@ void create(lua_State* L, SharedCodeGenContext* codeGenContext)
     header.entryOffsetOrAddress = reinterpret_cast<const uint8_t*>(static_cast<uintptr_t>(instTarget));
     header.bytecodeId = uint32_t(proto->bytecodeid);
     header.bytecodeInstructionCount = proto->sizecode;
+    header.speculativeInstructionCount = ir.function.speculativeInstCount;
+    header.inlinedCallCount = uint32_t(ir.function.inlinedCalls.size());
+
+    if (!ir.function.inlinedCalls.empty())
+    {
+        header.inlinedCalls = new Proto*[ir.function.inlinedCalls.size()];
+        std::copy(ir.function.inlinedCalls.begin(), ir.function.inlinedCalls.end(), header.inlinedCalls);
+    }
+
+    header.userdataCacheSiteCount = ir.function.userdataCacheSiteCount;
 
     return nativeExecData;
 }
@@ -463,12 +578,23 @@ template<typename AssemblyBuilder>
     AssemblyBuilder& build,
     ModuleHelpers& helpers,
     Proto* proto,
+    const std::vector<Proto*>& callTargets,
     uint32_t& totalIrInstCount,
-    const HostIrHooks& hooks,
+    const CompilationOptions& options,
     CodeGenCompilationResult& result
 )
 {
-    IrBuilder ir(hooks);
+    IrBuilder ir(options.hooks);
+    ir.function.callTargets = callTargets;
+
+    std::unique_ptr<uint64_t[]> executionCounters;
+
+    if (options.flags & CodeGen_Instrumentation)
+    {
+        executionCounters = std::make_unique<uint64_t[]>(NativeExecCounter_Exit + proto->sizecode);
+        ir.function.executionCounters = executionCounters.get();
+    }
+
     ir.buildFunctionIr(proto);
 
     unsigned instCount = unsigned(ir.function.instructions.size());
@@ -481,20 +607,306 @@ template<typename AssemblyBuilder>
 
     totalIrInstCount += instCount;
 
-    if (!lowerFunction(ir, build, helpers, proto, {}, /* stats */ nullptr, result))
+    AssemblyOptions assemblyOptions;
+    assemblyOptions.compilationOptions = options;
+
+    if (!lowerFunction(ir, build, helpers, proto, assemblyOptions, /* stats */ nullptr, result))
     {
         return {};
     }
 
-    return createNativeProtoExecData(proto, ir);
+    NativeProtoExecDataPtr nativeExecData = createNativeProtoExecData(proto, ir);
+
+    // Native code of the function updates the counters, so they are owned by its exec data
+    getNativeProtoExecDataHeader(nativeExecData.get()).executionCounters = executionCounters.release();
+
+    return nativeExecData;
 }
 
-[[nodiscard]] static CompilationResult compileInternal(
+[[nodiscard]] static CompilationResult compileProtos(
+    BaseCodeGenContext* codeGenContext,
     const std::optional<ModuleId>& moduleId,
+    const std::vector<Proto*>& protos,
+    const CompilationOptions& options,
+    CompilationStats* stats,
+    const std::vector<std::vector<Proto*>>& callTargets = {}
+);
+
+// Interpreted frames of a function that just got native code can switch to it at a loop back-edge, which lets a long-running loop benefit
+// from the compilation it triggered.  Functions with typed parameters are excluded, as native code relies on the argument types that are
+// checked on entry, while the interpreter doesn't check them
+static void enableOnStackReplacement(Proto* proto)
+{
+    IrFunction function;
+    function.proto = proto;
+    loadBytecodeTypeInfo(function);
+
+    for (uint8_t ty : function.bcTypeInfo.argumentTypes)
+    {
+        if (ty != LBC_TYPE_ANY)
+            return;
+    }
+
+    proto->tierloops = -1;
+}
+
+[[nodiscard]] static bool isAsyncPending(BaseCodeGenContext* codeGenContext, Proto* proto)
+{
+    std::unique_lock guard(codeGenContext->asyncMutex);
+    return codeGenContext->asyncPending.count(proto) != 0;
+}
+
+// Marked functions are entered through kCodeEntryInsn without having native code, which makes the VM count their calls, and count
+// down their loop budget on back-edges; onTierUp is called when either runs out
+static void markTierUpFunctions(lua_State* L, BaseCodeGenContext* codeGenContext, const std::vector<Proto*>& protos, const CompilationOptions& options)
+{
+    codeGenContext->tierUpOptions = options;
+
+    uint32_t marked = 0;
+
+    for (Proto* proto : protos)
+    {
+        // functions with breakpoints stay in the interpreter
+        if (proto->debuginsn)
+            continue;
+
+        proto->codeentry = &kCodeEntryInsn;
+        proto->tiercalls = FInt::LuauCodeGenTierUpCalls > 0 ? FInt::LuauCodeGenTierUpCalls : 1;
+        proto->tierloops = FInt::LuauCodeGenTierUpLoops > 0 ? FInt::LuauCodeGenTierUpLoops : 0;
+
+        // while the function runs in the interpreter, it records the operand types that the native code can be specialized for
+        if (!proto->typefeedback)
+            luaF_newtypefeedback(L, proto);
+
+        ++marked;
+    }
+
+    codeGenContext->tierUpFunctionsMarked += marked;
+}
+
+static Closure* getCallTarget(lua_State* L, Closure* cl, int pcpos)
+{
+    Proto* proto = cl->l.p;
+    Instruction insn = proto->code[pcpos];
+
+    const TValue* value = nullptr;
+
+    switch (LUAU_INSN_OP(insn))
+    {
+    case LOP_GETUPVAL:
+    {
+        if (LUAU_INSN_B(insn) >= cl->nupvalues)
+            return nullptr;
+
+        const TValue* ur = &cl->l.uprefs[LUAU_INSN_B(insn)];
+        value = ttisupval(ur) ? upvalue(ur)->v : ur;
+        break;
+    }
+    case LOP_NAMECALL:
+    {
+        const TValue* self = L->ci->base + LUAU_INSN_B(insn);
+
+        if (!ttistable(self))
+            return nullptr;
+
+        TString* key = tsvalue(&proto->k[proto->code[pcpos + 1]]);
+        LuaTable* h = hvalue(self);
+
+        value = luaH_getstr(h, key);
+
+        if (ttisnil(value) && h->metatable)
+        {
+            const TValue* index = luaH_getstr(h->metatable, L->global->tmname[TM_INDEX]);
+
+            if (ttistable(index))
+                value = luaH_getstr(hvalue(index), key);
+        }
+        break;
+    }
+    default:
+        return nullptr;
+    }
+
+    return ttisfunction(value) && !clvalue(value)->isC ? clvalue(value) : nullptr;
+}
+
+// Calls are inlined when the function in their target register was loaded from an upvalue or looked up as a method, and the Luau function
+// found there in the running frame of the caller is small enough.  Native code guards the prototype of the function, so the frame only has
+// to be representative; see keepInlinedCalls for how the prototypes outlive the code
+static std::vector<Proto*> gatherCallTargets(lua_State* L)
+{
+    std::vector<Proto*> targets;
+
+    if (!isLua(L->ci))
+        return targets;
+
+    Closure* cl = clvalue(L->ci->func);
+    Proto* proto = cl->l.p;
+
+    // for each register, the last instruction that used it as the target
+    std::vector<int> lastTarget(proto->maxstacksize, -1);
+
+    for (int i = 0; i < proto->sizecode;)
+    {
+        Instruction insn = proto->code[i];
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+        int ra = LUAU_INSN_A(insn);
+
+        if (op == LOP_CALL && ra < proto->maxstacksize && lastTarget[ra] >= 0)
+        {
+            Closure* callee = getCallTarget(L, cl, lastTarget[ra]);
+
+            if (callee && isInlineCallCandidate(callee->l.p))
+            {
+                if (targets.empty())
+                    targets.resize(proto->sizecode);
+
+                targets[i] = callee->l.p;
+            }
+        }
+
+        if (ra < proto->maxstacksize)
+            lastTarget[ra] = i;
+
+        i += getOpLength(op);
+    }
+
+    return targets;
+}
+
+// Inlined prototypes are referenced by the proto that got the native code, so that they can't be freed and their addresses reused while the
+// code might still run; retired code belongs to the same proto, so the references are only dropped together with it
+static void keepInlinedCalls(lua_State* L, Proto* proto)
+{
+    const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(static_cast<const uint32_t*>(proto->execdata));
+
+    for (uint32_t i = 0; i < header.inlinedCallCount; ++i)
+        luaF_addinlined(L, proto, header.inlinedCalls[i]);
+}
+
+static void onTierUp(lua_State* L, Proto* proto)
+{
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+
+    // Functions that are compiled in the background only check whether their native code is ready
+    if (isAsyncPending(codeGenContext, proto))
+    {
+        installAsyncCompilations(L, /* wait= */ false, nullptr);
+
+        if (isAsyncPending(codeGenContext, proto))
+            proto->tiercalls = kAsyncPollCalls;
+
+        return;
+    }
+
+    // whether or not the function gets compiled, it is not counted anymore
+    proto->tiercalls = 0;
+    proto->tierloops = 0;
+
+    // native execution might have been disabled by the debugger since the function was marked
+    if (proto->execdata || proto->codeentry != &kCodeEntryInsn || proto->debuginsn)
+        return;
+
+    CompilationStats stats;
+    CompilationResult result = compileProtos(codeGenContext, std::nullopt, {proto}, codeGenContext->tierUpOptions, &stats, {gatherCallTargets(L)});
+
+    if (proto->execdata)
+    {
+        keepInlinedCalls(L, proto);
+        enableOnStackReplacement(proto);
+
+        // type feedback is only kept to tell apart the exits from the instructions that were specialized with it
+        const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(static_cast<const uint32_t*>(proto->execdata));
+
+        if (header.speculativeInstructionCount == 0 && proto->typefeedback)
+            luaF_freetypefeedback(L, proto);
+
+        codeGenContext->tierUpFunctionsCompiled++;
+        codeGenContext->tierUpCallsInlined += header.inlinedCallCount;
+        codeGenContext->tierUpNativeCodeSizeBytes += stats.nativeCodeSizeBytes;
+    }
+    else
+    {
+        proto->codeentry = proto->code;
+
+        if (proto->typefeedback)
+            luaF_freetypefeedback(L, proto);
+
+        codeGenContext->tierUpFunctionsSkipped++;
+    }
+}
+
+[[nodiscard]] static bool isSpeculativeTypeFeedback(uint8_t mask)
+{
+    return mask == luaF_feedbackbit(LUA_TNUMBER) || mask == luaF_feedbackbit(LUA_TVECTOR);
+}
+
+// Native code specialized with type feedback exits to the VM when an operand doesn't have the predicted type; once that happens often enough,
+// the function is compiled again without the feedback.  The replaced code might still be running in frames further up the stack, so it's
+// retired until the VM is closed instead of being destroyed
+static void onExit(lua_State* L)
+{
+    CallInfo* ci = L->ci;
+
+    if (!isLua(ci))
+        return;
+
+    Proto* proto = clvalue(ci->func)->l.p;
+
+    if (!proto->execdata || !proto->typefeedback)
+        return;
+
+    NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(static_cast<uint32_t*>(proto->execdata));
+
+    if (header.speculativeInstructionCount == 0)
+        return;
+
+    int pcpos = int(ci->savedpc - proto->code);
+
+    if (pcpos < 0 || pcpos >= proto->sizecode)
+        return;
+
+    const uint8_t* feedback = &proto->typefeedback[pcpos * 2];
+
+    // Checks that loop versioning moves in front of a loop don't exit; when they fail, the original loop runs and its checks exit from the
+    // specialized instruction, so these failures are counted here as well
+    if (!isSpeculativeTypeFeedback(feedback[0]) && !isSpeculativeTypeFeedback(feedback[1]))
+        return;
+
+    if (++header.speculationFailureCount < uint32_t(FInt::LuauCodeGenSpeculationFailures))
+        return;
+
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+
+    void* execdata = proto->execdata;
+
+    luaF_freetypefeedback(L, proto);
+
+    CompilationResult result = compileProtos(codeGenContext, std::nullopt, {proto}, codeGenContext->tierUpOptions, nullptr, {gatherCallTargets(L)});
+
+    // if the function can't be compiled again, it keeps the specialized code, which is still correct
+    if (proto->execdata == execdata)
+        return;
+
+    keepInlinedCalls(L, proto);
+    enableOnStackReplacement(proto);
+
+    {
+        std::unique_lock guard(codeGenContext->retiredMutex);
+        codeGenContext->retiredExecData.emplace_back(L->global, execdata);
+    }
+
+    codeGenContext->tierUpFunctionsRecompiled++;
+    codeGenContext->tierUpCallsInlined += getNativeProtoExecDataHeader(static_cast<const uint32_t*>(proto->execdata)).inlinedCallCount;
+}
+
+// Gathers the functions of the module that don't have native code yet
+[[nodiscard]] static CodeGenCompilationResult gatherModuleProtos(
     lua_State* L,
     int idx,
     const CompilationOptions& options,
-    CompilationStats* stats
+    unsigned int gatherFlags,
+    std::vector<Proto*>& protos
 )
 {
     CODEGEN_ASSERT(lua_isLfunction(L, idx));
@@ -503,14 +915,12 @@ template<typename AssemblyBuilder>
     Proto* root = clvalue(func)->l.p;
 
     if ((options.flags & CodeGen_OnlyNativeModules) != 0 && (root->flags & LPF_NATIVE_MODULE) == 0 && (root->flags & LPF_NATIVE_FUNCTION) == 0)
-        return CompilationResult{CodeGenCompilationResult::NotNativeModule};
+        return CodeGenCompilationResult::NotNativeModule;
 
-    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
-    if (codeGenContext == nullptr)
-        return CompilationResult{CodeGenCompilationResult::CodeGenNotInitialized};
+    if (getCodeGenContext(L) == nullptr)
+        return CodeGenCompilationResult::CodeGenNotInitialized;
 
-    std::vector<Proto*> protos;
-    gatherFunctions(protos, root, options.flags, root->flags & LPF_NATIVE_FUNCTION);
+    gatherFunctions(protos, root, gatherFlags, root->flags & LPF_NATIVE_FUNCTION);
 
     // Skip protos that have been compiled during previous invocations of CodeGen::compile
     protos.erase(
@@ -526,7 +936,28 @@ template<typename AssemblyBuilder>
     );
 
     if (protos.empty())
-        return CompilationResult{CodeGenCompilationResult::NothingToCompile};
+        return CodeGenCompilationResult::NothingToCompile;
+
+    return CodeGenCompilationResult::Success;
+}
+
+[[nodiscard]] static CompilationResult compileInternal(
+    const std::optional<ModuleId>& moduleId,
+    lua_State* L,
+    int idx,
+    const CompilationOptions& options,
+    CompilationStats* stats
+)
+{
+    // with tier-up, the runtime profile decides which functions are worth compiling instead of the compiler heuristics
+    unsigned int gatherFlags = (options.flags & CodeGen_TierUp) != 0 ? options.flags | CodeGen_ColdFunctions : options.flags;
+
+    std::vector<Proto*> protos;
+
+    if (CodeGenCompilationResult result = gatherModuleProtos(L, idx, options, gatherFlags, protos); result != CodeGenCompilationResult::Success)
+        return CompilationResult{result};
+
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
 
     if (stats != nullptr)
         stats->functionsTotal = uint32_t(protos.size());
@@ -542,9 +973,33 @@ template<typename AssemblyBuilder>
         }
     }
 
+    if ((options.flags & CodeGen_TierUp) != 0)
+    {
+        markTierUpFunctions(L, codeGenContext, protos, options);
+        return CompilationResult{};
+    }
+
+    return compileProtos(codeGenContext, moduleId, protos, options, stats);
+}
+
+// Assembly doesn't touch the VM or the code-gen context, which lets background compilation threads run it on function snapshots
+// Call targets are either empty or hold the targets observed for each function (see gatherCallTargets)
+static void assembleProtos(
+    const std::vector<Proto*>& protos,
+    const CompilationOptions& options,
+    CompilationResult& compilationResult,
+    AssembledProtos& assembled,
+    const std::vector<std::vector<Proto*>>& callTargets = {}
+)
+{
+    static const std::vector<Proto*> kNoCallTargets;
+
 #if defined(CODEGEN_TARGET_A64)
     static unsigned int cpuFeatures = getCpuFeaturesA64();
     A64::AssemblyBuilderA64 build(/* logText= */ false, cpuFeatures);
+#elif defined(CODEGEN_TARGET_X64)
+    static unsigned int cpuFeatures = getCpuFeaturesX64();
+    X64::AssemblyBuilderX64 build(/* logText= */ false, cpuFeatures);
 #else
     X64::AssemblyBuilderX64 build(/* logText= */ false);
 #endif
@@ -556,9 +1011,7 @@ template<typename AssemblyBuilder>
     X64::assembleHelpers(build, helpers);
 #endif
 
-    CompilationResult compilationResult;
-
-    std::vector<NativeProtoExecDataPtr> nativeProtos;
+    std::vector<NativeProtoExecDataPtr>& nativeProtos = assembled.nativeProtos;
     nativeProtos.reserve(protos.size());
 
     uint32_t totalIrInstCount = 0;
@@ -567,7 +1020,10 @@ template<typename AssemblyBuilder>
     {
         CodeGenCompilationResult protoResult = CodeGenCompilationResult::Success;
 
-        NativeProtoExecDataPtr nativeExecData = createNativeFunction(build, helpers, protos[i], totalIrInstCount, options.hooks, protoResult);
+        const std::vector<Proto*>& protoCallTargets = callTargets.empty() ? kNoCallTargets : callTargets[i];
+
+        NativeProtoExecDataPtr nativeExecData =
+            createNativeFunction(build, helpers, protos[i], protoCallTargets, totalIrInstCount, options, protoResult);
         if (nativeExecData != nullptr)
         {
             nativeProtos.push_back(std::move(nativeExecData));
@@ -584,29 +1040,13 @@ template<typename AssemblyBuilder>
     if (!build.finalize())
     {
         compilationResult.result = CodeGenCompilationResult::CodeGenAssemblerFinalizationFailure;
-        return compilationResult;
+        nativeProtos.clear();
+        return;
     }
 
     // If no functions were assembled, we don't need to allocate/copy executable pages for helpers
     if (nativeProtos.empty())
-        return compilationResult;
-
-    if (stats != nullptr)
-    {
-        for (const NativeProtoExecDataPtr& nativeExecData : nativeProtos)
-        {
-            NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeExecData.get());
-
-            stats->bytecodeSizeBytes += header.bytecodeInstructionCount * sizeof(Instruction);
-
-            // Account for the native -> bytecode instruction offsets mapping:
-            stats->nativeMetadataSizeBytes += header.bytecodeInstructionCount * sizeof(uint32_t);
-        }
-
-        stats->functionsCompiled += uint32_t(nativeProtos.size());
-        stats->nativeCodeSizeBytes += build.code.size() * sizeof(build.code[0]);
-        stats->nativeDataSizeBytes += build.data.size();
-    }
+        return;
 
     for (size_t i = 0; i < nativeProtos.size(); ++i)
     {
@@ -621,33 +1061,425 @@ template<typename AssemblyBuilder>
         header.nativeCodeSize = end - begin;
     }
 
-    const ModuleBindResult bindResult = codeGenContext->bindModule(
-        moduleId,
-        protos,
-        std::move(nativeProtos),
-        reinterpret_cast<const uint8_t*>(build.data.data()),
-        build.data.size(),
-        reinterpret_cast<const uint8_t*>(build.code.data()),
-        build.code.size() * sizeof(build.code[0])
-    );
-
-    if (stats != nullptr)
-        stats->functionsBound = bindResult.functionsBound;
-
-    if (bindResult.compilationResult != CodeGenCompilationResult::Success)
-        compilationResult.result = bindResult.compilationResult;
+    assembled.data = std::move(build.data);
 
-    return compilationResult;
+#if defined(CODEGEN_TARGET_A64)
+    const uint8_t* code = reinterpret_cast<const uint8_t*>(build.code.data());
+    assembled.code.assign(code, code + build.code.size() * sizeof(build.code[0]));
+#else
+    assembled.code = std::move(build.code);
+#endif
 }
 
-CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats)
+static void bindAssembledProtos(
+    BaseCodeGenContext* codeGenContext,
+    const std::optional<ModuleId>& moduleId,
+    const std::vector<Proto*>& protos,
+    AssembledProtos& assembled,
+    CompilationResult& compilationResult,
+    CompilationStats* stats
+)
 {
-    return compileInternal(moduleId, L, idx, options, stats);
-}
+    if (assembled.nativeProtos.empty())
+        return;
 
-CompilationResult compile(lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats)
-{
-    return compileInternal({}, L, idx, options, stats);
+    if (stats != nullptr)
+    {
+        for (const NativeProtoExecDataPtr& nativeExecData : assembled.nativeProtos)
+        {
+            NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeExecData.get());
+
+            stats->bytecodeSizeBytes += header.bytecodeInstructionCount * sizeof(Instruction);
+
+            // Account for the native -> bytecode instruction offsets mapping:
+            stats->nativeMetadataSizeBytes += header.bytecodeInstructionCount * sizeof(uint32_t);
+        }
+
+        stats->nativeCodeSizeBytes += assembled.code.size();
+        stats->nativeDataSizeBytes += assembled.data.size();
+    }
+
+    const ModuleBindResult bindResult = codeGenContext->bindModule(
+        moduleId,
+        protos,
+        std::move(assembled.nativeProtos),
+        assembled.data.data(),
+        assembled.data.size(),
+        assembled.code.data(),
+        assembled.code.size()
+    );
+
+    if (stats != nullptr)
+        stats->functionsBound += bindResult.functionsBound;
+
+    if (bindResult.compilationResult != CodeGenCompilationResult::Success)
+        compilationResult.result = bindResult.compilationResult;
+}
+
+[[nodiscard]] static CompilationResult compileProtos(
+    BaseCodeGenContext* codeGenContext,
+    const std::optional<ModuleId>& moduleId,
+    const std::vector<Proto*>& protos,
+    const CompilationOptions& options,
+    CompilationStats* stats,
+    const std::vector<std::vector<Proto*>>& callTargets
+)
+{
+    CompilationResult compilationResult;
+    AssembledProtos assembled;
+
+    assembleProtos(protos, options, compilationResult, assembled, callTargets);
+
+    if (stats != nullptr)
+        stats->functionsCompiled += uint32_t(assembled.nativeProtos.size());
+
+    bindAssembledProtos(codeGenContext, moduleId, protos, assembled, compilationResult, stats);
+
+    return compilationResult;
+}
+
+void BaseCodeGenContext::startAsyncThreads()
+{
+    if (!asyncThreads.empty())
+        return;
+
+    unsigned threadCount =
+        FInt::LuauCodeGenAsyncThreads > 0 ? unsigned(FInt::LuauCodeGenAsyncThreads) : std::max(std::thread::hardware_concurrency() / 2, 1u);
+
+    for (unsigned i = 0; i < threadCount; i++)
+    {
+        asyncThreads.emplace_back(
+            [this]
+            {
+                asyncThreadFunction();
+            }
+        );
+    }
+}
+
+void BaseCodeGenContext::asyncThreadFunction()
+{
+    std::unique_lock guard(asyncMutex);
+
+    for (;;)
+    {
+        asyncQueueChanged.wait(
+            guard,
+            [this]
+            {
+                return asyncShutdown || !asyncQueue.empty();
+            }
+        );
+
+        if (asyncShutdown)
+            return;
+
+        std::unique_ptr<AsyncCompileBatch> batch = std::move(asyncQueue.front());
+        asyncQueue.pop_front();
+        asyncRunning.push_back(batch.get());
+
+        guard.unlock();
+
+        std::vector<Proto*> protos;
+        protos.reserve(batch->snapshots.size());
+
+        for (Proto& snapshot : batch->snapshots)
+            protos.push_back(&snapshot);
+
+        assembleProtos(protos, batch->options, batch->result, batch->assembled);
+
+        guard.lock();
+
+        asyncRunning.erase(std::find(asyncRunning.begin(), asyncRunning.end(), batch.get()));
+        asyncCompleted.push_back(std::move(batch));
+
+        asyncBatchCompleted.notify_all();
+    }
+}
+
+static void installAsyncBatch(lua_State* L, BaseCodeGenContext* codeGenContext, AsyncCompileBatch& batch, CompilationStats* stats)
+{
+    std::vector<NativeProtoExecDataPtr>& nativeProtos = batch.assembled.nativeProtos;
+
+    // While the batch was compiled, its functions might have been compiled by other means, or disabled by the debugger
+    auto targetIt = batch.targets.begin();
+
+    for (size_t i = 0; i < nativeProtos.size();)
+    {
+        uint32_t bytecodeId = getNativeProtoExecDataHeader(nativeProtos[i].get()).bytecodeId;
+
+        while (uint32_t((*targetIt)->bytecodeid) != bytecodeId)
+            ++targetIt;
+
+        Proto* proto = *targetIt;
+
+        if (proto->execdata != nullptr || proto->codeentry != &kCodeEntryInsn || proto->debuginsn != nullptr)
+            nativeProtos.erase(nativeProtos.begin() + i);
+        else
+            ++i;
+    }
+
+    if (stats != nullptr)
+    {
+        stats->functionsTotal += uint32_t(batch.targets.size());
+        stats->functionsCompiled += uint32_t(nativeProtos.size());
+    }
+
+    bindAssembledProtos(codeGenContext, std::nullopt, batch.targets, batch.assembled, batch.result, stats);
+
+    // Functions that didn't get native code stay in the interpreter
+    for (Proto* proto : batch.targets)
+    {
+        if (proto->execdata == nullptr)
+        {
+            proto->codeentry = proto->code;
+            proto->tiercalls = 0;
+            proto->tierloops = 0;
+        }
+        else
+        {
+            enableOnStackReplacement(proto);
+        }
+    }
+
+    lua_unref(L, batch.rootRef);
+}
+
+[[nodiscard]] static bool isAsyncBatchOf(const AsyncCompileBatch& batch, global_State* owner)
+{
+    return batch.owner == owner;
+}
+
+CompilationResult compileAsync(lua_State* L, int idx, const CompilationOptions& options)
+{
+    CODEGEN_ASSERT(lua_isLfunction(L, idx));
+    const TValue* func = luaA_toobject(L, idx);
+
+    Proto* root = clvalue(func)->l.p;
+
+    if ((options.flags & CodeGen_OnlyNativeModules) != 0 && (root->flags & LPF_NATIVE_MODULE) == 0 && (root->flags & LPF_NATIVE_FUNCTION) == 0)
+        return CompilationResult{CodeGenCompilationResult::NotNativeModule};
+
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+    if (codeGenContext == nullptr)
+        return CompilationResult{CodeGenCompilationResult::CodeGenNotInitialized};
+
+    std::vector<Proto*> protos;
+    gatherFunctions(protos, root, options.flags, root->flags & LPF_NATIVE_FUNCTION);
+
+    {
+        std::unique_lock guard(codeGenContext->asyncMutex);
+
+        // Skip protos that have native code, are already being compiled in the background, or have breakpoints
+        protos.erase(
+            std::remove_if(
+                protos.begin(),
+                protos.end(),
+                [&](Proto* p)
+                {
+                    return p == nullptr || p->execdata != nullptr || p->debuginsn != nullptr || codeGenContext->asyncPending.count(p) != 0;
+                }
+            ),
+            protos.end()
+        );
+
+        codeGenContext->asyncPending.insert(protos.begin(), protos.end());
+    }
+
+    if (protos.empty())
+        return CompilationResult{CodeGenCompilationResult::NothingToCompile};
+
+    CompilationOptions batchOptions = options;
+    batchOptions.flags &= ~CodeGen_TierUp;
+
+    std::vector<std::unique_ptr<AsyncCompileBatch>> batches;
+
+    for (size_t i = 0; i < protos.size();)
+    {
+        std::unique_ptr<AsyncCompileBatch> batch = std::make_unique<AsyncCompileBatch>();
+        batch->owner = L->global;
+        batch->rootRef = lua_ref(L, idx);
+        batch->options = batchOptions;
+
+        int instructionCount = 0;
+
+        while (i < protos.size() && (batch->targets.empty() || instructionCount < kAsyncBatchInstructions))
+        {
+            Proto* proto = protos[i++];
+
+            instructionCount += proto->sizecode;
+
+            batch->targets.push_back(proto);
+            batch->snapshots.push_back(*proto);
+            batch->code.emplace_back(proto->code, proto->code + proto->sizecode);
+
+            // the interpreter keeps updating type feedback while the batch is compiled, so background compilation doesn't use it
+            batch->snapshots.back().typefeedback = nullptr;
+
+            // Until the native code is installed, the function runs in the interpreter and checks for it every few calls
+            proto->codeentry = &kCodeEntryInsn;
+            proto->tiercalls = kAsyncPollCalls;
+            proto->tierloops = 0;
+        }
+
+        for (size_t j = 0; j < batch->snapshots.size(); ++j)
+            batch->snapshots[j].code = batch->code[j].data();
+
+        batches.push_back(std::move(batch));
+    }
+
+    {
+        std::unique_lock guard(codeGenContext->asyncMutex);
+
+        codeGenContext->startAsyncThreads();
+
+        for (std::unique_ptr<AsyncCompileBatch>& batch : batches)
+            codeGenContext->asyncQueue.push_back(std::move(batch));
+    }
+
+    codeGenContext->asyncQueueChanged.notify_all();
+
+    return CompilationResult{};
+}
+
+uint32_t installAsyncCompilations(lua_State* L, bool wait, CompilationStats* stats)
+{
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+    if (codeGenContext == nullptr)
+        return 0;
+
+    global_State* owner = L->global;
+
+    std::vector<std::unique_ptr<AsyncCompileBatch>> completed;
+    uint32_t stillPending = 0;
+
+    {
+        std::unique_lock guard(codeGenContext->asyncMutex);
+
+        auto isIncomplete = [&]
+        {
+            for (const std::unique_ptr<AsyncCompileBatch>& batch : codeGenContext->asyncQueue)
+                if (isAsyncBatchOf(*batch, owner))
+                    return true;
+
+            for (const AsyncCompileBatch* batch : codeGenContext->asyncRunning)
+                if (isAsyncBatchOf(*batch, owner))
+                    return true;
+
+            return false;
+        };
+
+        if (wait)
+            codeGenContext->asyncBatchCompleted.wait(
+                guard,
+                [&]
+                {
+                    return !isIncomplete();
+                }
+            );
+
+        std::vector<std::unique_ptr<AsyncCompileBatch>>& list = codeGenContext->asyncCompleted;
+
+        for (size_t i = 0; i < list.size();)
+        {
+            if (isAsyncBatchOf(*list[i], owner))
+            {
+                for (Proto* proto : list[i]->targets)
+                    codeGenContext->asyncPending.erase(proto);
+
+                completed.push_back(std::move(list[i]));
+                list.erase(list.begin() + i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        for (const std::unique_ptr<AsyncCompileBatch>& batch : codeGenContext->asyncQueue)
+            if (isAsyncBatchOf(*batch, owner))
+                stillPending += uint32_t(batch->targets.size());
+
+        for (const AsyncCompileBatch* batch : codeGenContext->asyncRunning)
+            if (isAsyncBatchOf(*batch, owner))
+                stillPending += uint32_t(batch->targets.size());
+    }
+
+    for (std::unique_ptr<AsyncCompileBatch>& batch : completed)
+        installAsyncBatch(L, codeGenContext, *batch, stats);
+
+    return stillPending;
+}
+
+static void onPreCloseState(lua_State* L)
+{
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+    global_State* owner = L->global;
+
+    {
+        std::unique_lock guard(codeGenContext->retiredMutex);
+
+        std::vector<std::pair<global_State*, void*>>& list = codeGenContext->retiredExecData;
+
+        for (size_t i = 0; i < list.size();)
+        {
+            if (list[i].first == owner)
+            {
+                codeGenContext->onDestroyFunction(list[i].second);
+                list.erase(list.begin() + i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    std::unique_lock guard(codeGenContext->asyncMutex);
+
+    // Batches of this VM are dropped; the ones that are being compiled have to finish first, as they read objects that are about to be freed
+    codeGenContext->asyncBatchCompleted.wait(
+        guard,
+        [&]
+        {
+            for (const AsyncCompileBatch* batch : codeGenContext->asyncRunning)
+                if (isAsyncBatchOf(*batch, owner))
+                    return false;
+
+            return true;
+        }
+    );
+
+    auto drop = [&](auto& list)
+    {
+        for (size_t i = 0; i < list.size();)
+        {
+            if (isAsyncBatchOf(*list[i], owner))
+            {
+                for (Proto* proto : list[i]->targets)
+                    codeGenContext->asyncPending.erase(proto);
+
+                list.erase(list.begin() + i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    };
+
+    drop(codeGenContext->asyncQueue);
+    drop(codeGenContext->asyncCompleted);
+}
+
+CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats)
+{
+    return compileInternal(moduleId, L, idx, options, stats);
+}
+
+CompilationResult compile(lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats)
+{
+    return compileInternal({}, L, idx, options, stats);
 }
 
 CompilationResult compile(lua_State* L, int idx, unsigned int flags, CompilationStats* stats)
@@ -660,6 +1492,173 @@ CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, unsig
     return compileInternal(moduleId, L, idx, CompilationOptions{flags}, stats);
 }
 
+CompilationResult compileToCache(lua_State* L, int idx, const CompilationOptions& options, std::string& cache, CompilationStats* stats)
+{
+    CompilationOptions cacheOptions = options;
+    cacheOptions.flags &= ~(CodeGen_TierUp | CodeGen_Instrumentation);
+
+    std::vector<Proto*> protos;
+
+    if (CodeGenCompilationResult result = gatherModuleProtos(L, idx, cacheOptions, cacheOptions.flags, protos);
+        result != CodeGenCompilationResult::Success)
+        return CompilationResult{result};
+
+    if (stats != nullptr)
+        stats->functionsTotal = uint32_t(protos.size());
+
+    CompilationResult compilationResult;
+    AssembledProtos assembled;
+
+    assembleProtos(protos, cacheOptions, compilationResult, assembled);
+
+    // Entry offsets are stored before binding, which replaces them with addresses
+    if (compilationResult.result == CodeGenCompilationResult::Success)
+    {
+        if (std::optional<uint64_t> key = getNativeCacheKey(protos, cacheOptions))
+            serializeNativeCache(cache, *key, assembled);
+    }
+
+    if (stats != nullptr)
+        stats->functionsCompiled += uint32_t(assembled.nativeProtos.size());
+
+    bindAssembledProtos(getCodeGenContext(L), std::nullopt, protos, assembled, compilationResult, stats);
+
+    return compilationResult;
+}
+
+[[nodiscard]] static CompilationResult loadFromCacheInternal(
+    const std::optional<ModuleId>& moduleId,
+    lua_State* L,
+    int idx,
+    const CompilationOptions& options,
+    const char* cache,
+    size_t cacheSize,
+    CompilationStats* stats
+)
+{
+    CompilationOptions cacheOptions = options;
+    cacheOptions.flags &= ~(CodeGen_TierUp | CodeGen_Instrumentation);
+
+    std::vector<Proto*> protos;
+
+    if (CodeGenCompilationResult result = gatherModuleProtos(L, idx, cacheOptions, cacheOptions.flags, protos);
+        result != CodeGenCompilationResult::Success)
+        return CompilationResult{result};
+
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+
+    if (stats != nullptr)
+        stats->functionsTotal = uint32_t(protos.size());
+
+    if (moduleId.has_value())
+    {
+        if (std::optional<ModuleBindResult> existingModuleBindResult = codeGenContext->tryBindExistingModule(*moduleId, protos))
+        {
+            if (stats != nullptr)
+                stats->functionsBound = existingModuleBindResult->functionsBound;
+
+            return CompilationResult{existingModuleBindResult->compilationResult};
+        }
+    }
+
+    std::optional<uint64_t> key = getNativeCacheKey(protos, cacheOptions);
+    AssembledProtos assembled;
+
+    if (!key || !deserializeNativeCache(cache, cacheSize, *key, assembled))
+        return CompilationResult{CodeGenCompilationResult::CacheMismatch};
+
+    CompilationResult compilationResult;
+    bindAssembledProtos(codeGenContext, moduleId, protos, assembled, compilationResult, stats);
+
+    return compilationResult;
+}
+
+CompilationResult loadFromCache(lua_State* L, int idx, const CompilationOptions& options, const char* cache, size_t cacheSize, CompilationStats* stats)
+{
+    return loadFromCacheInternal({}, L, idx, options, cache, cacheSize, stats);
+}
+
+CompilationResult loadFromCache(
+    const ModuleId& moduleId,
+    lua_State* L,
+    int idx,
+    const CompilationOptions& options,
+    const char* cache,
+    size_t cacheSize,
+    CompilationStats* stats
+)
+{
+    return loadFromCacheInternal(moduleId, L, idx, options, cache, cacheSize, stats);
+}
+
+TierUpStats getTierUpStats(lua_State* L)
+{
+    TierUpStats stats;
+
+    if (BaseCodeGenContext* codeGenContext = getCodeGenContext(L))
+    {
+        stats.functionsMarked = codeGenContext->tierUpFunctionsMarked;
+        stats.functionsCompiled = codeGenContext->tierUpFunctionsCompiled;
+        stats.functionsSkipped = codeGenContext->tierUpFunctionsSkipped;
+        stats.functionsRecompiled = codeGenContext->tierUpFunctionsRecompiled;
+        stats.callsInlined = codeGenContext->tierUpCallsInlined;
+        stats.nativeCodeSizeBytes = codeGenContext->tierUpNativeCodeSizeBytes;
+    }
+
+    return stats;
+}
+
+CodeMemoryStats getCodeMemoryStats(lua_State* L)
+{
+    if (BaseCodeGenContext* codeGenContext = getCodeGenContext(L))
+        return codeGenContext->getCodeMemoryStats();
+
+    return {};
+}
+
+static void gatherNativeFunctionStats(std::vector<NativeFunctionStats>& results, Proto* proto, Proto* root)
+{
+    if (proto->execdata)
+    {
+        const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(static_cast<const uint32_t*>(proto->execdata));
+
+        if (const uint64_t* counters = header.executionCounters)
+        {
+            NativeFunctionStats stats;
+            stats.name = proto->debugname ? getstr(proto->debugname) : proto == root ? "[top level]" : "[anonymous]";
+            stats.line = proto->linedefined;
+            stats.entries = counters[NativeExecCounter_Entry];
+            stats.fallbacks = counters[NativeExecCounter_Fallback];
+
+            for (int pcpos = 0; pcpos < proto->sizecode; pcpos++)
+            {
+                if (uint64_t count = counters[NativeExecCounter_Exit + pcpos])
+                {
+                    stats.exits += count;
+                    stats.exitLocations.push_back({uint32_t(pcpos), luaG_getline(proto, pcpos), count});
+                }
+            }
+
+            results.push_back(std::move(stats));
+        }
+    }
+
+    for (int i = 0; i < proto->sizep; i++)
+        gatherNativeFunctionStats(results, proto->p[i], root);
+}
+
+std::vector<NativeFunctionStats> getNativeFunctionStats(lua_State* L, int idx)
+{
+    CODEGEN_ASSERT(lua_isLfunction(L, idx));
+    const TValue* func = luaA_toobject(L, idx);
+
+    Proto* root = clvalue(func)->l.p;
+
+    std::vector<NativeFunctionStats> results;
+    gatherNativeFunctionStats(results, root, root);
+    return results;
+}
+
 [[nodiscard]] bool isNativeExecutionEnabled(lua_State* L)
 {
     return getCodeGenContext(L) != nullptr && L->global->ecb.enter == onEnter;
@@ -683,7 +1682,18 @@ void disableNativeExecutionForFunction(lua_State* L, const int level) noexcept
     CODEGEN_ASSERT(proto);
 
     CODEGEN_ASSERT(proto->codeentry != proto->code);
-    onDestroyFunction(L, proto);
+
+    // The function is still running, so its native code has to stay alive until the VM is closed
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+
+    {
+        std::unique_lock guard(codeGenContext->retiredMutex);
+        codeGenContext->retiredExecData.emplace_back(L->global, proto->execdata);
+    }
+
+    proto->execdata = nullptr;
+    proto->exectarget = 0;
+    proto->codeentry = proto->code;
 }
 
 static uint8_t userdataRemapperWrap(lua_State* L, const char* str, size_t len)
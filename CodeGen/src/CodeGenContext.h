@@ -5,8 +5,16 @@
 
 #include "NativeState.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
 #include <stdint.h>
 
 namespace Luau
@@ -28,10 +36,39 @@ struct ModuleBindResult
     uint32_t functionsBound = 0;
 };
 
+// Native code and data of a group of functions before it is placed in executable memory; entry offsets in the exec data headers are
+// relative to the start of the code
+struct AssembledProtos
+{
+    std::vector<NativeProtoExecDataPtr> nativeProtos;
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> code;
+};
+
+// A group of functions compiled on a background thread (see compileAsync).  Compilation threads only see the snapshots, which are
+// copies of the target functions that own a copy of the bytecode, since the VM keeps patching the original one; the remaining data
+// that the snapshots point to is immutable and kept alive by the registry reference to the root closure
+struct AsyncCompileBatch
+{
+    global_State* owner = nullptr;
+    int rootRef = 0;
+
+    CompilationOptions options;
+
+    std::vector<Proto*> targets;
+    std::vector<Proto> snapshots;
+    std::vector<std::vector<Instruction>> code;
+
+    // Filled in by the compilation thread
+    CompilationResult result;
+    AssembledProtos assembled;
+};
+
 class BaseCodeGenContext
 {
 public:
     BaseCodeGenContext(size_t blockSize, size_t maxTotalSize, AllocationCallback* allocationCallback, void* allocationCallbackContext);
+    ~BaseCodeGenContext();
 
     [[nodiscard]] bool initHeaderFunctions();
 
@@ -53,6 +90,8 @@ public:
     virtual void onCloseState() noexcept = 0;
     virtual void onDestroyFunction(void* execdata) noexcept = 0;
 
+    [[nodiscard]] virtual CodeMemoryStats getCodeMemoryStats() const = 0;
+
     CodeAllocator codeAllocator;
     std::unique_ptr<UnwindBuilder> unwindBuilder;
 
@@ -62,7 +101,37 @@ public:
     void* userdataRemappingContext = nullptr;
     UserdataRemapperCallback* userdataRemapper = nullptr;
 
+    // Functions marked with CodeGen_TierUp are compiled with the options of the most recent compile call that marked them
+    CompilationOptions tierUpOptions;
+
+    std::atomic<uint32_t> tierUpFunctionsMarked{0};
+    std::atomic<uint32_t> tierUpFunctionsCompiled{0};
+    std::atomic<uint32_t> tierUpFunctionsSkipped{0};
+    std::atomic<size_t> tierUpNativeCodeSizeBytes{0};
+    std::atomic<uint32_t> tierUpFunctionsRecompiled{0};
+    std::atomic<uint32_t> tierUpCallsInlined{0};
+
+    // Native code of functions that were recompiled might still be running further up the stack, so it's kept until the VM is closed
+    std::mutex retiredMutex;
+    std::vector<std::pair<global_State*, void*>> retiredExecData;
+
     NativeContext context;
+
+    // Background compilation; batches move from the queue to a compilation thread and then to the completed list, from which the VM
+    // that submitted them installs the results.  Targets of all batches that weren't installed yet are in asyncPending
+    void startAsyncThreads();
+    void asyncThreadFunction();
+
+    std::mutex asyncMutex;
+    std::condition_variable asyncQueueChanged;
+    std::condition_variable asyncBatchCompleted;
+    std::deque<std::unique_ptr<AsyncCompileBatch>> asyncQueue;
+    std::vector<AsyncCompileBatch*> asyncRunning;
+    std::vector<std::unique_ptr<AsyncCompileBatch>> asyncCompleted;
+    std::unordered_set<Proto*> asyncPending;
+    bool asyncShutdown = false;
+
+    std::vector<std::thread> asyncThreads;
 };
 
 class StandaloneCodeGenContext final : public BaseCodeGenContext
@@ -86,6 +155,8 @@ public:
     virtual void onCloseState() noexcept override;
     virtual void onDestroyFunction(void* execdata) noexcept override;
 
+    [[nodiscard]] virtual CodeMemoryStats getCodeMemoryStats() const override;
+
 private:
 };
 
@@ -110,6 +181,8 @@ public:
     virtual void onCloseState() noexcept override;
     virtual void onDestroyFunction(void* execdata) noexcept override;
 
+    [[nodiscard]] virtual CodeMemoryStats getCodeMemoryStats() const override;
+
 private:
     SharedCodeAllocator sharedAllocator;
 };
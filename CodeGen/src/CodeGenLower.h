@@ -10,7 +10,9 @@
 #include "Luau/LoweringStats.h"
 #include "Luau/OptimizeConstProp.h"
 #include "Luau/OptimizeDeadStore.h"
+#include "Luau/OptimizeEscape.h"
 #include "Luau/OptimizeFinalX64.h"
+#include "Luau/OptimizeLoops.h"
 
 #include "EmitCommon.h"
 #include "IrLoweringA64.h"
@@ -23,6 +25,8 @@
 #include <vector>
 
 LUAU_FASTFLAG(DebugCodegenOptSize)
+LUAU_FASTFLAG(DebugCodegenSkipScalarReplacement)
+LUAU_FASTFLAG(DebugCodegenSkipLoopVersioning)
 LUAU_FASTINT(CodegenHeuristicsInstructionLimit)
 LUAU_FASTINT(CodegenHeuristicsBlockLimit)
 LUAU_FASTINT(CodegenHeuristicsBlockInstructionLimit)
@@ -286,6 +290,17 @@ inline bool lowerIr(
     return lowerImpl(build, lowering, ir.function, sortedBlocks, proto->bytecodeid, options);
 }
 
+inline bool isFusedMultiplyAddSupported(const X64::AssemblyBuilderX64& build)
+{
+    return (build.features & X64::Feature_FMA3) != 0;
+}
+
+inline bool isFusedMultiplyAddSupported(const A64::AssemblyBuilderA64&)
+{
+    // A64 lowering doesn't have fused instructions yet
+    return false;
+}
+
 template<typename AssemblyBuilder>
 inline bool lowerFunction(
     IrBuilder& ir,
@@ -317,6 +332,7 @@ inline bool lowerFunction(
     {
         stats->blocksPreOpt += preOptBlockCount;
         stats->maxBlockInstructions = maxBlockInstructions;
+        stats->inlinedCalls += unsigned(ir.function.inlinedCalls.size());
     }
 
     if (preOptBlockCount >= unsigned(FInt::CodegenHeuristicsBlockLimit.value))
@@ -333,6 +349,12 @@ inline bool lowerFunction(
 
     computeCfgInfo(ir.function);
 
+    if (!FFlag::DebugCodegenOptSize && !FFlag::DebugCodegenSkipLoopVersioning)
+    {
+        if (versionLoops(ir))
+            computeCfgInfo(ir.function);
+    }
+
     constPropInBlockChains(ir);
 
     if (!FFlag::DebugCodegenOptSize)
@@ -354,10 +376,21 @@ inline bool lowerFunction(
             constPropInstructionCount = getInstructionCount(ir.function.instructions, IrCmd::SUBSTITUTE) - constPropInstructionCount;
             stats->blockLinearizationStats.constPropInstructionCount += constPropInstructionCount;
         }
+
+        if (!FFlag::DebugCodegenSkipScalarReplacement)
+        {
+            unsigned scalarReplacedTables = scalarReplaceTablesInBlockChains(ir);
+
+            if (stats)
+                stats->scalarReplacedTables += scalarReplacedTables;
+        }
     }
 
     markDeadStoresInBlockChains(ir);
 
+    if (!FFlag::DebugCodegenOptSize && (options.compilationOptions.flags & CodeGen_FusedMultiplyAdd) != 0 && isFusedMultiplyAddSupported(build))
+        fuseMultiplyAddX64(ir.function);
+
     std::vector<uint32_t> sortedBlocks = getSortedBlockOrder(ir.function);
 
     // In order to allocate registers during lowering, we need to know where instruction results are last used
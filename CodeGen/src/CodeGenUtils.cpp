@@ -1,6 +1,8 @@
 // This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
 #include "CodeGenUtils.h"
 
+#include "Luau/NativeProtoExecData.h"
+
 #include "lvm.h"
 
 #include "lbuiltins.h"
@@ -235,6 +237,11 @@ Udata* newUserdata(lua_State* L, size_t s, int tag)
     return u;
 }
 
+void strbufAppend(lua_State* L, Udata* u, TString* ts)
+{
+    luaU_strbufappend(L, u, getstr(ts), ts->len);
+}
+
 void getImport(lua_State* L, StkId res, unsigned id, unsigned pc)
 {
     Closure* cl = clvalue(L->ci->func);
@@ -373,6 +380,35 @@ const Instruction* executeSETGLOBAL(lua_State* L, const Instruction* pc, StkId b
     return pc;
 }
 
+// values resolved through the metatable of userdata can be stored in the inline cache when native code of the function reads it
+static bool isUserdataCacheable(Proto* p, const TValue* rb)
+{
+    if (!ttisuserdata(rb) || !uvalue(rb)->metatable)
+        return false;
+
+    return p->execdata && getNativeProtoExecDataHeader(static_cast<const uint32_t*>(p->execdata)).userdataCacheSiteCount != 0;
+}
+
+// value is read from table h, which is the metatable itself or its __index table
+static void fillUserdataCache(lua_State* L, Proto* p, const Instruction* pc, LuaTable* mt, LuaTable* h, const TValue* value)
+{
+    if (!p->udatacache)
+        luaF_newudatacache(L, p);
+
+    // writes to the tables that the value was resolved through invalidate the cache
+    luaH_watch(mt);
+    luaH_watch(h);
+
+    UdataCache& entry = p->udatacache[pc - p->code];
+
+    entry.metatable = mt;
+    entry.epoch = L->global->udatacacheepoch;
+    setobj(L, &entry.value, value);
+
+    luaC_objbarrier(L, p, mt);
+    luaC_barrier(L, p, value);
+}
+
 const Instruction* executeGETTABLEKS(lua_State* L, const Instruction* pc, StkId base, TValue* k)
 {
     [[maybe_unused]] Closure* cl = clvalue(L->ci->func);
@@ -418,8 +454,23 @@ const Instruction* executeGETTABLEKS(lua_State* L, const Instruction* pc, StkId
     }
     else
     {
-        // fast-path: user data with C __index TM
+        // fast-path: user data with __index table that has the field, which native code can read from the inline cache
         const TValue* fn = 0;
+        if (isUserdataCacheable(cl->l.p, rb) && (fn = fasttm(L, uvalue(rb)->metatable, TM_INDEX)) && ttistable(fn))
+        {
+            const TValue* res = luaH_getstr(hvalue(fn), tsvalue(kv));
+
+            if (!ttisnil(res))
+            {
+                VM_PROTECT_PC(); // cache allocation might fail
+                fillUserdataCache(L, cl->l.p, pc - 2, uvalue(rb)->metatable, hvalue(fn), res);
+
+                setobj2s(L, ra, res);
+                return pc;
+            }
+        }
+
+        // fast-path: user data with C __index TM
         if (ttisuserdata(rb) && (fn = fasttm(L, uvalue(rb)->metatable, TM_INDEX)) && ttisfunction(fn) && clvalue(fn)->isC)
         {
             // note: it's safe to push arguments past top for complicated reasons (see top of the file)
@@ -589,6 +640,12 @@ const Instruction* executeNAMECALL(lua_State* L, const Instruction* pc, StkId ba
         // fast-path: metatable with __namecall
         if (const TValue* fn = fasttm(L, mt, TM_NAMECALL))
         {
+            if (isUserdataCacheable(cl->l.p, rb))
+            {
+                VM_PROTECT_PC(); // cache allocation might fail
+                fillUserdataCache(L, cl->l.p, pc - 2, mt, mt, fn);
+            }
+
             // note: order of copies allows rb to alias ra+1 or ra
             setobj2s(L, ra + 1, rb);
             setobj2s(L, ra, fn);
@@ -598,6 +655,18 @@ const Instruction* executeNAMECALL(lua_State* L, const Instruction* pc, StkId ba
         else if ((tmi = fasttm(L, mt, TM_INDEX)) && ttistable(tmi))
         {
             LuaTable* h = hvalue(tmi);
+
+            // methods of __index tables can be read by native code from the inline cache
+            if (isUserdataCacheable(cl->l.p, rb))
+            {
+                const TValue* res = luaH_getstr(h, tsvalue(kv));
+
+                if (!ttisnil(res))
+                {
+                    VM_PROTECT_PC(); // cache allocation might fail
+                    fillUserdataCache(L, cl->l.p, pc - 2, mt, h, res);
+                }
+            }
             int slot = LUAU_INSN_C(insn) & h->nodemask8;
             LuaNode* n = &h->node[slot];
 
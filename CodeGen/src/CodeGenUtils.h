@@ -18,6 +18,7 @@ Closure* callProlog(lua_State* L, TValue* ra, StkId argtop, int nresults);
 void callEpilogC(lua_State* L, int nresults, int n);
 
 Udata* newUserdata(lua_State* L, size_t s, int tag);
+void strbufAppend(lua_State* L, Udata* u, TString* ts);
 void getImport(lua_State* L, StkId res, unsigned id, unsigned pc);
 
 #define CALL_FALLBACK_YIELD 1
@@ -794,12 +794,107 @@ void computeIteratedDominanceFrontierForDefs(
     }
 }
 
+bool dominates(const CfgInfo& cfg, uint32_t a, uint32_t b)
+{
+    CODEGEN_ASSERT(a < cfg.domOrdering.size() && b < cfg.domOrdering.size());
+
+    const BlockOrdering& orderingA = cfg.domOrdering[a];
+    const BlockOrdering& orderingB = cfg.domOrdering[b];
+
+    if (!orderingA.visited || !orderingB.visited)
+        return false;
+
+    // Dominator tree node is an ancestor of all nodes visited between its pre-order and post-order visits
+    return orderingA.preOrder <= orderingB.preOrder && orderingB.postOrder <= orderingA.postOrder;
+}
+
+void computeCfgLoops(IrFunction& function)
+{
+    CfgInfo& info = function.cfg;
+
+    // Clear existing data
+    info.loops.clear();
+
+    // Collect back edges, grouping them by the loop header
+    std::vector<std::pair<uint32_t, uint32_t>> backEdges;
+
+    for (size_t blockIdx = 0; blockIdx < function.blocks.size(); blockIdx++)
+    {
+        if (function.blocks[blockIdx].kind == IrBlockKind::Dead)
+            continue;
+
+        for (uint32_t succIdx : successors(info, uint32_t(blockIdx)))
+        {
+            if (dominates(info, succIdx, uint32_t(blockIdx)))
+                backEdges.push_back({succIdx, uint32_t(blockIdx)});
+        }
+    }
+
+    std::sort(backEdges.begin(), backEdges.end());
+
+    // Each block records the last loop it was added to
+    std::vector<uint32_t> lastLoop(function.blocks.size(), ~0u);
+    std::vector<uint32_t> worklist;
+
+    for (size_t i = 0; i < backEdges.size(); i++)
+    {
+        auto [header, source] = backEdges[i];
+
+        if (i == 0 || backEdges[i - 1].first != header)
+        {
+            lastLoop[header] = uint32_t(info.loops.size());
+            info.loops.push_back({header, {header}});
+        }
+
+        uint32_t loopIdx = uint32_t(info.loops.size() - 1);
+        CfgLoop& loop = info.loops.back();
+
+        // Walk backwards from the back edge source until we reach the header
+        if (lastLoop[source] != loopIdx)
+        {
+            lastLoop[source] = loopIdx;
+            loop.blocks.push_back(source);
+            worklist.push_back(source);
+        }
+
+        while (!worklist.empty())
+        {
+            uint32_t currIdx = worklist.back();
+            worklist.pop_back();
+
+            for (uint32_t predIdx : predecessors(info, currIdx))
+            {
+                if (lastLoop[predIdx] == loopIdx)
+                    continue;
+
+                lastLoop[predIdx] = loopIdx;
+                loop.blocks.push_back(predIdx);
+                worklist.push_back(predIdx);
+            }
+        }
+    }
+
+    for (CfgLoop& loop : info.loops)
+        std::sort(loop.blocks.begin(), loop.blocks.end());
+
+    // Loop headers of the outer loops dominate the headers of the inner loops and are visited first
+    std::sort(
+        info.loops.begin(),
+        info.loops.end(),
+        [&](const CfgLoop& a, const CfgLoop& b)
+        {
+            return info.domOrdering[a.header].preOrder < info.domOrdering[b.header].preOrder;
+        }
+    );
+}
+
 void computeCfgInfo(IrFunction& function)
 {
     computeCfgBlockEdges(function);
     computeCfgImmediateDominators(function);
     computeCfgDominanceTreeChildren(function);
     computeCfgLiveInOutRegSets(function);
+    computeCfgLoops(function);
 }
 
 BlockIteratorWrapper predecessors(const CfgInfo& cfg, uint32_t blockIdx)
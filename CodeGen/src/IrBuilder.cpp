@@ -5,6 +5,7 @@
 #include "Luau/BytecodeAnalysis.h"
 #include "Luau/IrData.h"
 #include "Luau/IrUtils.h"
+#include "Luau/NativeProtoExecData.h"
 
 #include "IrTranslation.h"
 
@@ -134,7 +135,8 @@ void IrBuilder::buildFunctionIr(Proto* proto)
 
     // Reserve entry block
     bool generateTypeChecks = hasTypedParameters(function.bcTypeInfo);
-    IrOp entry = generateTypeChecks ? block(IrBlockKind::Internal) : IrOp{};
+    bool countEntries = function.executionCounters != nullptr;
+    IrOp entry = generateTypeChecks || countEntries ? block(IrBlockKind::Internal) : IrOp{};
 
     // Rebuild original control flow blocks
     rebuildBytecodeBasicBlocks(proto);
@@ -144,11 +146,15 @@ void IrBuilder::buildFunctionIr(Proto* proto)
 
     function.bcMapping.resize(proto->sizecode, {~0u, ~0u});
 
-    if (generateTypeChecks)
+    if (generateTypeChecks || countEntries)
     {
         beginBlock(entry);
 
-        buildArgumentTypeChecks(*this);
+        if (countEntries)
+            inst(IrCmd::INC_EXEC_COUNTER, constUint(NativeExecCounter_Entry));
+
+        if (generateTypeChecks)
+            buildArgumentTypeChecks(*this);
 
         inst(IrCmd::JUMP, blockAtInst(0));
     }
@@ -276,6 +282,9 @@ void IrBuilder::translateInst(LuauOpcode op, const Instruction* pc, int i)
     case LOP_MOVE:
         translateInstMove(*this, pc);
         break;
+    case LOP_MOVE2:
+        translateInstMove2(*this, pc);
+        break;
     case LOP_GETGLOBAL:
         translateInstGetGlobal(*this, pc, i);
         break;
@@ -283,6 +292,10 @@ void IrBuilder::translateInst(LuauOpcode op, const Instruction* pc, int i)
         translateInstSetGlobal(*this, pc, i);
         break;
     case LOP_CALL:
+        if (!activeFastcallFallback && size_t(i) < function.callTargets.size() && function.callTargets[i] &&
+            translateInlinedCall(*this, pc, i, function.callTargets[i]))
+            break;
+
         inst(IrCmd::INTERRUPT, constUint(i));
         inst(IrCmd::SET_SAVEDPC, constUint(i + 1));
 
@@ -705,6 +718,14 @@ IrOp IrBuilder::constTag(uint8_t value)
     return constAny(constant, uint64_t(value));
 }
 
+IrOp IrBuilder::constPointer(const void* value)
+{
+    IrConst constant;
+    constant.kind = IrConstKind::Pointer;
+    constant.valuePointer = value;
+    return constAny(constant, uint64_t(uintptr_t(value)));
+}
+
 IrOp IrBuilder::constAny(IrConst constant, uint64_t asCommonKey)
 {
     ConstantKey key{constant.kind, asCommonKey};
@@ -762,6 +783,10 @@ IrOp IrBuilder::inst(IrCmd cmd, IrOp a, IrOp b, IrOp c, IrOp d, IrOp e, IrOp f)
 
 IrOp IrBuilder::inst(IrCmd cmd, IrOp a, IrOp b, IrOp c, IrOp d, IrOp e, IrOp f, IrOp g)
 {
+    // Instrumented functions count the instructions that are completed by the VM
+    if (function.executionCounters && isFullFallback(cmd))
+        inst(IrCmd::INC_EXEC_COUNTER, constUint(NativeExecCounter_Fallback));
+
     uint32_t index = uint32_t(function.instructions.size());
     function.instructions.push_back({cmd, a, b, c, d, e, f, g});
 
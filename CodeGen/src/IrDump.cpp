@@ -153,6 +153,8 @@ const char* getCmdName(IrCmd cmd)
         return "MIN_NUM";
     case IrCmd::MAX_NUM:
         return "MAX_NUM";
+    case IrCmd::MULADD_NUM:
+        return "MULADD_NUM";
     case IrCmd::UNM_NUM:
         return "UNM_NUM";
     case IrCmd::FLOOR_NUM:
@@ -179,6 +181,8 @@ const char* getCmdName(IrCmd cmd)
         return "MUL_VEC";
     case IrCmd::DIV_VEC:
         return "DIV_VEC";
+    case IrCmd::MULADD_VEC:
+        return "MULADD_VEC";
     case IrCmd::UNM_VEC:
         return "UNM_VEC";
     case IrCmd::DOT_VEC:
@@ -213,6 +217,10 @@ const char* getCmdName(IrCmd cmd)
         return "TABLE_SETNUM";
     case IrCmd::STRING_LEN:
         return "STRING_LEN";
+    case IrCmd::STRING_CHAR:
+        return "STRING_CHAR";
+    case IrCmd::STRING_SUB:
+        return "STRING_SUB";
     case IrCmd::NEW_TABLE:
         return "NEW_TABLE";
     case IrCmd::DUP_TABLE:
@@ -221,8 +229,12 @@ const char* getCmdName(IrCmd cmd)
         return "TRY_NUM_TO_INDEX";
     case IrCmd::TRY_CALL_FASTGETTM:
         return "TRY_CALL_FASTGETTM";
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
+        return "GET_USERDATA_CACHE_ADDR";
     case IrCmd::NEW_USERDATA:
         return "NEW_USERDATA";
+    case IrCmd::STRBUF_APPEND:
+        return "STRBUF_APPEND";
     case IrCmd::INT_TO_NUM:
         return "INT_TO_NUM";
     case IrCmd::UINT_TO_NUM:
@@ -281,6 +293,8 @@ const char* getCmdName(IrCmd cmd)
         return "CHECK_NODE_NO_NEXT";
     case IrCmd::CHECK_NODE_VALUE:
         return "CHECK_NODE_VALUE";
+    case IrCmd::CHECK_CLOSURE_PROTO:
+        return "CHECK_CLOSURE_PROTO";
     case IrCmd::CHECK_BUFFER_LEN:
         return "CHECK_BUFFER_LEN";
     case IrCmd::CHECK_USERDATA_TAG:
@@ -315,6 +329,8 @@ const char* getCmdName(IrCmd cmd)
         return "FORGPREP_XNEXT_FALLBACK";
     case IrCmd::COVERAGE:
         return "COVERAGE";
+    case IrCmd::INC_EXEC_COUNTER:
+        return "INC_EXEC_COUNTER";
     case IrCmd::FALLBACK_GETGLOBAL:
         return "FALLBACK_GETGLOBAL";
     case IrCmd::FALLBACK_SETGLOBAL:
@@ -594,6 +610,9 @@ void toString(std::string& result, Proto* proto, IrConst constant)
             append(result, ")");
         }
         break;
+    case IrConstKind::Pointer:
+        append(result, "%p", constant.valuePointer);
+        break;
     }
 }
 
@@ -844,6 +863,21 @@ void toStringDetailed(
         }
     }
 
+    // Loop body for loop headers
+    if (includeCfgInfo == IncludeCfgInfo::Yes)
+    {
+        for (const CfgLoop& loop : ctx.cfg.loops)
+        {
+            if (loop.header != blockIdx)
+                continue;
+
+            append(ctx.result, "; loop blocks: ");
+
+            appendBlockSet(ctx, BlockIteratorWrapper{loop.blocks.data(), loop.blocks.data() + loop.blocks.size()});
+            append(ctx.result, "\n");
+        }
+    }
+
     // Live-in VM regs
     if (includeRegFlowInfo == IncludeRegFlowInfo::Yes && blockIdx < ctx.cfg.in.size())
     {
@@ -5,6 +5,7 @@
 #include "Luau/IrData.h"
 #include "Luau/IrUtils.h"
 #include "Luau/LoweringStats.h"
+#include "Luau/NativeProtoExecData.h"
 
 #include "EmitCommonA64.h"
 #include "NativeState.h"
@@ -185,6 +186,15 @@ static void emitFallback(AssemblyBuilderA64& build, int offset, int pcpos)
     emitUpdateBase(build);
 }
 
+static void emitIncExecCounter(AssemblyBuilderA64& build, RegisterA64 temp1, RegisterA64 temp2, uint64_t* counter)
+{
+    build.adr(temp1, uint64_t(uintptr_t(counter)));
+    build.ldr(temp1, mem(temp1));
+    build.ldr(temp2, mem(temp1));
+    build.add(temp2, temp2, uint16_t(1));
+    build.str(temp2, mem(temp1));
+}
+
 static void emitInvokeLibm1P(AssemblyBuilderA64& build, size_t func, int arg)
 {
     CODEGEN_ASSERT(kTempSlots >= 1);
@@ -952,18 +962,25 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     {
         IrCondition cond = conditionOp(inst.c);
 
-        if (cond == IrCondition::Equal && intOp(inst.b) == 0)
+        bool zero = inst.b.kind == IrOpKind::Constant && intOp(inst.b) == 0;
+
+        if (cond == IrCondition::Equal && zero)
         {
-            build.cbz(regOp(inst.a), labelOp(inst.d));
+            build.cbz(tempInt(inst.a), labelOp(inst.d));
         }
-        else if (cond == IrCondition::NotEqual && intOp(inst.b) == 0)
+        else if (cond == IrCondition::NotEqual && zero)
         {
-            build.cbnz(regOp(inst.a), labelOp(inst.d));
+            build.cbnz(tempInt(inst.a), labelOp(inst.d));
         }
         else
         {
-            CODEGEN_ASSERT(unsigned(intOp(inst.b)) <= AssemblyBuilderA64::kMaxImmediate);
-            build.cmp(regOp(inst.a), uint16_t(intOp(inst.b)));
+            RegisterA64 lhs = tempInt(inst.a);
+
+            if (inst.b.kind == IrOpKind::Constant && unsigned(intOp(inst.b)) <= AssemblyBuilderA64::kMaxImmediate)
+                build.cmp(lhs, uint16_t(intOp(inst.b)));
+            else
+                build.cmp(lhs, tempInt(inst.b));
+
             build.b(getConditionInt(cond), labelOp(inst.d));
         }
         jumpOrFallthrough(blockOp(inst.e), next);
@@ -1040,6 +1057,69 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.ldr(inst.regA64, mem(regOp(inst.a), offsetof(TString, len)));
         break;
     }
+    case IrCmd::STRING_CHAR:
+    {
+        inst.regA64 = regs.allocReg(KindA64::x, index);
+        RegisterA64 temp = regs.allocTemp(KindA64::x);
+
+        build.ldr(temp, mem(rState, offsetof(lua_State, global)));
+
+        if (inst.a.kind == IrOpKind::Inst)
+            build.add(temp, temp, castReg(KindA64::x, regOp(inst.a)), 3);
+        else if (inst.a.kind == IrOpKind::Constant)
+            build.add(temp, temp, uint16_t(uint8_t(intOp(inst.a)) * sizeof(TString*)));
+        else
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+
+        build.ldr(inst.regA64, mem(temp, offsetof(global_State, charstr)));
+        build.cbz(inst.regA64, labelOp(inst.b));
+        break;
+    }
+    case IrCmd::STRING_SUB:
+    {
+        RegisterA64 temp1 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::w);
+
+        if (inst.b.kind == IrOpKind::Inst)
+        {
+            build.add(temp1, regOp(inst.a), regOp(inst.b)); // implicit uxtw
+            build.add(temp1, temp1, uint16_t(offsetof(TString, data)));
+        }
+        else if (inst.b.kind == IrOpKind::Constant)
+        {
+            // offset can only be negative in dead code (since offsets are checked); this avoids assertion in emitAddOffset
+            emitAddOffset(build, temp1, regOp(inst.a), offsetof(TString, data) + size_t(intOp(inst.b) < 0 ? 0 : intOp(inst.b)));
+        }
+        else
+        {
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+        }
+
+        if (inst.c.kind == IrOpKind::Inst)
+            build.mov(temp2, regOp(inst.c));
+        else
+            build.mov(temp2, intOp(inst.c));
+
+        regs.spill(build, index, {temp1, temp2});
+
+        if (temp2.index != 1)
+        {
+            build.mov(x1, temp1);
+            build.mov(w2, temp2);
+        }
+        else
+        {
+            build.mov(x3, temp1);
+            build.mov(w2, temp2);
+            build.mov(x1, x3);
+        }
+
+        build.mov(x0, rState);
+        build.ldr(x3, mem(rNativeContext, offsetof(NativeContext, luaS_newlstr)));
+        build.blr(x3);
+        inst.regA64 = regs.takeReg(x0, index);
+        break;
+    }
     case IrCmd::TABLE_SETNUM:
     {
         // note: we need to call regOp before spill so that we don't do redundant reloads
@@ -1134,6 +1214,39 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         inst.regA64 = regs.takeReg(x0, index);
         break;
     }
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
+    {
+        RegisterA64 temp1 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::x);
+
+        build.ldr(temp1, mem(rClosure, offsetof(Closure, l.p)));
+        build.ldr(temp1, mem(temp1, offsetof(Proto, udatacache)));
+        build.cbz(temp1, labelOp(inst.c)); // no cache was allocated
+
+        inst.regA64 = regs.allocReg(KindA64::x, index);
+
+        emitAddOffset(build, inst.regA64, temp1, uintOp(inst.b) * sizeof(UdataCache));
+
+        build.ldr(temp1, mem(regOp(inst.a), offsetof(Udata, metatable)));
+        build.ldr(temp2, mem(inst.regA64, offsetof(UdataCache, metatable)));
+        build.cmp(temp1, temp2);
+        build.b(ConditionA64::NotEqual, labelOp(inst.c)); // cached for a different metatable
+
+        build.ldr(castReg(KindA64::w, temp1), mem(rGlobalState, offsetof(global_State, udatacacheepoch)));
+        build.ldr(castReg(KindA64::w, temp2), mem(inst.regA64, offsetof(UdataCache, epoch)));
+        build.cmp(castReg(KindA64::w, temp1), castReg(KindA64::w, temp2));
+        build.b(ConditionA64::NotEqual, labelOp(inst.c)); // not filled or invalidated
+
+        if (inst.d.kind == IrOpKind::VmConst)
+        {
+            emitAddOffset(build, temp1, rConstants, vmConstOp(inst.d) * sizeof(TValue) + offsetof(TValue, value));
+            build.ldr(temp1, mem(temp1));
+            build.str(temp1, mem(rState, offsetof(lua_State, namecall)));
+        }
+
+        build.add(inst.regA64, inst.regA64, uint16_t(offsetof(UdataCache, value)));
+        break;
+    }
     case IrCmd::NEW_USERDATA:
     {
         regs.spill(build, index);
@@ -1145,6 +1258,32 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         inst.regA64 = regs.takeReg(x0, index);
         break;
     }
+    case IrCmd::STRBUF_APPEND:
+    {
+        // note: we need to call regOp before spill so that we don't do redundant reloads
+        RegisterA64 udata = regOp(inst.a);
+        RegisterA64 str = regOp(inst.b);
+        RegisterA64 temp = regs.allocTemp(KindA64::x);
+
+        regs.spill(build, index, {udata, str});
+
+        if (x1 != str)
+        {
+            build.mov(x1, udata);
+            build.mov(x2, str);
+        }
+        else
+        {
+            build.mov(temp, x1);
+            build.mov(x1, udata);
+            build.mov(x2, temp);
+        }
+
+        build.mov(x0, rState);
+        build.ldr(x3, mem(rNativeContext, offsetof(NativeContext, strbufAppend)));
+        build.blr(x3);
+        break;
+    }
     case IrCmd::INT_TO_NUM:
     {
         inst.regA64 = regs.allocReg(KindA64::d, index);
@@ -1675,8 +1814,16 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.cmp(temp2, LUA_TSTRING);
         build.b(ConditionA64::NotEqual, mismatch);
 
-        AddressA64 addr = tempAddr(inst.b, offsetof(TValue, value));
-        build.ldr(temp2, addr);
+        if (inst.b.kind == IrOpKind::Constant)
+        {
+            build.adr(temp2, uint64_t(uintptr_t(pointerOp(inst.b))));
+            build.ldr(temp2, temp2);
+        }
+        else
+        {
+            AddressA64 addr = tempAddr(inst.b, offsetof(TValue, value));
+            build.ldr(temp2, addr);
+        }
         build.cmp(temp1, temp2);
         build.b(ConditionA64::NotEqual, mismatch);
 
@@ -1712,6 +1859,27 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         finalizeTargetLabel(inst.b, fresh);
         break;
     }
+    case IrCmd::CHECK_CLOSURE_PROTO:
+    {
+        Label fresh; // used when guard aborts execution or jumps to a VM exit
+        Label& fail = getTargetLabel(inst.c, fresh);
+
+        RegisterA64 temp1 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::x);
+
+        // C functions store the function pointer in the same location, which can't match the address of a prototype
+        build.ldr(temp1, mem(regOp(inst.a), offsetof(Closure, l.p)));
+        build.adr(temp2, uint64_t(uintptr_t(pointerOp(inst.b))));
+        build.ldr(temp2, temp2);
+        build.cmp(temp1, temp2);
+        build.b(ConditionA64::NotEqual, fail);
+
+        build.ldr(temp2, mem(temp1, offsetof(Proto, debuginsn)));
+        build.cbnz(temp2, fail);
+
+        finalizeTargetLabel(inst.c, fresh);
+        break;
+    }
     case IrCmd::CHECK_BUFFER_LEN:
     {
         int accessSize = intOp(inst.c);
@@ -1791,7 +1959,7 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
 
         Label next = build.setLabel();
 
-        interruptHandlers.push_back({self, uintOp(inst.a), next});
+        interruptHandlers.push_back({self, uintOp(inst.a), next, inst.b});
         break;
     }
     case IrCmd::CHECK_GC:
@@ -2077,6 +2245,16 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.str(temp2, mem(rCode, temp1));
         break;
     }
+    case IrCmd::INC_EXEC_COUNTER:
+    {
+        CODEGEN_ASSERT(function.executionCounters);
+
+        RegisterA64 temp1 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::x);
+
+        emitIncExecCounter(build, temp1, temp2, function.executionCounters + uintOp(inst.a));
+        break;
+    }
 
         // Full instruction fallbacks
     case IrCmd::FALLBACK_GETGLOBAL:
@@ -2520,6 +2698,12 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         break;
     }
 
+    case IrCmd::MULADD_NUM:
+    case IrCmd::MULADD_VEC:
+        // Fused instructions are only created for x64
+        error = true;
+        break;
+
         // To handle unsupported instructions, add "case IrCmd::OP" and make sure to set error = true!
     }
 
@@ -2540,6 +2724,10 @@ void IrLoweringA64::finishBlock(const IrBlock& curr, const IrBlock& next)
         // And the next block cannot be a join block in cfg
         CODEGEN_ASSERT(next.useCount == 1);
     }
+
+    // Values stored in spill slots can only be found there if the next block is entered from the end of the current one
+    if (!regs.spillHomes.empty() && !isBlockContinuation(function, curr, next))
+        regs.releaseSpillHomes();
 }
 
 void IrLoweringA64::finishFunction()
@@ -2551,7 +2739,7 @@ void IrLoweringA64::finishFunction()
     {
         build.setLabel(handler.self);
         build.mov(x0, (handler.pcpos + 1) * sizeof(Instruction));
-        build.adr(x1, handler.next);
+        build.adr(x1, handler.resume.kind == IrOpKind::Block ? labelOp(handler.resume) : handler.next);
         build.b(helpers.interrupt);
     }
 
@@ -2564,6 +2752,9 @@ void IrLoweringA64::finishFunction()
 
         build.setLabel(handler.self);
 
+        if (function.executionCounters)
+            emitIncExecCounter(build, x0, x1, function.executionCounters + NativeExecCounter_Exit + handler.pcpos);
+
         build.mov(x0, handler.pcpos * sizeof(Instruction));
         build.b(helpers.updatePcAndContinueInVm);
     }
@@ -2744,8 +2935,8 @@ AddressA64 IrLoweringA64::tempAddr(IrOp op, int offset)
 
 AddressA64 IrLoweringA64::tempAddrBuffer(IrOp bufferOp, IrOp indexOp, uint8_t tag)
 {
-    CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER);
-    int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : offsetof(Udata, data);
+    CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER || tag == LUA_TSTRING);
+    int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : tag == LUA_TSTRING ? offsetof(TString, data) : offsetof(Udata, data);
 
     if (indexOp.kind == IrOpKind::Inst)
     {
@@ -2811,6 +3002,11 @@ unsigned IrLoweringA64::importOp(IrOp op) const
     return function.importOp(op);
 }
 
+const void* IrLoweringA64::pointerOp(IrOp op) const
+{
+    return function.pointerOp(op);
+}
+
 double IrLoweringA64::doubleOp(IrOp op) const
 {
     return function.doubleOp(op);
@@ -55,6 +55,7 @@ struct IrLoweringA64
     int intOp(IrOp op) const;
     unsigned uintOp(IrOp op) const;
     unsigned importOp(IrOp op) const;
+    const void* pointerOp(IrOp op) const;
     double doubleOp(IrOp op) const;
 
     IrBlock& blockOp(IrOp op) const;
@@ -65,6 +66,7 @@ struct IrLoweringA64
         Label self;
         unsigned int pcpos;
         Label next;
+        IrOp resume;
     };
 
     struct ExitHandler
@@ -5,6 +5,7 @@
 #include "Luau/IrData.h"
 #include "Luau/IrUtils.h"
 #include "Luau/LoweringStats.h"
+#include "Luau/NativeProtoExecData.h"
 
 #include "Luau/IrCallWrapperX64.h"
 
@@ -108,6 +109,8 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
             build.vmovsd(inst.regX64, luauRegValue(vmRegOp(inst.a)));
         else if (inst.a.kind == IrOpKind::VmConst)
             build.vmovsd(inst.regX64, luauConstantValue(vmConstOp(inst.a)));
+        else if (inst.a.kind == IrOpKind::Inst)
+            build.vmovsd(inst.regX64, qword[regOp(inst.a) + offsetof(TValue, value)]);
         else
             CODEGEN_ASSERT(!"Unsupported instruction form");
         break;
@@ -393,7 +396,14 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     case IrCmd::SUB_INT:
         inst.regX64 = regs.allocRegOrReuse(SizeX64::dword, index, {inst.a});
 
-        if (inst.regX64 == regOp(inst.a) && intOp(inst.b) == 1)
+        if (inst.b.kind == IrOpKind::Inst)
+        {
+            if (inst.regX64 != regOp(inst.a))
+                build.mov(inst.regX64, regOp(inst.a));
+
+            build.sub(inst.regX64, regOp(inst.b));
+        }
+        else if (inst.regX64 == regOp(inst.a) && intOp(inst.b) == 1)
             build.dec(inst.regX64);
         else if (inst.regX64 == regOp(inst.a))
             build.sub(inst.regX64, intOp(inst.b));
@@ -547,6 +557,33 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
             build.vmaxsd(inst.regX64, regOp(inst.a), memRegDoubleOp(inst.b));
         }
         break;
+    case IrCmd::MULADD_NUM:
+    {
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.c});
+
+        ScopedRegX64 tmp{regs};
+        RegisterX64 lhs = noreg;
+
+        if (inst.a.kind == IrOpKind::Constant)
+        {
+            tmp.alloc(SizeX64::xmmword);
+            build.vmovsd(tmp.reg, memRegDoubleOp(inst.a));
+            lhs = tmp.reg;
+        }
+        else
+        {
+            lhs = regOp(inst.a);
+        }
+
+        // Addend is accumulated in place
+        if (inst.c.kind != IrOpKind::Inst)
+            build.vmovsd(inst.regX64, memRegDoubleOp(inst.c));
+        else if (regOp(inst.c) != inst.regX64)
+            build.vmovsd(inst.regX64, inst.regX64, regOp(inst.c));
+
+        build.vfmadd231sd(inst.regX64, lhs, memRegDoubleOp(inst.b));
+        break;
+    }
     case IrCmd::UNM_NUM:
     {
         inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
@@ -721,6 +758,24 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.vdivps(inst.regX64, tmpa, tmpb);
         break;
     }
+    case IrCmd::MULADD_VEC:
+    {
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.c});
+
+        ScopedRegX64 tmp1{regs};
+        ScopedRegX64 tmp2{regs};
+        ScopedRegX64 tmp3{regs};
+
+        RegisterX64 tmpa = vecOp(inst.a, tmp1);
+        RegisterX64 tmpb = (inst.a == inst.b) ? tmpa : vecOp(inst.b, tmp2);
+        RegisterX64 tmpc = vecOp(inst.c, tmp3);
+
+        if (tmpc != inst.regX64)
+            build.vmovaps(inst.regX64, tmpc);
+
+        build.vfmadd231ps(inst.regX64, tmpa, tmpb);
+        break;
+    }
     case IrCmd::UNM_VEC:
     {
         inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
@@ -873,7 +928,7 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     {
         IrCondition cond = conditionOp(inst.c);
 
-        if ((cond == IrCondition::Equal || cond == IrCondition::NotEqual) && intOp(inst.b) == 0)
+        if ((cond == IrCondition::Equal || cond == IrCondition::NotEqual) && inst.b.kind == IrOpKind::Constant && intOp(inst.b) == 0)
         {
             bool invert = cond == IrCondition::NotEqual;
 
@@ -892,7 +947,24 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         }
         else
         {
-            build.cmp(regOp(inst.a), intOp(inst.b));
+            ScopedRegX64 tmp{regs};
+            RegisterX64 lhs = noreg;
+
+            if (inst.a.kind == IrOpKind::Constant)
+            {
+                tmp.alloc(SizeX64::dword);
+                build.mov(tmp.reg, intOp(inst.a));
+                lhs = tmp.reg;
+            }
+            else
+            {
+                lhs = regOp(inst.a);
+            }
+
+            if (inst.b.kind == IrOpKind::Constant)
+                build.cmp(lhs, intOp(inst.b));
+            else
+                build.cmp(lhs, regOp(inst.b));
 
             build.jcc(getConditionInt(cond), labelOp(inst.d));
             jumpOrFallthrough(blockOp(inst.e), next);
@@ -970,6 +1042,54 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.mov(inst.regX64, dword[ptr + offsetof(TString, len)]);
         break;
     }
+    case IrCmd::STRING_CHAR:
+    {
+        ScopedRegX64 tmp{regs, SizeX64::qword};
+        build.mov(tmp.reg, qword[rState + offsetof(lua_State, global)]);
+
+        inst.regX64 = regs.allocReg(SizeX64::qword, index);
+
+        if (inst.a.kind == IrOpKind::Inst)
+            build.mov(inst.regX64, qword[tmp.reg + qwordReg(regOp(inst.a)) * sizeof(TString*) + offsetof(global_State, charstr)]);
+        else if (inst.a.kind == IrOpKind::Constant)
+            build.mov(inst.regX64, qword[tmp.reg + int(uint8_t(intOp(inst.a)) * sizeof(TString*) + offsetof(global_State, charstr))]);
+        else
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+
+        build.test(inst.regX64, inst.regX64);
+        build.jcc(ConditionX64::Zero, labelOp(inst.b));
+        break;
+    }
+    case IrCmd::STRING_SUB:
+    {
+        ScopedRegX64 tmp{regs, SizeX64::qword};
+
+        if (inst.b.kind == IrOpKind::Inst)
+            build.lea(tmp.reg, addr[regOp(inst.a) + qwordReg(regOp(inst.b)) + offsetof(TString, data)]);
+        else if (inst.b.kind == IrOpKind::Constant)
+            build.lea(tmp.reg, addr[regOp(inst.a) + intOp(inst.b) + offsetof(TString, data)]);
+        else
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+
+        // Release before the call if it's the last use
+        regs.freeLastUseReg(function.instOp(inst.a), index);
+
+        if (inst.b.kind == IrOpKind::Inst)
+            regs.freeLastUseReg(function.instOp(inst.b), index);
+
+        IrCallWrapperX64 callWrap(regs, build, index);
+        callWrap.addArgument(SizeX64::qword, rState);
+        callWrap.addArgument(SizeX64::qword, tmp);
+
+        if (inst.c.kind == IrOpKind::Inst)
+            callWrap.addArgument(SizeX64::dword, regOp(inst.c), inst.c);
+        else
+            callWrap.addArgument(SizeX64::qword, intOp(inst.c));
+
+        callWrap.call(qword[rNativeContext + offsetof(NativeContext, luaS_newlstr)]);
+        inst.regX64 = regs.takeReg(rax, index);
+        break;
+    }
     case IrCmd::NEW_TABLE:
     {
         IrCallWrapperX64 callWrap(regs, build, index);
@@ -1030,6 +1150,38 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         inst.regX64 = regs.takeReg(rax, index);
         break;
     }
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
+    {
+        ScopedRegX64 tmp{regs, SizeX64::qword};
+
+        build.mov(tmp.reg, sClosure);
+        build.mov(tmp.reg, qword[tmp.reg + offsetof(Closure, l.p)]);
+        build.mov(tmp.reg, qword[tmp.reg + offsetof(Proto, udatacache)]);
+        build.test(tmp.reg, tmp.reg);
+        build.jcc(ConditionX64::Zero, labelOp(inst.c)); // No cache was allocated
+
+        inst.regX64 = regs.allocReg(SizeX64::qword, index);
+
+        build.lea(inst.regX64, addr[tmp.reg + int(uintOp(inst.b) * sizeof(UdataCache))]);
+
+        build.mov(tmp.reg, qword[regOp(inst.a) + offsetof(Udata, metatable)]);
+        build.cmp(tmp.reg, qword[inst.regX64 + offsetof(UdataCache, metatable)]);
+        build.jcc(ConditionX64::NotEqual, labelOp(inst.c)); // Cached for a different metatable
+
+        build.mov(tmp.reg, qword[rState + offsetof(lua_State, global)]);
+        build.mov(dwordReg(tmp.reg), dword[tmp.reg + offsetof(global_State, udatacacheepoch)]);
+        build.cmp(dwordReg(tmp.reg), dword[inst.regX64 + offsetof(UdataCache, epoch)]);
+        build.jcc(ConditionX64::NotEqual, labelOp(inst.c)); // Not filled or invalidated
+
+        if (inst.d.kind == IrOpKind::VmConst)
+        {
+            build.mov(tmp.reg, qword[rConstants + vmConstOp(inst.d) * sizeof(TValue) + offsetof(TValue, value)]);
+            build.mov(qword[rState + offsetof(lua_State, namecall)], tmp.reg);
+        }
+
+        build.add(inst.regX64, offsetof(UdataCache, value));
+        break;
+    }
     case IrCmd::NEW_USERDATA:
     {
         IrCallWrapperX64 callWrap(regs, build, index);
@@ -1040,6 +1192,15 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         inst.regX64 = regs.takeReg(rax, index);
         break;
     }
+    case IrCmd::STRBUF_APPEND:
+    {
+        IrCallWrapperX64 callWrap(regs, build, index);
+        callWrap.addArgument(SizeX64::qword, rState);
+        callWrap.addArgument(SizeX64::qword, regOp(inst.a), inst.a);
+        callWrap.addArgument(SizeX64::qword, regOp(inst.b), inst.b);
+        callWrap.call(qword[rNativeContext + offsetof(NativeContext, strbufAppend)]);
+        break;
+    }
     case IrCmd::INT_TO_NUM:
         inst.regX64 = regs.allocReg(SizeX64::xmmword, index);
 
@@ -1446,7 +1607,10 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.jcc(ConditionX64::NotEqual, mismatch);
 
         // Check that node key value matches the expected one
-        build.mov(tmp.reg, luauConstantValue(vmConstOp(inst.b)));
+        if (inst.b.kind == IrOpKind::Constant)
+            build.mov64(tmp.reg, int64_t(uintptr_t(pointerOp(inst.b))));
+        else
+            build.mov(tmp.reg, luauConstantValue(vmConstOp(inst.b)));
         build.cmp(tmp.reg, luauNodeKeyValue(regOp(inst.a)));
         build.jcc(ConditionX64::NotEqual, mismatch);
 
@@ -1483,6 +1647,21 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         jumpOrAbortOnUndef(ConditionX64::Equal, inst.b, next);
         break;
     }
+    case IrCmd::CHECK_CLOSURE_PROTO:
+    {
+        ScopedRegX64 tmp1{regs, SizeX64::qword};
+        ScopedRegX64 tmp2{regs, SizeX64::qword};
+
+        // C functions store the function pointer in the same location, which can't match the address of a prototype
+        build.mov(tmp1.reg, qword[regOp(inst.a) + offsetof(Closure, l.p)]);
+        build.mov64(tmp2.reg, int64_t(uintptr_t(pointerOp(inst.b))));
+        build.cmp(tmp1.reg, tmp2.reg);
+        jumpOrAbortOnUndef(ConditionX64::NotEqual, inst.c, next);
+
+        build.cmp(qword[tmp1.reg + offsetof(Proto, debuginsn)], 0);
+        jumpOrAbortOnUndef(ConditionX64::NotEqual, inst.c, next);
+        break;
+    }
     case IrCmd::CHECK_BUFFER_LEN:
     {
         int accessSize = intOp(inst.c);
@@ -1566,7 +1745,7 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
 
         Label next = build.setLabel();
 
-        interruptHandlers.push_back({self, pcpos, next});
+        interruptHandlers.push_back({self, pcpos, next, inst.b});
         break;
     }
     case IrCmd::CHECK_GC:
@@ -1717,6 +1896,16 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.mov(dword[tmp1.reg], tmp3.reg);
         break;
     }
+    case IrCmd::INC_EXEC_COUNTER:
+    {
+        CODEGEN_ASSERT(function.executionCounters);
+
+        ScopedRegX64 tmp{regs, SizeX64::qword};
+
+        build.mov64(tmp.reg, int64_t(uintptr_t(function.executionCounters + uintOp(inst.a))));
+        build.inc(qword[tmp.reg]);
+        break;
+    }
 
         // Full instruction fallbacks
     case IrCmd::FALLBACK_GETGLOBAL:
@@ -2200,6 +2389,10 @@ void IrLoweringX64::finishBlock(const IrBlock& curr, const IrBlock& next)
         // And the next block cannot be a join block in cfg
         CODEGEN_ASSERT(next.useCount == 1);
     }
+
+    // Values stored in spill slots can only be found there if the next block is entered from the end of the current one
+    if (!regs.spillHomes.empty() && !isBlockContinuation(function, curr, next))
+        regs.releaseSpillHomes(0);
 }
 
 void IrLoweringX64::finishFunction()
@@ -2211,7 +2404,7 @@ void IrLoweringX64::finishFunction()
     {
         build.setLabel(handler.self);
         build.mov(eax, handler.pcpos + 1);
-        build.lea(rbx, handler.next);
+        build.lea(rbx, handler.resume.kind == IrOpKind::Block ? labelOp(handler.resume) : handler.next);
         build.jmp(helpers.interrupt);
     }
 
@@ -2224,6 +2417,12 @@ void IrLoweringX64::finishFunction()
 
         build.setLabel(handler.self);
 
+        if (function.executionCounters)
+        {
+            build.mov64(rax, int64_t(uintptr_t(function.executionCounters + NativeExecCounter_Exit + handler.pcpos)));
+            build.inc(qword[rax]);
+        }
+
         build.mov(edx, handler.pcpos * sizeof(Instruction));
         build.jmp(helpers.updatePcAndContinueInVm);
     }
@@ -2390,8 +2589,8 @@ RegisterX64 IrLoweringX64::regOp(IrOp op)
 
 OperandX64 IrLoweringX64::bufferAddrOp(IrOp bufferOp, IrOp indexOp, uint8_t tag)
 {
-    CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER);
-    int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : offsetof(Udata, data);
+    CODEGEN_ASSERT(tag == LUA_TUSERDATA || tag == LUA_TBUFFER || tag == LUA_TSTRING);
+    int dataOffset = tag == LUA_TBUFFER ? offsetof(Buffer, data) : tag == LUA_TSTRING ? offsetof(TString, data) : offsetof(Udata, data);
 
     if (indexOp.kind == IrOpKind::Inst)
         return regOp(bufferOp) + qwordReg(regOp(indexOp)) + dataOffset;
@@ -2443,6 +2642,11 @@ unsigned IrLoweringX64::importOp(IrOp op) const
     return function.importOp(op);
 }
 
+const void* IrLoweringX64::pointerOp(IrOp op) const
+{
+    return function.pointerOp(op);
+}
+
 double IrLoweringX64::doubleOp(IrOp op) const
 {
     return function.doubleOp(op);
@@ -58,6 +58,7 @@ struct IrLoweringX64
     int intOp(IrOp op) const;
     unsigned uintOp(IrOp op) const;
     unsigned importOp(IrOp op) const;
+    const void* pointerOp(IrOp op) const;
     double doubleOp(IrOp op) const;
 
     IrBlock& blockOp(IrOp op) const;
@@ -70,6 +71,7 @@ struct IrLoweringX64
         Label self;
         unsigned int pcpos;
         Label next;
+        IrOp resume;
     };
 
     struct ExitHandler
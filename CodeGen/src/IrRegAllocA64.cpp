@@ -11,6 +11,7 @@
 #include <string.h>
 
 LUAU_FASTFLAGVARIABLE(DebugCodegenChaosA64)
+LUAU_FASTFLAG(DebugCodegenSkipSpillSlotReuse)
 
 namespace Luau
 {
@@ -85,7 +86,14 @@ static AddressA64 getReloadAddress(const IrFunction& function, const IrInst& ins
     return AddressA64(xzr); // dummy
 }
 
-static void restoreInst(AssemblyBuilderA64& build, uint32_t& freeSpillSlots, IrFunction& function, const IrRegAllocA64::Spill& s, RegisterA64 reg)
+static void restoreInst(
+    AssemblyBuilderA64& build,
+    uint32_t& freeSpillSlots,
+    IrFunction& function,
+    const IrRegAllocA64::Spill& s,
+    RegisterA64 reg,
+    bool keepSlot
+)
 {
     IrInst& inst = function.instructions[s.inst];
     CODEGEN_ASSERT(inst.regA64 == noreg);
@@ -94,7 +102,7 @@ static void restoreInst(AssemblyBuilderA64& build, uint32_t& freeSpillSlots, IrF
     {
         build.ldr(reg, mem(sp, sSpillArea.data + s.slot * 8));
 
-        if (s.slot != kInvalidSpill)
+        if (s.slot != kInvalidSpill && !keepSlot)
             freeSpill(freeSpillSlots, reg.kind, s.slot);
     }
     else
@@ -196,6 +204,10 @@ RegisterA64 IrRegAllocA64::allocReuse(KindA64 kind, uint32_t index, std::initial
             set.defs[source.regA64.index] = index;
 
             source.reusedReg = true;
+
+            if (!spillHomes.empty())
+                releaseSpillHome(op.index);
+
             return source.regA64;
         }
     }
@@ -234,6 +246,9 @@ void IrRegAllocA64::freeLastUseReg(IrInst& target, uint32_t index)
     {
         CODEGEN_ASSERT(!target.spilled && !target.needsReload);
 
+        if (!spillHomes.empty())
+            releaseSpillHome(function.getInstIndex(target));
+
         // Register might have already been freed if it had multiple uses inside a single instruction
         if (target.regA64 == noreg)
             return;
@@ -325,6 +340,17 @@ size_t IrRegAllocA64::spill(AssemblyBuilderA64& build, uint32_t index, std::init
             {
                 // instead of spilling the register to never reload it, we assume the register is not needed anymore
             }
+            else if (int home = findSpillHome(inst); home >= 0)
+            {
+                // value was stored earlier and its slot still holds it
+                Spill s = {inst, def.regA64, int8_t(home), /*existing*/ true};
+                spills.push_back(s);
+
+                def.spilled = true;
+
+                if (stats)
+                    stats->spillsToExistingSlot++;
+            }
             else if (getReloadAddress(function, def, /*limitToCurrentBlock*/ true).base != xzr)
             {
                 // instead of spilling the register to stack, we can reload it from VM stack/constants
@@ -340,6 +366,11 @@ size_t IrRegAllocA64::spill(AssemblyBuilderA64& build, uint32_t index, std::init
             else
             {
                 int slot = allocSpill(freeSpillSlots, def.regA64.kind);
+
+                // copies of values in registers are given up before the function runs out of spill slots
+                if (slot < 0 && releaseSpillHomes())
+                    slot = allocSpill(freeSpillSlots, def.regA64.kind);
+
                 if (slot < 0)
                 {
                     slot = kInvalidSpill;
@@ -351,6 +382,9 @@ size_t IrRegAllocA64::spill(AssemblyBuilderA64& build, uint32_t index, std::init
                 Spill s = {inst, def.regA64, int8_t(slot)};
                 spills.push_back(s);
 
+                if (slot != kInvalidSpill && !FFlag::DebugCodegenSkipSpillSlotReuse)
+                    spillHomes.push_back(s);
+
                 def.spilled = true;
 
                 if (stats)
@@ -397,7 +431,12 @@ void IrRegAllocA64::restore(AssemblyBuilderA64& build, size_t start)
             Spill s = spills[i]; // copy in case takeReg reallocates spills
             RegisterA64 reg = takeReg(s.origin, s.inst);
 
-            restoreInst(build, freeSpillSlots, function, s, reg);
+            bool home = s.slot >= 0 && findSpillHome(s.inst) == s.slot;
+            restoreInst(build, freeSpillSlots, function, s, reg, /*keepSlot*/ home);
+
+            // value was only stored on one of the paths
+            if (home && !s.existing)
+                releaseSpillHome(s.inst);
         }
 
         spills.resize(start);
@@ -415,7 +454,8 @@ void IrRegAllocA64::restoreReg(AssemblyBuilderA64& build, IrInst& inst)
             Spill s = spills[i]; // copy in case allocReg reallocates spills
             RegisterA64 reg = allocReg(s.origin.kind, index);
 
-            restoreInst(build, freeSpillSlots, function, s, reg);
+            // slot remains reserved while it holds a copy of the value
+            restoreInst(build, freeSpillSlots, function, s, reg, /*keepSlot*/ s.slot >= 0 && findSpillHome(index) == s.slot);
 
             spills[i] = spills.back();
             spills.pop_back();
@@ -426,6 +466,53 @@ void IrRegAllocA64::restoreReg(AssemblyBuilderA64& build, IrInst& inst)
     CODEGEN_ASSERT(!"Expected to find a spill record");
 }
 
+int IrRegAllocA64::findSpillHome(uint32_t index) const
+{
+    for (const Spill& home : spillHomes)
+    {
+        if (home.inst == index)
+            return home.slot;
+    }
+
+    return -1;
+}
+
+void IrRegAllocA64::releaseSpillHome(uint32_t index)
+{
+    for (size_t i = 0; i < spillHomes.size(); ++i)
+    {
+        if (spillHomes[i].inst == index)
+        {
+            freeSpill(freeSpillSlots, spillHomes[i].origin.kind, spillHomes[i].slot);
+
+            spillHomes[i] = spillHomes.back();
+            spillHomes.pop_back();
+            return;
+        }
+    }
+}
+
+bool IrRegAllocA64::releaseSpillHomes()
+{
+    bool released = false;
+
+    for (size_t i = 0; i < spillHomes.size();)
+    {
+        // slots of values that are currently spilled are still in use
+        if (!function.instructions[spillHomes[i].inst].spilled)
+        {
+            releaseSpillHome(spillHomes[i].inst); // removes the entry, so the loop continues at the same 'i'
+            released = true;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return released;
+}
+
 IrRegAllocA64::Set& IrRegAllocA64::getSet(KindA64 kind)
 {
     switch (kind)
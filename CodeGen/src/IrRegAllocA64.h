@@ -46,6 +46,11 @@ struct IrRegAllocA64
     // Restores register for a single instruction; may not assign the previously used register!
     void restoreReg(AssemblyBuilderA64& build, IrInst& inst);
 
+    // Once stored, a value keeps its spill slot until the end of its live range, so that it doesn't have to be stored again
+    int findSpillHome(uint32_t index) const;
+    void releaseSpillHome(uint32_t index);
+    bool releaseSpillHomes();
+
     struct Set
     {
         // which registers are in the set that the allocator manages (initialized at construction)
@@ -67,6 +72,9 @@ struct IrRegAllocA64
 
         RegisterA64 origin;
         int8_t slot;
+
+        // slot already held the value before the spill
+        bool existing = false;
     };
 
     Set& getSet(KindA64 kind);
@@ -77,6 +85,9 @@ struct IrRegAllocA64
 
     std::vector<Spill> spills;
 
+    // slots that hold a copy of a value which might currently be in a register
+    std::vector<Spill> spillHomes;
+
     // which 8-byte slots are free
     uint32_t freeSpillSlots = 0;
 
@@ -6,6 +6,8 @@
 
 #include "EmitCommonX64.h"
 
+LUAU_FASTFLAG(DebugCodegenSkipSpillSlotReuse)
+
 namespace Luau
 {
 namespace CodeGen
@@ -87,6 +89,9 @@ RegisterX64 IrRegAllocX64::allocRegOrReuse(SizeX64 size, uint32_t instIdx, std::
 
             source.reusedReg = true;
 
+            if (!spillHomes.empty())
+                releaseSpillHome(op.index);
+
             if (size == SizeX64::xmmword)
                 xmmInstUsers[source.regX64.index] = instIdx;
             else
@@ -159,6 +164,9 @@ void IrRegAllocX64::freeLastUseReg(IrInst& target, uint32_t instIdx)
     {
         CODEGEN_ASSERT(!target.spilled && !target.needsReload);
 
+        if (!spillHomes.empty())
+            releaseSpillHome(function.getInstIndex(target));
+
         // Register might have already been freed if it had multiple uses inside a single instruction
         if (target.regX64 == noreg)
             return;
@@ -199,7 +207,16 @@ void IrRegAllocX64::preserve(IrInst& inst)
     spill.originalLoc = inst.regX64;
 
     // Loads from VmReg/VmConst don't have to be spilled, they can be restored from a register later
-    if (!hasRestoreOp(inst))
+    if (!hasRestoreOp(inst) && findSpillHome(spill.instIdx) != kNoStackSlot)
+    {
+        // Value was stored earlier and its slot still holds it
+        spill.stackSlot = findSpillHome(spill.instIdx);
+        inst.spilled = true;
+
+        if (stats)
+            stats->spillsToExistingSlot++;
+    }
+    else if (!hasRestoreOp(inst))
     {
         unsigned i = findSpillStackSlot(spill.valueKind);
 
@@ -230,6 +247,9 @@ void IrRegAllocX64::preserve(IrInst& inst)
         spill.stackSlot = uint8_t(i);
         inst.spilled = true;
 
+        if (!FFlag::DebugCodegenSkipSpillSlotReuse)
+            spillHomes.push_back(spill);
+
         if (stats)
             stats->spillsToSlot++;
     }
@@ -266,10 +286,14 @@ void IrRegAllocX64::restore(IrInst& inst, bool intoOriginalLocation)
                 restoreLocation = addr[sSpillArea + spill.stackSlot * 8];
                 restoreLocation.memSize = reg.size;
 
-                usedSpillSlots.set(spill.stackSlot, false);
+                // Slot remains reserved while it holds a copy of the value
+                if (findSpillHome(instIdx) != spill.stackSlot)
+                {
+                    usedSpillSlots.set(spill.stackSlot, false);
 
-                if (spill.valueKind == IrValueKind::Tvalue)
-                    usedSpillSlots.set(spill.stackSlot + 1, false);
+                    if (spill.valueKind == IrValueKind::Tvalue)
+                        usedSpillSlots.set(spill.stackSlot + 1, false);
+                }
             }
             else
             {
@@ -309,6 +333,60 @@ void IrRegAllocX64::preserveAndFreeInstValues()
     }
 }
 
+uint8_t IrRegAllocX64::findSpillHome(uint32_t instIdx) const
+{
+    for (const IrSpillX64& home : spillHomes)
+    {
+        if (home.instIdx == instIdx)
+            return home.stackSlot;
+    }
+
+    return kNoStackSlot;
+}
+
+void IrRegAllocX64::releaseSpillHome(uint32_t instIdx)
+{
+    for (size_t i = 0; i < spillHomes.size(); i++)
+    {
+        if (spillHomes[i].instIdx == instIdx)
+        {
+            const IrSpillX64& home = spillHomes[i];
+
+            usedSpillSlots.set(home.stackSlot, false);
+
+            if (home.valueKind == IrValueKind::Tvalue)
+                usedSpillSlots.set(home.stackSlot + 1, false);
+
+            spillHomes[i] = spillHomes.back();
+            spillHomes.pop_back();
+            return;
+        }
+    }
+}
+
+bool IrRegAllocX64::releaseSpillHomes(unsigned startSpillId)
+{
+    bool released = false;
+
+    for (size_t i = 0; i < spillHomes.size();)
+    {
+        const IrSpillX64& home = spillHomes[i];
+
+        // Slots of values that are currently spilled are still in use
+        if (home.spillId >= startSpillId && !function.instructions[home.instIdx].spilled)
+        {
+            releaseSpillHome(home.instIdx); // Removes the entry, so loop is repeated at the same 'i'
+            released = true;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return released;
+}
+
 bool IrRegAllocX64::shouldFreeGpr(RegisterX64 reg) const
 {
     if (reg == noreg)
@@ -339,6 +417,10 @@ unsigned IrRegAllocX64::findSpillStackSlot(IrValueKind valueKind)
             continue;
         }
 
+        // Copies of values in registers are given up before the function runs out of spill slots
+        if (i + (valueKind == IrValueKind::Tvalue ? 2 : 1) > kSpillSlots && releaseSpillHomes(0))
+            return findSpillStackSlot(valueKind);
+
         return i;
     }
 
@@ -408,6 +490,15 @@ uint32_t IrRegAllocX64::findInstructionWithFurthestNextUse(const std::array<uint
         if (nextUse == currInstIdx)
             continue;
 
+        // Values that don't have to be stored are cheaper to spill, which is accounted for by treating their next use as further away
+        if (!FFlag::DebugCodegenSkipSpillSlotReuse && nextUse > currInstIdx)
+        {
+            const IrInst& inst = function.instructions[regInstUser];
+
+            if (hasRestoreOp(inst) || findSpillHome(regInstUser) != kNoStackSlot)
+                nextUse += nextUse - currInstIdx;
+        }
+
         if (furthestUseTarget == kInvalidInstIdx || nextUse > furthestUseLocation)
         {
             furthestUseLocation = nextUse;
@@ -522,6 +613,9 @@ ScopedSpills::~ScopedSpills()
             i++;
         }
     }
+
+    // Values were only stored on one of the paths
+    owner.releaseSpillHomes(startSpillId);
 }
 
 } // namespace X64
@@ -5,6 +5,7 @@
 #include "Luau/IrBuilder.h"
 
 #include "lstate.h"
+#include "ludata.h"
 
 #include <math.h>
 
@@ -877,6 +878,182 @@ static BuiltinImplResult translateBuiltinStringLen(IrBuilder& build, int nparams
     return {BuiltinImplType::Full, 1};
 }
 
+// String positions are 1-based; positions that are out of range produce offsets that fail the bounds checks against the string length
+static IrOp builtinLoadStringOffset(IrBuilder& build, IrOp arg, IrOp fallback)
+{
+    if (arg.kind != IrOpKind::Constant)
+        build.loadAndCheckTag(arg, LUA_TNUMBER, fallback);
+
+    IrOp pos = build.inst(IrCmd::NUM_TO_INT, builtinLoadDouble(build, arg));
+    return build.inst(IrCmd::SUB_INT, pos, build.constInt(1));
+}
+
+static BuiltinImplResult translateBuiltinStringByte(
+    IrBuilder& build,
+    int nparams,
+    int ra,
+    int arg,
+    IrOp args,
+    IrOp arg3,
+    int nresults,
+    IrOp fallback
+)
+{
+    // ranges of more than one character produce multiple results, which are left to the generic fastcall
+    if (nparams < 1 || nparams > 3 || (nparams == 3 && args != arg3) || nresults > 1)
+        return {BuiltinImplType::None, -1};
+
+    if (nparams >= 2 && args.kind == IrOpKind::VmConst)
+        return {BuiltinImplType::None, -1};
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TSTRING, fallback);
+
+    IrOp ts = build.inst(IrCmd::LOAD_POINTER, build.vmReg(arg));
+    IrOp len = build.inst(IrCmd::STRING_LEN, ts);
+
+    IrOp offset = nparams >= 2 ? builtinLoadStringOffset(build, args, fallback) : build.constInt(0);
+
+    // Unsigned comparison also rejects negative offsets
+    IrOp inBounds = build.block(IrBlockKind::Internal);
+    build.inst(IrCmd::JUMP_CMP_INT, offset, len, build.cond(IrCondition::UnsignedLess), inBounds, fallback);
+    build.beginBlock(inBounds);
+
+    IrOp ch = build.inst(IrCmd::BUFFER_READU8, ts, offset, build.constTag(LUA_TSTRING));
+
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), build.inst(IrCmd::INT_TO_NUM, ch));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+
+    return {BuiltinImplType::UsesFallback, 1};
+}
+
+static BuiltinImplResult translateBuiltinStringChar(IrBuilder& build, int nparams, int ra, int arg, int nresults, IrOp fallback)
+{
+    // strings of multiple characters have to be allocated, which is left to the generic fastcall
+    if (nparams != 1 || nresults > 1)
+        return {BuiltinImplType::None, -1};
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TNUMBER, fallback);
+
+    IrOp code = build.inst(IrCmd::NUM_TO_INT, build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(arg)));
+
+    IrOp inRange = build.block(IrBlockKind::Internal);
+    build.inst(IrCmd::JUMP_CMP_INT, code, build.constInt(256), build.cond(IrCondition::UnsignedLess), inRange, fallback);
+    build.beginBlock(inRange);
+
+    // The first use of each character creates the string in the fallback, after which it's taken from the cache
+    IrOp str = build.inst(IrCmd::STRING_CHAR, code, fallback);
+
+    build.inst(IrCmd::STORE_POINTER, build.vmReg(ra), str);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TSTRING));
+
+    return {BuiltinImplType::UsesFallback, 1};
+}
+
+static BuiltinImplResult translateBuiltinStringSub(
+    IrBuilder& build,
+    int nparams,
+    int ra,
+    int arg,
+    IrOp args,
+    IrOp arg3,
+    int nresults,
+    IrOp fallback,
+    int pcpos
+)
+{
+    if (nparams < 3 || nresults > 1 || args.kind == IrOpKind::VmConst || arg3.kind == IrOpKind::VmConst)
+        return {BuiltinImplType::None, -1};
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TSTRING, fallback);
+
+    IrOp ts = build.inst(IrCmd::LOAD_POINTER, build.vmReg(arg));
+    IrOp len = build.inst(IrCmd::STRING_LEN, ts);
+
+    IrOp start = builtinLoadStringOffset(build, args, fallback);
+
+    // Unsigned comparison also rejects negative offsets
+    IrOp startInBounds = build.block(IrBlockKind::Internal);
+    build.inst(IrCmd::JUMP_CMP_INT, start, len, build.cond(IrCondition::UnsignedLess), startInBounds, fallback);
+    build.beginBlock(startInBounds);
+
+    // s:sub(i, i) doesn't need to allocate, single-character strings are cached
+    if (args == arg3)
+    {
+        IrOp ch = build.inst(IrCmd::BUFFER_READU8, ts, start, build.constTag(LUA_TSTRING));
+        IrOp str = build.inst(IrCmd::STRING_CHAR, ch, fallback);
+
+        build.inst(IrCmd::STORE_POINTER, build.vmReg(ra), str);
+        build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TSTRING));
+
+        return {BuiltinImplType::UsesFallback, 1};
+    }
+
+    if (arg3.kind != IrOpKind::Constant)
+        build.loadAndCheckTag(arg3, LUA_TNUMBER, fallback);
+
+    IrOp end = build.inst(IrCmd::NUM_TO_INT, builtinLoadDouble(build, arg3));
+
+    // Empty results are left to the fallback
+    IrOp endAfterStart = build.block(IrBlockKind::Internal);
+    build.inst(IrCmd::JUMP_CMP_INT, end, start, build.cond(IrCondition::Greater), endAfterStart, fallback);
+    build.beginBlock(endAfterStart);
+
+    IrOp endInBounds = build.block(IrBlockKind::Internal);
+    build.inst(IrCmd::JUMP_CMP_INT, end, len, build.cond(IrCondition::LessEqual), endInBounds, fallback);
+    build.beginBlock(endInBounds);
+
+    IrOp count = build.inst(IrCmd::SUB_INT, end, start);
+
+    build.inst(IrCmd::SET_SAVEDPC, build.constUint(pcpos));
+    IrOp str = build.inst(IrCmd::STRING_SUB, ts, start, count);
+
+    build.inst(IrCmd::STORE_POINTER, build.vmReg(ra), str);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TSTRING));
+
+    build.inst(IrCmd::CHECK_GC);
+
+    return {BuiltinImplType::UsesFallback, 1};
+}
+
+static BuiltinImplResult translateBuiltinStrbufAppend(
+    IrBuilder& build,
+    int nparams,
+    int ra,
+    int arg,
+    IrOp args,
+    int nresults,
+    IrOp fallback,
+    int pcpos
+)
+{
+    // constant numbers have to be formatted, which is left to the generic fastcall
+    if (nparams != 2 || nresults > 1 || args.kind == IrOpKind::Constant)
+        return {BuiltinImplType::None, -1};
+
+    build.loadAndCheckTag(build.vmReg(arg), LUA_TUSERDATA, fallback);
+
+    IrOp udata = build.inst(IrCmd::LOAD_POINTER, build.vmReg(arg));
+    build.inst(IrCmd::CHECK_USERDATA_TAG, udata, build.constInt(UTAG_STRBUF), fallback);
+
+    // other argument types are handled by the library function in the fallback
+    build.loadAndCheckTag(args, LUA_TSTRING, fallback);
+
+    IrOp ts = build.inst(IrCmd::LOAD_POINTER, args);
+
+    build.inst(IrCmd::SET_SAVEDPC, build.constUint(pcpos));
+    build.inst(IrCmd::STRBUF_APPEND, udata, ts);
+
+    if (nresults != 0)
+    {
+        build.inst(IrCmd::STORE_POINTER, build.vmReg(ra), udata);
+        build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TUSERDATA));
+    }
+
+    build.inst(IrCmd::CHECK_GC);
+
+    return {BuiltinImplType::UsesFallback, 1};
+}
+
 static void translateBufferArgsAndCheckBounds(
     IrBuilder& build,
     int nparams,
@@ -1319,6 +1496,12 @@ BuiltinImplResult translateBuiltin(
         return translateBuiltinTableInsert(build, nparams, ra, arg, args, nresults, pcpos);
     case LBF_STRING_LEN:
         return translateBuiltinStringLen(build, nparams, ra, arg, args, nresults, pcpos);
+    case LBF_STRING_BYTE:
+        return translateBuiltinStringByte(build, nparams, ra, arg, args, arg3, nresults, fallback);
+    case LBF_STRING_CHAR:
+        return translateBuiltinStringChar(build, nparams, ra, arg, nresults, fallback);
+    case LBF_STRING_SUB:
+        return translateBuiltinStringSub(build, nparams, ra, arg, args, arg3, nresults, fallback, pcpos);
     case LBF_BIT32_BYTESWAP:
         return translateBuiltinBit32Unary(build, IrCmd::BYTESWAP_UINT, nparams, ra, arg, args, nresults, pcpos);
     case LBF_BUFFER_READI8:
@@ -1373,6 +1556,8 @@ BuiltinImplResult translateBuiltin(
         return translateBuiltinVectorLerp(build, nparams, ra, arg, args, arg3, nresults, pcpos);
     case LBF_MATH_LERP:
         return translateBuiltinMathLerp(build, nparams, ra, arg, args, arg3, nresults, fallback, pcpos);
+    case LBF_STRBUF_APPEND:
+        return translateBuiltinStrbufAppend(build, nparams, ra, arg, args, nresults, fallback, pcpos);
     default:
         return {BuiltinImplType::None, -1};
     }
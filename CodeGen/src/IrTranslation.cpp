@@ -13,6 +13,8 @@
 #include "ltm.h"
 
 LUAU_FASTFLAGVARIABLE(LuauCodeGenSimplifyImport2)
+LUAU_FASTINTVARIABLE(LuauCodeGenInlineInstructionLimit, 16) // bytecode instructions in a function that can be inlined into its callers
+LUAU_FASTINTVARIABLE(LuauCodeGenInlineCallLimit, 32)        // calls that can be inlined into a single function
 
 namespace Luau
 {
@@ -138,6 +140,20 @@ void translateInstMove(IrBuilder& build, const Instruction* pc)
     build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), load);
 }
 
+void translateInstMove2(IrBuilder& build, const Instruction* pc)
+{
+    int ra = LUAU_INSN_A(*pc);
+    int rb = LUAU_INSN_B(*pc);
+    int rc = pc[1] & 0xff;
+    int rd = (pc[1] >> 8) & 0xff;
+
+    IrOp load1 = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(rb));
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), load1);
+
+    IrOp load2 = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(rd));
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(rc), load2);
+}
+
 void translateInstJump(IrBuilder& build, const Instruction* pc, int pcpos)
 {
     build.inst(IrCmd::JUMP, build.blockAtInst(pcpos + 1 + LUAU_INSN_D(*pc)));
@@ -664,6 +680,18 @@ void translateInstLength(IrBuilder& build, const Instruction* pc, int pcpos)
         return;
     }
 
+    if (bcTypes.a == LBC_TYPE_STRING)
+    {
+        build.loadAndCheckTag(build.vmReg(rb), LUA_TSTRING, build.vmExit(pcpos));
+
+        IrOp ts = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
+        IrOp len = build.inst(IrCmd::STRING_LEN, ts);
+
+        build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), build.inst(IrCmd::INT_TO_NUM, len));
+        build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+        return;
+    }
+
     IrOp fallback = build.block(IrBlockKind::Fallback);
 
     IrOp tb = build.inst(IrCmd::LOAD_TAG, build.vmReg(rb));
@@ -1307,7 +1335,22 @@ void translateInstGetTableKS(IrBuilder& build, const Instruction* pc, int pcpos)
                 return;
         }
 
+        // Fields of userdata resolved through the metatable are read from the inline cache that is filled by the fallback
+        IrOp fallback = build.block(IrBlockKind::Fallback);
+
+        IrOp udata = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
+        IrOp addrCacheEl = build.inst(IrCmd::GET_USERDATA_CACHE_ADDR, udata, build.constUint(pcpos), fallback, build.undef());
+
+        IrOp tvc = build.inst(IrCmd::LOAD_TVALUE, addrCacheEl);
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), tvc);
+
+        build.function.userdataCacheSiteCount++;
+
+        IrOp next = build.blockAtInst(pcpos + 2);
+        FallbackStreamScope scope(build, fallback, next);
+
         build.inst(IrCmd::FALLBACK_GETTABLEKS, build.constUint(pcpos), build.vmReg(ra), build.vmReg(rb), build.vmConst(aux));
+        build.inst(IrCmd::JUMP, next);
         return;
     }
 
@@ -1507,7 +1550,27 @@ bool translateInstNamecall(IrBuilder& build, const Instruction* pc, int pcpos)
                 return true;
         }
 
+        // Methods and __namecall handlers of userdata are read from the inline cache that is filled by the fallback
+        IrOp next = build.blockAtInst(pcpos + getOpLength(LuauOpcode(LOP_NAMECALL)));
+        IrOp fallback = build.block(IrBlockKind::Fallback);
+
+        IrOp udata = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
+        IrOp addrCacheEl = build.inst(IrCmd::GET_USERDATA_CACHE_ADDR, udata, build.constUint(pcpos), fallback, build.vmConst(aux));
+
+        IrOp self = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(rb));
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra + 1), self);
+
+        IrOp method = build.inst(IrCmd::LOAD_TVALUE, addrCacheEl);
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), method);
+        build.inst(IrCmd::JUMP, next);
+
+        build.function.userdataCacheSiteCount++;
+
+        build.beginBlock(fallback);
         build.inst(IrCmd::FALLBACK_NAMECALL, build.constUint(pcpos), build.vmReg(ra), build.vmReg(rb), build.vmConst(aux));
+        build.inst(IrCmd::JUMP, next);
+
+        build.beginBlock(next);
         return false;
     }
 
@@ -1688,5 +1751,316 @@ void translateInstNewClosure(IrBuilder& build, const Instruction* pc, int pcpos)
     build.inst(IrCmd::CHECK_GC);
 }
 
+enum class InlineValueKind
+{
+    None,
+    Nil,
+    Boolean,
+    Number,
+    Argument, // caller register that holds the argument
+    Node,     // value of a table node
+};
+
+struct InlineValue
+{
+    InlineValueKind kind = InlineValueKind::None;
+    int index = 0; // caller register of the argument or the boolean value
+    IrOp op;       // double number or node pointer
+};
+
+static bool isInlineNumberOperand(const InlineValue& value)
+{
+    return value.kind == InlineValueKind::Number || value.kind == InlineValueKind::Argument || value.kind == InlineValueKind::Node;
+}
+
+static IrOp loadInlineNumberOperand(IrBuilder& build, const InlineValue& value, IrOp fallback)
+{
+    if (value.kind == InlineValueKind::Number)
+        return value.op;
+
+    IrOp location = value.kind == InlineValueKind::Argument ? build.vmReg(uint8_t(value.index)) : value.op;
+
+    build.loadAndCheckTag(location, LUA_TNUMBER, fallback);
+    return build.inst(IrCmd::LOAD_DOUBLE, location);
+}
+
+static IrCmd getInlineArithCmd(LuauOpcode op)
+{
+    switch (op)
+    {
+    case LOP_ADD:
+    case LOP_ADDK:
+        return IrCmd::ADD_NUM;
+    case LOP_SUB:
+    case LOP_SUBK:
+    case LOP_SUBRK:
+        return IrCmd::SUB_NUM;
+    case LOP_MUL:
+    case LOP_MULK:
+        return IrCmd::MUL_NUM;
+    case LOP_DIV:
+    case LOP_DIVK:
+    case LOP_DIVRK:
+        return IrCmd::DIV_NUM;
+    case LOP_IDIV:
+    case LOP_IDIVK:
+        return IrCmd::IDIV_NUM;
+    case LOP_MOD:
+    case LOP_MODK:
+        return IrCmd::MOD_NUM;
+    default:
+        return IrCmd::NOP;
+    }
+}
+
+// Inlined functions are straight-line code without calls or stores, which only computes numbers from its arguments and reads fields of the
+// tables it was given; since it can't change the state of the VM, the call can be performed from the same arguments when a guard fails.
+// Without a builder, this only checks that the function can be inlined with the specified number of arguments
+static bool translateInlinedBody(IrBuilder* build, const Proto* callee, int argbase, int nparams, IrOp fallback, InlineValue& result)
+{
+    std::vector<InlineValue> regs(callee->maxstacksize);
+
+    for (int r = 0; r < callee->numparams; ++r)
+        regs[r] = r < nparams ? InlineValue{InlineValueKind::Argument, argbase + r} : InlineValue{InlineValueKind::Nil};
+
+    auto constantNumber = [&](int k, InlineValue& value)
+    {
+        if (!ttisnumber(&callee->k[k]))
+            return false;
+
+        value = {InlineValueKind::Number, 0, build ? build->constDouble(nvalue(&callee->k[k])) : IrOp{}};
+        return true;
+    };
+
+    for (int pcpos = 0; pcpos < callee->sizecode;)
+    {
+        const Instruction* pc = &callee->code[pcpos];
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(*pc));
+        int ra = LUAU_INSN_A(*pc);
+
+        switch (op)
+        {
+        case LOP_LOADNIL:
+            regs[ra] = {InlineValueKind::Nil};
+            break;
+        case LOP_LOADB:
+            if (LUAU_INSN_C(*pc) != 0)
+                return false;
+
+            regs[ra] = {InlineValueKind::Boolean, int(LUAU_INSN_B(*pc))};
+            break;
+        case LOP_LOADN:
+            regs[ra] = {InlineValueKind::Number, 0, build ? build->constDouble(double(LUAU_INSN_D(*pc))) : IrOp{}};
+            break;
+        case LOP_LOADK:
+            if (!constantNumber(LUAU_INSN_D(*pc), regs[ra]))
+                return false;
+            break;
+        case LOP_MOVE:
+            if (regs[LUAU_INSN_B(*pc)].kind == InlineValueKind::None)
+                return false;
+
+            regs[ra] = regs[LUAU_INSN_B(*pc)];
+            break;
+        case LOP_MOVE2:
+            if (regs[LUAU_INSN_B(*pc)].kind == InlineValueKind::None)
+                return false;
+
+            regs[ra] = regs[LUAU_INSN_B(*pc)];
+
+            if (regs[(pc[1] >> 8) & 0xff].kind == InlineValueKind::None)
+                return false;
+
+            regs[pc[1] & 0xff] = regs[(pc[1] >> 8) & 0xff];
+            break;
+        case LOP_ADD:
+        case LOP_SUB:
+        case LOP_MUL:
+        case LOP_DIV:
+        case LOP_IDIV:
+        case LOP_MOD:
+        case LOP_ADDK:
+        case LOP_SUBK:
+        case LOP_MULK:
+        case LOP_DIVK:
+        case LOP_IDIVK:
+        case LOP_MODK:
+        case LOP_SUBRK:
+        case LOP_DIVRK:
+        {
+            InlineValue lhs;
+            InlineValue rhs;
+
+            if (op == LOP_SUBRK || op == LOP_DIVRK)
+            {
+                if (!constantNumber(LUAU_INSN_B(*pc), lhs))
+                    return false;
+
+                rhs = regs[LUAU_INSN_C(*pc)];
+            }
+            else if (op == LOP_ADD || op == LOP_SUB || op == LOP_MUL || op == LOP_DIV || op == LOP_IDIV || op == LOP_MOD)
+            {
+                lhs = regs[LUAU_INSN_B(*pc)];
+                rhs = regs[LUAU_INSN_C(*pc)];
+            }
+            else
+            {
+                lhs = regs[LUAU_INSN_B(*pc)];
+
+                if (!constantNumber(LUAU_INSN_C(*pc), rhs))
+                    return false;
+            }
+
+            if (!isInlineNumberOperand(lhs) || !isInlineNumberOperand(rhs))
+                return false;
+
+            IrOp value;
+
+            if (build)
+            {
+                IrOp vb = loadInlineNumberOperand(*build, lhs, fallback);
+                IrOp vc = loadInlineNumberOperand(*build, rhs, fallback);
+
+                value = build->inst(getInlineArithCmd(op), vb, vc);
+            }
+
+            regs[ra] = {InlineValueKind::Number, 0, value};
+            break;
+        }
+        case LOP_MINUS:
+        {
+            const InlineValue& source = regs[LUAU_INSN_B(*pc)];
+
+            if (!isInlineNumberOperand(source))
+                return false;
+
+            IrOp value;
+
+            if (build)
+                value = build->inst(IrCmd::UNM_NUM, loadInlineNumberOperand(*build, source, fallback));
+
+            regs[ra] = {InlineValueKind::Number, 0, value};
+            break;
+        }
+        case LOP_GETTABLEKS:
+        {
+            const InlineValue& source = regs[LUAU_INSN_B(*pc)];
+
+            if (source.kind != InlineValueKind::Argument)
+                return false;
+
+            IrOp node;
+
+            if (build)
+            {
+                TString* key = tsvalue(&callee->k[pc[1]]);
+
+                // The field has to be in the main position of its key; other lookups are left to the call
+                build->loadAndCheckTag(build->vmReg(uint8_t(source.index)), LUA_TTABLE, fallback);
+                IrOp table = build->inst(IrCmd::LOAD_POINTER, build->vmReg(uint8_t(source.index)));
+
+                node = build->inst(IrCmd::GET_HASH_NODE_ADDR, table, build->constUint(key->hash));
+                build->inst(IrCmd::CHECK_SLOT_MATCH, node, build->constPointer(key), fallback);
+            }
+
+            regs[ra] = {InlineValueKind::Node, 0, node};
+            break;
+        }
+        case LOP_RETURN:
+        {
+            int count = LUAU_INSN_B(*pc) - 1;
+
+            if (count == 0)
+                result = {InlineValueKind::Nil};
+            else if (count == 1 && regs[ra].kind != InlineValueKind::None)
+                result = regs[ra];
+            else
+                return false;
+
+            return true;
+        }
+        default:
+            return false;
+        }
+
+        pcpos += getOpLength(op);
+    }
+
+    return false;
+}
+
+bool isInlineCallCandidate(const Proto* callee)
+{
+    if (callee->is_vararg || callee->sizep != 0 || callee->debuginsn || callee->sizecode > FInt::LuauCodeGenInlineInstructionLimit)
+        return false;
+
+    InlineValue result;
+    return translateInlinedBody(nullptr, callee, 0, callee->numparams, IrOp{}, result);
+}
+
+bool translateInlinedCall(IrBuilder& build, const Instruction* pc, int pcpos, Proto* callee)
+{
+    int ra = LUAU_INSN_A(*pc);
+    int nparams = LUAU_INSN_B(*pc) - 1;
+    int nresults = LUAU_INSN_C(*pc) - 1;
+
+    if (nparams < 0 || nresults < 0 || nresults > 1 || build.function.inlinedCalls.size() >= size_t(FInt::LuauCodeGenInlineCallLimit))
+        return false;
+
+    InlineValue result;
+
+    if (!isInlineCallCandidate(callee) || !translateInlinedBody(nullptr, callee, ra + 1, nparams, IrOp{}, result))
+        return false;
+
+    IrOp next = build.blockAtInst(pcpos + 1);
+    IrOp fallback = build.block(IrBlockKind::Fallback);
+
+    // Callee was observed when the caller got compiled, so the call is only replaced for the same function prototype
+    build.loadAndCheckTag(build.vmReg(ra), LUA_TFUNCTION, fallback);
+    IrOp closure = build.inst(IrCmd::LOAD_POINTER, build.vmReg(ra));
+    build.inst(IrCmd::CHECK_CLOSURE_PROTO, closure, build.constPointer(callee), fallback);
+
+    bool translated = translateInlinedBody(&build, callee, ra + 1, nparams, fallback, result);
+    CODEGEN_ASSERT(translated);
+
+    if (nresults == 1)
+    {
+        switch (result.kind)
+        {
+        case InlineValueKind::Nil:
+            build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNIL));
+            break;
+        case InlineValueKind::Boolean:
+            build.inst(IrCmd::STORE_INT, build.vmReg(ra), build.constInt(result.index));
+            build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TBOOLEAN));
+            break;
+        case InlineValueKind::Number:
+            build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), result.op);
+            build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+            break;
+        case InlineValueKind::Argument:
+            build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), build.inst(IrCmd::LOAD_TVALUE, build.vmReg(uint8_t(result.index))));
+            break;
+        case InlineValueKind::Node:
+            build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), build.inst(IrCmd::LOAD_TVALUE, result.op, build.constInt(offsetof(LuaNode, val))));
+            break;
+        case InlineValueKind::None:
+            CODEGEN_ASSERT(!"Unexpected inlined call result");
+            break;
+        }
+    }
+
+    build.function.inlinedCalls.push_back(callee);
+
+    FallbackStreamScope scope(build, fallback, next);
+
+    build.inst(IrCmd::INTERRUPT, build.constUint(pcpos));
+    build.inst(IrCmd::SET_SAVEDPC, build.constUint(pcpos + 1));
+    build.inst(IrCmd::CALL, build.vmReg(ra), build.constInt(nparams), build.constInt(nresults));
+    build.inst(IrCmd::JUMP, next);
+
+    return true;
+}
+
 } // namespace CodeGen
 } // namespace Luau
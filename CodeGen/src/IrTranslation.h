@@ -6,6 +6,7 @@
 #include "ltm.h"
 
 typedef uint32_t Instruction;
+struct Proto;
 
 namespace Luau
 {
@@ -23,6 +24,7 @@ void translateInstLoadN(IrBuilder& build, const Instruction* pc);
 void translateInstLoadK(IrBuilder& build, const Instruction* pc);
 void translateInstLoadKX(IrBuilder& build, const Instruction* pc);
 void translateInstMove(IrBuilder& build, const Instruction* pc);
+void translateInstMove2(IrBuilder& build, const Instruction* pc);
 void translateInstJump(IrBuilder& build, const Instruction* pc, int pcpos);
 void translateInstJumpBack(IrBuilder& build, const Instruction* pc, int pcpos);
 void translateInstJumpIf(IrBuilder& build, const Instruction* pc, int pcpos, bool not_);
@@ -74,6 +76,9 @@ void translateInstAndX(IrBuilder& build, const Instruction* pc, int pcpos, IrOp
 void translateInstOrX(IrBuilder& build, const Instruction* pc, int pcpos, IrOp c);
 void translateInstNewClosure(IrBuilder& build, const Instruction* pc, int pcpos);
 
+bool isInlineCallCandidate(const Proto* callee);
+bool translateInlinedCall(IrBuilder& build, const Instruction* pc, int pcpos, Proto* callee);
+
 void beforeInstForNPrep(IrBuilder& build, const Instruction* pc, int pcpos);
 void afterInstForNLoop(IrBuilder& build, const Instruction* pc);
 
@@ -50,6 +50,7 @@ int getOpLength(LuauOpcode op)
     case LOP_JUMPXEQKB:
     case LOP_JUMPXEQKN:
     case LOP_JUMPXEQKS:
+    case LOP_MOVE2:
         return 2;
 
     default:
@@ -176,6 +177,7 @@ IrValueKind getCmdValueKind(IrCmd cmd)
     case IrCmd::MOD_NUM:
     case IrCmd::MIN_NUM:
     case IrCmd::MAX_NUM:
+    case IrCmd::MULADD_NUM:
     case IrCmd::UNM_NUM:
     case IrCmd::FLOOR_NUM:
     case IrCmd::CEIL_NUM:
@@ -189,6 +191,7 @@ IrValueKind getCmdValueKind(IrCmd cmd)
     case IrCmd::SUB_VEC:
     case IrCmd::MUL_VEC:
     case IrCmd::DIV_VEC:
+    case IrCmd::MULADD_VEC:
     case IrCmd::UNM_VEC:
     case IrCmd::SELECT_VEC:
         return IrValueKind::Tvalue;
@@ -214,14 +217,20 @@ IrValueKind getCmdValueKind(IrCmd cmd)
         return IrValueKind::Pointer;
     case IrCmd::STRING_LEN:
         return IrValueKind::Int;
+    case IrCmd::STRING_CHAR:
+    case IrCmd::STRING_SUB:
+        return IrValueKind::Pointer;
     case IrCmd::NEW_TABLE:
     case IrCmd::DUP_TABLE:
         return IrValueKind::Pointer;
     case IrCmd::TRY_NUM_TO_INDEX:
         return IrValueKind::Int;
     case IrCmd::TRY_CALL_FASTGETTM:
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
     case IrCmd::NEW_USERDATA:
         return IrValueKind::Pointer;
+    case IrCmd::STRBUF_APPEND:
+        return IrValueKind::None;
     case IrCmd::INT_TO_NUM:
     case IrCmd::UINT_TO_NUM:
         return IrValueKind::Double;
@@ -257,6 +266,7 @@ IrValueKind getCmdValueKind(IrCmd cmd)
     case IrCmd::CHECK_SLOT_MATCH:
     case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::CHECK_CLOSURE_PROTO:
     case IrCmd::CHECK_BUFFER_LEN:
     case IrCmd::CHECK_USERDATA_TAG:
     case IrCmd::INTERRUPT:
@@ -274,6 +284,7 @@ IrValueKind getCmdValueKind(IrCmd cmd)
     case IrCmd::FORGLOOP_FALLBACK:
     case IrCmd::FORGPREP_XNEXT_FALLBACK:
     case IrCmd::COVERAGE:
+    case IrCmd::INC_EXEC_COUNTER:
     case IrCmd::FALLBACK_GETGLOBAL:
     case IrCmd::FALLBACK_SETGLOBAL:
     case IrCmd::FALLBACK_GETTABLEKS:
@@ -376,6 +387,135 @@ bool isGCO(uint8_t tag)
     return tag >= LUA_TSTRING;
 }
 
+bool isTableStateNeutral(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::NOP:
+    case IrCmd::LOAD_TAG:
+    case IrCmd::LOAD_POINTER:
+    case IrCmd::LOAD_DOUBLE:
+    case IrCmd::LOAD_INT:
+    case IrCmd::LOAD_FLOAT:
+    case IrCmd::LOAD_TVALUE:
+    case IrCmd::LOAD_ENV:
+    case IrCmd::GET_ARR_ADDR:
+    case IrCmd::GET_SLOT_NODE_ADDR:
+    case IrCmd::GET_HASH_NODE_ADDR:
+    case IrCmd::GET_CLOSURE_UPVAL_ADDR:
+    case IrCmd::STORE_TAG:
+    case IrCmd::STORE_EXTRA:
+    case IrCmd::STORE_POINTER:
+    case IrCmd::STORE_DOUBLE:
+    case IrCmd::STORE_INT:
+    case IrCmd::STORE_VECTOR:
+    case IrCmd::STORE_TVALUE:
+    case IrCmd::STORE_SPLIT_TVALUE:
+    case IrCmd::ADD_INT:
+    case IrCmd::SUB_INT:
+    case IrCmd::ADD_NUM:
+    case IrCmd::SUB_NUM:
+    case IrCmd::MUL_NUM:
+    case IrCmd::DIV_NUM:
+    case IrCmd::IDIV_NUM:
+    case IrCmd::MOD_NUM:
+    case IrCmd::MIN_NUM:
+    case IrCmd::MAX_NUM:
+    case IrCmd::MULADD_NUM:
+    case IrCmd::UNM_NUM:
+    case IrCmd::FLOOR_NUM:
+    case IrCmd::CEIL_NUM:
+    case IrCmd::ROUND_NUM:
+    case IrCmd::SQRT_NUM:
+    case IrCmd::ABS_NUM:
+    case IrCmd::SIGN_NUM:
+    case IrCmd::SELECT_NUM:
+    case IrCmd::SELECT_VEC:
+    case IrCmd::ADD_VEC:
+    case IrCmd::SUB_VEC:
+    case IrCmd::MUL_VEC:
+    case IrCmd::DIV_VEC:
+    case IrCmd::MULADD_VEC:
+    case IrCmd::UNM_VEC:
+    case IrCmd::DOT_VEC:
+    case IrCmd::NOT_ANY:
+    case IrCmd::CMP_INT:
+    case IrCmd::JUMP:
+    case IrCmd::JUMP_IF_TRUTHY:
+    case IrCmd::JUMP_IF_FALSY:
+    case IrCmd::JUMP_EQ_TAG:
+    case IrCmd::JUMP_CMP_INT:
+    case IrCmd::JUMP_EQ_POINTER:
+    case IrCmd::JUMP_CMP_NUM:
+    case IrCmd::JUMP_FORN_LOOP_COND:
+    case IrCmd::JUMP_SLOT_MATCH:
+    case IrCmd::FORGLOOP:
+    case IrCmd::TABLE_LEN:
+    case IrCmd::STRING_LEN:
+    case IrCmd::STRING_CHAR:
+    case IrCmd::STRING_SUB:
+    case IrCmd::TRY_NUM_TO_INDEX:
+    case IrCmd::INT_TO_NUM:
+    case IrCmd::UINT_TO_NUM:
+    case IrCmd::NUM_TO_INT:
+    case IrCmd::NUM_TO_UINT:
+    case IrCmd::NUM_TO_VEC:
+    case IrCmd::TAG_VECTOR:
+    case IrCmd::GET_UPVALUE:
+    case IrCmd::SET_UPVALUE:
+    case IrCmd::CHECK_TAG:
+    case IrCmd::CHECK_TRUTHY:
+    case IrCmd::CHECK_READONLY:
+    case IrCmd::CHECK_NO_METATABLE:
+    case IrCmd::CHECK_SAFE_ENV:
+    case IrCmd::CHECK_ARRAY_SIZE:
+    case IrCmd::CHECK_SLOT_MATCH:
+    case IrCmd::CHECK_NODE_NO_NEXT:
+    case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::CHECK_CLOSURE_PROTO:
+    case IrCmd::CHECK_BUFFER_LEN:
+    case IrCmd::CHECK_USERDATA_TAG:
+    case IrCmd::BARRIER_OBJ:
+    case IrCmd::BARRIER_TABLE_BACK:
+    case IrCmd::BARRIER_TABLE_FORWARD:
+    case IrCmd::SET_SAVEDPC:
+    case IrCmd::COVERAGE:
+    case IrCmd::INC_EXEC_COUNTER:
+    case IrCmd::BITAND_UINT:
+    case IrCmd::BITXOR_UINT:
+    case IrCmd::BITOR_UINT:
+    case IrCmd::BITNOT_UINT:
+    case IrCmd::BITLSHIFT_UINT:
+    case IrCmd::BITRSHIFT_UINT:
+    case IrCmd::BITARSHIFT_UINT:
+    case IrCmd::BITLROTATE_UINT:
+    case IrCmd::BITRROTATE_UINT:
+    case IrCmd::BITCOUNTLZ_UINT:
+    case IrCmd::BITCOUNTRZ_UINT:
+    case IrCmd::BYTESWAP_UINT:
+    case IrCmd::INVOKE_LIBM:
+    case IrCmd::GET_TYPE:
+    case IrCmd::GET_TYPEOF:
+    case IrCmd::BUFFER_READI8:
+    case IrCmd::BUFFER_READU8:
+    case IrCmd::BUFFER_WRITEI8:
+    case IrCmd::BUFFER_READI16:
+    case IrCmd::BUFFER_READU16:
+    case IrCmd::BUFFER_WRITEI16:
+    case IrCmd::BUFFER_READI32:
+    case IrCmd::BUFFER_WRITEI32:
+    case IrCmd::BUFFER_READF32:
+    case IrCmd::BUFFER_WRITEF32:
+    case IrCmd::BUFFER_READF64:
+    case IrCmd::BUFFER_WRITEF64:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
 bool isUserdataBytecodeType(uint8_t ty)
 {
     return ty == LBC_TYPE_USERDATA || isCustomUserdataBytecodeType(ty);
@@ -1140,5 +1280,22 @@ IrBlock& getNextBlock(IrFunction& function, const std::vector<uint32_t>& sortedB
     return dummy;
 }
 
+bool isBlockContinuation(const IrFunction& function, const IrBlock& curr, const IrBlock& next)
+{
+    if (next.useCount != 1 || next.kind == IrBlockKind::Dead || curr.kind == IrBlockKind::Dead)
+        return false;
+
+    const IrInst& term = function.instructions[curr.finish];
+    uint32_t nextIdx = function.getBlockIndex(next);
+
+    for (IrOp op : {term.a, term.b, term.c, term.d, term.e, term.f, term.g})
+    {
+        if (op.kind == IrOpKind::Block && op.index == nextIdx)
+            return true;
+    }
+
+    return false;
+}
+
 } // namespace CodeGen
 } // namespace Luau
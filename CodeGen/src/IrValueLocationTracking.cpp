@@ -130,6 +130,7 @@ void IrValueLocationTracking::beforeInstLowering(IrInst& inst)
     case IrCmd::MOD_NUM:
     case IrCmd::MIN_NUM:
     case IrCmd::MAX_NUM:
+    case IrCmd::MULADD_NUM:
     case IrCmd::JUMP_EQ_TAG:
     case IrCmd::JUMP_CMP_NUM:
     case IrCmd::FLOOR_NUM:
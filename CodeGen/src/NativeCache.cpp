@@ -0,0 +1,587 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "NativeCache.h"
+
+#include "Luau/AssemblyBuilderA64.h"
+#include "Luau/AssemblyBuilderX64.h"
+#include "Luau/IrUtils.h"
+
+#include "CodeGenA64.h"
+#include "CodeGenContext.h"
+#include "CodeGenX64.h"
+#include "EmitCommon.h"
+
+#include "lobject.h"
+#include "lstate.h"
+#include "lstring.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <limits.h>
+#include <mach-o/dyld.h>
+#endif
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// From CodeGen.cpp
+unsigned int getCpuFeaturesA64();
+unsigned int getCpuFeaturesX64();
+
+static const uint32_t kNativeCacheMagic = 0x434e554c; // 'LUNC'
+
+// Has to be incremented when the layout of the stored data changes
+static const uint32_t kNativeCacheVersion = 3;
+
+// FNV-1a
+struct NativeCacheHash
+{
+    uint64_t value = 14695981039346656037ull;
+
+    void addBytes(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            value ^= bytes[i];
+            value *= 1099511628211ull;
+        }
+    }
+
+    template<typename T>
+    void addValue(T data)
+    {
+        addBytes(&data, sizeof(data));
+    }
+
+    void addString(const char* str)
+    {
+        addBytes(str, strlen(str) + 1);
+    }
+};
+
+// Native code accesses fields of VM structures directly, so it can't be reused by a VM that was built with a different layout of them
+static void hashVmLayout(NativeCacheHash& hash)
+{
+#define HASH_SIZE(type) hash.addValue(uint32_t(sizeof(type)))
+#define HASH_OFFSET(type, field) hash.addValue(uint32_t(offsetof(type, field)))
+
+    HASH_SIZE(TValue);
+    HASH_OFFSET(TValue, value);
+    HASH_OFFSET(TValue, extra);
+    HASH_OFFSET(TValue, tt);
+
+    HASH_SIZE(LuaNode);
+    HASH_OFFSET(LuaNode, val);
+    HASH_OFFSET(LuaNode, key);
+
+    HASH_OFFSET(GCheader, marked);
+    HASH_OFFSET(TString, len);
+    HASH_OFFSET(TString, data);
+    HASH_OFFSET(Udata, tag);
+    HASH_OFFSET(Udata, metatable);
+    HASH_OFFSET(Udata, data);
+    HASH_OFFSET(Buffer, len);
+    HASH_OFFSET(Buffer, data);
+    HASH_OFFSET(UpVal, v);
+
+    HASH_SIZE(UdataCache);
+    HASH_OFFSET(UdataCache, metatable);
+    HASH_OFFSET(UdataCache, epoch);
+    HASH_OFFSET(UdataCache, value);
+
+    HASH_OFFSET(Proto, k);
+    HASH_OFFSET(Proto, code);
+    HASH_OFFSET(Proto, p);
+    HASH_OFFSET(Proto, execdata);
+    HASH_OFFSET(Proto, exectarget);
+    HASH_OFFSET(Proto, debuginsn);
+    HASH_OFFSET(Proto, udatacache);
+    HASH_OFFSET(Proto, numparams);
+    HASH_OFFSET(Proto, is_vararg);
+
+    HASH_OFFSET(Closure, isC);
+    HASH_OFFSET(Closure, env);
+    HASH_OFFSET(Closure, c.f);
+    HASH_OFFSET(Closure, l.p);
+    HASH_OFFSET(Closure, l.uprefs);
+
+    HASH_OFFSET(LuaTable, tmcache);
+    HASH_OFFSET(LuaTable, readonly);
+    HASH_OFFSET(LuaTable, safeenv);
+    HASH_OFFSET(LuaTable, lsizenode);
+    HASH_OFFSET(LuaTable, nodemask8);
+    HASH_OFFSET(LuaTable, sizearray);
+    HASH_OFFSET(LuaTable, metatable);
+    HASH_OFFSET(LuaTable, array);
+    HASH_OFFSET(LuaTable, node);
+    HASH_OFFSET(LuaTable, gclist);
+
+    HASH_SIZE(CallInfo);
+    HASH_OFFSET(CallInfo, base);
+    HASH_OFFSET(CallInfo, func);
+    HASH_OFFSET(CallInfo, top);
+    HASH_OFFSET(CallInfo, savedpc);
+    HASH_OFFSET(CallInfo, nresults);
+    HASH_OFFSET(CallInfo, flags);
+
+    HASH_OFFSET(lua_State, status);
+    HASH_OFFSET(lua_State, top);
+    HASH_OFFSET(lua_State, base);
+    HASH_OFFSET(lua_State, global);
+    HASH_OFFSET(lua_State, ci);
+    HASH_OFFSET(lua_State, openupval);
+    HASH_OFFSET(lua_State, namecall);
+
+    HASH_OFFSET(global_State, totalbytes);
+    HASH_OFFSET(global_State, GCthreshold);
+    HASH_OFFSET(global_State, cb.interrupt);
+    HASH_OFFSET(global_State, tmname);
+    HASH_OFFSET(global_State, ttname);
+    HASH_OFFSET(global_State, charstr);
+    HASH_OFFSET(global_State, udatacacheepoch);
+
+    // Fields are laid out in groups, so the bounds of each group cover the offsets of the fields in between
+    HASH_SIZE(NativeContext);
+    HASH_OFFSET(NativeContext, gateEntry);
+    HASH_OFFSET(NativeContext, gateExit);
+    HASH_OFFSET(NativeContext, luaV_lessthan);
+    HASH_OFFSET(NativeContext, luaV_concat);
+    HASH_OFFSET(NativeContext, luaH_getn);
+    HASH_OFFSET(NativeContext, luaH_setnum);
+    HASH_OFFSET(NativeContext, luaC_barriertable);
+    HASH_OFFSET(NativeContext, luaC_step);
+    HASH_OFFSET(NativeContext, luaS_newlstr);
+    HASH_OFFSET(NativeContext, luaF_close);
+    HASH_OFFSET(NativeContext, luaF_newLclosure);
+    HASH_OFFSET(NativeContext, luaT_gettm);
+    HASH_OFFSET(NativeContext, luaT_objtypenamestr);
+    HASH_OFFSET(NativeContext, libm_exp);
+    HASH_OFFSET(NativeContext, libm_modf);
+    HASH_OFFSET(NativeContext, forgLoopTableIter);
+    HASH_OFFSET(NativeContext, getImport);
+    HASH_OFFSET(NativeContext, callFallback);
+    HASH_OFFSET(NativeContext, executeGETGLOBAL);
+    HASH_OFFSET(NativeContext, executePREPVARARGS);
+    HASH_OFFSET(NativeContext, luauF_table);
+
+#undef HASH_OFFSET
+#undef HASH_SIZE
+}
+
+// The code generator and the VM are part of the executable, which is hashed as a whole to identify its build; this covers changes to the
+// generated code that don't affect the helpers or the layout of structures, such as changes to the lowering of individual instructions
+static std::optional<uint64_t> getBuildFingerprint()
+{
+#if defined(_WIN32)
+    wchar_t path[MAX_PATH];
+    DWORD length = GetModuleFileNameW(nullptr, path, MAX_PATH);
+    FILE* file = length != 0 && length < MAX_PATH ? _wfopen(path, L"rb") : nullptr;
+#elif defined(__APPLE__)
+    char path[PATH_MAX];
+    uint32_t size = sizeof(path);
+    FILE* file = _NSGetExecutablePath(path, &size) == 0 ? fopen(path, "rb") : nullptr;
+#else
+    FILE* file = fopen("/proc/self/exe", "rb");
+#endif
+
+    if (!file)
+        return std::nullopt;
+
+    NativeCacheHash hash;
+
+    char buffer[65536];
+
+    while (size_t read = fread(buffer, 1, sizeof(buffer), file))
+        hash.addBytes(buffer, read);
+
+    bool failed = ferror(file) != 0;
+    fclose(file);
+
+    if (failed)
+        return std::nullopt;
+
+    return hash.value;
+}
+
+// Changes to the code generator are detected through the build of the executable, the helper code included in every module and the layout
+// of the native context and VM structures
+static std::optional<uint64_t> getCodeGenFingerprint()
+{
+    std::optional<uint64_t> buildFingerprint = getBuildFingerprint();
+
+    if (!buildFingerprint)
+        return std::nullopt;
+
+    NativeCacheHash hash;
+    hash.addValue(*buildFingerprint);
+
+    ModuleHelpers helpers;
+
+#if defined(CODEGEN_TARGET_A64)
+    unsigned int cpuFeatures = getCpuFeaturesA64();
+    hash.addValue(cpuFeatures);
+
+    A64::AssemblyBuilderA64 build(/* logText= */ false, cpuFeatures);
+    A64::assembleHelpers(build, helpers);
+#elif defined(CODEGEN_TARGET_X64)
+    unsigned int cpuFeatures = getCpuFeaturesX64();
+    hash.addValue(cpuFeatures);
+
+    X64::AssemblyBuilderX64 build(/* logText= */ false, cpuFeatures);
+    X64::assembleHelpers(build, helpers);
+#else
+    X64::AssemblyBuilderX64 build(/* logText= */ false);
+    X64::assembleHelpers(build, helpers);
+#endif
+
+    build.finalize();
+
+    hash.addBytes(build.code.data(), build.code.size() * sizeof(build.code[0]));
+    hash.addBytes(build.data.data(), build.data.size());
+
+    hashVmLayout(hash);
+
+    return hash.value;
+}
+
+static void hashProto(NativeCacheHash& hash, const Proto* proto)
+{
+    hash.addValue(proto->bytecodeid);
+    hash.addValue(proto->nups);
+    hash.addValue(proto->numparams);
+    hash.addValue(proto->is_vararg);
+    hash.addValue(proto->maxstacksize);
+    hash.addValue(proto->flags);
+
+    hash.addValue(proto->sizecode);
+
+    for (int i = 0; i < proto->sizecode;)
+    {
+        Instruction insn = proto->code[i];
+
+        // breakpoints replace the opcode in the bytecode
+        LuauOpcode op = LuauOpcode(proto->debuginsn ? proto->debuginsn[i] : LUAU_INSN_OP(insn));
+        insn = (insn & ~0xffu) | op;
+
+        // the interpreter caches table slot indices and coverage counts in the bytecode, which native code doesn't depend on
+        switch (op)
+        {
+        case LOP_GETGLOBAL:
+        case LOP_SETGLOBAL:
+        case LOP_GETTABLEKS:
+        case LOP_SETTABLEKS:
+        case LOP_NAMECALL:
+            insn &= 0x00ffffff;
+            break;
+        case LOP_COVERAGE:
+            insn &= 0xff;
+            break;
+        default:
+            break;
+        }
+
+        hash.addValue(insn);
+
+        int length = getOpLength(op);
+
+        for (int j = 1; j < length && i + j < proto->sizecode; ++j)
+            hash.addValue(proto->code[i + j]);
+
+        i += length;
+    }
+
+    hash.addValue(proto->sizek);
+
+    for (int i = 0; i < proto->sizek; ++i)
+    {
+        const TValue* k = &proto->k[i];
+
+        hash.addValue(uint8_t(k->tt));
+
+        switch (k->tt)
+        {
+        case LUA_TBOOLEAN:
+            hash.addValue(bvalue(k));
+            break;
+        case LUA_TNUMBER:
+            hash.addValue(nvalue(k));
+            break;
+        case LUA_TVECTOR:
+            hash.addBytes(vvalue(k), LUA_VECTOR_SIZE * sizeof(float));
+            break;
+        case LUA_TSTRING:
+            hash.addValue(tsvalue(k)->len);
+            hash.addBytes(getstr(tsvalue(k)), tsvalue(k)->len);
+            break;
+        default:
+            break;
+        }
+    }
+
+    hash.addValue(proto->sizetypeinfo);
+
+    if (proto->typeinfo)
+        hash.addBytes(proto->typeinfo, proto->sizetypeinfo);
+}
+
+std::optional<uint64_t> getNativeCacheKey(const std::vector<Proto*>& protos, const CompilationOptions& options)
+{
+    static const std::optional<uint64_t> fingerprint = getCodeGenFingerprint();
+
+    if (!fingerprint)
+        return std::nullopt;
+
+    NativeCacheHash hash;
+    hash.addValue(kNativeCacheVersion);
+    hash.addValue(*fingerprint);
+
+    // It's not known which flags change the generated code, so all of them are included
+    for (FValue<bool>* flag = FValue<bool>::list; flag; flag = flag->next)
+    {
+        hash.addString(flag->name);
+        hash.addValue(flag->value);
+    }
+
+    for (FValue<int>* flag = FValue<int>::list; flag; flag = flag->next)
+    {
+        hash.addString(flag->name);
+        hash.addValue(flag->value);
+    }
+
+    hash.addValue(options.flags);
+
+    // Hooks are host functions, which can only be expected to generate the same code if the same ones are provided
+    const HostIrHooks& hooks = options.hooks;
+
+    const void* hookPointers[] = {
+        (const void*)hooks.vectorAccessBytecodeType,
+        (const void*)hooks.vectorNamecallBytecodeType,
+        (const void*)hooks.vectorAccess,
+        (const void*)hooks.vectorNamecall,
+        (const void*)hooks.userdataAccessBytecodeType,
+        (const void*)hooks.userdataMetamethodBytecodeType,
+        (const void*)hooks.userdataNamecallBytecodeType,
+        (const void*)hooks.userdataAccess,
+        (const void*)hooks.userdataMetamethod,
+        (const void*)hooks.userdataNamecall,
+    };
+
+    for (const void* hook : hookPointers)
+        hash.addValue(hook != nullptr);
+
+    if (options.userdataTypes)
+    {
+        for (const char* const* type = options.userdataTypes; *type; ++type)
+            hash.addString(*type);
+    }
+
+    hash.addValue(uint32_t(protos.size()));
+
+    for (const Proto* proto : protos)
+        hashProto(hash, proto);
+
+    return hash.value;
+}
+
+static void writeU32(std::string& result, uint32_t value)
+{
+    result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void writeU64(std::string& result, uint64_t value)
+{
+    result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void serializeNativeCache(std::string& result, uint64_t key, const AssembledProtos& assembled)
+{
+    writeU32(result, kNativeCacheMagic);
+    writeU32(result, kNativeCacheVersion);
+    writeU64(result, key);
+
+    size_t payloadStart = result.size();
+
+    writeU32(result, uint32_t(assembled.nativeProtos.size()));
+
+    for (const NativeProtoExecDataPtr& nativeProto : assembled.nativeProtos)
+    {
+        const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProto.get());
+
+        // Code that depends on the runtime state of the VM can't be reused by another process
+        CODEGEN_ASSERT(header.speculativeInstructionCount == 0 && header.inlinedCallCount == 0);
+
+        writeU32(result, header.bytecodeId);
+        writeU32(result, header.bytecodeInstructionCount);
+        writeU32(result, uint32_t(reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress)));
+        writeU32(result, uint32_t(header.nativeCodeSize));
+        writeU32(result, header.userdataCacheSiteCount);
+
+        result.append(reinterpret_cast<const char*>(nativeProto.get()), header.bytecodeInstructionCount * sizeof(uint32_t));
+    }
+
+    writeU32(result, uint32_t(assembled.data.size()));
+    result.append(reinterpret_cast<const char*>(assembled.data.data()), assembled.data.size());
+
+    writeU32(result, uint32_t(assembled.code.size()));
+    result.append(reinterpret_cast<const char*>(assembled.code.data()), assembled.code.size());
+
+    // Damaged files are detected before any of the code is used
+    NativeCacheHash checksum;
+    checksum.addBytes(result.data() + payloadStart, result.size() - payloadStart);
+    writeU64(result, checksum.value);
+}
+
+struct NativeCacheReader
+{
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+
+    bool readBytes(void* target, size_t count)
+    {
+        if (count > size - offset)
+            return false;
+
+        memcpy(target, data + offset, count);
+        offset += count;
+        return true;
+    }
+
+    template<typename T>
+    bool readValue(T& target)
+    {
+        return readBytes(&target, sizeof(target));
+    }
+
+    size_t remaining() const
+    {
+        return size - offset;
+    }
+};
+
+bool deserializeNativeCache(const char* data, size_t size, uint64_t key, AssembledProtos& assembled)
+{
+    NativeCacheReader reader{data, size};
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t storedKey = 0;
+
+    if (!reader.readValue(magic) || magic != kNativeCacheMagic)
+        return false;
+
+    if (!reader.readValue(version) || version != kNativeCacheVersion)
+        return false;
+
+    if (!reader.readValue(storedKey) || storedKey != key)
+        return false;
+
+    uint64_t storedChecksum = 0;
+
+    if (reader.remaining() < sizeof(storedChecksum))
+        return false;
+
+    // The payload is everything between the key and the checksum at the end
+    reader.size -= sizeof(storedChecksum);
+    memcpy(&storedChecksum, data + reader.size, sizeof(storedChecksum));
+
+    NativeCacheHash checksum;
+    checksum.addBytes(data + reader.offset, reader.remaining());
+
+    if (checksum.value != storedChecksum)
+        return false;
+
+    uint32_t protoCount = 0;
+
+    if (!reader.readValue(protoCount))
+        return false;
+
+    std::vector<NativeProtoExecDataPtr> nativeProtos;
+
+    for (uint32_t i = 0; i < protoCount; ++i)
+    {
+        uint32_t bytecodeId = 0;
+        uint32_t instructionCount = 0;
+        uint32_t entryOffset = 0;
+        uint32_t nativeCodeSize = 0;
+        uint32_t userdataCacheSiteCount = 0;
+
+        if (!reader.readValue(bytecodeId) || !reader.readValue(instructionCount) || !reader.readValue(entryOffset) ||
+            !reader.readValue(nativeCodeSize) || !reader.readValue(userdataCacheSiteCount))
+            return false;
+
+        if (instructionCount > reader.remaining() / sizeof(uint32_t))
+            return false;
+
+        NativeProtoExecDataPtr nativeExecData = createNativeProtoExecData(instructionCount);
+
+        if (!reader.readBytes(nativeExecData.get(), instructionCount * sizeof(uint32_t)))
+            return false;
+
+        NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeExecData.get());
+        header.entryOffsetOrAddress = reinterpret_cast<const uint8_t*>(uintptr_t(entryOffset));
+        header.bytecodeId = bytecodeId;
+        header.bytecodeInstructionCount = instructionCount;
+        header.nativeCodeSize = nativeCodeSize;
+        header.userdataCacheSiteCount = userdataCacheSiteCount;
+
+        nativeProtos.push_back(std::move(nativeExecData));
+    }
+
+    uint32_t dataSize = 0;
+
+    if (!reader.readValue(dataSize) || dataSize > reader.remaining())
+        return false;
+
+    std::vector<uint8_t> nativeData(dataSize);
+
+    if (!reader.readBytes(nativeData.data(), dataSize))
+        return false;
+
+    uint32_t codeSize = 0;
+
+    if (!reader.readValue(codeSize) || codeSize != reader.remaining())
+        return false;
+
+    std::vector<uint8_t> nativeCode(codeSize);
+
+    if (!reader.readBytes(nativeCode.data(), codeSize))
+        return false;
+
+    // Functions and the instructions inside of them have to be inside of the code
+    for (const NativeProtoExecDataPtr& nativeProto : nativeProtos)
+    {
+        const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProto.get());
+
+        if (reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress) + header.nativeCodeSize > codeSize)
+            return false;
+
+        for (uint32_t i = 0; i < header.bytecodeInstructionCount; ++i)
+        {
+            if (nativeProto[i] != kNativeInstructionOffsetNone && nativeProto[i] >= header.nativeCodeSize)
+                return false;
+        }
+    }
+
+    assembled.nativeProtos = std::move(nativeProtos);
+    assembled.data = std::move(nativeData);
+    assembled.code = std::move(nativeCode);
+
+    return true;
+}
+
+} // namespace CodeGen
+} // namespace Luau
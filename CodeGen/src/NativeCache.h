@@ -0,0 +1,34 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/CodeGenOptions.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct Proto;
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+struct AssembledProtos;
+
+// Native code of a module is stored together with a key that covers everything its generation depends on: the bytecode of the functions,
+// compilation options, CPU features, flags and the code generator itself.  Code is position independent, so the only values that have to
+// be relocated when it is loaded are the entry offsets of the functions, which are kept relative to the start of the code until binding.
+// Returns nullopt if the executable can't be read to identify the build, in which case native code can't be cached
+std::optional<uint64_t> getNativeCacheKey(const std::vector<Proto*>& protos, const CompilationOptions& options);
+
+void serializeNativeCache(std::string& result, uint64_t key, const AssembledProtos& assembled);
+
+// Returns false if the data is malformed, damaged or was stored with a different key
+[[nodiscard]] bool deserializeNativeCache(const char* data, size_t size, uint64_t key, AssembledProtos& assembled);
+
+} // namespace CodeGen
+} // namespace Luau
@@ -0,0 +1,726 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "NativeDebugInfo.h"
+
+#include "Luau/CodeGen.h"
+#include "Luau/CodeGenCommon.h"
+
+#include "lobject.h"
+#include "ldebug.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include <string.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+// GDB JIT interface, see https://sourceware.org/gdb/current/onlinedocs/gdb.html/JIT-Interface.html
+// The definitions are weak so that another JIT in the process that provides them shares the same list
+extern "C"
+{
+    struct jit_code_entry
+    {
+        jit_code_entry* next_entry;
+        jit_code_entry* prev_entry;
+        const char* symfile_addr;
+        uint64_t symfile_size;
+    };
+
+    struct jit_descriptor
+    {
+        uint32_t version;
+        uint32_t action_flag;
+        jit_code_entry* relevant_entry;
+        jit_code_entry* first_entry;
+    };
+
+    // GDB places a breakpoint in this function to find out about the changes to the list
+    __attribute__((weak)) LUAU_NOINLINE void __jit_debug_register_code()
+    {
+        asm volatile("" ::: "memory");
+    }
+
+    __attribute__((weak)) jit_descriptor __jit_debug_descriptor = {1, 0, nullptr, nullptr};
+}
+#endif
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+static std::atomic<bool> gJitDumpEnabled = false;
+static std::atomic<bool> gGdbJitEnabled = false;
+
+#if defined(__linux__)
+static std::mutex gJitDumpMutex;
+static FILE* gJitDumpFile = nullptr;
+static void* gJitDumpMarker = nullptr;
+static uint64_t gJitDumpCodeIndex = 0;
+
+// Entries of the list that were registered by us, with the code they describe
+struct GdbJitEntry
+{
+    jit_code_entry entry;
+    uintptr_t codeStart = 0;
+    std::string symfile;
+};
+
+static std::mutex gGdbJitMutex;
+static std::vector<GdbJitEntry*> gGdbJitEntries;
+
+// jitdump format, see tools/perf/Documentation/jitdump-specification.txt in the Linux kernel tree
+static const uint32_t kJitDumpMagic = 0x4a695444; // 'JiTD'
+static const uint32_t kJitDumpVersion = 1;
+
+enum JitDumpRecord
+{
+    JitDumpRecord_CodeLoad = 0,
+    JitDumpRecord_DebugInfo = 2,
+    JitDumpRecord_Close = 3,
+};
+#endif
+
+#if defined(CODEGEN_TARGET_A64)
+static const uint16_t kElfMachine = 183; // EM_AARCH64
+#else
+static const uint16_t kElfMachine = 62; // EM_X86_64
+#endif
+
+bool isNativeDebugInfoEnabled()
+{
+    return gJitDumpEnabled.load(std::memory_order_relaxed) || gGdbJitEnabled.load(std::memory_order_relaxed);
+}
+
+void buildNativeLineTable(Proto* proto, const uint32_t* instOffsets, uint32_t instCount, uint32_t codeSize, std::vector<NativeLineInfo>& lines)
+{
+    if (!proto->lineinfo)
+        return;
+
+    CODEGEN_ASSERT(instCount <= uint32_t(proto->sizecode));
+
+    size_t start = lines.size();
+
+    for (uint32_t i = 0; i < instCount; i++)
+    {
+        // Instructions that were removed as unreachable don't have a valid offset
+        if (instOffsets[i] >= codeSize)
+            continue;
+
+        lines.push_back({instOffsets[i], luaG_getline(proto, int(i))});
+    }
+
+    // Blocks are not placed in bytecode order, and instructions that don't generate code share the offset with the next instruction
+    std::stable_sort(
+        lines.begin() + start,
+        lines.end(),
+        [](const NativeLineInfo& a, const NativeLineInfo& b)
+        {
+            return a.offset < b.offset;
+        }
+    );
+
+    size_t count = start;
+
+    for (size_t i = start; i < lines.size(); i++)
+    {
+        if (count != start && lines[count - 1].offset == lines[i].offset)
+            lines[count - 1] = lines[i];
+        else if (count == start || lines[count - 1].line != lines[i].line)
+            lines[count++] = lines[i];
+    }
+
+    lines.resize(count);
+}
+
+#if defined(__linux__)
+static uint64_t getJitDumpTimestamp()
+{
+    // perf has to be used with '-k mono' for the samples to use the same clock
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
+
+template<typename T>
+static void appendValue(std::string& buffer, T value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void appendString(std::string& buffer, const std::string& value)
+{
+    buffer.append(value.c_str(), value.size() + 1);
+}
+
+static void appendJitDumpRecordHeader(std::string& buffer, uint32_t id, size_t size)
+{
+    appendValue(buffer, id);
+    appendValue(buffer, uint32_t(size + 16));
+    appendValue(buffer, getJitDumpTimestamp());
+}
+
+static void writeJitDumpFunctions(const std::vector<NativeDebugFunction>& functions)
+{
+    std::string record;
+
+    uint32_t pid = uint32_t(getpid());
+    uint32_t tid = uint32_t(syscall(SYS_gettid));
+
+    std::lock_guard<std::mutex> guard(gJitDumpMutex);
+
+    if (!gJitDumpFile)
+        return;
+
+    for (const NativeDebugFunction& function : functions)
+    {
+        // Debug information has to precede the code load record of the function
+        if (!function.lines.empty())
+        {
+            size_t size = 16 + function.lines.size() * (16 + function.source.size() + 1);
+
+            record.clear();
+            appendJitDumpRecordHeader(record, JitDumpRecord_DebugInfo, size);
+            appendValue(record, uint64_t(function.address));
+            appendValue(record, uint64_t(function.lines.size()));
+
+            for (const NativeLineInfo& line : function.lines)
+            {
+                appendValue(record, uint64_t(function.address + line.offset));
+                appendValue(record, uint32_t(line.line));
+                appendValue(record, uint32_t(0)); // discriminator
+                appendString(record, function.source);
+            }
+
+            fwrite(record.data(), 1, record.size(), gJitDumpFile);
+        }
+
+        record.clear();
+        appendJitDumpRecordHeader(record, JitDumpRecord_CodeLoad, 40 + function.name.size() + 1 + function.size);
+        appendValue(record, pid);
+        appendValue(record, tid);
+        appendValue(record, uint64_t(function.address)); // vma
+        appendValue(record, uint64_t(function.address));
+        appendValue(record, uint64_t(function.size));
+        appendValue(record, gJitDumpCodeIndex++);
+        appendString(record, function.name);
+        record.append(reinterpret_cast<const char*>(function.address), function.size);
+
+        fwrite(record.data(), 1, record.size(), gJitDumpFile);
+    }
+
+    fflush(gJitDumpFile);
+}
+
+struct ElfWriter
+{
+    std::string data;
+
+    template<typename T>
+    size_t write(T value)
+    {
+        size_t offset = data.size();
+        appendValue(data, value);
+        return offset;
+    }
+
+    template<typename T>
+    void patch(size_t offset, T value)
+    {
+        memcpy(&data[offset], &value, sizeof(value));
+    }
+
+    void writeString(const std::string& value)
+    {
+        appendString(data, value);
+    }
+
+    void writeUleb(uint64_t value)
+    {
+        do
+        {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            data.push_back(char(value ? byte | 0x80 : byte));
+        } while (value);
+    }
+
+    void writeSleb(int64_t value)
+    {
+        for (;;)
+        {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+
+            if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0))
+            {
+                data.push_back(char(byte));
+                break;
+            }
+
+            data.push_back(char(byte | 0x80));
+        }
+    }
+
+    void align(size_t alignment)
+    {
+        data.resize((data.size() + alignment - 1) & ~(alignment - 1));
+    }
+};
+
+enum GdbJitSection
+{
+    GdbJitSection_Null,
+    GdbJitSection_Text,
+    GdbJitSection_ShStrTab,
+    GdbJitSection_StrTab,
+    GdbJitSection_SymTab,
+    GdbJitSection_DebugAbbrev,
+    GdbJitSection_DebugInfo,
+    GdbJitSection_DebugLine,
+
+    GdbJitSection_Count
+};
+
+// In-memory relocatable object with an unallocated .text section placed at the code, symbols for the functions and a DWARF line table
+static std::string buildGdbJitSymbolFile(const std::vector<NativeDebugFunction>& functions)
+{
+    CODEGEN_ASSERT(!functions.empty());
+
+    uintptr_t textStart = functions.front().address;
+    uintptr_t textEnd = functions.back().address + functions.back().size;
+
+    std::vector<std::string> sources;
+
+    for (const NativeDebugFunction& function : functions)
+    {
+        if (!function.lines.empty() && std::find(sources.begin(), sources.end(), function.source) == sources.end())
+            sources.push_back(function.source);
+    }
+
+    struct Section
+    {
+        uint32_t name = 0;
+        uint32_t type = 0;
+        uint64_t flags = 0;
+        uint64_t addr = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t link = 0;
+        uint32_t info = 0;
+        uint64_t addralign = 1;
+        uint64_t entsize = 0;
+    };
+
+    Section sections[GdbJitSection_Count];
+
+    ElfWriter elf;
+
+    // ELF header, fields that depend on the layout are patched at the end
+    elf.write(uint32_t(0x464c457f)); // "\x7fELF"
+    elf.write(uint8_t(2));           // ELFCLASS64
+    elf.write(uint8_t(1));           // ELFDATA2LSB
+    elf.write(uint8_t(1));           // EV_CURRENT
+    elf.data.resize(16);             // ELFOSABI_NONE and padding
+    elf.write(uint16_t(1));          // ET_REL
+    elf.write(kElfMachine);
+    elf.write(uint32_t(1)); // EV_CURRENT
+    elf.write(uint64_t(0)); // e_entry
+    elf.write(uint64_t(0)); // e_phoff
+    size_t shoffPos = elf.write(uint64_t(0));
+    elf.write(uint32_t(0));  // e_flags
+    elf.write(uint16_t(64)); // e_ehsize
+    elf.write(uint16_t(0));  // e_phentsize
+    elf.write(uint16_t(0));  // e_phnum
+    elf.write(uint16_t(64)); // e_shentsize
+    elf.write(uint16_t(GdbJitSection_Count));
+    elf.write(uint16_t(GdbJitSection_ShStrTab));
+
+    auto beginSection = [&](GdbJitSection index, uint32_t type, size_t alignment)
+    {
+        elf.align(alignment);
+        sections[index].type = type;
+        sections[index].offset = elf.data.size();
+        sections[index].addralign = alignment;
+    };
+
+    auto endSection = [&](GdbJitSection index)
+    {
+        sections[index].size = elf.data.size() - sections[index].offset;
+    };
+
+    // .text doesn't have any data in the file, code is already in memory
+    sections[GdbJitSection_Text].type = 8; // SHT_NOBITS
+    sections[GdbJitSection_Text].flags = 2 | 4; // SHF_ALLOC | SHF_EXECINSTR
+    sections[GdbJitSection_Text].addr = textStart;
+    sections[GdbJitSection_Text].size = textEnd - textStart;
+    sections[GdbJitSection_Text].addralign = 16;
+
+    beginSection(GdbJitSection_ShStrTab, 3, 1); // SHT_STRTAB
+
+    const char* sectionNames[GdbJitSection_Count] = {
+        "", ".text", ".shstrtab", ".strtab", ".symtab", ".debug_abbrev", ".debug_info", ".debug_line"
+    };
+
+    for (int i = 0; i < GdbJitSection_Count; i++)
+    {
+        sections[i].name = uint32_t(elf.data.size() - sections[GdbJitSection_ShStrTab].offset);
+        elf.writeString(sectionNames[i]);
+    }
+
+    endSection(GdbJitSection_ShStrTab);
+
+    beginSection(GdbJitSection_StrTab, 3, 1); // SHT_STRTAB
+
+    std::vector<uint32_t> symbolNames;
+    elf.writeString("");
+
+    uint32_t fileSymbolName = uint32_t(elf.data.size() - sections[GdbJitSection_StrTab].offset);
+    elf.writeString(sources.empty() ? "luau" : sources.front());
+
+    for (const NativeDebugFunction& function : functions)
+    {
+        symbolNames.push_back(uint32_t(elf.data.size() - sections[GdbJitSection_StrTab].offset));
+        elf.writeString(function.name);
+    }
+
+    endSection(GdbJitSection_StrTab);
+
+    beginSection(GdbJitSection_SymTab, 2, 8); // SHT_SYMTAB
+    sections[GdbJitSection_SymTab].link = GdbJitSection_StrTab;
+    sections[GdbJitSection_SymTab].info = 2; // index of the first global symbol
+    sections[GdbJitSection_SymTab].entsize = 24;
+
+    auto writeSymbol = [&](uint32_t name, uint8_t info, uint16_t section, uint64_t value, uint64_t size)
+    {
+        elf.write(name);
+        elf.write(info);
+        elf.write(uint8_t(0)); // STV_DEFAULT
+        elf.write(section);
+        elf.write(value);
+        elf.write(size);
+    };
+
+    writeSymbol(0, 0, 0, 0, 0);
+    writeSymbol(fileSymbolName, 4, 0xfff1, 0, 0); // STB_LOCAL STT_FILE, SHN_ABS
+
+    for (size_t i = 0; i < functions.size(); i++)
+        writeSymbol(symbolNames[i], 0x12, GdbJitSection_Text, functions[i].address - textStart, functions[i].size); // STB_GLOBAL STT_FUNC
+
+    endSection(GdbJitSection_SymTab);
+
+    // DWARF data only describes a compilation unit with the line table
+    beginSection(GdbJitSection_DebugAbbrev, 1, 1); // SHT_PROGBITS
+    elf.writeUleb(1);
+    elf.writeUleb(0x11); // DW_TAG_compile_unit
+    elf.write(uint8_t(0)); // DW_CHILDREN_no
+    elf.writeUleb(0x03); // DW_AT_name
+    elf.writeUleb(0x08); // DW_FORM_string
+    elf.writeUleb(0x11); // DW_AT_low_pc
+    elf.writeUleb(0x01); // DW_FORM_addr
+    elf.writeUleb(0x12); // DW_AT_high_pc
+    elf.writeUleb(0x01); // DW_FORM_addr
+    elf.writeUleb(0x10); // DW_AT_stmt_list
+    elf.writeUleb(0x06); // DW_FORM_data4
+    elf.writeUleb(0);
+    elf.writeUleb(0);
+    elf.writeUleb(0);
+    endSection(GdbJitSection_DebugAbbrev);
+
+    beginSection(GdbJitSection_DebugInfo, 1, 1); // SHT_PROGBITS
+    size_t infoLengthPos = elf.write(uint32_t(0));
+    elf.write(uint16_t(2));  // DWARF version
+    elf.write(uint32_t(0));  // offset in .debug_abbrev
+    elf.write(uint8_t(8));   // address size
+    elf.writeUleb(1);
+    elf.writeString(sources.empty() ? "luau" : sources.front());
+    elf.write(uint64_t(textStart));
+    elf.write(uint64_t(textEnd));
+    elf.write(uint32_t(0)); // offset in .debug_line
+    elf.patch(infoLengthPos, uint32_t(elf.data.size() - infoLengthPos - 4));
+    endSection(GdbJitSection_DebugInfo);
+
+    beginSection(GdbJitSection_DebugLine, 1, 1); // SHT_PROGBITS
+    size_t lineLengthPos = elf.write(uint32_t(0));
+    elf.write(uint16_t(2)); // DWARF version
+    size_t headerLengthPos = elf.write(uint32_t(0));
+    elf.write(uint8_t(1));   // minimum_instruction_length
+    elf.write(uint8_t(1));   // default_is_stmt
+    elf.write(int8_t(-5));   // line_base
+    elf.write(uint8_t(14));  // line_range
+    elf.write(uint8_t(13));  // opcode_base
+
+    const uint8_t standardOpcodeLengths[12] = {0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1};
+
+    for (uint8_t length : standardOpcodeLengths)
+        elf.write(length);
+
+    elf.write(uint8_t(0)); // no include directories
+
+    for (const std::string& source : sources)
+    {
+        elf.writeString(source);
+        elf.writeUleb(0); // directory
+        elf.writeUleb(0); // modification time
+        elf.writeUleb(0); // length
+    }
+
+    elf.write(uint8_t(0));
+    elf.patch(headerLengthPos, uint32_t(elf.data.size() - headerLengthPos - 4));
+
+    // Every function is a separate sequence, which resets the state machine to file 1 and line 1
+    for (const NativeDebugFunction& function : functions)
+    {
+        if (function.lines.empty())
+            continue;
+
+        size_t file = std::find(sources.begin(), sources.end(), function.source) - sources.begin() + 1;
+
+        if (file != 1)
+        {
+            elf.write(uint8_t(4)); // DW_LNS_set_file
+            elf.writeUleb(file);
+        }
+
+        elf.write(uint8_t(0));
+        elf.writeUleb(9);
+        elf.write(uint8_t(2)); // DW_LNE_set_address
+        elf.write(uint64_t(function.address));
+
+        uint32_t offset = 0;
+        int line = 1;
+
+        for (const NativeLineInfo& info : function.lines)
+        {
+            if (info.offset != offset)
+            {
+                elf.write(uint8_t(2)); // DW_LNS_advance_pc
+                elf.writeUleb(info.offset - offset);
+                offset = info.offset;
+            }
+
+            if (info.line != line)
+            {
+                elf.write(uint8_t(3)); // DW_LNS_advance_line
+                elf.writeSleb(info.line - line);
+                line = info.line;
+            }
+
+            elf.write(uint8_t(1)); // DW_LNS_copy
+        }
+
+        elf.write(uint8_t(2)); // DW_LNS_advance_pc
+        elf.writeUleb(function.size - offset);
+
+        elf.write(uint8_t(0));
+        elf.writeUleb(1);
+        elf.write(uint8_t(1)); // DW_LNE_end_sequence
+    }
+
+    elf.patch(lineLengthPos, uint32_t(elf.data.size() - lineLengthPos - 4));
+    endSection(GdbJitSection_DebugLine);
+
+    elf.align(8);
+    elf.patch(shoffPos, uint64_t(elf.data.size()));
+
+    for (const Section& section : sections)
+    {
+        elf.write(section.name);
+        elf.write(section.type);
+        elf.write(section.flags);
+        elf.write(section.addr);
+        elf.write(section.offset);
+        elf.write(section.size);
+        elf.write(section.link);
+        elf.write(section.info);
+        elf.write(section.addralign);
+        elf.write(section.entsize);
+    }
+
+    return elf.data;
+}
+
+static void registerGdbJitFunctions(const std::vector<NativeDebugFunction>& functions)
+{
+    // Entries stay registered until the code is released, see releaseNativeDebugInfo
+    GdbJitEntry* gdbEntry = new GdbJitEntry{};
+    gdbEntry->codeStart = functions.front().address;
+    gdbEntry->symfile = buildGdbJitSymbolFile(functions);
+
+    jit_code_entry* entry = &gdbEntry->entry;
+    entry->symfile_addr = gdbEntry->symfile.data();
+    entry->symfile_size = gdbEntry->symfile.size();
+
+    std::lock_guard<std::mutex> guard(gGdbJitMutex);
+
+    entry->next_entry = __jit_debug_descriptor.first_entry;
+
+    if (entry->next_entry)
+        entry->next_entry->prev_entry = entry;
+
+    __jit_debug_descriptor.first_entry = entry;
+    __jit_debug_descriptor.relevant_entry = entry;
+    __jit_debug_descriptor.action_flag = 1; // JIT_REGISTER_FN
+    __jit_debug_register_code();
+
+    gGdbJitEntries.push_back(gdbEntry);
+}
+
+static void unregisterGdbJitEntry(GdbJitEntry* gdbEntry)
+{
+    jit_code_entry* entry = &gdbEntry->entry;
+
+    if (entry->prev_entry)
+        entry->prev_entry->next_entry = entry->next_entry;
+    else
+        __jit_debug_descriptor.first_entry = entry->next_entry;
+
+    if (entry->next_entry)
+        entry->next_entry->prev_entry = entry->prev_entry;
+
+    __jit_debug_descriptor.relevant_entry = entry;
+    __jit_debug_descriptor.action_flag = 2; // JIT_UNREGISTER_FN
+    __jit_debug_register_code();
+
+    delete gdbEntry;
+}
+#endif
+
+void emitNativeDebugInfo(const std::vector<NativeDebugFunction>& functions)
+{
+#if defined(__linux__)
+    if (functions.empty())
+        return;
+
+    if (gJitDumpEnabled.load(std::memory_order_relaxed))
+        writeJitDumpFunctions(functions);
+
+    if (gGdbJitEnabled.load(std::memory_order_relaxed))
+        registerGdbJitFunctions(functions);
+#endif
+}
+
+void releaseNativeDebugInfo(const uint8_t* start, size_t size)
+{
+#if defined(__linux__)
+    std::lock_guard<std::mutex> guard(gGdbJitMutex);
+
+    for (size_t i = 0; i < gGdbJitEntries.size();)
+    {
+        GdbJitEntry* gdbEntry = gGdbJitEntries[i];
+
+        if (gdbEntry->codeStart >= uintptr_t(start) && gdbEntry->codeStart < uintptr_t(start) + size)
+        {
+            unregisterGdbJitEntry(gdbEntry);
+
+            gGdbJitEntries[i] = gGdbJitEntries.back();
+            gGdbJitEntries.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+#endif
+}
+
+bool startJitDump(const char* path)
+{
+#if defined(__linux__)
+    std::lock_guard<std::mutex> guard(gJitDumpMutex);
+
+    if (gJitDumpFile)
+        return false;
+
+    // the file is always created anew, so that a file or symbolic link that someone else placed at a predictable path isn't written to
+    int fd = open(path, O_CREAT | O_EXCL | O_RDWR, 0644);
+
+    if (fd < 0)
+        return false;
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+
+    // perf finds the file through this executable mapping that it records
+    void* marker = mmap(nullptr, size_t(pageSize), PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0);
+
+    if (marker == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    FILE* file = fdopen(fd, "wb");
+
+    if (!file)
+    {
+        munmap(marker, size_t(pageSize));
+        close(fd);
+        return false;
+    }
+
+    std::string header;
+    appendValue(header, kJitDumpMagic);
+    appendValue(header, kJitDumpVersion);
+    appendValue(header, uint32_t(40)); // header size
+    appendValue(header, uint32_t(kElfMachine));
+    appendValue(header, uint32_t(0)); // padding
+    appendValue(header, uint32_t(getpid()));
+    appendValue(header, getJitDumpTimestamp());
+    appendValue(header, uint64_t(0)); // flags
+
+    fwrite(header.data(), 1, header.size(), file);
+    fflush(file);
+
+    gJitDumpFile = file;
+    gJitDumpMarker = marker;
+    gJitDumpEnabled.store(true, std::memory_order_relaxed);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void stopJitDump()
+{
+#if defined(__linux__)
+    std::lock_guard<std::mutex> guard(gJitDumpMutex);
+
+    if (!gJitDumpFile)
+        return;
+
+    gJitDumpEnabled.store(false, std::memory_order_relaxed);
+
+    std::string record;
+    appendJitDumpRecordHeader(record, JitDumpRecord_Close, 0);
+    fwrite(record.data(), 1, record.size(), gJitDumpFile);
+
+    munmap(gJitDumpMarker, size_t(sysconf(_SC_PAGESIZE)));
+    fclose(gJitDumpFile);
+
+    gJitDumpFile = nullptr;
+    gJitDumpMarker = nullptr;
+#endif
+}
+
+bool setGdbJitRegistration(bool enabled)
+{
+#if defined(__linux__)
+    gGdbJitEnabled.store(enabled, std::memory_order_relaxed);
+    return true;
+#else
+    return !enabled;
+#endif
+}
+
+} // namespace CodeGen
+} // namespace Luau
@@ -0,0 +1,48 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct Proto;
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+struct NativeLineInfo
+{
+    uint32_t offset = 0; // relative to the start of the function code
+    int line = 0;
+};
+
+struct NativeDebugFunction
+{
+    std::string name;
+    std::string source; // empty for code that doesn't belong to a Luau function
+
+    uintptr_t address = 0;
+    uint32_t size = 0;
+
+    // Sorted by offset; each line covers the code up to the offset of the next one
+    std::vector<NativeLineInfo> lines;
+};
+
+// Returns true when native code is described to a jitdump file or to the GDB JIT interface
+bool isNativeDebugInfoEnabled();
+
+// Builds the source line table of the native code of a function from the native offsets of its bytecode instructions
+void buildNativeLineTable(Proto* proto, const uint32_t* instOffsets, uint32_t instCount, uint32_t codeSize, std::vector<NativeLineInfo>& lines);
+
+// Describes functions of a module that was just placed in executable memory; functions have to be sorted by address
+void emitNativeDebugInfo(const std::vector<NativeDebugFunction>& functions);
+
+// Removes the descriptions of the code in executable memory that is released, so that the debugger doesn't see them when the memory is reused
+void releaseNativeDebugInfo(const uint8_t* start, size_t size);
+
+} // namespace CodeGen
+} // namespace Luau
@@ -30,6 +30,8 @@ void NativeProtoExecDataDeleter::operator()(const uint32_t* instructionOffsets)
 void destroyNativeProtoExecData(const uint32_t* instructionOffsets) noexcept
 {
     const NativeProtoExecDataHeader* header = &getNativeProtoExecDataHeader(instructionOffsets);
+    delete[] header->executionCounters;
+    delete[] header->inlinedCalls;
     header->~NativeProtoExecDataHeader();
     delete[] reinterpret_cast<const uint8_t*>(header);
 }
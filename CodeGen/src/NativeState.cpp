@@ -7,6 +7,7 @@
 
 #include "lbuiltins.h"
 #include "lgc.h"
+#include "lstring.h"
 #include "ltable.h"
 #include "lfunc.h"
 #include "lvm.h"
@@ -54,6 +55,8 @@ void initFunctions(NativeContext& context)
     context.luaC_barrierback = luaC_barrierback;
     context.luaC_step = luaC_step;
 
+    context.luaS_newlstr = luaS_newlstr;
+
     context.luaF_close = luaF_close;
     context.luaF_findupval = luaF_findupval;
     context.luaF_newLclosure = luaF_newLclosure;
@@ -90,6 +93,7 @@ void initFunctions(NativeContext& context)
     context.callProlog = callProlog;
     context.callEpilogC = callEpilogC;
     context.newUserdata = newUserdata;
+    context.strbufAppend = strbufAppend;
     context.getImport = getImport;
 
     context.callFallback = callFallback;
@@ -58,6 +58,8 @@ struct NativeContext
     void (*luaC_barrierback)(lua_State* L, GCObject* o, GCObject** gclist) = nullptr;
     size_t (*luaC_step)(lua_State* L, bool assist) = nullptr;
 
+    TString* (*luaS_newlstr)(lua_State* L, const char* str, size_t l) = nullptr;
+
     void (*luaF_close)(lua_State* L, StkId level) = nullptr;
     UpVal* (*luaF_findupval)(lua_State* L, StkId level) = nullptr;
     Closure* (*luaF_newLclosure)(lua_State* L, int nelems, LuaTable* e, Proto* p) = nullptr;
@@ -94,6 +96,7 @@ struct NativeContext
     Closure* (*callProlog)(lua_State* L, TValue* ra, StkId argtop, int nresults) = nullptr;
     void (*callEpilogC)(lua_State* L, int nresults, int n) = nullptr;
     Udata* (*newUserdata)(lua_State* L, size_t s, int tag) = nullptr;
+    void (*strbufAppend)(lua_State* L, Udata* u, TString* ts) = nullptr;
     void (*getImport)(lua_State* L, StkId res, unsigned id, unsigned pc) = nullptr;
 
     Closure* (*callFallback)(lua_State* L, StkId ra, StkId argtop, int nresults) = nullptr;
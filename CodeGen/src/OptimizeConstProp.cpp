@@ -5,7 +5,9 @@
 #include "Luau/IrData.h"
 #include "Luau/IrBuilder.h"
 #include "Luau/IrUtils.h"
+#include "Luau/IrVisitUseDef.h"
 
+#include "lobject.h"
 #include "lua.h"
 
 #include <limits.h>
@@ -21,6 +23,7 @@ LUAU_FASTINTVARIABLE(LuauCodeGenReuseSlotLimit, 64)
 LUAU_FASTINTVARIABLE(LuauCodeGenReuseUdataTagLimit, 64)
 LUAU_FASTINTVARIABLE(LuauCodeGenLiveSlotReuseLimit, 8)
 LUAU_FASTFLAGVARIABLE(DebugLuauAbortingChecks)
+LUAU_FASTFLAGVARIABLE(DebugCodegenSkipCrossBlockPropagation)
 LUAU_FASTFLAG(LuauCodeGenDirectBtest)
 
 namespace Luau
@@ -41,6 +44,10 @@ struct RegisterInfo
     bool knownNotReadonly = false;
     bool knownNoMetatable = false;
     int knownTableArraySize = -1;
+
+    // Tag was established by predecessor blocks; stores of the same tag cannot be removed, because dead store elimination in the
+    // predecessor might have removed the store that established it when this block redefines the register
+    bool inheritedTag = false;
 };
 
 // Load instructions are linked to target register to carry knowledge about the target
@@ -86,6 +93,8 @@ struct ConstPropState
     {
         if (RegisterInfo* info = tryGetRegisterInfo(op))
         {
+            info->inheritedTag = false;
+
             if (info->tag != tag)
             {
                 info->tag = tag;
@@ -124,6 +133,7 @@ struct ConstPropState
         if (invalidateTag)
         {
             reg.tag = 0xff;
+            reg.inheritedTag = false;
         }
 
         if (invalidateValue)
@@ -610,6 +620,7 @@ static void handleBuiltinEffects(ConstPropState& state, LuauBuiltinFunction bfid
     case LBF_VECTOR_MAX:
     case LBF_VECTOR_LERP:
     case LBF_MATH_LERP:
+    case LBF_STRBUF_APPEND:
         break;
     case LBF_TABLE_INSERT:
         state.invalidateHeap();
@@ -690,7 +701,7 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
                 // Register in this optimization cannot be captured to avoid complications in lowering (IrValueLocationTracking doesn't model it)
                 std::tie(activeLoadCmd, activeLoadValue) = state.getPreviousVersionedLoadForTag(value, source);
 
-                if (state.tryGetTag(source) == value)
+                if (state.tryGetTag(source) == value && !state.regs[vmRegOp(source)].inheritedTag)
                     kill(function, inst);
                 else
                     state.saveTag(source, value);
@@ -908,9 +919,9 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
         if (valueA && valueB)
         {
             if (compare(*valueA, *valueB, conditionOp(inst.c)))
-                replace(function, block, index, {IrCmd::JUMP, inst.c});
-            else
                 replace(function, block, index, {IrCmd::JUMP, inst.d});
+            else
+                replace(function, block, index, {IrCmd::JUMP, inst.e});
         }
         break;
     }
@@ -1344,6 +1355,11 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
         state.invalidateTableArraySize();
         break;
     case IrCmd::STRING_LEN:
+        // Strings are immutable
+        state.substituteOrRecord(inst, index);
+        break;
+    case IrCmd::STRING_CHAR:
+    case IrCmd::STRING_SUB:
     case IrCmd::NEW_TABLE:
     case IrCmd::DUP_TABLE:
         break;
@@ -1363,11 +1379,14 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             state.tryNumToIndexCache.push_back(index);
         break;
     case IrCmd::TRY_CALL_FASTGETTM:
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
         break;
     case IrCmd::NEW_USERDATA:
         if (int(state.useradataTagCache.size()) < FInt::LuauCodeGenReuseUdataTagLimit)
             state.useradataTagCache.push_back(index);
         break;
+    case IrCmd::STRBUF_APPEND:
+        break;
     case IrCmd::INT_TO_NUM:
     case IrCmd::UINT_TO_NUM:
         state.substituteOrRecord(inst, index);
@@ -1479,11 +1498,18 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             replace(function, inst.a, a->a);
         break;
 
+        // These instructions are only created by final x64 lowering after all other optimizations
+    case IrCmd::MULADD_NUM:
+    case IrCmd::MULADD_VEC:
+        break;
+
     case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::CHECK_CLOSURE_PROTO:
     case IrCmd::BARRIER_TABLE_BACK:
     case IrCmd::RETURN:
     case IrCmd::COVERAGE:
+    case IrCmd::INC_EXEC_COUNTER:
     case IrCmd::SET_SAVEDPC:  // TODO: we may be able to remove some updates to PC
     case IrCmd::CLOSE_UPVALS: // Doesn't change memory that we track
     case IrCmd::CAPTURE:
@@ -1638,12 +1664,395 @@ static void constPropInBlock(IrBuilder& build, IrBlock& block, ConstPropState& s
     }
 }
 
-static void constPropInBlockChain(IrBuilder& build, std::vector<uint8_t>& visited, IrBlock* block, ConstPropState& state)
+// Knowledge about VM registers at the start of a block that holds on all paths into it
+// SSA values are not included, they cannot be used across block joins
+struct BlockEntryState
+{
+    bool reachable = false;
+    bool inSafeEnv = false;
+
+    std::vector<uint8_t> tags;
+    std::vector<uint8_t> tables;
+};
+
+constexpr uint8_t kTableKnownNoMetatable = 1 << 0;
+constexpr uint8_t kTableKnownNotReadonly = 1 << 1;
+
+// Forward dataflow analysis of register tags, table properties and safe environment established by the predecessors of each block
+struct BlockEntryStateAnalysis
+{
+    BlockEntryStateAnalysis(IrFunction& function)
+        : function(function)
+        , regCount(function.proto ? function.proto->maxstacksize : 256)
+        , versions(regCount, 0)
+    {
+    }
+
+    void run()
+    {
+        states.resize(function.blocks.size());
+
+        std::vector<uint32_t> queue;
+        std::vector<uint8_t> queued(function.blocks.size(), false);
+
+        std::vector<uint8_t> external = getExternalEntries();
+
+        for (size_t i = 0; i < function.blocks.size(); i++)
+        {
+            if (external[i])
+            {
+                BlockEntryState& state = states[i];
+                state.reachable = true;
+                state.tags.assign(regCount, 0xff);
+                state.tables.assign(regCount, 0);
+
+                queue.push_back(uint32_t(i));
+                queued[i] = true;
+            }
+        }
+
+        while (!queue.empty())
+        {
+            uint32_t blockIdx = queue.back();
+            queue.pop_back();
+            queued[blockIdx] = false;
+
+            IrBlock& block = function.blocks[blockIdx];
+
+            current = states[blockIdx];
+            loadVersions.clear();
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                bool hasBlockOp = false;
+
+                for (IrOp op : {inst.a, inst.b, inst.c, inst.d, inst.e, inst.f, inst.g})
+                    hasBlockOp |= op.kind == IrOpKind::Block;
+
+                // Side exits to other blocks can happen before or after the instruction effects
+                if (hasBlockOp)
+                    previous = current;
+
+                transfer(inst, index);
+
+                if (!hasBlockOp)
+                    continue;
+
+                for (IrOp op : {inst.a, inst.b, inst.c, inst.d, inst.e, inst.f, inst.g})
+                {
+                    if (op.kind != IrOpKind::Block || external[op.index])
+                        continue;
+
+                    if (merge(states[op.index]) && !queued[op.index])
+                    {
+                        queue.push_back(op.index);
+                        queued[op.index] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Native code can be entered at function start and at loop back-edge targets when a running frame switches from the interpreter
+    std::vector<uint8_t> getExternalEntries()
+    {
+        std::vector<uint8_t> external(function.blocks.size(), false);
+
+        std::vector<uint32_t> blockAtStart(function.instructions.size(), ~0u);
+
+        for (size_t i = 0; i < function.blocks.size(); i++)
+        {
+            const IrBlock& block = function.blocks[i];
+
+            if (block.kind == IrBlockKind::Dead)
+                continue;
+
+            blockAtStart[block.start] = uint32_t(i);
+
+            if (uint32_t(i) == function.entryBlock || predecessors(function.cfg, uint32_t(i)).empty())
+                external[i] = true;
+        }
+
+        if (Proto* proto = function.proto)
+        {
+            for (int i = 0; i < proto->sizecode;)
+            {
+                const Instruction* pc = &proto->code[i];
+                LuauOpcode op = LuauOpcode(LUAU_INSN_OP(*pc));
+
+                int target = getJumpTarget(*pc, uint32_t(i));
+
+                if (target >= 0 && target <= i && size_t(target) < function.bcMapping.size())
+                {
+                    uint32_t location = function.bcMapping[target].irLocation;
+
+                    if (location < blockAtStart.size() && blockAtStart[location] != ~0u)
+                        external[blockAtStart[location]] = true;
+                }
+
+                i += getOpLength(op);
+            }
+        }
+
+        return external;
+    }
+
+    void transfer(const IrInst& inst, uint32_t index)
+    {
+        switch (inst.cmd)
+        {
+        case IrCmd::LOAD_TAG:
+        case IrCmd::LOAD_POINTER:
+            if (inst.a.kind == IrOpKind::VmReg && uint32_t(vmRegOp(inst.a)) < regCount)
+                loadVersions[index] = versions[vmRegOp(inst.a)];
+            break;
+        case IrCmd::STORE_TAG:
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                if (uint32_t reg = vmRegOp(inst.a); reg < regCount)
+                {
+                    invalidate(reg);
+
+                    if (inst.b.kind == IrOpKind::Constant)
+                        setTag(reg, function.tagOp(inst.b));
+                }
+            }
+            break;
+        case IrCmd::STORE_EXTRA:
+        case IrCmd::STORE_POINTER:
+        case IrCmd::STORE_DOUBLE:
+        case IrCmd::STORE_INT:
+        case IrCmd::STORE_VECTOR:
+            // Partial stores keep the tag
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                if (uint32_t reg = vmRegOp(inst.a); reg < regCount)
+                {
+                    uint8_t tag = current.tags[reg];
+                    invalidate(reg);
+                    setTag(reg, tag);
+                }
+            }
+            break;
+        case IrCmd::STORE_SPLIT_TVALUE:
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                if (uint32_t reg = vmRegOp(inst.a); reg < regCount)
+                {
+                    invalidate(reg);
+                    setTag(reg, function.tagOp(inst.b));
+                }
+            }
+            break;
+        case IrCmd::CHECK_TAG:
+            if (uint32_t reg = getLoadedReg(inst.a); reg != ~0u)
+                setTag(reg, function.tagOp(inst.b));
+            break;
+        case IrCmd::CHECK_NO_METATABLE:
+            if (uint32_t reg = getLoadedReg(inst.a); reg != ~0u)
+                current.tables[reg] |= kTableKnownNoMetatable;
+            break;
+        case IrCmd::CHECK_READONLY:
+            if (uint32_t reg = getLoadedReg(inst.a); reg != ~0u)
+                current.tables[reg] |= kTableKnownNotReadonly;
+            break;
+        case IrCmd::CHECK_SAFE_ENV:
+            current.inSafeEnv = true;
+            break;
+        case IrCmd::FORGLOOP:
+            // Constant propagation of this instruction invalidates all registers starting from Rn+2, we follow it here
+            for (uint32_t reg = vmRegOp(inst.a) + 2; reg < regCount; reg++)
+                invalidate(reg);
+            break;
+        default:
+            visitVmRegDefsUses(*this, function, inst);
+            break;
+        }
+
+        if (!isTableStateNeutral(inst.cmd))
+        {
+            current.inSafeEnv = false;
+            std::fill(current.tables.begin(), current.tables.end(), 0);
+        }
+    }
+
+    // Find the register that the operand was loaded from, as long as the register hasn't changed since
+    uint32_t getLoadedReg(IrOp op)
+    {
+        if (op.kind == IrOpKind::VmReg)
+            return uint32_t(vmRegOp(op)) < regCount && !function.cfg.captured.regs.test(vmRegOp(op)) ? vmRegOp(op) : ~0u;
+
+        if (op.kind != IrOpKind::Inst)
+            return ~0u;
+
+        const uint32_t* version = loadVersions.find(op.index);
+
+        if (!version)
+            return ~0u;
+
+        uint32_t reg = vmRegOp(function.instOp(op).a);
+
+        if (versions[reg] != *version || function.cfg.captured.regs.test(reg))
+            return ~0u;
+
+        return reg;
+    }
+
+    void setTag(uint32_t reg, uint8_t tag)
+    {
+        // Captured registers can be modified by any call
+        if (!function.cfg.captured.regs.test(reg))
+            current.tags[reg] = tag;
+    }
+
+    void invalidate(uint32_t reg)
+    {
+        if (reg >= regCount)
+            return;
+
+        current.tags[reg] = 0xff;
+        current.tables[reg] = 0;
+        versions[reg]++;
+    }
+
+    bool merge(BlockEntryState& target)
+    {
+        if (!target.reachable)
+        {
+            target.reachable = true;
+            target.inSafeEnv = current.inSafeEnv && previous.inSafeEnv;
+            target.tags = current.tags;
+            target.tables = current.tables;
+
+            for (uint32_t reg = 0; reg < regCount; reg++)
+            {
+                if (target.tags[reg] != previous.tags[reg])
+                    target.tags[reg] = 0xff;
+
+                target.tables[reg] &= previous.tables[reg];
+            }
+
+            return true;
+        }
+
+        bool changed = false;
+
+        if (target.inSafeEnv && !(current.inSafeEnv && previous.inSafeEnv))
+        {
+            target.inSafeEnv = false;
+            changed = true;
+        }
+
+        for (uint32_t reg = 0; reg < regCount; reg++)
+        {
+            if (target.tags[reg] != 0xff && (target.tags[reg] != current.tags[reg] || target.tags[reg] != previous.tags[reg]))
+            {
+                target.tags[reg] = 0xff;
+                changed = true;
+            }
+
+            if (uint8_t tables = target.tables[reg] & current.tables[reg] & previous.tables[reg]; tables != target.tables[reg])
+            {
+                target.tables[reg] = tables;
+                changed = true;
+            }
+        }
+
+        return changed;
+    }
+
+    // Register visitor interface
+    void def(IrOp op, int offset = 0)
+    {
+        invalidate(vmRegOp(op) + offset);
+    }
+
+    void use(IrOp op, int offset = 0) {}
+
+    void maybeDef(IrOp op)
+    {
+        if (op.kind == IrOpKind::VmReg)
+            def(op);
+    }
+
+    void maybeUse(IrOp op) {}
+
+    void defVarargs(uint8_t varargStart)
+    {
+        for (uint32_t reg = varargStart; reg < regCount; reg++)
+            invalidate(reg);
+    }
+
+    void useVarargs(uint8_t varargStart) {}
+
+    void defRange(int start, int count)
+    {
+        if (count == -1)
+        {
+            defVarargs(start);
+        }
+        else
+        {
+            for (int i = start; i < start + count; i++)
+                invalidate(i);
+        }
+    }
+
+    void useRange(int start, int count) {}
+
+    void capture(int reg) {}
+
+    IrFunction& function;
+    uint32_t regCount = 0;
+
+    std::vector<BlockEntryState> states;
+
+    BlockEntryState current;
+    BlockEntryState previous;
+
+    // Register versions are used to check that the register hasn't changed between the load and the check
+    std::vector<uint32_t> versions;
+    DenseHashMap<uint32_t, uint32_t> loadVersions{~0u};
+};
+
+static void constPropInBlockChain(
+    IrBuilder& build,
+    std::vector<uint8_t>& visited,
+    IrBlock* block,
+    ConstPropState& state,
+    const BlockEntryState* entryState
+)
 {
     IrFunction& function = build.function;
 
     state.clear();
 
+    if (entryState && entryState->reachable)
+    {
+        for (size_t i = 0; i < entryState->tags.size(); i++)
+        {
+            RegisterInfo& info = state.regs[i];
+
+            if (entryState->tags[i] != 0xff)
+            {
+                info.tag = entryState->tags[i];
+                info.inheritedTag = true;
+                state.maxReg = int(i) > state.maxReg ? int(i) : state.maxReg;
+            }
+
+            if (entryState->tables[i] != 0)
+            {
+                info.knownNoMetatable = (entryState->tables[i] & kTableKnownNoMetatable) != 0;
+                info.knownNotReadonly = (entryState->tables[i] & kTableKnownNotReadonly) != 0;
+                state.maxReg = int(i) > state.maxReg ? int(i) : state.maxReg;
+            }
+        }
+
+        state.inSafeEnv = entryState->inSafeEnv;
+    }
+
     const uint32_t startSortkey = block->sortkey;
     uint32_t chainPos = 0;
 
@@ -1857,6 +2266,12 @@ void constPropInBlockChains(IrBuilder& build)
 
     ConstPropState state{function};
 
+    // Register knowledge is carried across block joins when CFG information is available
+    BlockEntryStateAnalysis entryStates{function};
+
+    if (!FFlag::DebugCodegenSkipCrossBlockPropagation && function.cfg.predecessorsOffsets.size() == function.blocks.size())
+        entryStates.run();
+
     std::vector<uint8_t> visited(function.blocks.size(), false);
 
     for (IrBlock& block : function.blocks)
@@ -1864,10 +2279,12 @@ void constPropInBlockChains(IrBuilder& build)
         if (block.kind == IrBlockKind::Fallback || block.kind == IrBlockKind::Dead)
             continue;
 
-        if (visited[function.getBlockIndex(block)])
+        uint32_t blockIdx = function.getBlockIndex(block);
+
+        if (visited[blockIdx])
             continue;
 
-        constPropInBlockChain(build, visited, &block, state);
+        constPropInBlockChain(build, visited, &block, state, blockIdx < entryStates.states.size() ? &entryStates.states[blockIdx] : nullptr);
     }
 }
 
@@ -709,8 +709,12 @@ static void markDeadStoresInInst(RemoveDeadStoreState& state, IrBuilder& build,
         state.checkLiveIns(inst.b);
         break;
     case IrCmd::TRY_CALL_FASTGETTM:
+    case IrCmd::GET_USERDATA_CACHE_ADDR:
         state.checkLiveIns(inst.c);
         break;
+    case IrCmd::STRING_CHAR:
+        state.checkLiveIns(inst.b);
+        break;
     case IrCmd::CHECK_FASTCALL_RES:
         state.checkLiveIns(inst.b);
         break;
@@ -738,6 +742,9 @@ static void markDeadStoresInInst(RemoveDeadStoreState& state, IrBuilder& build,
     case IrCmd::CHECK_NODE_VALUE:
         state.checkLiveIns(inst.b);
         break;
+    case IrCmd::CHECK_CLOSURE_PROTO:
+        state.checkLiveIns(inst.c);
+        break;
     case IrCmd::CHECK_BUFFER_LEN:
         state.checkLiveIns(inst.d);
         break;
@@ -755,6 +762,14 @@ static void markDeadStoresInInst(RemoveDeadStoreState& state, IrBuilder& build,
         // At the end of a function, we can kill stores to registers that are not live out
         state.checkLiveOuts(block);
         break;
+    case IrCmd::INTERRUPT:
+        if (state.hasGcoToClear)
+            state.flushGcoRegs();
+
+        // Execution can continue in a different block after the interrupt handler is called
+        if (inst.b.kind == IrOpKind::Block)
+            state.checkLiveIns(inst.b);
+        break;
     case IrCmd::ADJUST_STACK_TO_REG:
         // visitVmRegDefsUses considers adjustment as the fast call register definition point, but for dead store removal, we count the actual writes
         break;
@@ -769,7 +784,6 @@ static void markDeadStoresInInst(RemoveDeadStoreState& state, IrBuilder& build,
     case IrCmd::GET_IMPORT:
     case IrCmd::GET_CACHED_IMPORT:
     case IrCmd::CONCAT:
-    case IrCmd::INTERRUPT:
     case IrCmd::CHECK_GC:
     case IrCmd::CALL:
     case IrCmd::FORGLOOP_FALLBACK:
@@ -0,0 +1,1293 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "Luau/OptimizeEscape.h"
+
+#include "Luau/DenseHash.h"
+#include "Luau/IrAnalysis.h"
+#include "Luau/IrBuilder.h"
+#include "Luau/IrUtils.h"
+#include "Luau/IrVisitUseDef.h"
+
+#include "lobject.h"
+#include "lstate.h"
+#include "ltable.h"
+
+#include <bitset>
+#include <vector>
+
+// Tables with more fields than this limit are not replaced
+LUAU_FASTINTVARIABLE(LuauCodeGenScalarReplacementFieldLimit, 32)
+
+// Temporary tables are often created, filled and read back inside a single block chain, for example 'local p = {x = a, y = b}'.
+// When such a table doesn't escape the chain, loads from its fields are replaced with the values that were stored into them, and the
+// allocation together with the field stores, guards and GC barriers is removed.
+//
+// A table escapes when:
+// * its pointer is used by anything except field address computations, table guards and GC barriers
+// * a VM register that holds it is read, captured, is live at the block that follows the chain, or is live at an exit where the table
+//   cannot be materialized
+// * a field is accessed by a key that is not known during compilation, or which is not present in the table
+// * a field is read before a value was written to it, or after an instruction that cannot keep values in registers (a call, for example)
+// * a field holds a GC object that is no longer kept alive by a VM register at a point where garbage collection can run
+//
+// When the table is live at a VM exit or at the start of a fallback block, the exit is redirected through a new fallback block that allocates
+// the table, fills it and stores it into the registers that held it. Exit targets are lowered separately from the chain and cannot use its
+// values, so this is only possible when every field can be reloaded from a VM register that wasn't changed since, or from a constant.
+//
+// Registers that held the table keep their previous values; like dead store elimination, this assumes that the interrupt handler doesn't
+// inspect the registers of a running function.
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// The field value is not a GC object or it's a constant that is kept alive by the function
+constexpr int kNoBackingReg = -1;
+
+// The field value might be a GC object that is not referenced by any VM register
+constexpr int kLostBackingReg = -2;
+
+struct VirtualField
+{
+    bool assigned = false;
+
+    // TValue, or a value for STORE_SPLIT_TVALUE when the tag is specified
+    IrOp value;
+    IrOp tag;
+
+    // VM register that keeps the GC object stored in the field alive
+    int backingReg = kNoBackingReg;
+
+    // Values stored before an instruction that requires all values to be spilled cannot be used after it
+    uint32_t epoch = 0;
+};
+
+enum class DerivedKind : uint8_t
+{
+    Table,
+    Field,
+    FieldLoad,
+};
+
+struct DerivedValue
+{
+    DerivedKind kind = DerivedKind::Table;
+
+    // Node index for DUP_TABLE, array index for NEW_TABLE
+    int field = -1;
+};
+
+struct FieldLoad
+{
+    uint32_t index = 0;
+    VirtualField field;
+};
+
+struct SplitStoreRewrite
+{
+    uint32_t index = 0;
+    uint32_t block = 0;
+    VirtualField field;
+};
+
+// Value that can be reloaded outside of the chain
+struct FieldSource
+{
+    int field = -1;
+
+    // Load instruction to repeat, or NOP when the value is a constant
+    IrInst load = {IrCmd::NOP};
+
+    IrOp value;
+    IrOp tag;
+};
+
+struct ExitMaterialization
+{
+    uint32_t index = 0;
+    int operand = 0;
+
+    std::bitset<256> homes;
+    std::vector<FieldSource> fields;
+};
+
+struct RegisterLoad
+{
+    int reg = -1;
+    uint32_t version = 0;
+};
+
+struct TableScalarReplacement;
+
+struct EscapeRegVisitor
+{
+    TableScalarReplacement& state;
+
+    void def(IrOp op, int offset = 0);
+    void use(IrOp op, int offset = 0);
+    void maybeDef(IrOp op);
+    void maybeUse(IrOp op);
+    void defVarargs(uint8_t varargStart);
+    void useVarargs(uint8_t varargStart);
+    void defRange(int start, int count);
+    void useRange(int start, int count);
+    void capture(int reg);
+};
+
+struct TableScalarReplacement
+{
+    TableScalarReplacement(IrBuilder& build, const std::vector<uint32_t>& chain)
+        : build(build)
+        , function(build.function)
+        , chain(chain)
+    {
+    }
+
+    IrBuilder& build;
+    IrFunction& function;
+    const std::vector<uint32_t>& chain;
+
+    uint32_t tableIndex = kInvalidInstIdx;
+
+    // Table constant that is copied by DUP_TABLE; the copy has the same node layout
+    LuaTable* layout = nullptr;
+
+    IrOp layoutConst;
+
+    // Array size of a NEW_TABLE
+    int arraySize = 0;
+
+    // Allocation is repeated with the same operands and saved pc on exits
+    IrOp allocA;
+    IrOp allocB;
+    IrOp savedPc;
+
+    std::vector<VirtualField> fields;
+    DenseHashMap<uint32_t, DerivedValue> derived{kInvalidInstIdx};
+
+    // Registers that hold the table
+    std::bitset<256> homes;
+
+    // Registers where the table pointer was stored, but not the tag yet
+    std::bitset<256> pendingTag;
+
+    // Registers that hold the table, but a different value was stored and the tag is not updated yet
+    std::bitset<256> pendingValue;
+
+    // Last value stored into each register, used to replace SETLIST
+    VirtualField regValues[256];
+    IrOp regPartialValues[256];
+
+    // Loads of VM registers are used to find out if the loaded GC object is still referenced by the register
+    uint32_t regVersions[256] = {};
+    DenseHashMap<uint32_t, RegisterLoad> regLoads{kInvalidInstIdx};
+
+    uint32_t epoch = 0;
+    bool escaped = false;
+
+    std::vector<uint32_t> removed;
+    std::vector<uint32_t> tagLoads;
+    std::vector<FieldLoad> loads;
+    std::vector<SplitStoreRewrite> splitStores;
+    std::vector<uint32_t> derivedList;
+    std::vector<ExitMaterialization> exits;
+
+    bool init(uint32_t blockStart, uint32_t index)
+    {
+        IrInst& inst = function.instructions[index];
+
+        if (inst.cmd == IrCmd::NEW_TABLE)
+        {
+            arraySize = int(function.uintOp(inst.a));
+
+            if (arraySize > FInt::LuauCodeGenScalarReplacementFieldLimit)
+                return false;
+        }
+        else if (inst.cmd == IrCmd::DUP_TABLE)
+        {
+            IrInst* source = function.asInstOp(inst.a);
+
+            if (!function.proto || !source || source->cmd != IrCmd::LOAD_POINTER || source->a.kind != IrOpKind::VmConst)
+                return false;
+
+            int k = vmConstOp(source->a);
+
+            if (k >= function.proto->sizek || !ttistable(&function.proto->k[k]))
+                return false;
+
+            layout = hvalue(&function.proto->k[k]);
+            layoutConst = source->a;
+
+            if (sizenode(layout) > FInt::LuauCodeGenScalarReplacementFieldLimit)
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+
+        tableIndex = index;
+        fields.resize(layout ? sizenode(layout) : arraySize);
+
+        allocA = inst.a;
+        allocB = inst.b;
+
+        for (uint32_t i = index; i > blockStart; i--)
+        {
+            if (function.instructions[i - 1].cmd == IrCmd::SET_SAVEDPC)
+            {
+                savedPc = function.instructions[i - 1].a;
+                break;
+            }
+        }
+
+        addDerived(index, DerivedKind::Table, -1);
+        return true;
+    }
+
+    bool run(size_t chainPos)
+    {
+        // Values that are stored into the table might be loaded from or stored into registers before the allocation
+        for (size_t pos = 0; pos <= chainPos; pos++)
+        {
+            IrBlock& block = function.blocks[chain[pos]];
+
+            uint32_t end = pos == chainPos ? tableIndex : block.finish + 1;
+
+            for (uint32_t index = block.start; index < end; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                if (isPseudo(inst.cmd))
+                    continue;
+
+                visitRegisters(index, inst);
+                visitValueBarrier(inst);
+            }
+        }
+
+        for (size_t pos = chainPos; pos < chain.size(); pos++)
+        {
+            uint32_t blockIdx = chain[pos];
+            IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = pos == chainPos ? tableIndex + 1 : block.start; index <= block.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                if (isPseudo(inst.cmd))
+                    continue;
+
+                // Jump to the next block of the chain is not an exit
+                bool continuation = index == block.finish && pos + 1 < chain.size();
+
+                visit(blockIdx, index, inst, continuation);
+
+                if (escaped)
+                    return false;
+            }
+        }
+
+        // Tables that are never read from are left alone, they are often created only to put pressure on the garbage collector
+        return !loads.empty() || !tagLoads.empty();
+    }
+
+    void apply(size_t chainPos)
+    {
+        for (uint32_t index : tagLoads)
+            substitute(function, function.instructions[index], build.constTag(LUA_TTABLE));
+
+        for (const FieldLoad& load : loads)
+        {
+            if (load.field.tag.kind == IrOpKind::None)
+                substitute(function, function.instructions[load.index], load.field.value);
+        }
+
+        for (const SplitStoreRewrite& store : splitStores)
+        {
+            IrInst& inst = function.instructions[store.index];
+
+            IrInst split = {IrCmd::STORE_SPLIT_TVALUE, inst.a, store.field.tag, store.field.value, inst.c};
+            replace(function, function.blocks[store.block], store.index, split);
+        }
+
+        for (size_t pos = chainPos; pos < chain.size(); pos++)
+        {
+            IrBlock& block = function.blocks[chain[pos]];
+
+            for (uint32_t index = pos == chainPos ? tableIndex + 1 : block.start; index <= block.finish; index++)
+                applySubstitutions(function, function.instructions[index]);
+        }
+
+        for (size_t i = removed.size(); i > 0; i--)
+            kill(function, function.instructions[removed[i - 1]]);
+
+        // Field addresses and table pointer loads are left without uses
+        for (size_t i = derivedList.size(); i > 0; i--)
+        {
+            IrInst& inst = function.instructions[derivedList[i - 1]];
+
+            if (inst.cmd != IrCmd::NOP && inst.useCount == 0)
+                kill(function, inst);
+        }
+
+        CODEGEN_ASSERT(function.instructions[tableIndex].cmd == IrCmd::NOP);
+
+        for (const ExitMaterialization& exit : exits)
+            materialize(exit);
+    }
+
+    void visit(uint32_t blockIdx, uint32_t index, IrInst& inst, bool continuation)
+    {
+        if (visitTableUse(index, inst))
+            return;
+
+        // Any other use of the table, of its field addresses or of split field values makes the table escape
+        if (!checkOperand(blockIdx, index, inst, inst.a) || !checkOperand(blockIdx, index, inst, inst.b) ||
+            !checkOperand(blockIdx, index, inst, inst.c) || !checkOperand(blockIdx, index, inst, inst.d) ||
+            !checkOperand(blockIdx, index, inst, inst.e) || !checkOperand(blockIdx, index, inst, inst.f) ||
+            !checkOperand(blockIdx, index, inst, inst.g))
+        {
+            escaped = true;
+            return;
+        }
+
+        // Registers holding the table cannot be live at exits unless the table can be materialized there
+        int operand = 0;
+
+        for (IrOp* op : {&inst.a, &inst.b, &inst.c, &inst.d, &inst.e, &inst.f, &inst.g})
+        {
+            if (!checkExit(index, inst, operand++, *op, continuation))
+            {
+                escaped = true;
+                return;
+            }
+        }
+
+        // Garbage collection can run inside instructions that can call into the VM
+        if (!isTableStateNeutral(inst.cmd))
+        {
+            for (const VirtualField& field : fields)
+            {
+                if (field.assigned && field.backingReg == kLostBackingReg)
+                {
+                    escaped = true;
+                    return;
+                }
+            }
+        }
+
+        visitRegisters(index, inst);
+        visitValueBarrier(inst);
+    }
+
+    // Values cannot be kept in registers across these instructions
+    void visitValueBarrier(IrInst& inst)
+    {
+        switch (inst.cmd)
+        {
+        case IrCmd::GET_CACHED_IMPORT:
+        case IrCmd::SETLIST:
+        case IrCmd::CALL:
+        case IrCmd::RETURN:
+        case IrCmd::FORGLOOP:
+            epoch++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Returns true when the instruction is an access to the table that will be removed or replaced
+    bool visitTableUse(uint32_t index, IrInst& inst)
+    {
+        switch (inst.cmd)
+        {
+        case IrCmd::STORE_POINTER:
+            if (inst.a.kind == IrOpKind::VmReg && isTable(inst.b))
+            {
+                int reg = vmRegOp(inst.a);
+
+                if (function.cfg.captured.regs.test(reg) || pendingTag.test(reg) || pendingValue.test(reg))
+                    return escape();
+
+                if (!homes.test(reg))
+                {
+                    defReg(reg);
+                    pendingTag.set(reg);
+                }
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::STORE_TAG:
+            if (inst.a.kind == IrOpKind::VmReg && pendingTag.test(vmRegOp(inst.a)))
+            {
+                if (function.tagOp(inst.b) != LUA_TTABLE)
+                    return escape();
+
+                pendingTag.reset(vmRegOp(inst.a));
+                homes.set(vmRegOp(inst.a));
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::GET_SLOT_NODE_ADDR:
+            if (isTable(inst.a))
+            {
+                int node = layout ? findNode(getKey(inst.c)) : -1;
+
+                if (node < 0)
+                    return escape();
+
+                addDerived(index, DerivedKind::Field, node);
+                return true;
+            }
+            break;
+        case IrCmd::GET_HASH_NODE_ADDR:
+            if (isTable(inst.a))
+            {
+                if (!layout)
+                    return escape();
+
+                // Key at this position is validated by CHECK_SLOT_MATCH
+                addDerived(index, DerivedKind::Field, int(function.uintOp(inst.b) & (sizenode(layout) - 1)));
+                return true;
+            }
+            break;
+        case IrCmd::GET_ARR_ADDR:
+            if (isTable(inst.a))
+            {
+                if (layout || inst.b.kind != IrOpKind::Constant)
+                    return escape();
+
+                addDerived(index, DerivedKind::Field, function.intOp(inst.b));
+                return true;
+            }
+            break;
+        case IrCmd::CHECK_READONLY:
+        case IrCmd::CHECK_NO_METATABLE:
+            if (isTable(inst.a))
+            {
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::CHECK_ARRAY_SIZE:
+            if (isTable(inst.a))
+            {
+                if (layout || inst.b.kind != IrOpKind::Constant || function.intOp(inst.b) < 0 || function.intOp(inst.b) >= arraySize)
+                    return escape();
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::CHECK_SLOT_MATCH:
+            if (isField(inst.a))
+            {
+                LuaNode* node = gnode(layout, derived[inst.a.index].field);
+                TString* key = getKey(inst.b);
+
+                if (!key || !ttisstring(gkey(node)) || tsvalue(gkey(node)) != key)
+                    return escape();
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::CHECK_NODE_VALUE:
+            // Table has no metatable, so a nil value is the result of the lookup, same as in the fast path
+            if (isField(inst.a))
+            {
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::LOAD_TVALUE:
+            if (isField(inst.a))
+            {
+                int field = getFieldAt(inst.a, inst.b);
+
+                if (field < 0 || !fields[field].assigned || fields[field].epoch != epoch)
+                    return escape();
+
+                addDerived(index, DerivedKind::FieldLoad, field);
+                loads.push_back({index, fields[field]});
+                return true;
+            }
+            break;
+        case IrCmd::STORE_TVALUE:
+            if (isField(inst.a))
+            {
+                int field = getFieldAt(inst.a, inst.c);
+
+                if (field < 0)
+                    return escape();
+
+                fields[field] = getStoredValue(inst.b, {});
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::STORE_SPLIT_TVALUE:
+            if (isField(inst.a))
+            {
+                int field = getFieldAt(inst.a, inst.d);
+
+                if (field < 0)
+                    return escape();
+
+                fields[field] = getStoredValue(inst.c, inst.b);
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::BARRIER_OBJ:
+        case IrCmd::BARRIER_TABLE_BACK:
+        case IrCmd::BARRIER_TABLE_FORWARD:
+            if (isTable(inst.a))
+            {
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::LOAD_POINTER:
+            if (isHome(inst.a))
+            {
+                addDerived(index, DerivedKind::Table, -1);
+                return true;
+            }
+            break;
+        case IrCmd::LOAD_TAG:
+            if (isHome(inst.a))
+            {
+                tagLoads.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::CHECK_TAG:
+            if (isHome(inst.a))
+            {
+                if (function.tagOp(inst.b) != LUA_TTABLE)
+                    return escape();
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        case IrCmd::SETLIST:
+            if (isHome(inst.b))
+            {
+                if (layout || inst.d.kind != IrOpKind::Constant || function.intOp(inst.d) < 0)
+                    return escape();
+
+                int source = vmRegOp(inst.c);
+                int count = function.intOp(inst.d);
+                int first = int(function.uintOp(inst.e)) - 1;
+
+                for (int i = 0; i < count; i++)
+                {
+                    if (first + i < 0 || first + i >= arraySize || source + i >= 256 || !regValues[source + i].assigned)
+                        return escape();
+
+                    const VirtualField& value = regValues[source + i];
+
+                    fields[first + i] = getStoredValue(value.value, value.tag);
+
+                    if (value.epoch != epoch)
+                        return escape();
+                }
+
+                removed.push_back(index);
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    bool checkOperand(uint32_t blockIdx, uint32_t index, IrInst& inst, IrOp op)
+    {
+        if (op.kind != IrOpKind::Inst)
+            return true;
+
+        const DerivedValue* value = derived.find(op.index);
+
+        if (!value)
+            return true;
+
+        if (value->kind != DerivedKind::FieldLoad)
+            return false;
+
+        // Loaded TValue is replaced by the stored one
+        FieldLoad* load = findLoad(op.index);
+        CODEGEN_ASSERT(load);
+
+        if (load->field.tag.kind == IrOpKind::None)
+            return true;
+
+        // There is no TValue for a split value, but a store of a loaded TValue can be split
+        if (inst.cmd == IrCmd::STORE_TVALUE && inst.b == op && inst.a != op)
+        {
+            splitStores.push_back({index, blockIdx, load->field});
+            return true;
+        }
+
+        return false;
+    }
+
+    bool checkExit(uint32_t index, IrInst& inst, int operand, IrOp op, bool continuation)
+    {
+        if (op.kind != IrOpKind::Block && op.kind != IrOpKind::VmExit)
+            return true;
+
+        if (continuation && inst.cmd == IrCmd::JUMP)
+            return true;
+
+        std::bitset<256> held = homes | pendingTag | pendingValue;
+
+        if (held.none())
+            return true;
+
+        if (op.kind == IrOpKind::VmExit)
+        {
+            // All registers are live at VM exits
+            if (vmExitOp(op) == kVmExitEntryGuardPc)
+                return false;
+        }
+        else
+        {
+            // Blocks that materialize other tables don't have live register information
+            if (op.index < function.cfg.in.size())
+            {
+                const RegisterSet& in = function.cfg.in[op.index];
+
+                if ((in.regs & held).none() && (!in.varargSeq || (held >> in.varargStart).none()))
+                    return true;
+            }
+
+            // Allocation is only moved to cold code
+            if (function.blocks[op.index].kind != IrBlockKind::Fallback)
+                return false;
+        }
+
+        if (pendingTag.any() || pendingValue.any())
+            return false;
+
+        ExitMaterialization exit;
+        exit.index = index;
+        exit.operand = operand;
+        exit.homes = homes;
+
+        for (int i = 0; i < int(fields.size()); i++)
+        {
+            if (!fields[i].assigned)
+                continue;
+
+            FieldSource source;
+
+            if (!getFieldSource(fields[i], source))
+                return false;
+
+            // Node is addressed by the key hash, keys that were moved by a collision are not supported
+            if (layout && (!ttisstring(gkey(gnode(layout, i))) || (tsvalue(gkey(gnode(layout, i)))->hash & (sizenode(layout) - 1)) != unsigned(i)))
+                return false;
+
+            source.field = i;
+            exit.fields.push_back(source);
+        }
+
+        exits.push_back(std::move(exit));
+        return true;
+    }
+
+    bool getFieldSource(const VirtualField& field, FieldSource& source)
+    {
+        source.value = field.value;
+        source.tag = field.tag;
+
+        if (field.tag.kind != IrOpKind::None && field.tag.kind != IrOpKind::Constant)
+            return false;
+
+        if (field.value.kind == IrOpKind::Constant)
+            return field.tag.kind == IrOpKind::Constant;
+
+        IrInst* value = function.asInstOp(field.value);
+
+        if (!value)
+            return false;
+
+        // Load of a register that still has the same value or a load of a constant can be repeated
+        bool tvalue = field.tag.kind == IrOpKind::None;
+
+        if ((value->cmd == IrCmd::LOAD_TVALUE && tvalue) ||
+            (!tvalue && (value->cmd == IrCmd::LOAD_POINTER || value->cmd == IrCmd::LOAD_DOUBLE || value->cmd == IrCmd::LOAD_INT)))
+        {
+            const RegisterLoad* load = value->a.kind == IrOpKind::VmReg ? regLoads.find(field.value.index) : nullptr;
+
+            if (value->a.kind == IrOpKind::VmConst || (load && regVersions[load->reg] == load->version))
+            {
+                source.load = *value;
+                return true;
+            }
+        }
+
+        // Otherwise, the value might have been stored into a register that wasn't changed since
+        IrCmd cmd = IrCmd::LOAD_TVALUE;
+
+        if (!tvalue)
+        {
+            uint8_t tag = function.tagOp(field.tag);
+
+            if (tag == LUA_TNUMBER)
+                cmd = IrCmd::LOAD_DOUBLE;
+            else if (tag == LUA_TBOOLEAN)
+                cmd = IrCmd::LOAD_INT;
+            else if (isGCO(tag))
+                cmd = IrCmd::LOAD_POINTER;
+            else
+                return false;
+        }
+
+        for (int reg = 0; reg < 256; reg++)
+        {
+            const VirtualField& held = regValues[reg];
+
+            if (held.assigned && held.value == field.value && (tvalue ? held.tag.kind == IrOpKind::None : held.tag.kind != IrOpKind::None))
+            {
+                source.load = {cmd, build.vmReg(uint8_t(reg))};
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void materialize(const ExitMaterialization& exit)
+    {
+        IrOp block = build.block(IrBlockKind::Fallback);
+        build.beginBlock(block);
+
+        uint32_t start = uint32_t(function.instructions.size());
+
+        if (savedPc.kind != IrOpKind::None)
+            build.inst(IrCmd::SET_SAVEDPC, savedPc);
+
+        IrOp table = layout ? build.inst(IrCmd::DUP_TABLE, build.inst(IrCmd::LOAD_POINTER, layoutConst))
+                            : build.inst(IrCmd::NEW_TABLE, allocA, allocB);
+
+        IrOp array = layout ? IrOp{} : build.inst(IrCmd::GET_ARR_ADDR, table, build.constInt(0));
+
+        for (const FieldSource& source : exit.fields)
+        {
+            IrOp value = source.value;
+
+            if (source.load.cmd != IrCmd::NOP)
+                value = build.inst(source.load.cmd, source.load.a, source.load.b, source.load.c);
+
+            IrOp address = array;
+            int offset = source.field * int(sizeof(TValue));
+
+            if (layout)
+            {
+                address = build.inst(IrCmd::GET_HASH_NODE_ADDR, table, build.constUint(tsvalue(gkey(gnode(layout, source.field)))->hash));
+                offset = offsetof(LuaNode, val);
+            }
+
+            if (source.tag.kind == IrOpKind::None)
+                build.inst(IrCmd::STORE_TVALUE, address, value, build.constInt(offset));
+            else
+                build.inst(IrCmd::STORE_SPLIT_TVALUE, address, source.tag, value, build.constInt(offset));
+        }
+
+        for (int reg = 0; reg < 256; reg++)
+        {
+            if (exit.homes.test(reg))
+            {
+                build.inst(IrCmd::STORE_POINTER, build.vmReg(uint8_t(reg)), table);
+                build.inst(IrCmd::STORE_TAG, build.vmReg(uint8_t(reg)), build.constTag(LUA_TTABLE));
+            }
+        }
+
+        IrInst& inst = function.instructions[exit.index];
+        IrOp* ops[] = {&inst.a, &inst.b, &inst.c, &inst.d, &inst.e, &inst.f, &inst.g};
+
+        build.inst(IrCmd::JUMP, *ops[exit.operand]);
+
+        for (uint32_t index = start; index < function.instructions.size(); index++)
+        {
+            IrInst& added = function.instructions[index];
+
+            for (IrOp op : {added.a, added.b, added.c, added.d, added.e, added.f, added.g})
+                addUse(function, op);
+        }
+
+        // Instruction storage could have been reallocated
+        IrInst& exitInst = function.instructions[exit.index];
+        IrOp* exitOps[] = {&exitInst.a, &exitInst.b, &exitInst.c, &exitInst.d, &exitInst.e, &exitInst.f, &exitInst.g};
+
+        replace(function, *exitOps[exit.operand], block);
+    }
+
+    void visitRegisters(uint32_t index, IrInst& inst)
+    {
+        switch (inst.cmd)
+        {
+        case IrCmd::LOAD_TAG:
+        case IrCmd::LOAD_POINTER:
+        case IrCmd::LOAD_DOUBLE:
+        case IrCmd::LOAD_INT:
+        case IrCmd::LOAD_FLOAT:
+        case IrCmd::LOAD_TVALUE:
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                int reg = vmRegOp(inst.a);
+
+                useReg(reg);
+                regLoads[index] = {reg, regVersions[reg]};
+            }
+            return;
+        case IrCmd::STORE_TAG:
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                int reg = vmRegOp(inst.a);
+                uint8_t tag = function.tagOp(inst.b);
+
+                if (pendingTag.test(reg))
+                {
+                    escaped = true;
+                    return;
+                }
+
+                // The value part of the register wasn't written and is left from an earlier value
+                if (homes.test(reg) && tag != LUA_TNIL && !pendingValue.test(reg))
+                {
+                    escaped = true;
+                    return;
+                }
+
+                IrOp partial = regPartialValues[reg];
+
+                defReg(reg);
+
+                if (partial.kind != IrOpKind::None)
+                    regValues[reg] = getStoredValue(partial, inst.b);
+            }
+            return;
+        case IrCmd::STORE_EXTRA:
+        case IrCmd::STORE_POINTER:
+        case IrCmd::STORE_DOUBLE:
+        case IrCmd::STORE_INT:
+            if (inst.a.kind == IrOpKind::VmReg)
+                storePartial(vmRegOp(inst.a), inst.cmd == IrCmd::STORE_EXTRA ? IrOp{} : inst.b);
+            return;
+        case IrCmd::STORE_VECTOR:
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                if (inst.e.kind != IrOpKind::None)
+                    defReg(vmRegOp(inst.a));
+                else
+                    storePartial(vmRegOp(inst.a), {});
+            }
+            return;
+        case IrCmd::STORE_TVALUE:
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                int reg = vmRegOp(inst.a);
+
+                if (pendingTag.test(reg))
+                {
+                    escaped = true;
+                    return;
+                }
+
+                VirtualField value = getStoredValue(inst.b, {});
+
+                defReg(reg);
+                regValues[reg] = value;
+            }
+            return;
+        case IrCmd::STORE_SPLIT_TVALUE:
+            if (inst.a.kind == IrOpKind::VmReg)
+            {
+                int reg = vmRegOp(inst.a);
+
+                if (pendingTag.test(reg))
+                {
+                    escaped = true;
+                    return;
+                }
+
+                VirtualField value = getStoredValue(inst.c, inst.b);
+
+                defReg(reg);
+                regValues[reg] = value;
+            }
+            return;
+        default:
+            break;
+        }
+
+        EscapeRegVisitor visitor{*this};
+        visitVmRegDefsUses(visitor, function, inst);
+    }
+
+    void storePartial(int reg, IrOp value)
+    {
+        if (pendingTag.test(reg))
+        {
+            escaped = true;
+            return;
+        }
+
+        bool home = homes.test(reg);
+
+        defReg(reg);
+
+        // Register keeps holding the table until the tag is updated
+        if (home)
+        {
+            homes.set(reg);
+            pendingValue.set(reg);
+        }
+
+        regPartialValues[reg] = value;
+    }
+
+    void useReg(int reg)
+    {
+        if (homes.test(reg) || pendingTag.test(reg) || pendingValue.test(reg))
+            escaped = true;
+    }
+
+    void defReg(int reg)
+    {
+        if (pendingTag.test(reg))
+            escaped = true;
+
+        homes.reset(reg);
+        pendingValue.reset(reg);
+
+        regValues[reg] = {};
+        regPartialValues[reg] = {};
+        regVersions[reg]++;
+
+        for (VirtualField& field : fields)
+        {
+            if (field.assigned && field.backingReg == reg)
+                field.backingReg = kLostBackingReg;
+        }
+    }
+
+    VirtualField getStoredValue(IrOp value, IrOp tag)
+    {
+        // Value loaded from a field of this table
+        if (tag.kind == IrOpKind::None && value.kind == IrOpKind::Inst)
+        {
+            if (FieldLoad* load = findLoad(value.index))
+            {
+                VirtualField result = load->field;
+                result.epoch = epoch;
+                return result;
+            }
+        }
+
+        VirtualField result;
+        result.assigned = true;
+        result.value = value;
+        result.tag = tag;
+        result.backingReg = getBackingReg(value, tag);
+        result.epoch = epoch;
+        return result;
+    }
+
+    int getBackingReg(IrOp value, IrOp tag)
+    {
+        if (tag.kind != IrOpKind::None && !isGCO(function.tagOp(tag)))
+            return kNoBackingReg;
+
+        IrInst* source = function.asInstOp(value);
+
+        // Constants are kept alive by the function
+        if (!source)
+            return kNoBackingReg;
+
+        if (tag.kind == IrOpKind::None)
+        {
+            if (source->cmd == IrCmd::TAG_VECTOR)
+                return kNoBackingReg;
+
+            if (source->cmd == IrCmd::LOAD_TVALUE && source->c.kind != IrOpKind::None && !isGCO(function.tagOp(source->c)))
+                return kNoBackingReg;
+        }
+
+        if (source->cmd == IrCmd::LOAD_TVALUE || source->cmd == IrCmd::LOAD_POINTER)
+        {
+            if (source->a.kind == IrOpKind::VmConst)
+                return kNoBackingReg;
+
+            if (const RegisterLoad* load = regLoads.find(value.index); load && regVersions[load->reg] == load->version)
+                return load->reg;
+        }
+
+        return kLostBackingReg;
+    }
+
+    int getFieldAt(IrOp pointer, IrOp offsetOp)
+    {
+        int field = derived[pointer.index].field;
+        int offset = offsetOp.kind == IrOpKind::None ? 0 : function.intOp(offsetOp);
+
+        if (layout)
+            return offset == offsetof(LuaNode, val) ? field : -1;
+
+        if (offset % int(sizeof(TValue)) != 0)
+            return -1;
+
+        field += offset / int(sizeof(TValue));
+
+        return field >= 0 && field < arraySize ? field : -1;
+    }
+
+    TString* getKey(IrOp op)
+    {
+        if (op.kind == IrOpKind::VmConst)
+        {
+            const TValue* key = &function.proto->k[vmConstOp(op)];
+
+            return ttisstring(key) ? tsvalue(key) : nullptr;
+        }
+
+        if (op.kind == IrOpKind::Constant && function.constOp(op).kind == IrConstKind::Pointer)
+            return (TString*)function.constOp(op).valuePointer;
+
+        return nullptr;
+    }
+
+    int findNode(TString* key)
+    {
+        if (!key)
+            return -1;
+
+        for (int i = 0; i < sizenode(layout); i++)
+        {
+            LuaNode* node = gnode(layout, i);
+
+            if (ttisstring(gkey(node)) && tsvalue(gkey(node)) == key)
+                return i;
+        }
+
+        return -1;
+    }
+
+    FieldLoad* findLoad(uint32_t index)
+    {
+        const DerivedValue* value = derived.find(index);
+
+        if (!value || value->kind != DerivedKind::FieldLoad)
+            return nullptr;
+
+        for (FieldLoad& load : loads)
+        {
+            if (load.index == index)
+                return &load;
+        }
+
+        return nullptr;
+    }
+
+    void addDerived(uint32_t index, DerivedKind kind, int field)
+    {
+        derived[index] = {kind, field};
+        derivedList.push_back(index);
+    }
+
+    bool isTable(IrOp op)
+    {
+        if (op.kind != IrOpKind::Inst)
+            return false;
+
+        const DerivedValue* value = derived.find(op.index);
+        return value && value->kind == DerivedKind::Table;
+    }
+
+    bool isField(IrOp op)
+    {
+        if (op.kind != IrOpKind::Inst)
+            return false;
+
+        const DerivedValue* value = derived.find(op.index);
+        return value && value->kind == DerivedKind::Field;
+    }
+
+    bool isHome(IrOp op)
+    {
+        return op.kind == IrOpKind::VmReg && homes.test(vmRegOp(op)) && !pendingValue.test(vmRegOp(op));
+    }
+
+    bool escape()
+    {
+        escaped = true;
+        return true;
+    }
+};
+
+void EscapeRegVisitor::def(IrOp op, int offset)
+{
+    state.defReg(vmRegOp(op) + offset);
+}
+
+void EscapeRegVisitor::use(IrOp op, int offset)
+{
+    state.useReg(vmRegOp(op) + offset);
+}
+
+void EscapeRegVisitor::maybeDef(IrOp op)
+{
+    if (op.kind == IrOpKind::VmReg)
+        def(op);
+}
+
+void EscapeRegVisitor::maybeUse(IrOp op)
+{
+    if (op.kind == IrOpKind::VmReg)
+        use(op);
+}
+
+void EscapeRegVisitor::defVarargs(uint8_t varargStart)
+{
+    for (int i = varargStart; i < 256; i++)
+        state.defReg(i);
+}
+
+void EscapeRegVisitor::useVarargs(uint8_t varargStart)
+{
+    for (int i = varargStart; i < 256; i++)
+        state.useReg(i);
+}
+
+void EscapeRegVisitor::defRange(int start, int count)
+{
+    if (count == -1)
+    {
+        defVarargs(start);
+    }
+    else
+    {
+        for (int i = start; i < start + count; i++)
+            state.defReg(i);
+    }
+}
+
+void EscapeRegVisitor::useRange(int start, int count)
+{
+    if (count == -1)
+    {
+        useVarargs(start);
+    }
+    else
+    {
+        for (int i = start; i < start + count; i++)
+            state.useReg(i);
+    }
+}
+
+void EscapeRegVisitor::capture(int reg)
+{
+    state.useReg(reg);
+}
+
+static void collectBlockChain(IrFunction& function, std::vector<uint8_t>& visited, uint32_t blockIdx, std::vector<uint32_t>& chain)
+{
+    chain.clear();
+
+    while (blockIdx != kInvalidInstIdx)
+    {
+        visited[blockIdx] = true;
+        chain.push_back(blockIdx);
+
+        IrBlock& block = function.blocks[blockIdx];
+        IrInst& termInst = function.instructions[block.finish];
+
+        uint32_t nextIdx = kInvalidInstIdx;
+
+        // Values can only be used across blocks that are lowered one after another
+        if (termInst.cmd == IrCmd::JUMP && termInst.a.kind == IrOpKind::Block)
+        {
+            IrBlock& target = function.blockOp(termInst.a);
+
+            if (target.useCount == 1 && target.kind != IrBlockKind::Fallback && !visited[termInst.a.index] &&
+                block.expectedNextBlock == termInst.a.index)
+                nextIdx = termInst.a.index;
+        }
+
+        blockIdx = nextIdx;
+    }
+}
+
+unsigned scalarReplaceTablesInBlockChains(IrBuilder& build)
+{
+    IrFunction& function = build.function;
+
+    // Exits are checked against registers that are live at their targets
+    if (function.cfg.in.empty())
+        return 0;
+
+    // Blocks that materialize tables on exits are added at the end and are not visited
+    uint32_t blockCount = uint32_t(function.blocks.size());
+
+    std::vector<uint8_t> visited(blockCount, false);
+    std::vector<uint32_t> chain;
+
+    unsigned replaced = 0;
+
+    for (uint32_t blockIdx = 0; blockIdx < blockCount; blockIdx++)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        if (block.kind == IrBlockKind::Fallback || block.kind == IrBlockKind::Dead || visited[blockIdx])
+            continue;
+
+        collectBlockChain(function, visited, blockIdx, chain);
+
+        // Removal of a table can also remove a SETLIST which prevented replacement of earlier tables
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+
+            for (size_t pos = 0; pos < chain.size(); pos++)
+            {
+                // Block storage can be reallocated when tables are materialized
+                for (uint32_t index = function.blocks[chain[pos]].start; index <= function.blocks[chain[pos]].finish; index++)
+                {
+                    IrCmd cmd = function.instructions[index].cmd;
+
+                    if (cmd != IrCmd::NEW_TABLE && cmd != IrCmd::DUP_TABLE)
+                        continue;
+
+                    TableScalarReplacement replacement{build, chain};
+
+                    if (replacement.init(function.blocks[chain[pos]].start, index) && replacement.run(pos))
+                    {
+                        replacement.apply(pos);
+                        replaced++;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return replaced;
+}
+
+} // namespace CodeGen
+} // namespace Luau
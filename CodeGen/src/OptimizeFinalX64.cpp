@@ -62,6 +62,7 @@ static void optimizeMemoryOperandsX64(IrFunction& function, IrBlock& block)
         case IrCmd::MOD_NUM:
         case IrCmd::MIN_NUM:
         case IrCmd::MAX_NUM:
+        case IrCmd::MULADD_NUM:
         {
             if (inst.b.kind == IrOpKind::Inst)
             {
@@ -103,7 +104,7 @@ static void optimizeMemoryOperandsX64(IrFunction& function, IrBlock& block)
             {
                 IrInst& num = function.instOp(inst.a);
 
-                if (num.useCount == 1 && num.cmd == IrCmd::LOAD_DOUBLE)
+                if (num.useCount == 1 && num.cmd == IrCmd::LOAD_DOUBLE && (num.a.kind == IrOpKind::VmReg || num.a.kind == IrOpKind::VmConst))
                     replace(function, inst.a, num.a);
             }
             break;
@@ -140,5 +141,59 @@ void optimizeMemoryOperandsX64(IrFunction& function)
     }
 }
 
+// Product is only fused into the addition when it's computed in the same block and isn't used anywhere else
+static bool isFusableProduct(IrFunction& function, const IrBlock& block, IrOp op, IrCmd mulCmd)
+{
+    if (op.kind != IrOpKind::Inst)
+        return false;
+
+    IrInst& mul = function.instOp(op);
+
+    return mul.cmd == mulCmd && mul.useCount == 1 && op.index >= block.start && op.index <= block.finish;
+}
+
+// FMA3 computes 'a * b + c' with a single rounding step, which makes the result more precise than the one computed by the interpreter
+static void fuseMultiplyAddX64(IrFunction& function, IrBlock& block)
+{
+    CODEGEN_ASSERT(block.kind != IrBlockKind::Dead);
+
+    for (uint32_t index = block.start; index <= block.finish; index++)
+    {
+        CODEGEN_ASSERT(index < function.instructions.size());
+        IrInst& inst = function.instructions[index];
+
+        if (inst.cmd != IrCmd::ADD_NUM && inst.cmd != IrCmd::ADD_VEC)
+            continue;
+
+        IrCmd mulCmd = inst.cmd == IrCmd::ADD_NUM ? IrCmd::MUL_NUM : IrCmd::MUL_VEC;
+        IrCmd fusedCmd = inst.cmd == IrCmd::ADD_NUM ? IrCmd::MULADD_NUM : IrCmd::MULADD_VEC;
+
+        IrOp product = inst.a;
+        IrOp addend = inst.b;
+
+        if (!isFusableProduct(function, block, product, mulCmd))
+            std::swap(product, addend);
+
+        if (!isFusableProduct(function, block, product, mulCmd))
+            continue;
+
+        IrInst& mul = function.instOp(product);
+
+        // Multiplication becomes unused and is removed by the replacement
+        replace(function, block, index, {fusedCmd, mul.a, mul.b, addend});
+    }
+}
+
+void fuseMultiplyAddX64(IrFunction& function)
+{
+    for (IrBlock& block : function.blocks)
+    {
+        if (block.kind == IrBlockKind::Dead)
+            continue;
+
+        fuseMultiplyAddX64(function, block);
+    }
+}
+
 } // namespace CodeGen
 } // namespace Luau
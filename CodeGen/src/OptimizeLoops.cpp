@@ -0,0 +1,867 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "Luau/OptimizeLoops.h"
+
+#include "Luau/DenseHash.h"
+#include "Luau/IrAnalysis.h"
+#include "Luau/IrBuilder.h"
+#include "Luau/IrUtils.h"
+#include "Luau/IrVisitUseDef.h"
+
+#include "lobject.h"
+
+#include <algorithm>
+#include <bitset>
+#include <vector>
+
+// Loops with more instructions than this limit are not duplicated
+LUAU_FASTINTVARIABLE(LuauCodeGenLoopVersioningLimit, 256)
+
+// Guards inside the loop body are executed on every iteration, even when the values they check cannot change inside the loop.
+// Our register allocator cannot keep values across block joins, so loads cannot be moved out of the loop into a preheader.
+// Instead, innermost loops are versioned: a preheader block validates the loop-invariant guards once and enters a copy of the loop where these
+// guards are removed. If any preheader check fails or any of the remaining guards in the copy fail, execution continues in the original loop.
+//
+// Guards that can be removed from the copy:
+// * tag checks of registers that are not captured and which tag is not changed inside the loop
+// * metatable, readonly and constant index array size checks of tables held in such registers, when the loop cannot modify tables
+// * array size checks indexed by the numeric for loop index, when the loop limit is in bounds of the table array part
+// * safe environment check, when the loop cannot modify the environment
+//
+// The only instruction that is allowed to modify tables in the loop copy is the interrupt, which might call into the host
+// After the interrupt handler runs, table checks are validated again before continuing in the copy
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// Collects VM registers that are written inside the loop
+struct LoopRegisterDefs
+{
+    // Registers which tag might change
+    std::bitset<256> tags;
+
+    // Registers which value might change
+    std::bitset<256> values;
+
+    void def(IrOp op, int offset = 0)
+    {
+        tags.set(vmRegOp(op) + offset);
+        values.set(vmRegOp(op) + offset);
+    }
+
+    void use(IrOp op, int offset = 0) {}
+
+    void maybeDef(IrOp op)
+    {
+        if (op.kind == IrOpKind::VmReg)
+            def(op);
+    }
+
+    void maybeUse(IrOp op) {}
+
+    void defVarargs(uint8_t varargStart)
+    {
+        for (int i = varargStart; i < 256; i++)
+        {
+            tags.set(i);
+            values.set(i);
+        }
+    }
+
+    void useVarargs(uint8_t varargStart) {}
+
+    void defRange(int start, int count)
+    {
+        if (count == -1)
+        {
+            defVarargs(start);
+        }
+        else
+        {
+            for (int i = start; i < start + count; i++)
+            {
+                tags.set(i);
+                values.set(i);
+            }
+        }
+    }
+
+    void useRange(int start, int count) {}
+
+    void capture(int reg) {}
+};
+
+struct HoistedTableChecks
+{
+    uint8_t reg = 0;
+
+    bool noMetatable = false;
+    bool notReadonly = false;
+
+    // Largest constant array index that is accessed
+    int arrayIndex = -1;
+
+    // Array is accessed by the numeric for loop index
+    bool loopIndex = false;
+};
+
+struct LoopVersioning
+{
+    explicit LoopVersioning(IrBuilder& build)
+        : build(build)
+        , function(build.function)
+    {
+    }
+
+    IrBuilder& build;
+    IrFunction& function;
+
+    std::vector<uint8_t> inLoop;
+    std::vector<uint8_t> inCopy;
+    std::vector<uint32_t> loopBlocks;
+    std::vector<uint32_t> copyBlocks;
+
+    std::vector<uint8_t> instInCopy;
+    std::vector<uint16_t> instUsesInCopy;
+    std::vector<uint8_t> instRemoved;
+
+    LoopRegisterDefs defs;
+
+    // Numeric for loop registers
+    int indexReg = -1;
+    int limitReg = -1;
+
+    // Hoisted checks
+    std::vector<std::pair<uint8_t, uint8_t>> tagChecks;
+    std::vector<HoistedTableChecks> tableChecks;
+    bool safeEnv = false;
+
+    bool hasTableState = false;
+
+    void reset()
+    {
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                instInCopy[index] = false;
+                instUsesInCopy[index] = 0;
+                instRemoved[index] = false;
+            }
+        }
+
+        for (uint32_t blockIdx : loopBlocks)
+            inLoop[blockIdx] = false;
+
+        for (uint32_t blockIdx : copyBlocks)
+            inCopy[blockIdx] = false;
+
+        loopBlocks.clear();
+        copyBlocks.clear();
+
+        defs = {};
+        indexReg = -1;
+        limitReg = -1;
+
+        tagChecks.clear();
+        tableChecks.clear();
+        safeEnv = false;
+
+        hasTableState = false;
+    }
+
+    bool isInvariantTag(int reg) const
+    {
+        return !defs.tags.test(reg) && !function.cfg.captured.regs.test(reg);
+    }
+
+    int getHoistedTag(int reg) const
+    {
+        for (auto [checkReg, tag] : tagChecks)
+        {
+            if (checkReg == reg)
+                return tag;
+        }
+
+        return -1;
+    }
+
+    // Returns the register if the operand is a pointer loaded from a register that holds a table through the whole loop
+    int getInvariantTableReg(IrOp op) const
+    {
+        IrInst* load = function.asInstOp(op);
+
+        if (!load || load->cmd != IrCmd::LOAD_POINTER || load->a.kind != IrOpKind::VmReg)
+            return -1;
+
+        int reg = vmRegOp(load->a);
+
+        if (defs.values.test(reg) || getHoistedTag(reg) != LUA_TTABLE)
+            return -1;
+
+        return reg;
+    }
+
+    HoistedTableChecks& getTableChecks(int reg)
+    {
+        for (HoistedTableChecks& checks : tableChecks)
+        {
+            if (checks.reg == reg)
+                return checks;
+        }
+
+        tableChecks.push_back({uint8_t(reg)});
+        return tableChecks.back();
+    }
+
+    // Check if the operand is the array index computed from the numeric for loop index
+    bool isLoopArrayIndex(IrOp op) const
+    {
+        if (indexReg < 0)
+            return false;
+
+        IrInst* sub = function.asInstOp(op);
+
+        if (!sub || sub->cmd != IrCmd::SUB_INT || sub->b.kind != IrOpKind::Constant || function.intOp(sub->b) != 1)
+            return false;
+
+        IrInst* toIndex = function.asInstOp(sub->a);
+
+        if (!toIndex || toIndex->cmd != IrCmd::TRY_NUM_TO_INDEX)
+            return false;
+
+        IrInst* load = function.asInstOp(toIndex->a);
+
+        return load && load->cmd == IrCmd::LOAD_DOUBLE && load->a.kind == IrOpKind::VmReg && vmRegOp(load->a) == indexReg;
+    }
+
+    bool collectBlocks(const CfgLoop& loop)
+    {
+        loopBlocks = loop.blocks;
+
+        for (uint32_t blockIdx : loopBlocks)
+            inLoop[blockIdx] = true;
+
+        // Loop copy doesn't include fallback blocks, those rejoin the original loop
+        std::vector<uint32_t> worklist;
+        worklist.push_back(loop.header);
+        inCopy[loop.header] = true;
+
+        while (!worklist.empty())
+        {
+            uint32_t blockIdx = worklist.back();
+            worklist.pop_back();
+
+            copyBlocks.push_back(blockIdx);
+
+            for (uint32_t succIdx : successors(function.cfg, blockIdx))
+            {
+                if (inLoop[succIdx] && !inCopy[succIdx] && function.blocks[succIdx].kind != IrBlockKind::Fallback)
+                {
+                    inCopy[succIdx] = true;
+                    worklist.push_back(succIdx);
+                }
+            }
+        }
+
+        // Blocks are copied in the order of their instructions so that values are defined before their uses
+        std::sort(
+            copyBlocks.begin(),
+            copyBlocks.end(),
+            [&](uint32_t a, uint32_t b)
+            {
+                return function.blocks[a].start < function.blocks[b].start;
+            }
+        );
+
+        uint32_t instCount = 0;
+
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+                instInCopy[index] = true;
+
+            instCount += block.finish - block.start + 1;
+        }
+
+        return instCount <= uint32_t(FInt::LuauCodeGenLoopVersioningLimit);
+    }
+
+    bool checkValueFlow()
+    {
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                auto checkOp = [&](IrOp op)
+                {
+                    if (op.kind != IrOpKind::Inst)
+                        return true;
+
+                    // Values coming from outside of the copied blocks are not available
+                    if (!instInCopy[op.index] || op.index >= index)
+                        return false;
+
+                    instUsesInCopy[op.index]++;
+                    return true;
+                };
+
+                if (!checkOp(inst.a) || !checkOp(inst.b) || !checkOp(inst.c) || !checkOp(inst.d) || !checkOp(inst.e) || !checkOp(inst.f) ||
+                    !checkOp(inst.g))
+                    return false;
+            }
+        }
+
+        // Values defined in the copied blocks cannot be used outside of them
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                if (function.instructions[index].useCount != instUsesInCopy[index])
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    void collectDefs()
+    {
+        hasTableState = true;
+
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                switch (inst.cmd)
+                {
+                case IrCmd::STORE_EXTRA:
+                case IrCmd::STORE_POINTER:
+                case IrCmd::STORE_DOUBLE:
+                case IrCmd::STORE_INT:
+                case IrCmd::STORE_VECTOR:
+                    // Partial stores keep the tag
+                    if (inst.a.kind == IrOpKind::VmReg)
+                        defs.values.set(vmRegOp(inst.a));
+                    break;
+                default:
+                    visitVmRegDefsUses(defs, function, inst);
+                    break;
+                }
+
+                if (inst.cmd == IrCmd::INTERRUPT)
+                {
+                    // Interrupt handler can be followed by table check validation only on a block boundary
+                    bool atStart = index == block.start;
+                    bool beforeJump = index + 1 == block.finish && function.instructions[block.finish].cmd == IrCmd::JUMP;
+
+                    if (!atStart && !beforeJump)
+                        hasTableState = false;
+                }
+                else if (!isTableStateNeutral(inst.cmd))
+                {
+                    hasTableState = false;
+                }
+            }
+        }
+    }
+
+    // Numeric for loop with a constant positive step has its index in the [start, limit] range while the loop is running
+    void findNumericLoop(const CfgLoop& loop)
+    {
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+            IrInst& term = function.instructions[block.finish];
+
+            if (term.cmd != IrCmd::JUMP_CMP_NUM || term.d.kind != IrOpKind::Block || term.d.index != loop.header)
+                continue;
+
+            if (conditionOp(term.c) != IrCondition::LessEqual || block.finish == block.start)
+                continue;
+
+            IrInst* idx = function.asInstOp(term.a);
+            IrInst* limit = function.asInstOp(term.b);
+
+            if (!idx || idx->cmd != IrCmd::ADD_NUM || !limit || limit->cmd != IrCmd::LOAD_DOUBLE || limit->a.kind != IrOpKind::VmReg)
+                continue;
+
+            if (idx->b.kind != IrOpKind::Constant || function.doubleOp(idx->b) <= 0.0)
+                continue;
+
+            IrInst* load = function.asInstOp(idx->a);
+
+            if (!load || load->cmd != IrCmd::LOAD_DOUBLE || load->a.kind != IrOpKind::VmReg)
+                continue;
+
+            int ra = vmRegOp(limit->a);
+
+            if (vmRegOp(load->a) != ra + 2)
+                continue;
+
+            // Loop index update has to be the last store
+            IrInst& store = function.instructions[block.finish - 1];
+
+            if (store.cmd != IrCmd::STORE_DOUBLE || store.a.kind != IrOpKind::VmReg || vmRegOp(store.a) != ra + 2 || store.b != term.a)
+                continue;
+
+            if (defs.values.test(ra) || !isInvariantTag(ra) || !isInvariantTag(ra + 2))
+                continue;
+
+            // And it has to be the only store to the loop index
+            bool otherStores = false;
+
+            for (uint32_t otherIdx : copyBlocks)
+            {
+                const IrBlock& other = function.blocks[otherIdx];
+
+                for (uint32_t index = other.start; index <= other.finish; index++)
+                {
+                    IrInst& inst = function.instructions[index];
+
+                    if (index != block.finish - 1 && inst.cmd == IrCmd::STORE_DOUBLE && inst.a.kind == IrOpKind::VmReg && vmRegOp(inst.a) == ra + 2)
+                        otherStores = true;
+                }
+            }
+
+            if (otherStores)
+                continue;
+
+            indexReg = ra + 2;
+            limitReg = ra;
+            return;
+        }
+    }
+
+    bool usesLoopIndex() const
+    {
+        for (const HoistedTableChecks& checks : tableChecks)
+        {
+            if (checks.loopIndex)
+                return true;
+        }
+
+        return false;
+    }
+
+    void addTagCheck(int reg, uint8_t tag)
+    {
+        for (auto& [checkReg, checkTag] : tagChecks)
+        {
+            if (checkReg == reg)
+            {
+                // Conflicting checks are kept in the loop
+                if (checkTag != tag)
+                    checkTag = 0xff;
+                return;
+            }
+        }
+
+        tagChecks.push_back({uint8_t(reg), tag});
+    }
+
+    bool selectChecks()
+    {
+        bool removed = false;
+
+        // Tag checks come first, table checks depend on them
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                if (inst.cmd != IrCmd::CHECK_TAG)
+                    continue;
+
+                IrInst* load = function.asInstOp(inst.a);
+
+                if (load && load->cmd == IrCmd::LOAD_TAG && load->a.kind == IrOpKind::VmReg && isInvariantTag(vmRegOp(load->a)))
+                    addTagCheck(vmRegOp(load->a), function.tagOp(inst.b));
+            }
+        }
+
+        tagChecks.erase(
+            std::remove_if(
+                tagChecks.begin(),
+                tagChecks.end(),
+                [](auto check)
+                {
+                    return check.second == 0xff;
+                }
+            ),
+            tagChecks.end()
+        );
+
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                switch (inst.cmd)
+                {
+                case IrCmd::CHECK_TAG:
+                    if (IrInst* load = function.asInstOp(inst.a); load && load->cmd == IrCmd::LOAD_TAG && load->a.kind == IrOpKind::VmReg)
+                        instRemoved[index] = getHoistedTag(vmRegOp(load->a)) == function.tagOp(inst.b);
+                    break;
+                case IrCmd::CHECK_NO_METATABLE:
+                    if (int reg = getInvariantTableReg(inst.a); reg >= 0 && hasTableState)
+                        instRemoved[index] = getTableChecks(reg).noMetatable = true;
+                    break;
+                case IrCmd::CHECK_READONLY:
+                    if (int reg = getInvariantTableReg(inst.a); reg >= 0 && hasTableState)
+                        instRemoved[index] = getTableChecks(reg).notReadonly = true;
+                    break;
+                case IrCmd::CHECK_ARRAY_SIZE:
+                    if (int reg = getInvariantTableReg(inst.a); reg >= 0 && hasTableState)
+                    {
+                        if (inst.b.kind == IrOpKind::Constant)
+                        {
+                            HoistedTableChecks& checks = getTableChecks(reg);
+                            checks.arrayIndex = std::max(checks.arrayIndex, function.intOp(inst.b));
+                            instRemoved[index] = true;
+                        }
+                        else if (isLoopArrayIndex(inst.b))
+                        {
+                            instRemoved[index] = getTableChecks(reg).loopIndex = true;
+                        }
+                    }
+                    break;
+                case IrCmd::CHECK_SAFE_ENV:
+                    if (hasTableState)
+                        instRemoved[index] = safeEnv = true;
+                    break;
+                default:
+                    break;
+                }
+
+                removed |= bool(instRemoved[index]);
+            }
+        }
+
+        return removed;
+    }
+
+    void emitChecks(bool entry, IrOp fallback, IrOp next)
+    {
+        // Register tags cannot be changed by the interrupt handler, so they are only checked on entry
+        if (entry)
+        {
+            for (auto [reg, tag] : tagChecks)
+                build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(reg)), build.constTag(tag), fallback);
+
+            if (usesLoopIndex())
+            {
+                if (getHoistedTag(limitReg) != LUA_TNUMBER)
+                    build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(limitReg)), build.constTag(LUA_TNUMBER), fallback);
+
+                if (getHoistedTag(indexReg) != LUA_TNUMBER)
+                    build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(indexReg)), build.constTag(LUA_TNUMBER), fallback);
+            }
+        }
+
+        if (safeEnv)
+            build.inst(IrCmd::CHECK_SAFE_ENV, fallback);
+
+        for (const HoistedTableChecks& checks : tableChecks)
+        {
+            IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(checks.reg));
+
+            if (checks.noMetatable)
+                build.inst(IrCmd::CHECK_NO_METATABLE, table, fallback);
+
+            if (checks.notReadonly)
+                build.inst(IrCmd::CHECK_READONLY, table, fallback);
+
+            if (checks.arrayIndex >= 0)
+                build.inst(IrCmd::CHECK_ARRAY_SIZE, table, build.constInt(checks.arrayIndex), fallback);
+
+            if (checks.loopIndex)
+            {
+                // Loop index doesn't go past the limit, which has to be inside the array part
+                IrOp limit = build.inst(IrCmd::TRY_NUM_TO_INDEX, build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(limitReg)), fallback);
+                build.inst(IrCmd::CHECK_ARRAY_SIZE, table, build.inst(IrCmd::SUB_INT, limit, build.constInt(1)), fallback);
+
+                // Loop index only grows, so the first index has to be inside the array part as well
+                if (entry)
+                {
+                    IrOp start = build.inst(IrCmd::TRY_NUM_TO_INDEX, build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(indexReg)), fallback);
+                    build.inst(IrCmd::CHECK_ARRAY_SIZE, table, build.inst(IrCmd::SUB_INT, start, build.constInt(1)), fallback);
+                }
+            }
+        }
+
+        build.inst(IrCmd::JUMP, next);
+    }
+
+    void addUses(uint32_t start)
+    {
+        for (uint32_t index = start; index < function.instructions.size(); index++)
+        {
+            IrInst& inst = function.instructions[index];
+
+            addUse(function, inst.a);
+            addUse(function, inst.b);
+            addUse(function, inst.c);
+            addUse(function, inst.d);
+            addUse(function, inst.e);
+            addUse(function, inst.f);
+            addUse(function, inst.g);
+        }
+    }
+
+    void createCopy(const CfgLoop& loop)
+    {
+        uint32_t header = loop.header;
+
+        IrOp preheader = build.block(IrBlockKind::Internal);
+
+        bool checkTableState = safeEnv || !tableChecks.empty();
+
+        std::vector<uint32_t> blockMap(function.blocks.size(), ~0u);
+        std::vector<uint32_t> splitMap(function.blocks.size(), ~0u);
+
+        // Copies are created in the order of original block indices since later passes visit blocks in that order
+        // The part of a block that follows a split interrupt is created right after it
+        std::vector<uint32_t> copyOrder = copyBlocks;
+        std::sort(copyOrder.begin(), copyOrder.end());
+
+        for (uint32_t blockIdx : copyOrder)
+        {
+            blockMap[blockIdx] = build.block(IrBlockKind::Internal).index;
+
+            if (checkTableState && function.instructions[function.blocks[blockIdx].start].cmd == IrCmd::INTERRUPT)
+                splitMap[blockIdx] = build.block(IrBlockKind::Internal).index;
+        }
+
+        auto mapBlock = [&](IrOp op)
+        {
+            if (op.kind == IrOpKind::Block && op.index < blockMap.size() && blockMap[op.index] != ~0u)
+                return IrOp{IrOpKind::Block, blockMap[op.index]};
+
+            return op;
+        };
+
+        // Loop is entered through the preheader which validates the invariant checks
+        for (uint32_t predIdx : predecessors(function.cfg, header))
+        {
+            if (inLoop[predIdx])
+                continue;
+
+            IrBlock& pred = function.blocks[predIdx];
+
+            for (uint32_t index = pred.start; index <= pred.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                for (IrOp* op : {&inst.a, &inst.b, &inst.c, &inst.d, &inst.e, &inst.f, &inst.g})
+                {
+                    if (op->kind == IrOpKind::Block && op->index == header)
+                        replace(function, *op, preheader);
+                }
+            }
+        }
+
+        uint32_t firstNewInst = uint32_t(function.instructions.size());
+
+        build.beginBlock(preheader);
+        emitChecks(/* entry */ true, IrOp{IrOpKind::Block, header}, mapBlock(IrOp{IrOpKind::Block, header}));
+
+        // Interrupt handler continuation blocks have to validate table checks again
+        struct Continuation
+        {
+            IrOp block;
+            IrOp fallback;
+            IrOp next;
+        };
+
+        std::vector<Continuation> continuations;
+
+        DenseHashMap<uint32_t, uint32_t> instMap{~0u};
+
+        auto mapInst = [&](IrOp op)
+        {
+            if (op.kind == IrOpKind::Inst)
+            {
+                const uint32_t* newIndex = instMap.find(op.index);
+                CODEGEN_ASSERT(newIndex);
+                return IrOp{IrOpKind::Inst, *newIndex};
+            }
+
+            return mapBlock(op);
+        };
+
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            // Note: block reference can be invalidated by 'build.block' below
+            uint32_t start = function.blocks[blockIdx].start;
+            uint32_t finish = function.blocks[blockIdx].finish;
+
+            build.beginBlock(IrOp{IrOpKind::Block, blockMap[blockIdx]});
+
+            for (uint32_t index = start; index <= finish; index++)
+            {
+                IrInst inst = function.instructions[index];
+
+                if (isPseudo(inst.cmd) || instRemoved[index])
+                    continue;
+
+                if (inst.cmd == IrCmd::INTERRUPT && checkTableState)
+                {
+                    IrOp continuation = build.block(IrBlockKind::Internal);
+
+                    build.inst(IrCmd::INTERRUPT, inst.a, continuation);
+
+                    if (index == start)
+                    {
+                        // Interrupt handler might have to run again when the original loop is entered
+                        IrOp rest = IrOp{IrOpKind::Block, splitMap[blockIdx]};
+
+                        build.inst(IrCmd::JUMP, rest);
+                        build.beginBlock(rest);
+
+                        continuations.push_back({continuation, IrOp{IrOpKind::Block, blockIdx}, rest});
+                    }
+                    else
+                    {
+                        IrOp target = function.instructions[finish].a;
+
+                        continuations.push_back({continuation, target, mapBlock(target)});
+                    }
+                    continue;
+                }
+
+                instMap[index] = uint32_t(function.instructions.size());
+
+                build.inst(
+                    inst.cmd, mapInst(inst.a), mapInst(inst.b), mapInst(inst.c), mapInst(inst.d), mapInst(inst.e), mapInst(inst.f), mapInst(inst.g)
+                );
+            }
+        }
+
+        for (const Continuation& continuation : continuations)
+        {
+            build.beginBlock(continuation.block);
+            emitChecks(/* entry */ false, continuation.fallback, continuation.next);
+        }
+
+        addUses(firstNewInst);
+
+        // Loads that were only used by the removed checks are no longer needed
+        for (uint32_t blockIdx : copyBlocks)
+        {
+            const IrBlock& block = function.blocks[blockIdx];
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                const IrInst& original = function.instructions[index];
+
+                if (original.cmd != IrCmd::LOAD_TAG && original.cmd != IrCmd::LOAD_POINTER)
+                    continue;
+
+                if (const uint32_t* newIndex = instMap.find(index))
+                {
+                    IrInst& copy = function.instructions[*newIndex];
+
+                    if (copy.useCount == 0)
+                        kill(function, copy);
+                }
+            }
+        }
+
+        // Entry into the loop from the interpreter also goes through the preheader
+        for (BytecodeMapping& mapping : function.bcMapping)
+        {
+            if (mapping.irLocation == function.blocks[header].start)
+                mapping.irLocation = function.blocks[preheader.index].start;
+        }
+    }
+
+    bool run(const CfgLoop& loop)
+    {
+        if (function.blocks[loop.header].kind == IrBlockKind::Fallback)
+            return false;
+
+        if (!collectBlocks(loop))
+            return false;
+
+        if (!checkValueFlow())
+            return false;
+
+        collectDefs();
+        findNumericLoop(loop);
+
+        if (!selectChecks())
+            return false;
+
+        createCopy(loop);
+        return true;
+    }
+};
+
+bool versionLoops(IrBuilder& build)
+{
+    IrFunction& function = build.function;
+
+    if (function.cfg.loops.empty())
+        return false;
+
+    LoopVersioning state(build);
+
+    state.inLoop.resize(function.blocks.size());
+    state.inCopy.resize(function.blocks.size());
+
+    state.instInCopy.resize(function.instructions.size());
+    state.instUsesInCopy.resize(function.instructions.size());
+    state.instRemoved.resize(function.instructions.size());
+
+    bool changed = false;
+
+    // Loop list has to be copied as the function is modified
+    std::vector<CfgLoop> loops = function.cfg.loops;
+
+    for (size_t i = 0; i < loops.size(); i++)
+    {
+        const CfgLoop& loop = loops[i];
+
+        // Only the innermost loops are versioned
+        bool innermost = true;
+
+        for (size_t j = i + 1; j < loops.size(); j++)
+        {
+            if (std::binary_search(loop.blocks.begin(), loop.blocks.end(), loops[j].header))
+                innermost = false;
+        }
+
+        if (!innermost)
+            continue;
+
+        changed |= state.run(loop);
+        state.reset();
+    }
+
+    return changed;
+}
+
+} // namespace CodeGen
+} // namespace Luau
@@ -283,6 +283,9 @@ void SharedCodeAllocator::eraseNativeModuleIfUnreferenced(const NativeModule& na
     if (nativeModule.getRefcount() != 0)
         return;
 
+    // Code of the module is dead now; the allocator reclaims the block once nothing else in it is alive
+    codeAllocator->releaseAllocation(nativeModule.getModuleBaseAddress());
+
     if (const std::optional<ModuleId>& moduleId = nativeModule.getModuleId())
     {
         const auto it = identifiedModules.find(*moduleId);
@@ -297,6 +300,13 @@ void SharedCodeAllocator::eraseNativeModuleIfUnreferenced(const NativeModule& na
     }
 }
 
+[[nodiscard]] CodeMemoryStats SharedCodeAllocator::getMemoryStats() const
+{
+    std::unique_lock lock{mutex};
+
+    return codeAllocator->getMemoryStats();
+}
+
 [[nodiscard]] NativeModuleRef SharedCodeAllocator::tryGetNativeModuleWithLockHeld(const ModuleId& moduleId) const noexcept
 {
     const auto it = identifiedModules.find(moduleId);
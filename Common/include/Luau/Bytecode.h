@@ -47,6 +47,7 @@
 // Version 4: Adds Proto::flags, typeinfo, and floor division opcodes IDIV/IDIVK. Currently supported.
 // Version 5: Adds SUBRK/DIVRK and vector constants. Currently supported.
 // Version 6: Adds FASTCALL3. Currently supported.
+// Version 7: Adds MOVE2 superinstruction; only emitted for modules that use it. Currently supported.
 
 // # Bytecode type information history
 // Version 1: (from bytecode version 4) Type information for function signature. Currently supported.
@@ -418,6 +419,13 @@ enum LuauOpcode
     // C: constant table index (0..255)
     LOP_IDIVK,
 
+    // MOVE2: copy two values between registers, in order; a superinstruction for a pair of MOVE instructions on the same line
+    // A: target register 1
+    // B: source register 1
+    // AUX: target register 2 in least-significant byte
+    // AUX: source register 2 in second least-significant byte
+    LOP_MOVE2,
+
     // Enum entry for number of opcodes, not a valid opcode by itself!
     LOP__COUNT
 };
@@ -442,7 +450,7 @@ enum LuauBytecodeTag
 {
     // Bytecode version; runtime supports [MIN, MAX], compiler emits TARGET by default but may emit a higher version when flags are enabled
     LBC_VERSION_MIN = 3,
-    LBC_VERSION_MAX = 6,
+    LBC_VERSION_MAX = 7,
     LBC_VERSION_TARGET = 6,
     // Type encoding version
     LBC_TYPE_VERSION_MIN = 1,
@@ -620,6 +628,9 @@ enum LuauBuiltinFunction
     LBF_MATH_LERP,
 
     LBF_VECTOR_LERP,
+
+    // strbuf.append
+    LBF_STRBUF_APPEND,
 };
 
 // Capture type, used in LOP_CAPTURE
@@ -33,6 +33,7 @@ inline int getOpLength(LuauOpcode op)
     case LOP_JUMPXEQKB:
     case LOP_JUMPXEQKN:
     case LOP_JUMPXEQKS:
+    case LOP_MOVE2:
         return 2;
 
     default:
@@ -74,6 +74,8 @@ public:
 
     void foldJumps();
     void expandJumps();
+    void fuseInstructions();
+    void removeRedundantInstructions(bool removeDeadStores);
 
     void setFunctionTypeInfo(std::string value);
     void pushLocalTypeInfo(LuauBytecodeType type, uint8_t reg, uint32_t startpc, uint32_t endpc);
@@ -119,6 +121,12 @@ public:
         return (dumpFlags & Dump_Remarks) != 0;
     }
 
+    // instructions can only be removed when all jump offsets fit into their instructions
+    bool canRemoveInstructions() const
+    {
+        return !hasLongJumps;
+    }
+
     const std::string& getBytecode() const
     {
         LUAU_ASSERT(!bytecode.empty()); // did you forget to call finalize?
@@ -265,6 +273,10 @@ private:
     uint32_t mainFunction = ~0u;
 
     size_t totalInstructionCount = 0;
+
+    // the lowest bytecode version that supports all instructions emitted so far
+    uint8_t requiredVersion = 0;
+
     std::vector<uint32_t> insns;
     std::vector<int> lines;
     std::vector<Constant> constants;
@@ -310,6 +322,9 @@ private:
     void validateInstructions() const;
     void validateVariadic() const;
 
+    bool isRegisterDead(uint8_t reg, uint32_t pc, int& budget) const;
+    void removeInstructions(const std::vector<bool>& removed);
+
     std::string dumpCurrentFunction(std::vector<int>& dumpinstoffs) const;
     void dumpConstant(std::string& result, int k) const;
     void dumpInstruction(const uint32_t* opcode, std::string& output, int targetLabel) const;
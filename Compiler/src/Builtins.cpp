@@ -8,6 +8,7 @@
 #include <array>
 
 LUAU_FASTFLAGVARIABLE(LuauCompileVectorLerp)
+LUAU_FASTFLAGVARIABLE(LuauCompileStrbufAppend)
 
 namespace Luau
 {
@@ -257,6 +258,12 @@ static int getBuiltinFunctionId(const Builtin& builtin, const CompileOptions& op
             return LBF_VECTOR_LERP;
     }
 
+    if (FFlag::LuauCompileStrbufAppend && builtin.object == "strbuf")
+    {
+        if (builtin.method == "append")
+            return LBF_STRBUF_APPEND;
+    }
+
     if (options.vectorCtor)
     {
         if (options.vectorLib)
@@ -561,6 +568,9 @@ BuiltinInfo getBuiltinInfo(int bfid)
 
     case LBF_MATH_LERP:
         return {3, 1, BuiltinInfo::Flag_NoneSafe};
+
+    case LBF_STRBUF_APPEND:
+        return {-1, 1}; // variadic
     }
 
     LUAU_UNREACHABLE();
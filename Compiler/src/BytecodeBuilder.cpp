@@ -682,7 +682,7 @@ void BytecodeBuilder::finalize()
     bytecode.reserve(capacity);
 
     // assemble final bytecode blob
-    uint8_t version = getVersion();
+    uint8_t version = std::max(getVersion(), requiredVersion);
     LUAU_ASSERT(version >= LBC_VERSION_MIN && version <= LBC_VERSION_MAX);
 
     bytecode = char(version);
@@ -1074,6 +1074,441 @@ void BytecodeBuilder::foldJumps()
     }
 }
 
+void BytecodeBuilder::fuseInstructions()
+{
+    // instructions can only be fused with the next instruction when it's not a jump target
+    std::vector<bool> targets(insns.size() + 1);
+
+    for (size_t i = 0; i < insns.size();)
+    {
+        uint32_t insn = insns[i];
+
+        if (int target = getJumpTarget(insn, uint32_t(i)); target >= 0)
+            targets[target] = true;
+
+        i += getOpLength(LuauOpcode(LUAU_INSN_OP(insn)));
+    }
+
+    for (size_t i = 0; i < insns.size();)
+    {
+        uint32_t insn = insns[i];
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+
+        // both instructions have to be on the same line, so that line breakpoints never land on the instruction that became AUX
+        bool fusible = i + 1 < insns.size() && !targets[i + 1] && lines[i] == lines[i + 1];
+
+        if (op == LOP_MOVE && fusible && LUAU_INSN_OP(insns[i + 1]) == LOP_MOVE)
+        {
+            uint32_t next = insns[i + 1];
+
+            insns[i] = LOP_MOVE2 | (LUAU_INSN_A(insn) << 8) | (LUAU_INSN_B(insn) << 16);
+            insns[i + 1] = LUAU_INSN_A(next) | (LUAU_INSN_B(next) << 8);
+
+            // MOVE2 was added in version 7
+            requiredVersion = std::max(requiredVersion, uint8_t(7));
+
+            i += 2;
+            continue;
+        }
+
+        i += getOpLength(op);
+    }
+}
+
+// Reports whether an instruction reads or overwrites the register; returns false for instructions that aren't modeled
+static bool getRegisterUse(const uint32_t* code, uint8_t reg, bool& reads, bool& writes)
+{
+    uint32_t insn = code[0];
+    LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+
+    uint8_t a = LUAU_INSN_A(insn);
+    uint8_t b = LUAU_INSN_B(insn);
+    uint8_t c = LUAU_INSN_C(insn);
+
+    reads = false;
+    writes = false;
+
+    switch (op)
+    {
+    case LOP_LOADNIL:
+    case LOP_LOADB:
+    case LOP_LOADN:
+    case LOP_LOADK:
+    case LOP_LOADKX:
+    case LOP_GETUPVAL:
+    case LOP_GETGLOBAL:
+    case LOP_GETIMPORT:
+    case LOP_NEWTABLE:
+    case LOP_DUPTABLE:
+        writes = a == reg;
+        return true;
+
+    case LOP_MOVE:
+    case LOP_GETTABLEKS:
+    case LOP_GETTABLEN:
+    case LOP_ADDK:
+    case LOP_SUBK:
+    case LOP_MULK:
+    case LOP_DIVK:
+    case LOP_IDIVK:
+    case LOP_MODK:
+    case LOP_POWK:
+    case LOP_ANDK:
+    case LOP_ORK:
+    case LOP_NOT:
+    case LOP_MINUS:
+    case LOP_LENGTH:
+        reads = b == reg;
+        writes = a == reg;
+        return true;
+
+    case LOP_GETTABLE:
+    case LOP_ADD:
+    case LOP_SUB:
+    case LOP_MUL:
+    case LOP_DIV:
+    case LOP_IDIV:
+    case LOP_MOD:
+    case LOP_POW:
+    case LOP_AND:
+    case LOP_OR:
+        reads = b == reg || c == reg;
+        writes = a == reg;
+        return true;
+
+    case LOP_SUBRK:
+    case LOP_DIVRK:
+        reads = c == reg;
+        writes = a == reg;
+        return true;
+
+    case LOP_CONCAT:
+        reads = reg >= b && reg <= c;
+        writes = a == reg;
+        return true;
+
+    case LOP_SETGLOBAL:
+    case LOP_SETUPVAL:
+    case LOP_JUMPIF:
+    case LOP_JUMPIFNOT:
+    case LOP_JUMPXEQKNIL:
+    case LOP_JUMPXEQKB:
+    case LOP_JUMPXEQKN:
+    case LOP_JUMPXEQKS:
+        reads = a == reg;
+        return true;
+
+    case LOP_SETTABLEKS:
+    case LOP_SETTABLEN:
+        reads = a == reg || b == reg;
+        return true;
+
+    case LOP_SETTABLE:
+        reads = a == reg || b == reg || c == reg;
+        return true;
+
+    case LOP_JUMPIFEQ:
+    case LOP_JUMPIFLE:
+    case LOP_JUMPIFLT:
+    case LOP_JUMPIFNOTEQ:
+    case LOP_JUMPIFNOTLE:
+    case LOP_JUMPIFNOTLT:
+        reads = a == reg || code[1] == reg;
+        return true;
+
+    case LOP_RETURN:
+        // B=0 returns all values up to the stack top
+        reads = reg >= a && (b == 0 || reg < a + b - 1);
+        return true;
+
+    case LOP_JUMP:
+    case LOP_NOP:
+    case LOP_COVERAGE:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+bool BytecodeBuilder::isRegisterDead(uint8_t reg, uint32_t pc, int& budget) const
+{
+    while (pc < insns.size())
+    {
+        if (--budget < 0)
+            return false;
+
+        uint32_t insn = insns[pc];
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+
+        bool reads = false, writes = false;
+
+        if (!getRegisterUse(&insns[pc], reg, reads, writes) || reads)
+            return false;
+
+        if (writes || op == LOP_RETURN)
+            return true;
+
+        if (int target = getJumpTarget(insn, pc); target >= 0)
+        {
+            // we only follow forward jumps to make sure the search terminates
+            if (target <= int(pc))
+                return false;
+
+            if (op == LOP_JUMP)
+            {
+                pc = uint32_t(target);
+                continue;
+            }
+
+            if (!isRegisterDead(reg, uint32_t(target), budget))
+                return false;
+        }
+
+        pc += getOpLength(op);
+    }
+
+    return false;
+}
+
+void BytecodeBuilder::removeRedundantInstructions(bool removeDeadStores)
+{
+    // jump offsets are not final when the function has long jumps
+    if (!canRemoveInstructions())
+        return;
+
+    // the search for register reads is limited to keep compilation time linear
+    const int kMaxDeadStoreSearch = 64;
+
+    std::vector<bool> targets(insns.size() + 1);
+
+    // registers captured by reference can be read by closures at any point
+    std::vector<bool> captured(256);
+
+    std::vector<uint32_t> unconditionalJumps;
+
+    for (size_t i = 0; i < insns.size();)
+    {
+        uint32_t insn = insns[i];
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+
+        if (int target = getJumpTarget(insn, uint32_t(i)); target >= 0)
+            targets[target] = true;
+
+        if (op == LOP_CAPTURE && LUAU_INSN_A(insn) == LCT_REF)
+            captured[LUAU_INSN_B(insn)] = true;
+
+        if (op == LOP_JUMP)
+            unconditionalJumps.push_back(uint32_t(i));
+
+        i += getOpLength(op);
+    }
+
+    std::vector<bool> removed(insns.size());
+    bool changed = false;
+
+    for (size_t i = 0; i < insns.size();)
+    {
+        uint32_t insn = insns[i];
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+        int oplen = getOpLength(op);
+
+        if (op == LOP_MOVE && LUAU_INSN_A(insn) == LUAU_INSN_B(insn))
+        {
+            removed[i] = true;
+            changed = true;
+        }
+        else if (op == LOP_MOVE)
+        {
+            uint8_t ra = LUAU_INSN_A(insn);
+            uint8_t rb = LUAU_INSN_B(insn);
+
+            // MOVE A B followed by MOVE B A in the same block, with no writes to either register in between
+            for (size_t j = i + 1; j < insns.size() && !targets[j];)
+            {
+                uint32_t next = insns[j];
+                LuauOpcode nextop = LuauOpcode(LUAU_INSN_OP(next));
+
+                if (nextop == LOP_MOVE && LUAU_INSN_A(next) == rb && LUAU_INSN_B(next) == ra)
+                {
+                    removed[j] = true;
+                    changed = true;
+                    break;
+                }
+
+                bool readsA = false, writesA = false, readsB = false, writesB = false;
+
+                if (!getRegisterUse(&insns[j], ra, readsA, writesA) || !getRegisterUse(&insns[j], rb, readsB, writesB))
+                    break;
+
+                if (writesA || writesB || getJumpTarget(next, uint32_t(j)) >= 0 || nextop == LOP_RETURN)
+                    break;
+
+                j += getOpLength(nextop);
+            }
+        }
+
+        // the removal of loads that are overwritten before they are read is only visible to the debugger
+        if (removeDeadStores && !removed[i])
+        {
+            bool store = false;
+
+            switch (op)
+            {
+            case LOP_LOADNIL:
+            case LOP_LOADN:
+            case LOP_LOADK:
+            case LOP_LOADKX:
+            case LOP_MOVE:
+            case LOP_GETUPVAL:
+                store = true;
+                break;
+
+            case LOP_LOADB:
+                store = LUAU_INSN_C(insn) == 0;
+                break;
+
+            default:
+                break;
+            }
+
+            int budget = kMaxDeadStoreSearch;
+
+            if (store && !captured[LUAU_INSN_A(insn)] && isRegisterDead(LUAU_INSN_A(insn), uint32_t(i + oplen), budget))
+            {
+                for (int j = 0; j < oplen; ++j)
+                    removed[i + j] = true;
+
+                changed = true;
+            }
+        }
+
+        i += oplen;
+    }
+
+    // unconditional jumps to the next remaining instruction are removed last, in reverse order to handle jumps over other such jumps
+    for (auto it = unconditionalJumps.rbegin(); it != unconditionalJumps.rend(); ++it)
+    {
+        uint32_t pc = *it;
+        int target = getJumpTarget(insns[pc], pc);
+
+        if (target <= int(pc))
+            continue;
+
+        bool skipsCode = false;
+
+        for (int j = int(pc) + 1; j < target; ++j)
+            skipsCode |= !removed[j];
+
+        if (!skipsCode)
+        {
+            removed[pc] = true;
+            changed = true;
+        }
+    }
+
+    if (changed)
+        removeInstructions(removed);
+}
+
+void BytecodeBuilder::removeInstructions(const std::vector<bool>& removed)
+{
+    LUAU_ASSERT(removed.size() == insns.size());
+
+    // remap[oldpc] = newpc; removed instructions are mapped to the next remaining instruction
+    std::vector<uint32_t> remap(insns.size() + 1);
+    uint32_t newsize = 0;
+
+    for (size_t i = 0; i < insns.size(); ++i)
+    {
+        remap[i] = newsize;
+
+        if (!removed[i])
+            newsize++;
+    }
+
+    remap[insns.size()] = newsize;
+
+    // jump offsets are relative, so they need to be recomputed between the remapped instructions
+    for (size_t i = 0; i < insns.size();)
+    {
+        uint32_t& insn = insns[i];
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+
+        if (int target = getJumpTarget(insn, uint32_t(i)); target >= 0 && !removed[i])
+        {
+            int offset = int(remap[target]) - int(remap[i]) - 1;
+
+            if (isJumpD(op))
+            {
+                LUAU_ASSERT(int16_t(offset) == offset);
+
+                insn &= 0xffff;
+                insn |= uint16_t(offset) << 16;
+            }
+            else if (isFastCall(op))
+            {
+                LUAU_ASSERT(offset >= 1 && offset <= 256);
+
+                insn &= 0x00ffffff;
+                insn |= uint32_t(offset - 1) << 24;
+            }
+            else
+            {
+                LUAU_ASSERT(isSkipC(op) && offset >= 0 && offset <= 255);
+
+                insn &= 0x00ffffff;
+                insn |= uint32_t(offset) << 24;
+            }
+        }
+
+        i += getOpLength(op);
+    }
+
+    size_t write = 0;
+
+    for (size_t i = 0; i < insns.size(); ++i)
+    {
+        if (removed[i])
+            continue;
+
+        insns[write] = insns[i];
+        lines[write] = lines[i];
+        write++;
+    }
+
+    LUAU_ASSERT(write == newsize);
+    insns.resize(newsize);
+    lines.resize(newsize);
+
+    size_t writeJump = 0;
+
+    for (Jump& jump : jumps)
+    {
+        if (removed[jump.source])
+            continue;
+
+        jumps[writeJump++] = {remap[jump.source], remap[jump.target]};
+    }
+
+    jumps.resize(writeJump);
+
+    for (DebugLocal& local : debugLocals)
+    {
+        local.startpc = remap[local.startpc];
+        local.endpc = remap[local.endpc];
+    }
+
+    for (TypedLocal& local : typedLocals)
+    {
+        local.startpc = remap[local.startpc];
+        local.endpc = remap[local.endpc];
+    }
+
+    for (auto& remark : debugRemarks)
+        remark.first = remap[remark.first];
+}
+
 void BytecodeBuilder::expandJumps()
 {
     if (!hasLongJumps)
@@ -1295,6 +1730,13 @@ void BytecodeBuilder::validateInstructions() const
             VREG(LUAU_INSN_B(insn));
             break;
 
+        case LOP_MOVE2:
+            VREG(LUAU_INSN_A(insn));
+            VREG(LUAU_INSN_B(insn));
+            VREG(insns[i + 1] & 0xff);
+            VREG((insns[i + 1] >> 8) & 0xff);
+            break;
+
         case LOP_GETGLOBAL:
         case LOP_SETGLOBAL:
             VREG(LUAU_INSN_A(insn));
@@ -1751,8 +2193,8 @@ void BytecodeBuilder::validateVariadic() const
             // variadic sequence since they are never executed if FASTCALL does anything, so it's okay to skip their validation until CALL
             // (we can't simply start a variadic sequence here because that would trigger assertions during linked CALL validation)
         }
-        else if (op == LOP_CLOSEUPVALS || op == LOP_NAMECALL || op == LOP_GETIMPORT || op == LOP_MOVE || op == LOP_GETUPVAL || op == LOP_GETGLOBAL ||
-                 op == LOP_GETTABLEKS || op == LOP_COVERAGE)
+        else if (op == LOP_CLOSEUPVALS || op == LOP_NAMECALL || op == LOP_GETIMPORT || op == LOP_MOVE || op == LOP_MOVE2 || op == LOP_GETUPVAL ||
+                 op == LOP_GETGLOBAL || op == LOP_GETTABLEKS || op == LOP_COVERAGE)
         {
             // instructions inside a variadic sequence must be neutral (can't change L->top)
             // while there are many neutral instructions like this, here we check that the instruction is one of the few
@@ -1896,6 +2338,11 @@ void BytecodeBuilder::dumpInstruction(const uint32_t* code, std::string& result,
         formatAppend(result, "MOVE R%d R%d\n", LUAU_INSN_A(insn), LUAU_INSN_B(insn));
         break;
 
+    case LOP_MOVE2:
+        formatAppend(result, "MOVE2 R%d R%d R%d R%d\n", LUAU_INSN_A(insn), LUAU_INSN_B(insn), *code & 0xff, (*code >> 8) & 0xff);
+        code++;
+        break;
+
     case LOP_GETGLOBAL:
         formatAppend(result, "GETGLOBAL R%d K%d [", LUAU_INSN_A(insn), *code);
         dumpConstant(result, *code);
@@ -26,6 +26,9 @@ LUAU_FASTINTVARIABLE(LuauCompileInlineThreshold, 25)
 LUAU_FASTINTVARIABLE(LuauCompileInlineThresholdMaxBoost, 300)
 LUAU_FASTINTVARIABLE(LuauCompileInlineDepth, 5)
 
+LUAU_FASTFLAGVARIABLE(LuauCompileSuperinstructions)
+LUAU_FASTFLAGVARIABLE(LuauCompilePeephole)
+
 namespace Luau
 {
 
@@ -265,12 +268,27 @@ struct Compiler
             }
         }
 
+        bool removeInstructions = FFlag::LuauCompilePeephole && options.optimizationLevel >= 1 && bytecode.canRemoveInstructions();
+
+        // debug ranges of the remaining locals have to be recorded before instructions are removed
+        if (removeInstructions)
+            popLocals(0);
+
         if (options.optimizationLevel >= 1)
             bytecode.foldJumps();
 
+        // removal of dead stores makes locals unobservable in the debugger, so it's only enabled with O2
+        if (removeInstructions)
+            bytecode.removeRedundantInstructions(options.optimizationLevel >= 2);
+
         bytecode.expandJumps();
 
-        popLocals(0);
+        // jump offsets have to be final to find the instructions that can be fused
+        if (FFlag::LuauCompileSuperinstructions && options.optimizationLevel >= 1)
+            bytecode.fuseInstructions();
+
+        if (!removeInstructions)
+            popLocals(0);
 
         if (bytecode.getInstructionCount() > kMaxInstructionCount)
             CompileError::raise(func->location, "Exceeded function instruction limit; split the function into parts to compile");
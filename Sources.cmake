@@ -97,7 +97,9 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/include/Luau/OperandX64.h
     CodeGen/include/Luau/OptimizeConstProp.h
     CodeGen/include/Luau/OptimizeDeadStore.h
+    CodeGen/include/Luau/OptimizeEscape.h
     CodeGen/include/Luau/OptimizeFinalX64.h
+    CodeGen/include/Luau/OptimizeLoops.h
     CodeGen/include/Luau/RegisterA64.h
     CodeGen/include/Luau/RegisterX64.h
     CodeGen/include/Luau/SharedCodeAllocator.h
@@ -134,11 +136,15 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/src/IrUtils.cpp
     CodeGen/src/IrValueLocationTracking.cpp
     CodeGen/src/lcodegen.cpp
+    CodeGen/src/NativeCache.cpp
+    CodeGen/src/NativeDebugInfo.cpp
     CodeGen/src/NativeProtoExecData.cpp
     CodeGen/src/NativeState.cpp
     CodeGen/src/OptimizeConstProp.cpp
     CodeGen/src/OptimizeDeadStore.cpp
+    CodeGen/src/OptimizeEscape.cpp
     CodeGen/src/OptimizeFinalX64.cpp
+    CodeGen/src/OptimizeLoops.cpp
     CodeGen/src/UnwindBuilderDwarf2.cpp
     CodeGen/src/UnwindBuilderWin.cpp
     CodeGen/src/BytecodeAnalysis.cpp
@@ -163,6 +169,8 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/src/IrTranslateBuiltins.h
     CodeGen/src/IrTranslation.h
     CodeGen/src/IrValueLocationTracking.h
+    CodeGen/src/NativeCache.h
+    CodeGen/src/NativeDebugInfo.h
     CodeGen/src/NativeState.h
 )
 
@@ -357,13 +365,16 @@ target_sources(Luau.VM PRIVATE
     VM/src/lgc.cpp
     VM/src/lgcdebug.cpp
     VM/src/linit.cpp
+    VM/src/ljsonlib.cpp
     VM/src/lmathlib.cpp
     VM/src/lmem.cpp
     VM/src/lnumprint.cpp
     VM/src/lobject.cpp
     VM/src/loslib.cpp
     VM/src/lperf.cpp
+    VM/src/lserlib.cpp
     VM/src/lstate.cpp
+    VM/src/lstrbuflib.cpp
     VM/src/lstring.cpp
     VM/src/lstrlib.cpp
     VM/src/ltable.cpp
@@ -130,6 +130,15 @@ LUALIB_API int luaopen_bit32(lua_State* L);
 #define LUA_BUFFERLIBNAME "buffer"
 LUALIB_API int luaopen_buffer(lua_State* L);
 
+#define LUA_JSONLIBNAME "json"
+LUALIB_API int luaopen_json(lua_State* L);
+
+#define LUA_SERLIBNAME "serialize"
+LUALIB_API int luaopen_serialize(lua_State* L);
+
+#define LUA_STRBUFLIBNAME "strbuf"
+LUALIB_API int luaopen_strbuf(lua_State* L);
+
 #define LUA_UTF8LIBNAME "utf8"
 LUALIB_API int luaopen_utf8(lua_State* L);
 
@@ -809,7 +809,10 @@ void lua_setreadonly(lua_State* L, int objindex, int enabled)
     api_check(L, ttistable(o));
     LuaTable* t = hvalue(o);
     api_check(L, t != hvalue(registry(L)));
-    t->readonly = bool(enabled);
+    // values that native code cached from readonly or watched tables might change after this
+    if (t->readonly && !enabled && ++L->global->udatacacheepoch == 0)
+        L->global->udatacacheepoch = 1;
+    t->readonly = enabled ? LUAH_READONLY : 0;
 }
 
 int lua_getreadonly(lua_State* L, int objindex)
@@ -817,7 +820,7 @@ int lua_getreadonly(lua_State* L, int objindex)
     const TValue* o = index2addr(L, objindex);
     api_check(L, ttistable(o));
     LuaTable* t = hvalue(o);
-    int res = t->readonly;
+    int res = luaH_isreadonly(t);
     return res;
 }
 
@@ -904,7 +907,7 @@ void lua_rawsetfield(lua_State* L, int idx, const char* k)
     StkId t = index2addr(L, idx);
     api_check(L, ttistable(t));
     if (hvalue(t)->readonly)
-        luaG_readonlyerror(L);
+        luaH_checkwrite(L, hvalue(t));
     setobj2t(L, luaH_setstr(L, hvalue(t), luaS_new(L, k)), L->top - 1);
     luaC_barriert(L, hvalue(t), L->top - 1);
     L->top--;
@@ -916,7 +919,7 @@ void lua_rawset(lua_State* L, int idx)
     StkId t = index2addr(L, idx);
     api_check(L, ttistable(t));
     if (hvalue(t)->readonly)
-        luaG_readonlyerror(L);
+        luaH_checkwrite(L, hvalue(t));
     setobj2t(L, luaH_set(L, hvalue(t), L->top - 2), L->top - 1);
     luaC_barriert(L, hvalue(t), L->top - 1);
     L->top -= 2;
@@ -928,7 +931,7 @@ void lua_rawseti(lua_State* L, int idx, int n)
     StkId o = index2addr(L, idx);
     api_check(L, ttistable(o));
     if (hvalue(o)->readonly)
-        luaG_readonlyerror(L);
+        luaH_checkwrite(L, hvalue(o));
     setobj2t(L, luaH_setnum(L, hvalue(o), n), L->top - 1);
     luaC_barriert(L, hvalue(o), L->top - 1);
     L->top--;
@@ -950,7 +953,7 @@ int lua_setmetatable(lua_State* L, int objindex)
     case LUA_TTABLE:
     {
         if (hvalue(obj)->readonly)
-            luaG_readonlyerror(L);
+            luaH_checkwrite(L, hvalue(obj));
         hvalue(obj)->metatable = mt;
         if (mt)
             luaC_objbarrier(L, hvalue(obj), mt);
@@ -1601,7 +1604,7 @@ void lua_cleartable(lua_State* L, int idx)
     api_check(L, ttistable(t));
     LuaTable* tt = hvalue(t);
     if (tt->readonly)
-        luaG_readonlyerror(L);
+        luaH_checkwrite(L, tt);
     luaH_clear(tt);
 }
 
@@ -9,6 +9,7 @@
 #include "lnumutils.h"
 #include "ldo.h"
 #include "lbuffer.h"
+#include "ludata.h"
 
 #include <math.h>
 #include <string.h>
@@ -1740,6 +1741,45 @@ static int luauF_lerp(lua_State* L, StkId res, TValue* arg0, int nresults, StkId
     return -1;
 }
 
+static int luauF_strbufappend(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
+{
+    if (nparams == 2 && nresults <= 1 && ttisuserdata(arg0) && uvalue(arg0)->tag == UTAG_STRBUF)
+    {
+        Udata* u = uvalue(arg0);
+        StrBuf* sb = (StrBuf*)u->data;
+
+        char buf[LUAI_MAXNUM2STR];
+        const char* s = NULL;
+        size_t len = 0;
+
+        if (ttisstring(args))
+        {
+            s = svalue(args);
+            len = tsvalue(args)->len;
+        }
+        else if (ttisnumber(args))
+        {
+            s = buf;
+            len = luai_num2str(buf, nvalue(args)) - buf;
+        }
+        else
+        {
+            return -1;
+        }
+
+        // growing the storage allocates memory; we can't call luaC_checkGC so fall back to C implementation
+        if (len > sb->size - sb->len && luaC_needsGC(L))
+            return -1;
+
+        luaU_strbufappend(L, u, s, len);
+
+        setobj2s(L, res, arg0);
+        return 1;
+    }
+
+    return -1;
+}
+
 static int luauF_missing(lua_State* L, StkId res, TValue* arg0, int nresults, StkId args, int nparams)
 {
     return -1;
@@ -1939,6 +1979,8 @@ const luau_FastFunction luauF_table[256] = {
 
     luauF_vectorlerp,
 
+    luauF_strbufappend,
+
 // When adding builtins, add them above this line; what follows is 64 "dummy" entries with luauF_missing fallback.
 // This is important so that older versions of the runtime that don't support newer builtins automatically fall back via luauF_missing.
 // Given the builtin addition velocity this should always provide a larger compatibility window than bytecode versions suggest.
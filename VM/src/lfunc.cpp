@@ -6,6 +6,8 @@
 #include "lmem.h"
 #include "lgc.h"
 
+#include <string.h>
+
 Proto* luaF_newproto(lua_State* L)
 {
     Proto* f = luaM_newgco(L, Proto, sizeof(Proto), L->activememcat);
@@ -34,6 +36,9 @@ Proto* luaF_newproto(lua_State* L)
 
     f->debugname = NULL;
     f->debuginsn = NULL;
+    f->typefeedback = NULL;
+    f->udatacache = NULL;
+    f->inlined = NULL;
 
     f->typeinfo = NULL;
 
@@ -43,6 +48,7 @@ Proto* luaF_newproto(lua_State* L)
 
     f->sizecode = 0;
     f->sizep = 0;
+    f->sizeinlined = 0;
     f->sizelocvars = 0;
     f->sizeupvalues = 0;
     f->sizek = 0;
@@ -52,6 +58,9 @@ Proto* luaF_newproto(lua_State* L)
     f->bytecodeid = 0;
     f->sizetypeinfo = 0;
 
+    f->tiercalls = 0;
+    f->tierloops = 0;
+
     return f;
 }
 
@@ -159,6 +168,51 @@ void luaF_closeupval(lua_State* L, UpVal* uv, bool dead)
     luaC_upvalclosed(L, uv);
 }
 
+void luaF_newtypefeedback(lua_State* L, Proto* f)
+{
+    LUAU_ASSERT(!f->typefeedback);
+
+    f->typefeedback = luaM_newarray(L, f->sizecode * 2, uint8_t, f->memcat);
+    memset(f->typefeedback, 0, f->sizecode * 2);
+}
+
+void luaF_freetypefeedback(lua_State* L, Proto* f)
+{
+    luaM_freearray(L, f->typefeedback, f->sizecode * 2, uint8_t, f->memcat);
+    f->typefeedback = NULL;
+}
+
+void luaF_newudatacache(lua_State* L, Proto* f)
+{
+    LUAU_ASSERT(!f->udatacache);
+
+    f->udatacache = luaM_newarray(L, f->sizecode, UdataCache, f->memcat);
+
+    for (int i = 0; i < f->sizecode; ++i)
+    {
+        f->udatacache[i].metatable = NULL;
+        f->udatacache[i].epoch = 0;
+        setnilvalue(&f->udatacache[i].value);
+    }
+}
+
+void luaF_freeudatacache(lua_State* L, Proto* f)
+{
+    luaM_freearray(L, f->udatacache, f->sizecode, UdataCache, f->memcat);
+    f->udatacache = NULL;
+}
+
+void luaF_addinlined(lua_State* L, Proto* f, Proto* callee)
+{
+    for (int i = 0; i < f->sizeinlined; ++i)
+        if (f->inlined[i] == callee)
+            return;
+
+    luaM_reallocarray(L, f->inlined, f->sizeinlined, f->sizeinlined + 1, Proto*, f->memcat);
+    f->inlined[f->sizeinlined++] = callee;
+    luaC_objbarrier(L, f, callee);
+}
+
 void luaF_freeproto(lua_State* L, Proto* f, lua_Page* page)
 {
     luaM_freearray(L, f->code, f->sizecode, Instruction, f->memcat);
@@ -170,6 +224,12 @@ void luaF_freeproto(lua_State* L, Proto* f, lua_Page* page)
     luaM_freearray(L, f->upvalues, f->sizeupvalues, TString*, f->memcat);
     if (f->debuginsn)
         luaM_freearray(L, f->debuginsn, f->sizecode, uint8_t, f->memcat);
+    if (f->typefeedback)
+        luaF_freetypefeedback(L, f);
+    if (f->udatacache)
+        luaF_freeudatacache(L, f);
+    if (f->inlined)
+        luaM_freearray(L, f->inlined, f->sizeinlined, Proto*, f->memcat);
 
     if (f->execdata)
         L->global->ecb.destroy(L, f);
@@ -7,12 +7,29 @@
 #define sizeCclosure(n) (offsetof(Closure, c.upvals) + sizeof(TValue) * (n))
 #define sizeLclosure(n) (offsetof(Closure, l.uprefs) + sizeof(TValue) * (n))
 
+// type feedback records the types of arithmetic and field access operands, including the ones handled by the number and table fast paths of the
+// interpreter, as a mask of tag bits for operands B and C of each instruction; it's collected until the function gets native code, which is
+// specialized for operands that only had a single type
+#define luaF_feedbackbit(tag) uint8_t(1 << (unsigned(tag) < 7 ? (tag) : 7))
+
+// userdata inline cache holds the values of fields and methods that native code resolved through tagged metatables (and their __index
+// tables); an entry is valid while the userdata has the same metatable and the epoch matches, which changes when a readonly table becomes
+// writable again or when a table that the cache was filled from is written (filling marks writable tables as watched, see ltable.h)
+
+// native code can contain copies of the bodies of other functions that were inlined into it; these functions are recorded in the list of inlined
+// functions, so that their constants and the code that is referenced from the copies can't be collected before the function itself
+
 LUAI_FUNC Proto* luaF_newproto(lua_State* L);
 LUAI_FUNC Closure* luaF_newLclosure(lua_State* L, int nelems, LuaTable* e, Proto* p);
 LUAI_FUNC Closure* luaF_newCclosure(lua_State* L, int nelems, LuaTable* e);
 LUAI_FUNC UpVal* luaF_findupval(lua_State* L, StkId level);
 LUAI_FUNC void luaF_close(lua_State* L, StkId level);
 LUAI_FUNC void luaF_closeupval(lua_State* L, UpVal* uv, bool dead);
+LUAI_FUNC void luaF_newtypefeedback(lua_State* L, Proto* f);
+LUAI_FUNC void luaF_freetypefeedback(lua_State* L, Proto* f);
+LUAI_FUNC void luaF_newudatacache(lua_State* L, Proto* f);
+LUAI_FUNC void luaF_freeudatacache(lua_State* L, Proto* f);
+LUAI_FUNC void luaF_addinlined(lua_State* L, Proto* f, Proto* callee);
 LUAI_FUNC void luaF_freeproto(lua_State* L, Proto* f, struct lua_Page* page);
 LUAI_FUNC void luaF_freeclosure(lua_State* L, Closure* c, struct lua_Page* page);
 LUAI_FUNC void luaF_freeupval(lua_State* L, UpVal* uv, struct lua_Page* page);
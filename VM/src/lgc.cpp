@@ -377,6 +377,17 @@ static void traverseproto(global_State* g, Proto* f)
         if (f->locvars[i].varname)
             stringmark(f->locvars[i].varname);
     }
+    if (f->udatacache)
+    { // mark values of the userdata inline cache
+        for (i = 0; i < f->sizecode; i++)
+        {
+            if (f->udatacache[i].metatable)
+                markobject(g, f->udatacache[i].metatable);
+            markvalue(g, &f->udatacache[i].value);
+        }
+    }
+    for (i = 0; i < f->sizeinlined; i++) // mark functions inlined into native code
+        markobject(g, f->inlined[i]);
 }
 
 static void traverseclosure(global_State* g, Closure* cl)
@@ -523,7 +534,8 @@ static size_t propagatemark(global_State* g)
         traverseproto(g, p);
 
         return sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
-               sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues + p->sizetypeinfo;
+               sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues + p->sizetypeinfo + sizeof(Proto*) * p->sizeinlined +
+               (p->typefeedback ? p->sizecode * 2 : 0) + (p->udatacache ? sizeof(UdataCache) * p->sizecode : 0);
     }
     default:
         LUAU_ASSERT(0);
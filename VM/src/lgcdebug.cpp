@@ -486,7 +486,8 @@ static void dumpbuffer(FILE* f, Buffer* b)
 static void dumpproto(FILE* f, Proto* p)
 {
     size_t size = sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
-                  sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues;
+                  sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues + sizeof(Proto*) * p->sizeinlined +
+                  (p->typefeedback ? p->sizecode * 2 : 0) + (p->udatacache ? sizeof(UdataCache) * p->sizecode : 0);
 
     fprintf(f, "{\"type\":\"proto\",\"cat\":%d,\"size\":%d", p->memcat, int(size));
 
@@ -823,7 +824,8 @@ static void enumbuffer(EnumContext* ctx, Buffer* b)
 static void enumproto(EnumContext* ctx, Proto* p)
 {
     size_t size = sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
-                  sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues;
+                  sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues + sizeof(Proto*) * p->sizeinlined +
+                  (p->typefeedback ? p->sizecode * 2 : 0) + (p->udatacache ? sizeof(UdataCache) * p->sizecode : 0);
 
     if (p->execdata && ctx->L->global->ecb.getmemorysize)
     {
@@ -847,6 +849,9 @@ static void enumproto(EnumContext* ctx, Proto* p)
 
     for (int i = 0; i < p->sizep; ++i)
         enumedge(ctx, obj2gco(p), obj2gco(p->p[i]), "protos");
+
+    for (int i = 0; i < p->sizeinlined; ++i)
+        enumedge(ctx, obj2gco(p), obj2gco(p->inlined[i]), "inlined");
 }
 
 static void enumupval(EnumContext* ctx, UpVal* uv)
@@ -2,8 +2,14 @@
 // This code is based on Lua 5.x implementation licensed under MIT License; see lua_LICENSE.txt for details
 #include "lualib.h"
 
+#include "lcommon.h"
+
 #include <stdlib.h>
 
+LUAU_FASTFLAG(LuauSerializeLibrary)
+LUAU_FASTFLAG(LuauJsonLibrary)
+LUAU_FASTFLAG(LuauStrbufLibrary)
+
 static const luaL_Reg lualibs[] = {
     {"", luaopen_base},
     {LUA_COLIBNAME, luaopen_coroutine},
@@ -19,15 +25,28 @@ static const luaL_Reg lualibs[] = {
     {NULL, NULL},
 };
 
+static void openlib(lua_State* L, const char* name, lua_CFunction func)
+{
+    lua_pushcfunction(L, func, NULL);
+    lua_pushstring(L, name);
+    lua_call(L, 1, 0);
+}
+
 void luaL_openlibs(lua_State* L)
 {
     const luaL_Reg* lib = lualibs;
     for (; lib->func; lib++)
-    {
-        lua_pushcfunction(L, lib->func, NULL);
-        lua_pushstring(L, lib->name);
-        lua_call(L, 1, 0);
-    }
+        openlib(L, lib->name, lib->func);
+
+    // new libraries add globals that existing code might already use, so they are opened only when their flag is enabled
+    if (FFlag::LuauSerializeLibrary)
+        openlib(L, LUA_SERLIBNAME, luaopen_serialize);
+
+    if (FFlag::LuauJsonLibrary)
+        openlib(L, LUA_JSONLIBNAME, luaopen_json);
+
+    if (FFlag::LuauStrbufLibrary)
+        openlib(L, LUA_STRBUFLIBNAME, luaopen_strbuf);
 }
 
 void luaL_sandbox(lua_State* L)
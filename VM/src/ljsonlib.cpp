@@ -0,0 +1,958 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lualib.h"
+
+#include "lcommon.h"
+#include "lnumutils.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LUAU_JSON_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LUAU_JSON_NEON
+#endif
+
+LUAU_FASTFLAGVARIABLE(LuauJsonLibrary)
+
+// nesting limit for arrays and objects; keeps the recursive encoder and decoder within native stack limits
+#define JSON_MAXDEPTH LUAI_MAXCCALLS
+
+// stack slots used by the decoder after the source string
+#define JSON_COUNTS 2
+
+// stack slots used by the encoder after the value
+#define JSON_STORAGE 2
+
+inline bool json_isspecial(unsigned char ch)
+{
+    return ch == '"' || ch == '\\' || ch < 0x20;
+}
+
+inline int json_ctz(unsigned mask)
+{
+#ifdef _MSC_VER
+    unsigned long rl;
+    _BitScanForward(&rl, mask);
+    return int(rl);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// returns the first character in [p, end) that needs special handling inside a string: a quote, a backslash or a control character
+// strings make up most of the bytes in typical documents, so this scans 16 bytes at a time where SIMD is available
+static const char* json_scanstring(const char* p, const char* end)
+{
+#if defined(LUAU_JSON_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1f);
+
+    while (end - p >= 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+
+        if (unsigned mask = unsigned(_mm_movemask_epi8(special)))
+            return p + json_ctz(mask);
+
+        p += 16;
+    }
+#elif defined(LUAU_JSON_NEON)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t control = vdupq_n_u8(0x1f);
+
+    while (end - p >= 16)
+    {
+        uint8x16_t v = vld1q_u8((const uint8_t*)p);
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vcleq_u8(v, control));
+
+        // narrow each byte of the comparison result to 4 bits to get a 64-bit mask
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+
+        if (mask)
+            return p + (__builtin_ctzll(mask) >> 2);
+
+        p += 16;
+    }
+#endif
+
+    while (p < end && !json_isspecial(*p))
+        p++;
+
+    return p;
+}
+
+struct JsonDecoder
+{
+    lua_State* L;
+
+    const char* start;
+    const char* end;
+    const char* p;
+
+    // element counts for every array and object in the order they are opened, used to presize tables
+    unsigned* counts;
+    int ncounts;
+    int container;
+
+    int depth;
+};
+
+static l_noret json_error(JsonDecoder* D, const char* what)
+{
+    if (D->p >= D->end)
+        luaL_error(D->L, "unexpected end of JSON input");
+    else
+        luaL_error(D->L, "%s at position %d", what, int(D->p - D->start) + 1);
+}
+
+inline void json_skipspace(JsonDecoder* D)
+{
+    const char* p = D->p;
+    const char* end = D->end;
+
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+        p++;
+
+    D->p = p;
+}
+
+// structural pre-pass: counts elements of every container so that tables can be created with their final size
+// the pass only computes size hints and doesn't validate the document, which is done by the parser afterwards
+static void json_countelements(JsonDecoder* D)
+{
+    lua_State* L = D->L;
+
+    struct Level
+    {
+        int container;
+        bool value;
+    };
+
+    Level stack[JSON_MAXDEPTH];
+    int depth = 0;
+
+    int capacity = 0;
+    unsigned* counts = NULL;
+    int ncounts = 0;
+
+    const char* p = D->p;
+    const char* end = D->end;
+
+    while (p < end)
+    {
+        char ch = *p;
+
+        switch (ch)
+        {
+        case ' ':
+        case '\n':
+        case '\r':
+        case '\t':
+            p++;
+            continue;
+
+        case '"':
+            // skip the string, including escaped quotes
+            p++;
+
+            for (;;)
+            {
+                p = json_scanstring(p, end);
+
+                if (p == end)
+                    break;
+
+                if (*p == '"')
+                {
+                    p++;
+                    break;
+                }
+
+                p += (*p == '\\' && end - p >= 2) ? 2 : 1;
+            }
+            break;
+
+        case '[':
+        case '{':
+            if (depth > 0)
+                stack[depth - 1].value = true;
+
+            if (depth == JSON_MAXDEPTH)
+            {
+                // the parser will fail on this document
+                p = end;
+                continue;
+            }
+
+            if (ncounts == capacity)
+            {
+                capacity = capacity ? capacity * 2 : 64;
+
+                // storage is a buffer object so that it's reclaimed when an error is raised
+                unsigned* newcounts = (unsigned*)lua_newbuffer(L, capacity * sizeof(unsigned));
+                if (ncounts)
+                    memcpy(newcounts, counts, ncounts * sizeof(unsigned));
+                lua_replace(L, JSON_COUNTS);
+
+                counts = newcounts;
+            }
+
+            counts[ncounts] = 0;
+            stack[depth].container = ncounts++;
+            stack[depth].value = false;
+            depth++;
+            p++;
+            continue;
+
+        case ']':
+        case '}':
+            if (depth > 0)
+            {
+                depth--;
+                counts[stack[depth].container] += stack[depth].value;
+            }
+            p++;
+            continue;
+
+        case ',':
+            if (depth > 0)
+                counts[stack[depth - 1].container]++;
+            p++;
+            continue;
+
+        case ':':
+            p++;
+            continue;
+
+        default:
+            p++;
+            break;
+        }
+
+        if (depth > 0)
+            stack[depth - 1].value = true;
+    }
+
+    D->counts = counts;
+    D->ncounts = ncounts;
+}
+
+static void json_decodevalue(JsonDecoder* D);
+
+static void json_appendutf8(luaL_Strbuf* B, unsigned cp)
+{
+    char* s = luaL_prepbuffsize(B, 4);
+
+    if (cp < 0x80)
+    {
+        s[0] = char(cp);
+        B->p += 1;
+    }
+    else if (cp < 0x800)
+    {
+        s[0] = char(0xC0 | (cp >> 6));
+        s[1] = char(0x80 | (cp & 0x3F));
+        B->p += 2;
+    }
+    else if (cp < 0x10000)
+    {
+        s[0] = char(0xE0 | (cp >> 12));
+        s[1] = char(0x80 | ((cp >> 6) & 0x3F));
+        s[2] = char(0x80 | (cp & 0x3F));
+        B->p += 3;
+    }
+    else
+    {
+        s[0] = char(0xF0 | (cp >> 18));
+        s[1] = char(0x80 | ((cp >> 12) & 0x3F));
+        s[2] = char(0x80 | ((cp >> 6) & 0x3F));
+        s[3] = char(0x80 | (cp & 0x3F));
+        B->p += 4;
+    }
+}
+
+static unsigned json_readhex4(JsonDecoder* D)
+{
+    if (D->end - D->p < 4)
+    {
+        D->p = D->end;
+        json_error(D, "invalid escape");
+    }
+
+    unsigned result = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        char ch = *D->p;
+        unsigned digit;
+
+        if (ch >= '0' && ch <= '9')
+            digit = ch - '0';
+        else if (ch >= 'a' && ch <= 'f')
+            digit = ch - 'a' + 10;
+        else if (ch >= 'A' && ch <= 'F')
+            digit = ch - 'A' + 10;
+        else
+            json_error(D, "invalid unicode escape");
+
+        result = result * 16 + digit;
+        D->p++;
+    }
+
+    return result;
+}
+
+static void json_decodeescape(JsonDecoder* D, luaL_Strbuf* B)
+{
+    // D->p points at the backslash
+    D->p++;
+
+    if (D->p >= D->end)
+        json_error(D, "invalid escape");
+
+    char ch = *D->p++;
+
+    switch (ch)
+    {
+    case '"':
+    case '\\':
+    case '/':
+        luaL_addchar(B, ch);
+        break;
+    case 'b':
+        luaL_addchar(B, '\b');
+        break;
+    case 'f':
+        luaL_addchar(B, '\f');
+        break;
+    case 'n':
+        luaL_addchar(B, '\n');
+        break;
+    case 'r':
+        luaL_addchar(B, '\r');
+        break;
+    case 't':
+        luaL_addchar(B, '\t');
+        break;
+    case 'u':
+    {
+        unsigned cp = json_readhex4(D);
+
+        // surrogate pairs encode code points outside of the basic multilingual plane
+        if (cp >= 0xD800 && cp <= 0xDBFF && D->end - D->p >= 2 && D->p[0] == '\\' && D->p[1] == 'u')
+        {
+            const char* pair = D->p;
+            D->p += 2;
+
+            unsigned low = json_readhex4(D);
+
+            if (low >= 0xDC00 && low <= 0xDFFF)
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            else
+                D->p = pair; // unpaired surrogate; the next escape will be decoded separately
+        }
+
+        json_appendutf8(B, cp);
+        break;
+    }
+    default:
+        D->p -= 2;
+        json_error(D, "invalid escape");
+    }
+}
+
+// D->p points at the opening quote; the resulting string is pushed onto the stack
+static void json_decodestring(JsonDecoder* D)
+{
+    const char* begin = D->p + 1;
+    const char* p = json_scanstring(begin, D->end);
+
+    // fast path: strings without escapes are interned directly from the source
+    if (p < D->end && *p == '"')
+    {
+        lua_pushlstring(D->L, begin, p - begin);
+        D->p = p + 1;
+        return;
+    }
+
+    luaL_Strbuf B;
+    luaL_buffinit(D->L, &B);
+
+    for (;;)
+    {
+        luaL_addlstring(&B, begin, p - begin);
+        D->p = p;
+
+        if (p >= D->end)
+            json_error(D, "unterminated string");
+
+        if (*p == '"')
+            break;
+
+        if (*p == '\\')
+            json_decodeescape(D, &B);
+        else
+            json_error(D, "invalid control character in string");
+
+        begin = D->p;
+        p = json_scanstring(begin, D->end);
+    }
+
+    D->p++;
+    luaL_pushresult(&B);
+}
+
+static void json_decodenumber(JsonDecoder* D)
+{
+    const char* start = D->p;
+    const char* p = start;
+    const char* end = D->end;
+
+    bool negative = false;
+
+    if (p < end && *p == '-')
+    {
+        negative = true;
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+
+    if (p < end && *p == '0')
+    {
+        p++;
+    }
+    else if (p < end && *p >= '1' && *p <= '9')
+    {
+        for (; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            if (digits < 19)
+                mantissa = mantissa * 10 + (*p - '0');
+            else
+                exponent++;
+
+            digits += (mantissa != 0);
+        }
+    }
+    else
+    {
+        D->p = p;
+        json_error(D, "invalid number");
+    }
+
+    if (p < end && *p == '.')
+    {
+        p++;
+
+        if (p >= end || *p < '0' || *p > '9')
+        {
+            D->p = p;
+            json_error(D, "invalid number");
+        }
+
+        for (; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                exponent--;
+            }
+
+            digits += (mantissa != 0);
+        }
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+
+        bool negexp = false;
+
+        if (p < end && (*p == '+' || *p == '-'))
+            negexp = *p++ == '-';
+
+        if (p >= end || *p < '0' || *p > '9')
+        {
+            D->p = p;
+            json_error(D, "invalid number");
+        }
+
+        int exp = 0;
+
+        for (; p < end && *p >= '0' && *p <= '9'; p++)
+            if (exp < 100000)
+                exp = exp * 10 + (*p - '0');
+
+        exponent += negexp ? -exp : exp;
+    }
+
+    D->p = p;
+
+    double value;
+
+    if (digits <= 19 && luai_dec2num(mantissa, exponent, &value))
+    {
+        value = negative ? -value : value;
+    }
+    else
+    {
+        // the token has been validated so strtod will consume exactly the same characters
+        lua_pushlstring(D->L, start, p - start);
+        value = strtod(lua_tostring(D->L, -1), NULL);
+        lua_pop(D->L, 1);
+    }
+
+    lua_pushnumber(D->L, value);
+}
+
+static void json_decodeliteral(JsonDecoder* D, const char* literal, size_t len)
+{
+    if (size_t(D->end - D->p) < len || memcmp(D->p, literal, len) != 0)
+        json_error(D, "unexpected character");
+
+    D->p += len;
+}
+
+inline int json_nextcount(JsonDecoder* D)
+{
+    int container = D->container++;
+
+    return container < D->ncounts ? int(D->counts[container]) : 0;
+}
+
+static void json_enter(JsonDecoder* D)
+{
+    if (++D->depth > JSON_MAXDEPTH)
+        json_error(D, "document is too deeply nested");
+
+    luaL_checkstack(D->L, LUA_MINSTACK, "document is too deeply nested");
+}
+
+static void json_decodearray(JsonDecoder* D)
+{
+    lua_State* L = D->L;
+
+    json_enter(D);
+
+    lua_createtable(L, json_nextcount(D), 0);
+    D->p++;
+
+    json_skipspace(D);
+
+    if (D->p < D->end && *D->p == ']')
+    {
+        D->p++;
+        D->depth--;
+        return;
+    }
+
+    for (int index = 1;; index++)
+    {
+        json_decodevalue(D);
+        lua_rawseti(L, -2, index);
+
+        json_skipspace(D);
+
+        if (D->p >= D->end)
+            json_error(D, "unterminated array");
+
+        if (*D->p == ']')
+            break;
+
+        if (*D->p != ',')
+            json_error(D, "expected ',' or ']'");
+
+        D->p++;
+    }
+
+    D->p++;
+    D->depth--;
+}
+
+static void json_decodeobject(JsonDecoder* D)
+{
+    lua_State* L = D->L;
+
+    json_enter(D);
+
+    lua_createtable(L, 0, json_nextcount(D));
+    D->p++;
+
+    json_skipspace(D);
+
+    if (D->p < D->end && *D->p == '}')
+    {
+        D->p++;
+        D->depth--;
+        return;
+    }
+
+    for (;;)
+    {
+        json_skipspace(D);
+
+        if (D->p >= D->end || *D->p != '"')
+            json_error(D, "expected string key");
+
+        json_decodestring(D);
+
+        json_skipspace(D);
+
+        if (D->p >= D->end || *D->p != ':')
+            json_error(D, "expected ':'");
+
+        D->p++;
+
+        json_decodevalue(D);
+        lua_rawset(L, -3);
+
+        json_skipspace(D);
+
+        if (D->p >= D->end)
+            json_error(D, "unterminated object");
+
+        if (*D->p == '}')
+            break;
+
+        if (*D->p != ',')
+            json_error(D, "expected ',' or '}'");
+
+        D->p++;
+    }
+
+    D->p++;
+    D->depth--;
+}
+
+static void json_decodevalue(JsonDecoder* D)
+{
+    json_skipspace(D);
+
+    if (D->p >= D->end)
+        json_error(D, "unexpected end of JSON input");
+
+    switch (*D->p)
+    {
+    case '{':
+        json_decodeobject(D);
+        break;
+    case '[':
+        json_decodearray(D);
+        break;
+    case '"':
+        json_decodestring(D);
+        break;
+    case 't':
+        json_decodeliteral(D, "true", 4);
+        lua_pushboolean(D->L, true);
+        break;
+    case 'f':
+        json_decodeliteral(D, "false", 5);
+        lua_pushboolean(D->L, false);
+        break;
+    case 'n':
+        json_decodeliteral(D, "null", 4);
+        lua_pushnil(D->L);
+        break;
+    default:
+        if (*D->p == '-' || (*D->p >= '0' && *D->p <= '9'))
+            json_decodenumber(D);
+        else
+            json_error(D, "unexpected character");
+    }
+}
+
+static int json_decode(lua_State* L)
+{
+    size_t len = 0;
+    const char* str = luaL_checklstring(L, 1, &len);
+
+    lua_settop(L, 1);
+    lua_pushnil(L); // JSON_COUNTS
+
+    JsonDecoder D = {L};
+    D.start = str;
+    D.end = str + len;
+    D.p = str;
+
+    json_countelements(&D);
+    json_decodevalue(&D);
+
+    json_skipspace(&D);
+
+    if (D.p != D.end)
+        json_error(&D, "unexpected character after JSON value");
+
+    return 1;
+}
+
+struct JsonEncoder
+{
+    lua_State* L;
+
+    luaL_Strbuf B;
+
+    int depth;
+};
+
+// luaL_Strbuf expects its storage at the top of the stack when it grows, but the encoder keeps traversal state on the stack
+// instead the storage is kept at a fixed slot and is temporarily moved to the top when more space is needed
+static char* json_reserve(JsonEncoder* E, size_t size)
+{
+    luaL_Strbuf* B = &E->B;
+
+    if (size_t(B->end - B->p) < size)
+    {
+        if (B->storage)
+            lua_pushvalue(E->L, JSON_STORAGE);
+
+        luaL_prepbuffsize(B, size);
+        lua_replace(E->L, JSON_STORAGE);
+    }
+
+    return B->p;
+}
+
+static void json_write(JsonEncoder* E, const char* data, size_t size)
+{
+    char* p = json_reserve(E, size);
+    memcpy(p, data, size);
+    E->B.p += size;
+}
+
+static void json_encodestring(JsonEncoder* E, const char* str, size_t len)
+{
+    static const char kHex[] = "0123456789abcdef";
+
+    const char* end = str + len;
+
+    // reserve space for the common case of a string without escapes
+    json_reserve(E, len + 2);
+    *E->B.p++ = '"';
+
+    for (;;)
+    {
+        const char* p = json_scanstring(str, end);
+
+        json_write(E, str, p - str);
+
+        if (p == end)
+            break;
+
+        unsigned char ch = *p;
+        char* s = json_reserve(E, 6);
+
+        s[0] = '\\';
+
+        switch (ch)
+        {
+        case '"':
+        case '\\':
+            s[1] = ch;
+            E->B.p += 2;
+            break;
+        case '\b':
+            s[1] = 'b';
+            E->B.p += 2;
+            break;
+        case '\f':
+            s[1] = 'f';
+            E->B.p += 2;
+            break;
+        case '\n':
+            s[1] = 'n';
+            E->B.p += 2;
+            break;
+        case '\r':
+            s[1] = 'r';
+            E->B.p += 2;
+            break;
+        case '\t':
+            s[1] = 't';
+            E->B.p += 2;
+            break;
+        default:
+            s[1] = 'u';
+            s[2] = '0';
+            s[3] = '0';
+            s[4] = kHex[ch >> 4];
+            s[5] = kHex[ch & 15];
+            E->B.p += 6;
+            break;
+        }
+
+        str = p + 1;
+    }
+
+    json_write(E, "\"", 1);
+}
+
+static void json_encodevalue(JsonEncoder* E, int idx);
+
+static void json_encodetable(JsonEncoder* E, int idx)
+{
+    lua_State* L = E->L;
+
+    if (++E->depth > JSON_MAXDEPTH)
+        luaL_error(L, "cannot encode a table that is too deeply nested or has a reference cycle");
+
+    luaL_checkstack(L, LUA_MINSTACK, "value is too deeply nested");
+
+    int narr = lua_objlen(L, idx);
+
+    // tables with keys [1..n] are encoded as arrays, including empty tables; any other key makes the table an object
+    int nkeys = 0;
+    bool array = true;
+
+    lua_pushnil(L);
+    while (lua_next(L, idx))
+    {
+        lua_pop(L, 1);
+        nkeys++;
+
+        if (array)
+        {
+            double key = lua_type(L, -1) == LUA_TNUMBER ? lua_tonumber(L, -1) : 0;
+            array = key >= 1 && key <= narr && double(int(key)) == key;
+        }
+    }
+
+    if (array && nkeys == narr)
+    {
+        json_write(E, "[", 1);
+
+        for (int i = 1; i <= narr; ++i)
+        {
+            if (i > 1)
+                json_write(E, ",", 1);
+
+            lua_rawgeti(L, idx, i);
+            json_encodevalue(E, lua_gettop(L));
+            lua_pop(L, 1);
+        }
+
+        json_write(E, "]", 1);
+    }
+    else
+    {
+        json_write(E, "{", 1);
+
+        bool first = true;
+
+        lua_pushnil(L);
+        while (lua_next(L, idx))
+        {
+            if (lua_type(L, -2) != LUA_TSTRING)
+                luaL_error(L, "cannot encode a table with %s keys", luaL_typename(L, -2));
+
+            if (!first)
+                json_write(E, ",", 1);
+
+            first = false;
+
+            size_t len = 0;
+            const char* key = lua_tolstring(L, -2, &len);
+
+            json_encodestring(E, key, len);
+            json_write(E, ":", 1);
+            json_encodevalue(E, lua_gettop(L));
+
+            lua_pop(L, 1);
+        }
+
+        json_write(E, "}", 1);
+    }
+
+    E->depth--;
+}
+
+static void json_encodevalue(JsonEncoder* E, int idx)
+{
+    lua_State* L = E->L;
+
+    switch (lua_type(L, idx))
+    {
+    case LUA_TNIL:
+        json_write(E, "null", 4);
+        break;
+
+    case LUA_TBOOLEAN:
+        if (lua_toboolean(L, idx))
+            json_write(E, "true", 4);
+        else
+            json_write(E, "false", 5);
+        break;
+
+    case LUA_TNUMBER:
+    {
+        double n = lua_tonumber(L, idx);
+
+        if (!isfinite(n))
+            luaL_error(L, "cannot encode %s", isnan(n) ? "NaN" : "infinity");
+
+        char* s = json_reserve(E, LUAI_MAXNUM2STR);
+        E->B.p = luai_num2str(s, n);
+        break;
+    }
+
+    case LUA_TSTRING:
+    {
+        size_t len = 0;
+        const char* str = lua_tolstring(L, idx, &len);
+        json_encodestring(E, str, len);
+        break;
+    }
+
+    case LUA_TTABLE:
+        json_encodetable(E, idx);
+        break;
+
+    default:
+        luaL_error(L, "cannot encode a %s value", luaL_typename(L, idx));
+    }
+}
+
+static int json_encode(lua_State* L)
+{
+    luaL_checkany(L, 1);
+    lua_settop(L, 1);
+    lua_pushnil(L); // JSON_STORAGE
+
+    JsonEncoder E = {L};
+    luaL_buffinit(L, &E.B);
+
+    json_encodevalue(&E, 1);
+
+    if (E.B.storage)
+        lua_pushvalue(L, JSON_STORAGE);
+
+    luaL_pushresult(&E.B);
+    return 1;
+}
+
+static const luaL_Reg jsonlib[] = {
+    {"encode", json_encode},
+    {"decode", json_decode},
+    {NULL, NULL},
+};
+
+int luaopen_json(lua_State* L)
+{
+    luaL_register(L, LUA_JSONLIBNAME, jsonlib);
+
+    return 1;
+}
@@ -5,6 +5,8 @@
 
 #include "lcommon.h"
 
+#include <ctype.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef _MSC_VER
@@ -110,6 +112,32 @@ inline uint64_t roundodd(uint64_t ghi, uint64_t glo, uint64_t cp)
     return (yhi + (z < xhi)) | (z > 1);
 }
 
+// 9.8.2. Overestimates of powers of 10
+// Recover 10^p fraction using compact tables generated by tools/numutils.py
+// The 128-bit fraction is encoded as 128-bit baseline * power-of-5 * scale + offset
+// The result is normalized (top bit is set) and is exact for p in [0, 55]; other powers are overestimated by exactly 1
+inline uint64_t pow10table(int p, uint64_t* hi)
+{
+    LUAU_ASSERT(p >= kPow10TableMin && p <= kPow10TableMax);
+    int gtoff = p - kPow10TableMin;
+    const uint64_t* gt = kPow10Table[gtoff >> 4];
+
+    uint64_t ghi;
+    uint64_t glo = mul192hi(gt[0], gt[1], kPow5Table[gtoff & 15], &ghi);
+
+    // Apply 1-bit scale + 3-bit offset; note, offset is intentionally applied without carry, numutils.py validates that this is sufficient
+    int gterr = (gt[2] >> ((gtoff & 15) * 4)) & 15;
+    int gtscale = gterr >> 3;
+
+    ghi <<= gtscale;
+    ghi += (glo >> 63) & gtscale;
+    glo <<= gtscale;
+    glo -= (gterr & 7) - 4;
+
+    *hi = ghi;
+    return glo;
+}
+
 struct Decimal
 {
     uint64_t s;
@@ -150,23 +178,8 @@ static Decimal schubfach(int exponent, uint64_t fraction)
     int h = q + ((-k * C2) >> Q) + 1; // see (9) in 9.9
 
     // 9.8.2. Overestimates of powers of 10
-    // Recover 10^-k fraction using compact tables generated by tools/numutils.py
-    // The 128-bit fraction is encoded as 128-bit baseline * power-of-5 * scale + offset
-    LUAU_ASSERT(-k >= kPow10TableMin && -k <= kPow10TableMax);
-    int gtoff = -k - kPow10TableMin;
-    const uint64_t* gt = kPow10Table[gtoff >> 4];
-
     uint64_t ghi;
-    uint64_t glo = mul192hi(gt[0], gt[1], kPow5Table[gtoff & 15], &ghi);
-
-    // Apply 1-bit scale + 3-bit offset; note, offset is intentionally applied without carry, numutils.py validates that this is sufficient
-    int gterr = (gt[2] >> ((gtoff & 15) * 4)) & 15;
-    int gtscale = gterr >> 3;
-
-    ghi <<= gtscale;
-    ghi += (glo >> 63) & gtscale;
-    glo <<= gtscale;
-    glo -= (gterr & 7) - 4;
+    uint64_t glo = pow10table(-k, &ghi);
 
     // 9.9. Boundaries for v
     uint64_t vbl = roundodd(ghi, glo, cbl << h);
@@ -367,3 +380,355 @@ char* luai_num2str(char* buf, double n)
         return printexp(exp, dot - 1);
     }
 }
+
+// The general %g format prints the value rounded to 'precision' significant digits, choosing between fixed and scientific notation
+// and removing trailing zeros. We derive the digits from the shortest round-trip representation, which is only possible when
+// rounding that representation gives the same result as rounding the exact binary value; NULL is returned otherwise.
+char* luai_num2gstr(char* buf, double n, int precision)
+{
+    // IEEE-754
+    union
+    {
+        double v;
+        uint64_t bits;
+    } v = {n};
+    int sign = int(v.bits >> 63);
+    int exponent = int(v.bits >> 52) & 2047;
+    uint64_t fraction = v.bits & ((1ull << 52) - 1);
+
+    // specials are left to the C library since their spelling is platform-specific
+    // denormals are left to the C library as well since they have fewer significant bits than the error analysis below assumes
+    if (exponent == 0x7ff || (exponent == 0 && fraction != 0) || precision > 15)
+        return NULL;
+
+    if (precision == 0)
+        precision = 1;
+
+    // sign bit
+    *buf = '-';
+    buf += sign;
+
+    // zero
+    if (exponent == 0)
+    {
+        buf[0] = '0';
+        return buf + 1;
+    }
+
+    Decimal d = schubfach(exponent, fraction);
+    LUAU_ASSERT(d.s < uint64_t(1e17));
+
+    char decbuf[40];
+    char* decend = decbuf + 20;
+    char* dec = printunsignedrev(decend, d.s);
+
+    // integer fast path in schubfach may return trailing zeros
+    while (decend[-1] == '0')
+    {
+        decend--;
+        d.k++;
+    }
+
+    int declen = int(decend - dec);
+    int x = declen - 1 + d.k; // decimal exponent of the leading digit
+
+    if (declen > precision)
+    {
+        // tail holds the digits that are rounded off, scaled to the 17th significant digit
+        // the exact value is within half an ulp (< 23 units of the 17th digit) of the shortest representation, so the tail needs to stay
+        // clear of the midpoint by that margin for both to round the same way
+        uint64_t tail = 0;
+
+        for (int i = precision; i < 17; ++i)
+            tail = tail * 10 + (i < declen ? dec[i] - '0' : 0);
+
+        uint64_t half = 5;
+
+        for (int i = precision + 1; i < 17; ++i)
+            half *= 10;
+
+        if (tail + 23 > half && tail < half + 23)
+            return NULL;
+
+        declen = precision;
+
+        if (tail > half)
+        {
+            int i = declen - 1;
+
+            while (i >= 0 && dec[i] == '9')
+                dec[i--] = '0';
+
+            if (i >= 0)
+            {
+                dec[i]++;
+            }
+            else
+            {
+                // 99.9 => 100
+                *--dec = '1';
+                x++;
+            }
+        }
+
+        while (declen > 1 && dec[declen - 1] == '0')
+            declen--;
+    }
+
+    if (x < -4 || x >= precision)
+    {
+        // scientific format
+        buf[0] = dec[0];
+        buf[1] = '.';
+        memcpy(buf + 2, dec + 1, declen - 1);
+
+        char* exp = declen > 1 ? buf + declen + 1 : buf + 1;
+
+        return printexp(exp, x);
+    }
+    else if (x < 0)
+    {
+        buf[0] = '0';
+        buf[1] = '.';
+        memset(buf + 2, '0', -x - 1);
+        memcpy(buf + 1 - x, dec, declen);
+
+        return buf + 1 - x + declen;
+    }
+    else if (declen <= x + 1)
+    {
+        // no dot, zero padding
+        memcpy(buf, dec, declen);
+        memset(buf + declen, '0', x + 1 - declen);
+
+        return buf + x + 1;
+    }
+    else
+    {
+        // dot in the middle
+        memcpy(buf, dec, x + 1);
+        buf[x + 1] = '.';
+        memcpy(buf + x + 2, dec + x + 1, declen - x - 1);
+
+        return buf + declen + 1;
+    }
+}
+
+// This work is based on:
+// Daniel Lemire. Number Parsing at a Gigabyte per Second. 2021
+// https://arxiv.org/abs/2101.11408
+
+// Powers of 10 that are exactly representable as doubles, used by the fast path from Clinger's algorithm
+static const double kPow10Exact[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+inline int countlz64(uint64_t x)
+{
+    LUAU_ASSERT(x != 0);
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long r;
+    _BitScanReverse64(&r, x);
+    return 63 - int(r);
+#elif defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int r = 0;
+    while (!(x & (1ull << 63)))
+    {
+        x <<= 1;
+        r++;
+    }
+    return r;
+#endif
+}
+
+// Round p*2^e (p is a 192-bit value p2:p1:p0) to the nearest double; 'above' indicates that the value is slightly larger than p*2^e
+// Returns false when the result is not a normal number; these cases are left to strtod
+static bool roundbinary(uint64_t p2, uint64_t p1, uint64_t p0, int e, bool above, uint64_t* result)
+{
+    if (!(p2 >> 63))
+    {
+        p2 = (p2 << 1) | (p1 >> 63);
+        p1 = (p1 << 1) | (p0 >> 63);
+        p0 <<= 1;
+        e--;
+    }
+
+    int be = e + 191; // binary exponent of the leading bit
+
+    uint64_t m = p2 >> 11;
+    bool roundbit = (p2 >> 10) & 1;
+    bool sticky = (p2 & 0x3ff) || p1 || p0 || above;
+
+    m += roundbit && (sticky || (m & 1));
+
+    if (m >> 53)
+    {
+        m >>= 1;
+        be++;
+    }
+
+    if (be < -1022 || be > 1023)
+        return false;
+
+    *result = (uint64_t(be + 1023) << 52) | (m & ((1ull << 52) - 1));
+    return true;
+}
+
+bool luai_dec2num(uint64_t w, int q, double* result)
+{
+    if (w == 0)
+    {
+        *result = 0.0;
+        return true;
+    }
+
+    // when both the mantissa and the power of 10 are exactly representable, a single rounding operation gives a correct result
+    if (w <= (1ull << 53) && q >= -22 && q <= 22)
+    {
+        double r = double(w);
+        *result = q < 0 ? r / kPow10Exact[-q] : r * kPow10Exact[q];
+        return true;
+    }
+
+    // very small and very large numbers are rare, and are left to strtod
+    if (q < kPow10TableMin || q > 308)
+        return false;
+
+    uint64_t ghi;
+    uint64_t glo = pow10table(q, &ghi);
+
+    // normalize the mantissa so that the product has a leading bit in one of the top two positions
+    int lz = countlz64(w);
+    uint64_t wn = w << lz;
+
+    uint64_t p1c;
+    uint64_t p0 = mul128(wn, glo, &p1c);
+    uint64_t p2;
+    uint64_t p1 = mul128(wn, ghi, &p2);
+
+    p1 += p1c;
+    p2 += (p1 < p1c);
+
+    // 10^q == g*2^(floor(log2(10^q)) - 127), w == wn*2^-lz
+    int e = ((q * 217706) >> 16) - 127 - lz;
+
+    uint64_t hi;
+    if (!roundbinary(p2, p1, p0, e, false, &hi))
+        return false;
+
+    // the table stores overestimates of inexact powers of 10, so the exact product is somewhere in (p - wn, p]
+    // since rounding is monotonic, if both ends of the interval round to the same double, the result is correctly rounded
+    if (q < 0 || q > 55)
+    {
+        uint64_t b1 = p0 < wn;
+        uint64_t b2 = p1 < b1;
+
+        uint64_t lo;
+        if (!roundbinary(p2 - b2, p1 - b1, p0 - wn, e, true, &lo) || lo != hi)
+            return false;
+    }
+
+    memcpy(result, &hi, sizeof(double));
+    return true;
+}
+
+double luai_str2num(const char* s, char** endptr)
+{
+    const char* p = s;
+
+    while (isspace((unsigned char)*p))
+        p++;
+
+    bool negative = false;
+
+    if (*p == '-' || *p == '+')
+        negative = *p++ == '-';
+
+    // hexadecimal numbers are parsed by strtod
+    if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+        return strtod(s, endptr);
+
+    uint64_t w = 0;
+    int digits = 0;
+    int q = 0;
+    bool truncated = false;
+    const char* mantissa = p;
+
+    for (; *p >= '0' && *p <= '9'; p++)
+    {
+        if (digits < 19)
+            w = w * 10 + (*p - '0');
+        else
+        {
+            q++;
+            truncated |= *p != '0';
+        }
+
+        digits += (w != 0);
+    }
+
+    if (*p == '.')
+    {
+        p++;
+
+        for (; *p >= '0' && *p <= '9'; p++)
+        {
+            if (digits < 19)
+            {
+                w = w * 10 + (*p - '0');
+                q--;
+            }
+            else
+            {
+                truncated |= *p != '0';
+            }
+
+            digits += (w != 0);
+        }
+    }
+
+    // no digits in the mantissa; this could be an infinity, nan or an invalid number
+    if (p == mantissa || (p == mantissa + 1 && *mantissa == '.'))
+        return strtod(s, endptr);
+
+    if (*p == 'e' || *p == 'E')
+    {
+        const char* ep = p + 1;
+        bool negexp = false;
+
+        if (*ep == '+' || *ep == '-')
+            negexp = *ep++ == '-';
+
+        // exponent is only consumed when it has at least one digit
+        if (*ep >= '0' && *ep <= '9')
+        {
+            int exp = 0;
+
+            for (; *ep >= '0' && *ep <= '9'; ep++)
+                if (exp < 100000)
+                    exp = exp * 10 + (*ep - '0');
+
+            q += negexp ? -exp : exp;
+            p = ep;
+        }
+    }
+
+    *endptr = (char*)p;
+
+    double result;
+    if (!luai_dec2num(w, q, &result))
+        return strtod(s, endptr);
+
+    // when the mantissa was truncated, the exact value is in [w, w+1) * 10^q, so the result is correct if both ends round the same way
+    if (truncated)
+    {
+        double upper;
+        if (!luai_dec2num(w + 1, q, &upper) || upper != result)
+            return strtod(s, endptr);
+    }
+
+    return negative ? -result : result;
+}
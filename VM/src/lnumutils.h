@@ -3,6 +3,7 @@
 #pragma once
 
 #include <math.h>
+#include <stdint.h>
 
 #define luai_numadd(a, b) ((a) + (b))
 #define luai_numsub(a, b) ((a) - (b))
@@ -81,5 +82,7 @@ inline float luai_lerpf(float a, float b, float t)
 #define LUAI_MAXNUM2STR 48
 
 LUAI_FUNC char* luai_num2str(char* buf, double n);
+LUAI_FUNC char* luai_num2gstr(char* buf, double n, int precision);
 
-#define luai_str2num(s, p) strtod((s), (p))
+LUAI_FUNC bool luai_dec2num(uint64_t w, int q, double* result);
+LUAI_FUNC double luai_str2num(const char* s, char** endptr);
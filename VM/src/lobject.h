@@ -237,7 +237,8 @@ typedef TValue* StkId; // index to stack elements
 typedef struct TString
 {
     CommonHeader;
-    // 1 byte padding
+
+    uint8_t utf8; // cached classification of the contents as UTF-8 (see UTF8_*), computed on demand by the utf8 library
 
     int16_t atom;
 
@@ -279,6 +280,17 @@ typedef struct LuauBuffer
     alignas(8) char data[1];
 } Buffer;
 
+/*
+** Inline cache entry for a field or method of userdata, filled and read by native code
+*/
+typedef struct UdataCache
+{
+    struct LuaTable* metatable; // metatable of the userdata that the value was resolved for
+    unsigned int epoch;         // global_State::udatacacheepoch at the time the entry was filled
+
+    TValue value;
+} UdataCache;
+
 /*
 ** Function Prototypes
 */
@@ -312,6 +324,9 @@ typedef struct Proto
 
     TString* debugname;
     uint8_t* debuginsn; // a copy of code[] array with just opcodes
+    uint8_t* typefeedback; // for each instruction, a pair of operand type masks observed by the interpreter; see lfunc.h
+    UdataCache* udatacache; // for each instruction, the inline cache entry of a userdata field or method access; see lfunc.h
+    struct Proto** inlined; // functions inlined into native code of this function, which has to keep them alive; see lfunc.h
 
     uint8_t* typeinfo;
 
@@ -330,6 +345,11 @@ typedef struct Proto
     int linedefined;
     int bytecodeid;
     int sizetypeinfo;
+    int sizeinlined;
+
+    int tiercalls; // remaining calls before the function is handed to ecb.tierup; only counted when codeentry is redirected (see LOP_NATIVECALL)
+    int tierloops; // remaining loop iterations before the function is handed to ecb.tierup; only counted when positive, while a negative value
+                   // makes the next taken loop back-edge of an interpreted frame switch it to native code (on-stack replacement)
 } Proto;
 // clang-format on
 
@@ -454,7 +474,7 @@ typedef struct LuaTable
 
 
     uint8_t tmcache;    // 1<<p means tagmethod(p) is not present
-    uint8_t readonly;   // sandboxing feature to prohibit writes to table
+    uint8_t readonly;   // sandboxing feature to prohibit writes to table; also marks tables watched by caches, see ltable.h
     uint8_t safeenv;    // environment doesn't share globals with other scripts
     uint8_t lsizenode;  // log2 of size of `node' array
     uint8_t nodemask8; // (1<<lsizenode)-1, truncated to 8 bits
@@ -0,0 +1,704 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lualib.h"
+
+#include "lcommon.h"
+#include "lbuffer.h"
+
+#include <math.h>
+#include <string.h>
+
+LUAU_FASTFLAGVARIABLE(LuauSerializeLibrary)
+
+// serialized data format, version 1:
+//   version:u8 value
+// value is encoded as a tag byte followed by a tag-specific payload:
+//   nil, false, true: no payload
+//   int: zigzag varint (used for numbers that are exactly representable as a 32-bit integer)
+//   number: 8 byte little-endian IEEE double
+//   string: varint length, bytes; every string is assigned the next string index
+//   stringref: varint string index (1-based)
+//   vector: 3 (or 4 for vector4) little-endian floats
+//   buffer: varint length, bytes; assigned the next object index
+//   table: varint array count, varint hash count, array values, key/value pairs; assigned the next object index before contents
+//   ref: varint object index (1-based), used for shared and cyclic references
+//   custom: value produced by the encode hook; the decode hook result is assigned the next object index
+#define SER_VERSION 1
+
+// nesting limit for values; keeps the recursive encoder and decoder within native stack limits
+#define SER_MAXDEPTH LUAI_MAXCCALLS
+
+enum SerTag
+{
+    SER_NIL,
+    SER_FALSE,
+    SER_TRUE,
+    SER_INT,
+    SER_NUMBER,
+    SER_STRING,
+    SER_STRINGREF,
+    SER_VECTOR,
+    SER_VECTOR4,
+    SER_BUFFER,
+    SER_TABLE,
+    SER_REF,
+    SER_CUSTOM,
+};
+
+// stack slots used by the encoder and the decoder, after the value/buffer and the hook arguments
+#define SER_SCRATCH 3
+#define SER_STRINGS 4
+#define SER_OBJECTS 5
+
+struct SerEncoder
+{
+    lua_State* L;
+
+    char* data;
+    size_t size;
+    size_t capacity;
+
+    bool hook;
+    int depth;
+
+    int nstrings;
+    int nobjects;
+};
+
+static void ser_grow(SerEncoder* E, size_t extra)
+{
+    lua_State* L = E->L;
+
+    if (E->size + extra > MAX_BUFFER_SIZE)
+        luaL_error(L, "serialized data is too large");
+
+    size_t capacity = E->capacity * 2;
+    if (capacity < E->size + extra)
+        capacity = E->size + extra;
+    if (capacity > MAX_BUFFER_SIZE)
+        capacity = MAX_BUFFER_SIZE;
+
+    // scratch storage is a buffer object anchored on the stack so that it's reclaimed if the encoder errors out
+    char* data = (char*)lua_newbuffer(L, capacity);
+    memcpy(data, E->data, E->size);
+    lua_replace(L, SER_SCRATCH);
+
+    E->data = data;
+    E->capacity = capacity;
+}
+
+inline char* ser_reserve(SerEncoder* E, size_t extra)
+{
+    if (E->capacity - E->size < extra)
+        ser_grow(E, extra);
+
+    return E->data + E->size;
+}
+
+inline void ser_writebyte(SerEncoder* E, uint8_t value)
+{
+    char* p = ser_reserve(E, 1);
+    *p = char(value);
+    E->size++;
+}
+
+static void ser_writevarint(SerEncoder* E, uint32_t value)
+{
+    char* p = ser_reserve(E, 5);
+    char* start = p;
+
+    do
+    {
+        *p++ = char((value & 127) | ((value > 127) << 7));
+        value >>= 7;
+    } while (value);
+
+    E->size += p - start;
+}
+
+static void ser_writebytes(SerEncoder* E, const void* data, size_t size)
+{
+    char* p = ser_reserve(E, size);
+    memcpy(p, data, size);
+    E->size += size;
+}
+
+static void ser_writeu32(SerEncoder* E, uint32_t value)
+{
+    char* p = ser_reserve(E, 4);
+    for (int i = 0; i < 4; ++i)
+        p[i] = char(value >> (i * 8));
+    E->size += 4;
+}
+
+static void ser_writeu64(SerEncoder* E, uint64_t value)
+{
+    char* p = ser_reserve(E, 8);
+    for (int i = 0; i < 8; ++i)
+        p[i] = char(value >> (i * 8));
+    E->size += 8;
+}
+
+static void ser_writefloat(SerEncoder* E, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    ser_writeu32(E, bits);
+}
+
+static void ser_encode(SerEncoder* E, int idx, bool allowhook);
+
+static void ser_encodenumber(SerEncoder* E, double value)
+{
+    // integers are stored as zigzag varints, which makes common small values take 1-2 bytes instead of 8
+    if (value >= -2147483648.0 && value <= 2147483647.0)
+    {
+        int32_t iv = int32_t(value);
+
+        if (double(iv) == value && (iv != 0 || !signbit(value)))
+        {
+            ser_writebyte(E, SER_INT);
+            ser_writevarint(E, (uint32_t(iv) << 1) ^ uint32_t(iv >> 31));
+            return;
+        }
+    }
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    ser_writebyte(E, SER_NUMBER);
+    ser_writeu64(E, bits);
+}
+
+static void ser_encodestring(SerEncoder* E, int idx)
+{
+    lua_State* L = E->L;
+
+    lua_pushvalue(L, idx);
+    lua_rawget(L, SER_STRINGS);
+
+    if (!lua_isnil(L, -1))
+    {
+        ser_writebyte(E, SER_STRINGREF);
+        ser_writevarint(E, uint32_t(lua_tointeger(L, -1)));
+        lua_pop(L, 1);
+        return;
+    }
+
+    lua_pop(L, 1);
+
+    size_t len = 0;
+    const char* str = lua_tolstring(L, idx, &len);
+
+    ser_writebyte(E, SER_STRING);
+    ser_writevarint(E, uint32_t(len));
+    ser_writebytes(E, str, len);
+
+    lua_pushvalue(L, idx);
+    lua_pushinteger(L, ++E->nstrings);
+    lua_rawset(L, SER_STRINGS);
+}
+
+static void ser_registerobject(SerEncoder* E, int idx)
+{
+    lua_State* L = E->L;
+
+    lua_pushvalue(L, idx);
+    lua_pushinteger(L, ++E->nobjects);
+    lua_rawset(L, SER_OBJECTS);
+}
+
+// array part is encoded for keys [1..n] where n is the table border
+inline bool ser_isarraykey(lua_State* L, int idx, int narr)
+{
+    if (lua_type(L, idx) != LUA_TNUMBER)
+        return false;
+
+    double key = lua_tonumber(L, idx);
+    return key >= 1 && key <= narr && double(int(key)) == key;
+}
+
+static void ser_encodetable(SerEncoder* E, int idx)
+{
+    lua_State* L = E->L;
+
+    ser_registerobject(E, idx);
+
+    int narr = lua_objlen(L, idx);
+    int nhash = 0;
+
+    lua_pushnil(L);
+    while (lua_next(L, idx))
+    {
+        lua_pop(L, 1);
+
+        if (!ser_isarraykey(L, -1, narr))
+            nhash++;
+    }
+
+    ser_writebyte(E, SER_TABLE);
+    ser_writevarint(E, uint32_t(narr));
+    ser_writevarint(E, uint32_t(nhash));
+
+    for (int i = 1; i <= narr; ++i)
+    {
+        lua_rawgeti(L, idx, i);
+        ser_encode(E, lua_gettop(L), true);
+        lua_pop(L, 1);
+    }
+
+    int written = 0;
+
+    lua_pushnil(L);
+    while (lua_next(L, idx))
+    {
+        if (!ser_isarraykey(L, -2, narr))
+        {
+            int top = lua_gettop(L);
+
+            ser_encode(E, top - 1, true);
+            ser_encode(E, top, true);
+            written++;
+        }
+
+        lua_pop(L, 1);
+    }
+
+    // encode hooks can modify the tables that are being traversed
+    if (written != nhash)
+        luaL_error(L, "table was modified during serialization");
+}
+
+static void ser_encodecustom(SerEncoder* E, int idx)
+{
+    lua_State* L = E->L;
+
+    // mark the object as in progress to detect reference cycles through the hook result
+    lua_pushvalue(L, idx);
+    lua_pushboolean(L, false);
+    lua_rawset(L, SER_OBJECTS);
+
+    lua_pushvalue(L, 2);
+    lua_pushvalue(L, idx);
+    lua_call(L, 1, 1);
+
+    ser_writebyte(E, SER_CUSTOM);
+    ser_encode(E, lua_gettop(L), false);
+    lua_pop(L, 1);
+
+    ser_registerobject(E, idx);
+}
+
+static void ser_encode(SerEncoder* E, int idx, bool allowhook)
+{
+    lua_State* L = E->L;
+
+    int type = lua_type(L, idx);
+
+    switch (type)
+    {
+    case LUA_TNIL:
+        ser_writebyte(E, SER_NIL);
+        return;
+
+    case LUA_TBOOLEAN:
+        ser_writebyte(E, lua_toboolean(L, idx) ? SER_TRUE : SER_FALSE);
+        return;
+
+    case LUA_TNUMBER:
+        ser_encodenumber(E, lua_tonumber(L, idx));
+        return;
+
+    case LUA_TSTRING:
+        ser_encodestring(E, idx);
+        return;
+
+    case LUA_TVECTOR:
+    {
+        const float* v = lua_tovector(L, idx);
+
+#if LUA_VECTOR_SIZE == 4
+        ser_writebyte(E, SER_VECTOR4);
+#else
+        ser_writebyte(E, SER_VECTOR);
+#endif
+
+        for (int i = 0; i < LUA_VECTOR_SIZE; ++i)
+            ser_writefloat(E, v[i]);
+        return;
+    }
+
+    default:
+        break;
+    }
+
+    // remaining values are objects that are encoded once and referenced by index afterwards
+    lua_pushvalue(L, idx);
+    lua_rawget(L, SER_OBJECTS);
+
+    if (!lua_isnil(L, -1))
+    {
+        if (!lua_isnumber(L, -1))
+            luaL_error(L, "cannot serialize a cyclic reference through the hook");
+
+        ser_writebyte(E, SER_REF);
+        ser_writevarint(E, uint32_t(lua_tointeger(L, -1)));
+        lua_pop(L, 1);
+        return;
+    }
+
+    lua_pop(L, 1);
+
+    if (++E->depth > SER_MAXDEPTH)
+        luaL_error(L, "value is too deeply nested");
+
+    luaL_checkstack(L, LUA_MINSTACK, "value is too deeply nested");
+
+    if (type == LUA_TBUFFER)
+    {
+        size_t len = 0;
+        void* data = lua_tobuffer(L, idx, &len);
+
+        ser_registerobject(E, idx);
+
+        ser_writebyte(E, SER_BUFFER);
+        ser_writevarint(E, uint32_t(len));
+        ser_writebytes(E, data, len);
+    }
+    else if (type == LUA_TTABLE && !(E->hook && allowhook && lua_getmetatable(L, idx)))
+    {
+        ser_encodetable(E, idx);
+    }
+    else if (E->hook && allowhook)
+    {
+        if (type == LUA_TTABLE)
+            lua_pop(L, 1); // metatable
+
+        ser_encodecustom(E, idx);
+    }
+    else
+    {
+        luaL_error(L, "cannot serialize a %s value", luaL_typename(L, idx));
+    }
+
+    E->depth--;
+}
+
+struct SerDecoder
+{
+    lua_State* L;
+
+    const char* data;
+    size_t size;
+    size_t pos;
+
+    bool hook;
+    int depth;
+
+    int nstrings;
+    int nobjects;
+};
+
+static l_noret ser_malformed(SerDecoder* D)
+{
+    luaL_error(D->L, "malformed serialized data at offset %d", int(D->pos));
+}
+
+inline uint8_t ser_readbyte(SerDecoder* D)
+{
+    if (D->pos >= D->size)
+        ser_malformed(D);
+
+    return uint8_t(D->data[D->pos++]);
+}
+
+static uint32_t ser_readvarint(SerDecoder* D)
+{
+    uint32_t result = 0;
+
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t byte = ser_readbyte(D);
+        result |= uint32_t(byte & 127) << shift;
+
+        if (!(byte & 128))
+            return result;
+    }
+
+    ser_malformed(D);
+}
+
+static const char* ser_readbytes(SerDecoder* D, size_t size)
+{
+    if (size > D->size - D->pos)
+        ser_malformed(D);
+
+    const char* result = D->data + D->pos;
+    D->pos += size;
+    return result;
+}
+
+static uint64_t ser_readu64(SerDecoder* D, int bytes)
+{
+    const char* p = ser_readbytes(D, bytes);
+
+    uint64_t result = 0;
+    for (int i = 0; i < bytes; ++i)
+        result |= uint64_t(uint8_t(p[i])) << (i * 8);
+
+    return result;
+}
+
+static float ser_readfloat(SerDecoder* D)
+{
+    uint32_t bits = uint32_t(ser_readu64(D, 4));
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+static void ser_decode(SerDecoder* D);
+
+static void ser_enter(SerDecoder* D)
+{
+    if (++D->depth > SER_MAXDEPTH)
+        luaL_error(D->L, "value is too deeply nested");
+
+    luaL_checkstack(D->L, LUA_MINSTACK, "value is too deeply nested");
+}
+
+static void ser_decodetable(SerDecoder* D)
+{
+    lua_State* L = D->L;
+
+    uint32_t narr = ser_readvarint(D);
+    uint32_t nhash = ser_readvarint(D);
+
+    // every array element takes at least one byte and every pair at least two, which bounds the preallocation
+    size_t remaining = D->size - D->pos;
+    if (narr > remaining || nhash > remaining / 2 || narr + nhash * 2 > remaining)
+        ser_malformed(D);
+
+    lua_createtable(L, int(narr), int(nhash));
+
+    lua_pushvalue(L, -1);
+    lua_rawseti(L, SER_OBJECTS, ++D->nobjects);
+
+    int table = lua_gettop(L);
+
+    for (uint32_t i = 1; i <= narr; ++i)
+    {
+        ser_decode(D);
+        lua_rawseti(L, table, int(i));
+    }
+
+    for (uint32_t i = 0; i < nhash; ++i)
+    {
+        ser_decode(D);
+
+        if (lua_isnil(L, -1))
+            ser_malformed(D);
+
+        ser_decode(D);
+        lua_rawset(L, table);
+    }
+}
+
+static void ser_decode(SerDecoder* D)
+{
+    lua_State* L = D->L;
+
+    uint8_t tag = ser_readbyte(D);
+
+    switch (tag)
+    {
+    case SER_NIL:
+        lua_pushnil(L);
+        break;
+
+    case SER_FALSE:
+    case SER_TRUE:
+        lua_pushboolean(L, tag == SER_TRUE);
+        break;
+
+    case SER_INT:
+    {
+        uint32_t zz = ser_readvarint(D);
+        lua_pushinteger(L, int32_t((zz >> 1) ^ (0u - (zz & 1))));
+        break;
+    }
+
+    case SER_NUMBER:
+    {
+        uint64_t bits = ser_readu64(D, 8);
+
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        lua_pushnumber(L, value);
+        break;
+    }
+
+    case SER_STRING:
+    {
+        uint32_t len = ser_readvarint(D);
+        const char* str = ser_readbytes(D, len);
+
+        lua_pushlstring(L, str, len);
+        lua_pushvalue(L, -1);
+        lua_rawseti(L, SER_STRINGS, ++D->nstrings);
+        break;
+    }
+
+    case SER_STRINGREF:
+    {
+        uint32_t index = ser_readvarint(D);
+
+        if (index == 0 || index > uint32_t(D->nstrings))
+            ser_malformed(D);
+
+        lua_rawgeti(L, SER_STRINGS, int(index));
+        break;
+    }
+
+    case SER_VECTOR:
+    case SER_VECTOR4:
+    {
+        float x = ser_readfloat(D);
+        float y = ser_readfloat(D);
+        float z = ser_readfloat(D);
+        float w = tag == SER_VECTOR4 ? ser_readfloat(D) : 0.0f;
+
+#if LUA_VECTOR_SIZE == 4
+        lua_pushvector(L, x, y, z, w);
+#else
+        (void)w;
+        lua_pushvector(L, x, y, z);
+#endif
+        break;
+    }
+
+    case SER_BUFFER:
+    {
+        uint32_t len = ser_readvarint(D);
+        const char* data = ser_readbytes(D, len);
+
+        void* buf = lua_newbuffer(L, len);
+        memcpy(buf, data, len);
+
+        lua_pushvalue(L, -1);
+        lua_rawseti(L, SER_OBJECTS, ++D->nobjects);
+        break;
+    }
+
+    case SER_TABLE:
+        ser_enter(D);
+        ser_decodetable(D);
+        D->depth--;
+        break;
+
+    case SER_REF:
+    {
+        uint32_t index = ser_readvarint(D);
+
+        if (index == 0 || index > uint32_t(D->nobjects))
+            ser_malformed(D);
+
+        lua_rawgeti(L, SER_OBJECTS, int(index));
+        break;
+    }
+
+    case SER_CUSTOM:
+    {
+        ser_enter(D);
+        ser_decode(D);
+        D->depth--;
+
+        if (D->hook)
+        {
+            lua_pushvalue(L, 2);
+            lua_insert(L, -2);
+            lua_call(L, 1, 1);
+        }
+
+        lua_pushvalue(L, -1);
+        lua_rawseti(L, SER_OBJECTS, ++D->nobjects);
+        break;
+    }
+
+    default:
+        D->pos--;
+        ser_malformed(D);
+    }
+}
+
+static int serialize_encode(lua_State* L)
+{
+    luaL_checkany(L, 1);
+
+    bool hook = !lua_isnoneornil(L, 2);
+    if (hook)
+        luaL_checktype(L, 2, LUA_TFUNCTION);
+
+    lua_settop(L, 2);
+
+    SerEncoder E = {L};
+    E.hook = hook;
+
+    // scratch storage starts reasonably large to avoid regrowing on small values
+    E.capacity = LUA_BUFFERSIZE;
+    E.data = (char*)lua_newbuffer(L, E.capacity);
+
+    lua_createtable(L, 0, 0); // SER_STRINGS
+    lua_createtable(L, 0, 0); // SER_OBJECTS
+
+    ser_writebyte(&E, SER_VERSION);
+    ser_encode(&E, 1, true);
+
+    void* result = lua_newbuffer(L, E.size);
+    memcpy(result, E.data, E.size);
+    return 1;
+}
+
+static int serialize_decode(lua_State* L)
+{
+    size_t len = 0;
+    void* data = luaL_checkbuffer(L, 1, &len);
+
+    bool hook = !lua_isnoneornil(L, 2);
+    if (hook)
+        luaL_checktype(L, 2, LUA_TFUNCTION);
+
+    lua_settop(L, 2);
+
+    SerDecoder D = {L};
+    D.data = (const char*)data;
+    D.size = len;
+    D.hook = hook;
+
+    if (ser_readbyte(&D) != SER_VERSION)
+        luaL_error(L, "unsupported serialized data version");
+
+    lua_pushnil(L);           // SER_SCRATCH, unused by the decoder
+    lua_createtable(L, 0, 0); // SER_STRINGS
+    lua_createtable(L, 0, 0); // SER_OBJECTS
+
+    ser_decode(&D);
+
+    if (D.pos != D.size)
+        ser_malformed(&D);
+
+    return 1;
+}
+
+static const luaL_Reg serializelib[] = {
+    {"encode", serialize_encode},
+    {"decode", serialize_decode},
+    {NULL, NULL},
+};
+
+int luaopen_serialize(lua_State* L)
+{
+    luaL_register(L, LUA_SERLIBNAME, serializelib);
+
+    return 1;
+}
@@ -85,6 +85,8 @@ static void preinit_state(lua_State* L, global_State* g)
 static void close_state(lua_State* L)
 {
     global_State* g = L->global;
+    if (g->ecb.preclose)
+        g->ecb.preclose(L);
     luaF_close(L, L->stack); // close all upvalues for this thread
     luaC_freeall(L);         // collect all objects
     LUAU_ASSERT(g->strt.nuse == 0);
@@ -214,8 +216,11 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
         g->udatagc[i] = NULL;
         g->udatamt[i] = NULL;
     }
+    g->udatacacheepoch = 1;
     for (i = 0; i < LUA_LUTAG_LIMIT; i++)
         g->lightuserdataname[i] = NULL;
+    for (i = 0; i < 256; i++)
+        g->charstr[i] = NULL;
     for (i = 0; i < LUA_MEMORY_CATEGORIES; i++)
         g->memcatbytes[i] = 0;
 
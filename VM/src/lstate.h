@@ -152,11 +152,13 @@ struct lua_ExecutionCallbacks
 {
     void* context;
     void (*close)(lua_State* L);                 // called when global VM state is closed
+    void (*preclose)(lua_State* L);              // called when global VM state is about to be closed, before its objects are freed
     void (*destroy)(lua_State* L, Proto* proto); // called when function is destroyed
     int (*enter)(lua_State* L, Proto* proto);    // called when function is about to start/resume (when execdata is present), return 0 to exit VM
     void (*disable)(lua_State* L, Proto* proto); // called when function has to be switched from native to bytecode in the debugger
     size_t (*getmemorysize)(lua_State* L, Proto* proto); // called to request the size of memory associated with native part of the Proto
     uint8_t (*gettypemapping)(lua_State* L, const char* str, size_t len); // called to get the userdata type index
+    void (*tierup)(lua_State* L, Proto* proto); // called when a function marked for tier-up exhausts its call or loop budget (see Proto::tiercalls)
 };
 
 /*
@@ -201,6 +203,7 @@ typedef struct global_State
     struct LuaTable* mt[LUA_T_COUNT];                   // metatables for basic types
     TString* ttname[LUA_T_COUNT];       // names for basic types
     TString* tmname[TM_N];             // array with tag-method names
+    TString* charstr[256];             // single-character strings, pinned on first use so that they can be reused without hashing
 
     TValue pseudotemp; // storage for temporary values used in pseudo2addr
 
@@ -218,6 +221,7 @@ typedef struct global_State
 
     void (*udatagc[LUA_UTAG_LIMIT])(lua_State*, void*); // for each userdata tag, a gc callback to be called immediately before freeing memory
     LuaTable* udatamt[LUA_UTAG_LIMIT]; // metatables for tagged userdata
+    unsigned int udatacacheepoch; // invalidates all userdata inline cache entries when changed; see lfunc.h
 
     TString* lightuserdataname[LUA_LUTAG_LIMIT]; // names for tagged lightuserdata
 
@@ -0,0 +1,217 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lualib.h"
+
+#include "lapi.h"
+#include "lgc.h"
+#include "lnumutils.h"
+#include "lstate.h"
+#include "lstring.h"
+#include "ludata.h"
+
+#include <string.h>
+
+LUAU_FASTFLAGVARIABLE(LuauStrbufLibrary)
+
+// string builders are userdata objects tagged with UTAG_STRBUF that own a separately allocated, growable character storage
+// the storage is only turned into a string (or buffer) on request, so appending fragments never creates intermediate strings
+// strbuf.append with a single fragment is additionally implemented as a fastcall builtin (see luauF_strbufappend)
+
+static Udata* strbuf_check(lua_State* L, int idx)
+{
+    const TValue* o = luaA_toobject(L, idx);
+
+    if (!o || !ttisuserdata(o) || uvalue(o)->tag != UTAG_STRBUF)
+        luaL_typeerrorL(L, idx, "strbuf");
+
+    return uvalue(o);
+}
+
+static void strbuf_appendvalue(lua_State* L, Udata* u, int idx)
+{
+    const TValue* o = luaA_toobject(L, idx);
+
+    if (o && ttisstring(o))
+    {
+        luaU_strbufappend(L, u, svalue(o), tsvalue(o)->len);
+    }
+    else if (o && ttisnumber(o))
+    {
+        char buf[LUAI_MAXNUM2STR];
+        char* end = luai_num2str(buf, nvalue(o));
+        luaU_strbufappend(L, u, buf, end - buf);
+    }
+    else
+    {
+        luaL_typeerrorL(L, idx, "string or number");
+    }
+}
+
+static int strbuf_create(lua_State* L)
+{
+    int capacity = luaL_optinteger(L, 1, 0);
+    luaL_argcheck(L, capacity >= 0, 1, "size");
+
+    luaC_checkGC(L);
+    luaC_threadbarrier(L);
+
+    Udata* u = luaU_newudata(L, sizeof(StrBuf), UTAG_STRBUF);
+
+    StrBuf* sb = (StrBuf*)u->data;
+    sb->data = NULL;
+    sb->len = 0;
+    sb->size = 0;
+
+    TValue v;
+    setuvalue(L, &v, u);
+    luaA_pushobject(L, &v);
+
+    // metatable is shared by all builders and stored as an upvalue of create
+    lua_pushvalue(L, lua_upvalueindex(1));
+    lua_setmetatable(L, -2);
+
+    if (capacity > 0)
+        luaU_strbufreserve(L, u, capacity);
+
+    return 1;
+}
+
+static int strbuf_append(lua_State* L)
+{
+    Udata* u = strbuf_check(L, 1);
+    int n = lua_gettop(L);
+
+    for (int i = 2; i <= n; i++)
+        strbuf_appendvalue(L, u, i);
+
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int strbuf_appendf(lua_State* L)
+{
+    Udata* u = strbuf_check(L, 1);
+    luaL_checkstring(L, 2);
+    int n = lua_gettop(L);
+
+    lua_rawgetfield(L, LUA_REGISTRYINDEX, "_LOADED");
+    if (lua_istable(L, -1))
+        lua_rawgetfield(L, -1, LUA_STRLIBNAME);
+    if (lua_istable(L, -1))
+        lua_rawgetfield(L, -1, "format");
+    if (!lua_isfunction(L, -1))
+        luaL_error(L, "appendf requires the string library");
+
+    for (int i = 2; i <= n; i++)
+        lua_pushvalue(L, i);
+
+    lua_call(L, n - 1, 1);
+
+    strbuf_appendvalue(L, u, -1);
+
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int strbuf_reserve(lua_State* L)
+{
+    Udata* u = strbuf_check(L, 1);
+    int extra = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, extra >= 0, 2, "size");
+
+    luaU_strbufreserve(L, u, extra);
+
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int strbuf_reset(lua_State* L)
+{
+    Udata* u = strbuf_check(L, 1);
+    bool release = luaL_optboolean(L, 2, false);
+
+    luaU_strbufreset(L, u, release);
+
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int strbuf_len(lua_State* L)
+{
+    Udata* u = strbuf_check(L, 1);
+    StrBuf* sb = (StrBuf*)u->data;
+
+    lua_pushinteger(L, sb->len);
+    return 1;
+}
+
+static int strbuf_tostring(lua_State* L)
+{
+    Udata* u = strbuf_check(L, 1);
+    StrBuf* sb = (StrBuf*)u->data;
+
+    luaC_checkGC(L);
+    luaC_threadbarrier(L);
+
+    // the string is filled in place and interned once, without going through an intermediate copy
+    TString* ts = luaS_bufstart(L, sb->len);
+    if (sb->len)
+        memcpy(ts->data, sb->data, sb->len);
+    ts = luaS_buffinish(L, ts);
+
+    TValue v;
+    setsvalue(L, &v, ts);
+    luaA_pushobject(L, &v);
+    return 1;
+}
+
+static int strbuf_tobuffer(lua_State* L)
+{
+    Udata* u = strbuf_check(L, 1);
+    StrBuf* sb = (StrBuf*)u->data;
+
+    void* data = lua_newbuffer(L, sb->len);
+    if (sb->len)
+        memcpy(data, sb->data, sb->len);
+    return 1;
+}
+
+static const luaL_Reg strbuflib[] = {
+    {"append", strbuf_append},
+    {"appendf", strbuf_appendf},
+    {"reserve", strbuf_reserve},
+    {"reset", strbuf_reset},
+    {"len", strbuf_len},
+    {"tostring", strbuf_tostring},
+    {"tobuffer", strbuf_tobuffer},
+    {NULL, NULL},
+};
+
+static void createmetatable(lua_State* L)
+{
+    lua_createtable(L, 0, 4);
+
+    lua_pushvalue(L, -2);
+    lua_setfield(L, -2, "__index");
+
+    lua_pushcfunction(L, strbuf_len, "__len");
+    lua_setfield(L, -2, "__len");
+
+    lua_pushcfunction(L, strbuf_tostring, "__tostring");
+    lua_setfield(L, -2, "__tostring");
+
+    lua_pushstring(L, "strbuf");
+    lua_setfield(L, -2, "__type");
+
+    lua_setreadonly(L, -1, true);
+}
+
+int luaopen_strbuf(lua_State* L)
+{
+    luaL_register(L, LUA_STRBUFLIBNAME, strbuflib);
+
+    createmetatable(L);
+    lua_pushcclosure(L, strbuf_create, "create", 1);
+    lua_setfield(L, -2, "create");
+
+    return 1;
+}
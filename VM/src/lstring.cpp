@@ -75,6 +75,7 @@ static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
 
     TString* ts = luaM_newgco(L, TString, sizestring(l), L->activememcat);
     luaC_init(L, ts, LUA_TSTRING);
+    ts->utf8 = UTF8_UNKNOWN;
     ts->atom = ATOM_UNDEF;
     ts->hash = h;
     ts->len = unsigned(l);
@@ -101,6 +102,7 @@ TString* luaS_bufstart(lua_State* L, size_t size)
 
     TString* ts = luaM_newgco(L, TString, sizestring(size), L->activememcat);
     luaC_init(L, ts, LUA_TSTRING);
+    ts->utf8 = UTF8_UNKNOWN;
     ts->atom = ATOM_UNDEF;
     ts->hash = 0; // computed in luaS_buffinish
     ts->len = unsigned(size);
@@ -133,6 +135,7 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
 
     ts->hash = h;
     ts->data[ts->len] = '\0'; // ending 0
+    ts->utf8 = UTF8_UNKNOWN;
     ts->atom = ATOM_UNDEF;
     ts->next = tb->hash[bucket]; // chain new entry
     tb->hash[bucket] = ts;
@@ -146,6 +149,9 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
 
 TString* luaS_newlstr(lua_State* L, const char* str, size_t l)
 {
+    if (l == 1)
+        return luaS_newchar(L, uint8_t(str[0]));
+
     unsigned int h = luaS_hash(str, l);
     for (TString* el = L->global->strt.hash[lmod(h, L->global->strt.size)]; el != NULL; el = el->next)
     {
@@ -160,6 +166,40 @@ TString* luaS_newlstr(lua_State* L, const char* str, size_t l)
     return newlstr(L, str, l, h); // not found
 }
 
+TString* luaS_newchar(lua_State* L, uint8_t ch)
+{
+    global_State* g = L->global;
+
+    if (TString* ts = g->charstr[ch])
+        return ts;
+
+    char str = char(ch);
+    unsigned int h = luaS_hash(&str, 1);
+
+    TString* ts = NULL;
+
+    for (TString* el = g->strt.hash[lmod(h, g->strt.size)]; el != NULL; el = el->next)
+    {
+        if (el->len == 1 && getstr(el)[0] == str)
+        {
+            // string may be dead
+            if (isdead(g, obj2gco(el)))
+                changewhite(obj2gco(el));
+
+            ts = el;
+            break;
+        }
+    }
+
+    if (!ts)
+        ts = newlstr(L, &str, 1, h);
+
+    luaS_fix(ts); // cached strings are never collected
+
+    g->charstr[ch] = ts;
+    return ts;
+}
+
 static bool unlinkstr(lua_State* L, TString* ts)
 {
     global_State* g = L->global;
@@ -11,6 +11,12 @@
 // string atoms are not defined by default; the storage is 16-bit integer
 #define ATOM_UNDEF -32768
 
+// UTF-8 classification of string contents; strings start out unclassified
+#define UTF8_UNKNOWN 0
+#define UTF8_ASCII 1
+#define UTF8_VALID 2
+#define UTF8_INVALID 3
+
 #define sizestring(len) (offsetof(TString, data) + len + 1)
 
 #define luaS_new(L, s) (luaS_newlstr(L, s, strlen(s)))
@@ -23,6 +29,7 @@ LUAI_FUNC unsigned int luaS_hash(const char* str, size_t len);
 LUAI_FUNC void luaS_resize(lua_State* L, int newsize);
 
 LUAI_FUNC TString* luaS_newlstr(lua_State* L, const char* str, size_t l);
+LUAI_FUNC TString* luaS_newchar(lua_State* L, uint8_t ch);
 LUAI_FUNC void luaS_free(lua_State* L, TString* ts, struct lua_Page* page);
 
 LUAI_FUNC TString* luaS_bufstart(lua_State* L, size_t size);
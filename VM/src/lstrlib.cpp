@@ -3,6 +3,7 @@
 #include "lualib.h"
 
 #include "lstring.h"
+#include "lnumutils.h"
 
 #include <ctype.h>
 #include <string.h>
@@ -963,6 +964,22 @@ static void addInt64Format(char form[MAX_FORMAT], char formatIndicator, size_t f
     form[formatItemSize + 3] = 0;
 }
 
+// returns precision of a format that only has the precision specified ("%g" or "%.Ng"), or -1 for other formats
+static int gprecision(const char* form)
+{
+    LUAU_ASSERT(form[0] == '%');
+
+    if (form[1] != '.')
+        return isdigit(uchar(form[1])) || strchr(FLAGS, form[1]) ? -1 : 6;
+
+    int precision = 0;
+
+    for (const char* p = form + 2; isdigit(uchar(*p)); p++)
+        precision = precision * 10 + (*p - '0');
+
+    return precision;
+}
+
 static int str_format(lua_State* L)
 {
     int top = lua_gettop(L);
@@ -1027,7 +1044,22 @@ static int str_format(lua_State* L)
             case 'g':
             case 'G':
             {
-                snprintf(buff, sizeof(buff), form, (double)luaL_checknumber(L, arg));
+                double v = luaL_checknumber(L, arg);
+
+                // %g and %.Ng without flags or width are printed without going through the C library when possible
+                if (formatIndicator == 'g')
+                {
+                    int precision = gprecision(form);
+                    char* end = precision >= 0 ? luai_num2gstr(buff, v, precision) : NULL;
+
+                    if (end)
+                    {
+                        luaL_addlstring(&b, buff, end - buff);
+                        continue; // skip the 'luaL_addlstring' at the end
+                    }
+                }
+
+                snprintf(buff, sizeof(buff), form, v);
                 break;
             }
             case 'q':
@@ -857,3 +857,17 @@ void luaH_clear(LuaTable* tt)
     // back to empty -> no tag methods present
     tt->tmcache = cast_byte(~0);
 }
+
+void luaH_checkwrite(lua_State* L, LuaTable* t)
+{
+    if (luaH_isreadonly(t))
+        luaG_readonlyerror(L);
+
+    LUAU_ASSERT(t->readonly == LUAH_WATCHED);
+
+    // values that native code cached from this table might change after the write; the table is watched again when the cache is refilled
+    if (++L->global->udatacacheepoch == 0)
+        L->global->udatacacheepoch = 1;
+
+    t->readonly = 0;
+}
@@ -14,6 +14,13 @@
 // reset cache of absent metamethods, cache is updated in luaT_gettm
 #define invalidateTMcache(t) t->tmcache = 0
 
+// tables that the userdata inline cache holds values from are watched; like readonly tables, their writes take the slow path (luaH_checkwrite)
+#define LUAH_READONLY 1
+#define LUAH_WATCHED 2
+
+#define luaH_isreadonly(t) ((t)->readonly == LUAH_READONLY)
+#define luaH_watch(t) ((t)->readonly = (t)->readonly ? (t)->readonly : LUAH_WATCHED)
+
 LUAI_FUNC const TValue* luaH_getnum(LuaTable* t, int key);
 LUAI_FUNC TValue* luaH_setnum(lua_State* L, LuaTable* t, int key);
 LUAI_FUNC const TValue* luaH_getstr(LuaTable* t, TString* key);
@@ -29,6 +36,7 @@ LUAI_FUNC int luaH_next(lua_State* L, LuaTable* t, StkId key);
 LUAI_FUNC int luaH_getn(LuaTable* t);
 LUAI_FUNC LuaTable* luaH_clone(lua_State* L, LuaTable* tt);
 LUAI_FUNC void luaH_clear(LuaTable* tt);
+LUAI_FUNC void luaH_checkwrite(lua_State* L, LuaTable* t);
 
 #define luaH_setslot(L, t, slot, key) (invalidateTMcache(t), (slot == luaO_nilobject ? luaH_newkey(L, t, key) : cast_to(TValue*, slot)))
 
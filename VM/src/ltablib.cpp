@@ -91,7 +91,7 @@ static void moveelements(lua_State* L, int srct, int dstt, int f, int e, int t)
     LuaTable* dst = hvalue(L->base + (dstt - 1));
 
     if (dst->readonly)
-        luaG_readonlyerror(L);
+        luaH_checkwrite(L, dst);
 
     int n = e - f + 1; // number of elements to move
 
@@ -214,7 +214,7 @@ static int tmove(lua_State* L)
         LuaTable* dst = hvalue(L->base + (tt - 1));
 
         if (dst->readonly) // also checked in moveelements, but this blocks resizes of r/o tables
-            luaG_readonlyerror(L);
+            luaH_checkwrite(L, dst);
 
         if (t > 0 && (t - 1) <= dst->sizearray && (t - 1 + n) > dst->sizearray)
         { // grow the destination table array
@@ -478,7 +478,7 @@ static int tsort(lua_State* L)
     LuaTable* t = hvalue(L->base);
     int n = luaH_getn(t);
     if (t->readonly)
-        luaG_readonlyerror(L);
+        luaH_checkwrite(L, t);
 
     SortPredicate pred = luaV_lessthan;
     if (!lua_isnoneornil(L, 2)) // is there a 2nd argument?
@@ -554,7 +554,7 @@ static int tclear(lua_State* L)
 
     LuaTable* tt = hvalue(L->base);
     if (tt->readonly)
-        luaG_readonlyerror(L);
+        luaH_checkwrite(L, tt);
 
     luaH_clear(tt);
     return 0;
@@ -4,6 +4,7 @@
 
 #include "lgc.h"
 #include "lmem.h"
+#include "lstring.h"
 
 #include <string.h>
 
@@ -37,7 +38,58 @@ void luaU_freeudata(lua_State* L, Udata* u, lua_Page* page)
         if (dtor)
             dtor(u->data);
     }
-
+    else if (u->tag == UTAG_STRBUF)
+    {
+        StrBuf* sb = (StrBuf*)u->data;
+        luaM_freearray(L, sb->data, sb->size, char, u->memcat);
+    }
 
     luaM_freegco(L, u, sizeudata(u->len), u->memcat, page);
 }
+
+void luaU_strbufreserve(lua_State* L, Udata* u, size_t extra)
+{
+    LUAU_ASSERT(u->tag == UTAG_STRBUF);
+    StrBuf* sb = (StrBuf*)u->data;
+
+    if (extra <= sb->size - sb->len)
+        return;
+
+    if (extra > MAXSSIZE - sb->len)
+        luaM_toobig(L);
+
+    size_t required = sb->len + extra;
+    size_t newsize = sb->size < 32 ? 32 : size_t(sb->size) * 2;
+
+    if (newsize < required)
+        newsize = required;
+    if (newsize > MAXSSIZE)
+        newsize = MAXSSIZE;
+
+    luaM_reallocarray(L, sb->data, sb->size, newsize, char, u->memcat);
+    sb->size = unsigned(newsize);
+}
+
+void luaU_strbufappend(lua_State* L, Udata* u, const char* s, size_t len)
+{
+    luaU_strbufreserve(L, u, len);
+
+    StrBuf* sb = (StrBuf*)u->data;
+    memcpy(sb->data + sb->len, s, len);
+    sb->len += unsigned(len);
+}
+
+void luaU_strbufreset(lua_State* L, Udata* u, bool release)
+{
+    LUAU_ASSERT(u->tag == UTAG_STRBUF);
+    StrBuf* sb = (StrBuf*)u->data;
+
+    if (release)
+    {
+        luaM_freearray(L, sb->data, sb->size, char, u->memcat);
+        sb->data = NULL;
+        sb->size = 0;
+    }
+
+    sb->len = 0;
+}
@@ -10,8 +10,23 @@
 // special tag value is used for newproxy-created user data (all other user data objects are host-exposed)
 #define UTAG_PROXY (LUA_UTAG_LIMIT + 1)
 
+// special tag value is used for string builders created by the strbuf library; user data payload is StrBuf
+#define UTAG_STRBUF (LUA_UTAG_LIMIT + 2)
+
 // userdata larger than 16 bytes will be extended to guarantee 16 byte alignment of subsequent blocks
 #define sizeudata(len) (offsetof(Udata, data) + (len > 16 ? ((len + 15) & ~15) : len))
 
+// string builder state; character storage is allocated separately so that it can grow in place
+struct StrBuf
+{
+    char* data;
+    unsigned int len;
+    unsigned int size;
+};
+
 LUAI_FUNC Udata* luaU_newudata(lua_State* L, size_t s, int tag);
 LUAI_FUNC void luaU_freeudata(lua_State* L, Udata* u, struct lua_Page* page);
+
+LUAI_FUNC void luaU_strbufreserve(lua_State* L, Udata* u, size_t extra);
+LUAI_FUNC void luaU_strbufappend(lua_State* L, Udata* u, const char* s, size_t len);
+LUAI_FUNC void luaU_strbufreset(lua_State* L, Udata* u, bool release);
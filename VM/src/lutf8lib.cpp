@@ -2,7 +2,41 @@
 // This code is based on Lua 5.x implementation licensed under MIT License; see lua_LICENSE.txt for details
 #include "lualib.h"
 
+#include "lapi.h"
 #include "lcommon.h"
+#include "lstring.h"
+
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#ifndef _MSC_VER
+#include <cpuid.h> // on MSVC this comes from intrin.h
+#endif
+
+#define LUAU_UTF8_X64
+
+// validation uses SSE4.1 and AVX2 when available at runtime; the functions are compiled for the respective targets individually
+#if defined(__GNUC__) && defined(__has_attribute)
+#if __has_attribute(target)
+#define LUAU_UTF8_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define LUAU_UTF8_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#ifndef LUAU_UTF8_TARGET_SSE41
+#define LUAU_UTF8_TARGET_SSE41
+#define LUAU_UTF8_TARGET_AVX2
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LUAU_UTF8_NEON
+#endif
 
 #define MAXUNICODE 0x10FFFF
 
@@ -54,6 +88,446 @@ static const char* utf8_decode(const char* o, int* val)
     return (const char*)s + 1; // +1 to include first byte
 }
 
+// Whole-string validation is performed 16 or 32 bytes at a time using the lookup algorithm from "Validating UTF-8 In Less Than One
+// Instruction Per Byte" (Keiser, Lemire): three 16-entry tables indexed by nibbles of the current and the previous byte classify each byte
+// pair, and the AND of the three lookups is non-zero only for invalid pairs. Sequences that need the 3rd and 4th byte are checked separately.
+// The result is cached on the string (TString::utf8), so repeated calls on the same string only pay for it once.
+#define U8E_TOO_SHORT (1 << 0)       // 11______ 0_______ or 11______ 11______
+#define U8E_TOO_LONG (1 << 1)        // 0_______ 10______
+#define U8E_OVERLONG_3 (1 << 2)      // 11100000 100_____
+#define U8E_TOO_LARGE (1 << 3)       // 11110100 1001____ and above
+#define U8E_SURROGATE (1 << 4)       // 11101101 101_____
+#define U8E_OVERLONG_2 (1 << 5)      // 1100000_ 10______
+#define U8E_TOO_LARGE_1000 (1 << 6)  // 11110101 1000____ and above
+#define U8E_OVERLONG_4 (1 << 6)      // 11110000 1000____
+#define U8E_TWO_CONTS (1 << 7)       // 10______ 10______
+#define U8E_CARRY (U8E_TOO_SHORT | U8E_TOO_LONG | U8E_TWO_CONTS)
+
+// indexed by the high nibble of the previous byte
+static const uint8_t kUtf8Byte1High[16] = {
+    U8E_TOO_LONG,
+    U8E_TOO_LONG,
+    U8E_TOO_LONG,
+    U8E_TOO_LONG,
+    U8E_TOO_LONG,
+    U8E_TOO_LONG,
+    U8E_TOO_LONG,
+    U8E_TOO_LONG,
+    U8E_TWO_CONTS,
+    U8E_TWO_CONTS,
+    U8E_TWO_CONTS,
+    U8E_TWO_CONTS,
+    U8E_TOO_SHORT | U8E_OVERLONG_2,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT | U8E_OVERLONG_3 | U8E_SURROGATE,
+    U8E_TOO_SHORT | U8E_TOO_LARGE | U8E_TOO_LARGE_1000 | U8E_OVERLONG_4,
+};
+
+// indexed by the low nibble of the previous byte
+static const uint8_t kUtf8Byte1Low[16] = {
+    U8E_CARRY | U8E_OVERLONG_3 | U8E_OVERLONG_2 | U8E_OVERLONG_4,
+    U8E_CARRY | U8E_OVERLONG_2,
+    U8E_CARRY,
+    U8E_CARRY,
+    U8E_CARRY | U8E_TOO_LARGE,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000 | U8E_SURROGATE,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+    U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+};
+
+// indexed by the high nibble of the current byte
+static const uint8_t kUtf8Byte2High[16] = {
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_OVERLONG_3 | U8E_TOO_LARGE_1000 | U8E_OVERLONG_4,
+    U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_OVERLONG_3 | U8E_TOO_LARGE,
+    U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_SURROGATE | U8E_TOO_LARGE,
+    U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_SURROGATE | U8E_TOO_LARGE,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+    U8E_TOO_SHORT,
+};
+
+// a block that ends with a byte above these values has a sequence continuing into the next block
+static const uint8_t kUtf8MaxValue[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+static int utf8_classify_scalar(const unsigned char* s, size_t len)
+{
+    const unsigned char* end = s + len;
+    int result = UTF8_ASCII;
+
+    while (s < end)
+    {
+        if (end - s >= 8)
+        {
+            uint64_t w;
+            memcpy(&w, s, 8);
+
+            if ((w & 0x8080808080808080ull) == 0)
+            {
+                s += 8;
+                continue;
+            }
+        }
+
+        if (*s < 0x80)
+        {
+            s++;
+            continue;
+        }
+
+        // the string is zero-terminated, so a truncated sequence at the end is rejected by the decoder
+        const char* next = utf8_decode((const char*)s, NULL);
+        if (!next)
+            return UTF8_INVALID;
+
+        s = (const unsigned char*)next;
+        result = UTF8_VALID;
+    }
+
+    return result;
+}
+
+#if defined(LUAU_UTF8_X64)
+LUAU_UTF8_TARGET_SSE41 inline __m128i utf8_check_sse41(__m128i v, __m128i prev)
+{
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+
+    __m128i prev1 = _mm_alignr_epi8(v, prev, 15);
+    __m128i prev2 = _mm_alignr_epi8(v, prev, 14);
+    __m128i prev3 = _mm_alignr_epi8(v, prev, 13);
+
+    __m128i byte1high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)kUtf8Byte1High), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    __m128i byte1low = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)kUtf8Byte1Low), _mm_and_si128(prev1, nibble));
+    __m128i byte2high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)kUtf8Byte2High), _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+    __m128i special = _mm_and_si128(_mm_and_si128(byte1high, byte1low), byte2high);
+
+    // 3rd and 4th bytes of a sequence must be continuations, which the pair lookup reports as TWO_CONTS
+    __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xE0 - 0x80)));
+    __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80)));
+    __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(char(0x80)));
+
+    return _mm_xor_si128(must23, special);
+}
+
+LUAU_UTF8_TARGET_SSE41 static int utf8_classify_sse41(const unsigned char* s, size_t len)
+{
+    const __m128i maxvalue = _mm_loadu_si128((const __m128i*)(kUtf8MaxValue + 16));
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prev = _mm_setzero_si128();
+    __m128i incomplete = _mm_setzero_si128();
+    __m128i any = _mm_setzero_si128();
+
+    // the last partial block is padded with zeros, which also catches sequences truncated by the end of the string
+    unsigned char tail[16] = {};
+
+    for (size_t i = 0; i <= len; i += 16)
+    {
+        __m128i v;
+
+        if (len - i >= 16)
+        {
+            v = _mm_loadu_si128((const __m128i*)(s + i));
+        }
+        else
+        {
+            memcpy(tail, s + i, len - i);
+            v = _mm_loadu_si128((const __m128i*)tail);
+        }
+
+        if (_mm_movemask_epi8(v) == 0)
+        {
+            error = _mm_or_si128(error, incomplete);
+            incomplete = _mm_setzero_si128();
+        }
+        else
+        {
+            error = _mm_or_si128(error, utf8_check_sse41(v, prev));
+            incomplete = _mm_subs_epu8(v, maxvalue);
+            any = _mm_or_si128(any, v);
+        }
+
+        prev = v;
+    }
+
+    if (!_mm_testz_si128(error, error))
+        return UTF8_INVALID;
+
+    return _mm_movemask_epi8(any) ? UTF8_VALID : UTF8_ASCII;
+}
+
+LUAU_UTF8_TARGET_AVX2 inline __m256i utf8_check_avx2(__m256i v, __m256i prev)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+
+    // lanes of v preceded by the upper lane of prev, so that alignr can shift bytes across the 128-bit lane boundary
+    __m256i shifted = _mm256_permute2x128_si256(prev, v, 0x21);
+
+    __m256i prev1 = _mm256_alignr_epi8(v, shifted, 15);
+    __m256i prev2 = _mm256_alignr_epi8(v, shifted, 14);
+    __m256i prev3 = _mm256_alignr_epi8(v, shifted, 13);
+
+    __m256i table1high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)kUtf8Byte1High));
+    __m256i table1low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)kUtf8Byte1Low));
+    __m256i table2high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)kUtf8Byte2High));
+
+    __m256i byte1high = _mm256_shuffle_epi8(table1high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i byte1low = _mm256_shuffle_epi8(table1low, _mm256_and_si256(prev1, nibble));
+    __m256i byte2high = _mm256_shuffle_epi8(table2high, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte1high, byte1low), byte2high);
+
+    __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+
+    return _mm256_xor_si256(must23, special);
+}
+
+LUAU_UTF8_TARGET_AVX2 static int utf8_classify_avx2(const unsigned char* s, size_t len)
+{
+    const __m256i maxvalue = _mm256_loadu_si256((const __m256i*)kUtf8MaxValue);
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    __m256i any = _mm256_setzero_si256();
+
+    unsigned char tail[32] = {};
+
+    for (size_t i = 0; i <= len; i += 32)
+    {
+        __m256i v;
+
+        if (len - i >= 32)
+        {
+            v = _mm256_loadu_si256((const __m256i*)(s + i));
+        }
+        else
+        {
+            memcpy(tail, s + i, len - i);
+            v = _mm256_loadu_si256((const __m256i*)tail);
+        }
+
+        if (_mm256_movemask_epi8(v) == 0)
+        {
+            error = _mm256_or_si256(error, incomplete);
+            incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            error = _mm256_or_si256(error, utf8_check_avx2(v, prev));
+            incomplete = _mm256_subs_epu8(v, maxvalue);
+            any = _mm256_or_si256(any, v);
+        }
+
+        prev = v;
+    }
+
+    int result = UTF8_ASCII;
+
+    if (!_mm256_testz_si256(error, error))
+        result = UTF8_INVALID;
+    else if (_mm256_movemask_epi8(any))
+        result = UTF8_VALID;
+
+    // avoid AVX-SSE transition penalties in the caller
+    _mm256_zeroupper();
+    return result;
+}
+
+static uint64_t utf8_xgetbv()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (uint64_t(hi) << 32) | lo;
+#endif
+}
+
+static int (*utf8_selectclassify())(const unsigned char* s, size_t len)
+{
+    int cpuinfo[4] = {};
+#ifdef _MSC_VER
+    __cpuid(cpuinfo, 0);
+#else
+    __cpuid(0, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+#endif
+    int maxleaf = cpuinfo[0];
+
+#ifdef _MSC_VER
+    __cpuid(cpuinfo, 1);
+#else
+    __cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+#endif
+
+    // https://en.wikipedia.org/wiki/CPUID#EAX=1:_Processor_Info_and_Feature_Bits
+    bool sse41 = (cpuinfo[2] & (1 << 19)) != 0;
+    bool osxsave = (cpuinfo[2] & (1 << 27)) != 0;
+    bool avx = (cpuinfo[2] & (1 << 28)) != 0;
+
+    // AVX2 also requires the OS to preserve the upper halves of YMM registers
+    if (maxleaf >= 7 && osxsave && avx && (utf8_xgetbv() & 6) == 6)
+    {
+#ifdef _MSC_VER
+        __cpuidex(cpuinfo, 7, 0);
+#else
+        __cpuid_count(7, 0, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+#endif
+
+        if (cpuinfo[1] & (1 << 5))
+            return utf8_classify_avx2;
+    }
+
+    return sse41 ? utf8_classify_sse41 : utf8_classify_scalar;
+}
+
+static int (*const utf8_classify)(const unsigned char* s, size_t len) = utf8_selectclassify();
+#elif defined(LUAU_UTF8_NEON)
+inline uint8x16_t utf8_check_neon(uint8x16_t v, uint8x16_t prev)
+{
+    const uint8x16_t nibble = vdupq_n_u8(0x0f);
+
+    uint8x16_t prev1 = vextq_u8(prev, v, 15);
+    uint8x16_t prev2 = vextq_u8(prev, v, 14);
+    uint8x16_t prev3 = vextq_u8(prev, v, 13);
+
+    uint8x16_t byte1high = vqtbl1q_u8(vld1q_u8(kUtf8Byte1High), vshrq_n_u8(prev1, 4));
+    uint8x16_t byte1low = vqtbl1q_u8(vld1q_u8(kUtf8Byte1Low), vandq_u8(prev1, nibble));
+    uint8x16_t byte2high = vqtbl1q_u8(vld1q_u8(kUtf8Byte2High), vshrq_n_u8(v, 4));
+    uint8x16_t special = vandq_u8(vandq_u8(byte1high, byte1low), byte2high);
+
+    uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+    uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+    uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+    return veorq_u8(must23, special);
+}
+
+static int utf8_classify(const unsigned char* s, size_t len)
+{
+    const uint8x16_t maxvalue = vld1q_u8(kUtf8MaxValue + 16);
+
+    uint8x16_t error = vdupq_n_u8(0);
+    uint8x16_t prev = vdupq_n_u8(0);
+    uint8x16_t incomplete = vdupq_n_u8(0);
+    uint8x16_t any = vdupq_n_u8(0);
+
+    unsigned char tail[16] = {};
+
+    for (size_t i = 0; i <= len; i += 16)
+    {
+        uint8x16_t v;
+
+        if (len - i >= 16)
+        {
+            v = vld1q_u8(s + i);
+        }
+        else
+        {
+            memcpy(tail, s + i, len - i);
+            v = vld1q_u8(tail);
+        }
+
+        if (vmaxvq_u8(v) < 0x80)
+        {
+            error = vorrq_u8(error, incomplete);
+            incomplete = vdupq_n_u8(0);
+        }
+        else
+        {
+            error = vorrq_u8(error, utf8_check_neon(v, prev));
+            incomplete = vqsubq_u8(v, maxvalue);
+            any = vorrq_u8(any, v);
+        }
+
+        prev = v;
+    }
+
+    if (vmaxvq_u8(error) != 0)
+        return UTF8_INVALID;
+
+    return vmaxvq_u8(any) >= 0x80 ? UTF8_VALID : UTF8_ASCII;
+}
+#else
+#define utf8_classify utf8_classify_scalar
+#endif
+
+// counts the bytes that start a character, which is the number of characters in a valid string
+static size_t utf8_countchars(const unsigned char* s, size_t len)
+{
+    size_t count = 0;
+    size_t i = 0;
+
+#if defined(LUAU_UTF8_X64)
+    // 8-bit counters are accumulated for at most 255 blocks before being summed up
+    while (len - i >= 16)
+    {
+        size_t blocks = (len - i) / 16 < 255 ? (len - i) / 16 : 255;
+        __m128i acc = _mm_setzero_si128();
+
+        for (size_t b = 0; b < blocks; b++, i += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+            acc = _mm_sub_epi8(acc, _mm_cmpgt_epi8(v, _mm_set1_epi8(-65)));
+        }
+
+        __m128i sum = _mm_sad_epu8(acc, _mm_setzero_si128());
+        count += _mm_cvtsi128_si32(sum) + _mm_extract_epi16(sum, 4);
+    }
+#elif defined(LUAU_UTF8_NEON)
+    while (len - i >= 16)
+    {
+        size_t blocks = (len - i) / 16 < 255 ? (len - i) / 16 : 255;
+        uint8x16_t acc = vdupq_n_u8(0);
+
+        for (size_t b = 0; b < blocks; b++, i += 16)
+        {
+            int8x16_t v = vld1q_s8((const int8_t*)(s + i));
+            acc = vsubq_u8(acc, vcgtq_s8(v, vdupq_n_s8(-65)));
+        }
+
+        count += vaddlvq_u8(acc);
+    }
+#endif
+
+    for (; i < len; i++)
+        count += (signed char)s[i] > -65;
+
+    return count;
+}
+
+// returns the classification of the string at the given stack index (which must be a string), computing it if needed
+static int utf8_getclass(lua_State* L, int idx, bool compute)
+{
+    TString* ts = tsvalue(luaA_toobject(L, idx));
+
+    if (ts->utf8 == UTF8_UNKNOWN && compute)
+        ts->utf8 = uint8_t(utf8_classify((const unsigned char*)ts->data, ts->len));
+
+    return ts->utf8;
+}
+
 /*
 ** utf8len(s [, i [, j]]) --> number of characters that start in the
 ** range [i,j], or nil + current position if 's' is not well formed in
@@ -68,6 +542,35 @@ static int utflen(lua_State* L)
     int posj = u_posrelat(luaL_optinteger(L, 3, -1), len);
     luaL_argcheck(L, 1 <= posi && --posi <= (int)len, 2, "initial position out of string");
     luaL_argcheck(L, --posj < (int)len, 3, "final position out of string");
+
+    // whole-string classification is only worth computing when the range covers a large part of the string
+    int cls = utf8_getclass(L, 1, posj - posi >= (int)len / 2);
+
+    if (cls == UTF8_ASCII)
+    {
+        lua_pushinteger(L, posi <= posj ? posj - posi + 1 : 0);
+        return 1;
+    }
+    else if (cls == UTF8_VALID)
+    {
+        if (posi > posj)
+        {
+            lua_pushinteger(L, 0);
+            return 1;
+        }
+
+        // in a valid string, decoding only fails when starting in the middle of a character
+        if (iscont(s + posi))
+        {
+            lua_pushnil(L);
+            lua_pushinteger(L, posi + 1);
+            return 2;
+        }
+
+        lua_pushinteger(L, int(utf8_countchars((const unsigned char*)s + posi, posj - posi + 1)));
+        return 1;
+    }
+
     while (posi <= posj)
     {
         const char* s1 = utf8_decode(s + posi, NULL);
@@ -104,6 +607,12 @@ static int codepoint(lua_State* L)
         luaL_error(L, "string slice too long");
     n = (int)(pose - posi) + 1;
     luaL_checkstack(L, n, "string slice too long");
+    if (utf8_getclass(L, 1, false) == UTF8_ASCII)
+    {
+        for (int i = posi - 1; i < pose; i++)
+            lua_pushinteger(L, (unsigned char)s[i]);
+        return n;
+    }
     n = 0;
     se = s + pose;
     for (s += posi - 1; s < se;)
@@ -196,6 +705,17 @@ static int byteoffset(lua_State* L)
     int posi = (n >= 0) ? 1 : (int)len + 1;
     posi = u_posrelat(luaL_optinteger(L, 3, posi), len);
     luaL_argcheck(L, 1 <= posi && --posi <= (int)len, 3, "position out of range");
+    if (utf8_getclass(L, 1, false) == UTF8_ASCII)
+    {
+        // every byte is a character, so the offset can be computed directly
+        if (n == 0)
+            lua_pushinteger(L, posi + 1);
+        else if (n > 0 ? n - 1 <= (int)len - posi : n >= -posi)
+            lua_pushinteger(L, posi + n + (n < 0));
+        else
+            lua_pushnil(L);
+        return 1;
+    }
     if (n == 0)
     {
         // find beginning of current byte sequence
@@ -252,6 +772,12 @@ static int iter_aux(lua_State* L)
     }
     if (n >= (int)len)
         return 0; // no more codepoints
+    else if (utf8_getclass(L, 1, false) == UTF8_ASCII)
+    {
+        lua_pushinteger(L, n + 1);
+        lua_pushinteger(L, (unsigned char)s[n]);
+        return 2;
+    }
     else
     {
         int code;
@@ -267,6 +793,7 @@ static int iter_aux(lua_State* L)
 static int iter_codes(lua_State* L)
 {
     luaL_checkstring(L, 1);
+    utf8_getclass(L, 1, true); // the iterator uses the cached classification
     lua_pushcfunction(L, iter_aux, NULL);
     lua_pushvalue(L, 1);
     lua_pushinteger(L, 0);
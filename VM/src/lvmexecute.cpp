@@ -102,7 +102,7 @@
         VM_DISPATCH_OP(LOP_CAPTURE), VM_DISPATCH_OP(LOP_SUBRK), VM_DISPATCH_OP(LOP_DIVRK), VM_DISPATCH_OP(LOP_FASTCALL1), \
         VM_DISPATCH_OP(LOP_FASTCALL2), VM_DISPATCH_OP(LOP_FASTCALL2K), VM_DISPATCH_OP(LOP_FORGPREP), VM_DISPATCH_OP(LOP_JUMPXEQKNIL), \
         VM_DISPATCH_OP(LOP_JUMPXEQKB), VM_DISPATCH_OP(LOP_JUMPXEQKN), VM_DISPATCH_OP(LOP_JUMPXEQKS), VM_DISPATCH_OP(LOP_IDIV), \
-        VM_DISPATCH_OP(LOP_IDIVK),
+        VM_DISPATCH_OP(LOP_IDIVK), VM_DISPATCH_OP(LOP_MOVE2),
 
 #if defined(__GNUC__) || defined(__clang__)
 #define VM_USE_CGOTO 1
@@ -133,6 +133,78 @@
 // Does VM support native execution via ExecutionCallbacks? We mostly assume it does but keep the define to make it easy to quantify the cost.
 #define VM_HAS_NATIVE 1
 
+// Loop back-edges of functions marked for tier-up count down their loop budget; the function is handed to the code generator once it runs out
+#if VM_HAS_NATIVE
+#define VM_TIERUP() \
+    { \
+        Proto* tp = cl->l.p; \
+        if (LUAU_UNLIKELY(tp->tierloops > 0) && --tp->tierloops == 0) \
+        { \
+            VM_PROTECT_PC(); \
+            L->global->ecb.tierup(L, tp); \
+        } \
+    }
+#else
+#define VM_TIERUP() \
+    { \
+    }
+#endif
+
+// Functions that were compiled while running in the interpreter switch their frames to native code on a taken loop back-edge, as back-edge
+// targets always start a block in native code; see Proto::tierloops
+#if VM_HAS_NATIVE
+#define VM_OSR() \
+    { \
+        Proto* op = cl->l.p; \
+        if (LUAU_UNLIKELY(op->tierloops < 0)) \
+        { \
+            op->tierloops = 0; \
+            if (op->exectarget != 0 && !SingleStep) \
+            { \
+                L->ci->flags |= LUA_CALLINFO_NATIVE; \
+                L->ci->savedpc = pc; \
+                if (L->global->ecb.enter(L, op) == 1) \
+                    goto reentry; \
+                else \
+                    goto exit; \
+            } \
+        } \
+    }
+#else
+#define VM_OSR() \
+    { \
+    }
+#endif
+
+// Functions marked for tier-up record the operand types of instructions until they get native code; see lfunc.h
+#if VM_HAS_NATIVE
+#define VM_TYPEFEEDBACK(ipc, tb, tc) \
+    { \
+        Proto* fp = cl->l.p; \
+        if (LUAU_UNLIKELY(fp->typefeedback != NULL) && !fp->execdata) \
+        { \
+            uint8_t* tf = &fp->typefeedback[((ipc) - fp->code) * 2]; \
+            tf[0] |= luaF_feedbackbit(tb); \
+            if ((tc) != LUA_TNONE) \
+                tf[1] |= luaF_feedbackbit(tc); \
+        } \
+    }
+
+// fast paths record the types they handle as well, or the native code would be specialized for the types of the slow paths alone
+#define VM_FASTTYPEFEEDBACK(ipc, tb, tc) \
+    { \
+        if (LUAU_UNLIKELY(recordtypes)) \
+            VM_TYPEFEEDBACK(ipc, tb, tc); \
+    }
+#else
+#define VM_TYPEFEEDBACK(ipc, tb, tc) \
+    { \
+    }
+#define VM_FASTTYPEFEEDBACK(ipc, tb, tc) \
+    { \
+    }
+#endif
+
 LUAU_NOINLINE void luau_callhook(lua_State* L, lua_Hook hook, void* userdata)
 {
     ptrdiff_t base = savestack(L, L->base);
@@ -205,6 +277,9 @@ static void luau_execute(lua_State* L)
     StkId base;
     TValue* k;
     const Instruction* pc;
+#if VM_HAS_NATIVE
+    bool recordtypes; // set when the running function records type feedback, so that fast paths only have to test a local
+#endif
 
     LUAU_ASSERT(isLua(L->ci));
     LUAU_ASSERT(L->isactive);
@@ -230,6 +305,14 @@ reentry:
     base = L->base;
     k = cl->l.p->k;
 
+#if VM_HAS_NATIVE
+    recordtypes = cl->l.p->typefeedback != NULL;
+
+    // calls from C and from native code start functions without going through codeentry; redirect them so that tier-up counts them too
+    if (LUAU_UNLIKELY(cl->l.p->tiercalls > 0) && pc == cl->l.p->code && !SingleStep)
+        pc = cl->l.p->codeentry;
+#endif
+
     VM_NEXT(); // starts the interpreter "loop"
 
     {
@@ -320,6 +403,23 @@ reentry:
                 VM_NEXT();
             }
 
+            VM_CASE(LOP_MOVE2)
+            {
+                Instruction insn = *pc++;
+                uint32_t aux = *pc++;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                StkId rb = VM_REG(LUAU_INSN_B(insn));
+
+                setobj2s(L, ra, rb);
+
+                // second copy can read the register written by the first one
+                StkId rc = VM_REG(aux & 0xff);
+                StkId rd = VM_REG((aux >> 8) & 0xff);
+
+                setobj2s(L, rc, rd);
+                VM_NEXT();
+            }
+
             VM_CASE(LOP_GETGLOBAL)
             {
                 Instruction insn = *pc++;
@@ -450,6 +550,8 @@ reentry:
                 // fast-path: built-in table
                 if (LUAU_LIKELY(ttistable(rb)))
                 {
+                    VM_FASTTYPEFEEDBACK(pc - 2, LUA_TTABLE, LUA_TNONE);
+
                     LuaTable* h = hvalue(rb);
 
                     int slot = LUAU_INSN_C(insn) & h->nodemask8;
@@ -488,6 +590,8 @@ reentry:
                 }
                 else
                 {
+                    VM_TYPEFEEDBACK(pc - 2, ttype(rb), LUA_TNONE);
+
                     // fast-path: user data with C __index TM
                     const TValue* fn = 0;
                     if (ttisuserdata(rb) && (fn = fasttm(L, uvalue(rb)->metatable, TM_INDEX)) && ttisfunction(fn) && clvalue(fn)->isC)
@@ -803,6 +907,8 @@ reentry:
 
                 if (LUAU_LIKELY(ttistable(rb)))
                 {
+                    VM_FASTTYPEFEEDBACK(pc - 2, LUA_TTABLE, LUA_TNONE);
+
                     LuaTable* h = hvalue(rb);
                     // note: we can't use nodemask8 here because we need to query the main position of the table, and 8-bit nodemask8 only works
                     // for predictive lookups
@@ -843,6 +949,8 @@ reentry:
                 }
                 else
                 {
+                    VM_TYPEFEEDBACK(pc - 2, ttype(rb), LUA_TNONE);
+
                     LuaTable* mt = ttisuserdata(rb) ? uvalue(rb)->metatable : L->global->mt[ttype(rb)];
                     const TValue* tmi = 0;
 
@@ -959,6 +1067,9 @@ reentry:
                     cl = ccl;
                     base = L->base;
                     k = p->k;
+#if VM_HAS_NATIVE
+                    recordtypes = p->typefeedback != NULL;
+#endif
                     VM_NEXT();
                 }
                 else
@@ -1054,6 +1165,9 @@ reentry:
                 cl = nextcl;
                 base = L->base;
                 k = nextproto->k;
+#if VM_HAS_NATIVE
+                recordtypes = nextproto->typefeedback != NULL;
+#endif
                 VM_NEXT();
             }
 
@@ -1459,9 +1573,13 @@ reentry:
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
                 {
                     setnvalue(ra, nvalue(rb) + nvalue(rc));
+                    VM_FASTTYPEFEEDBACK(pc - 1, LUA_TNUMBER, LUA_TNUMBER);
                     VM_NEXT();
                 }
-                else if (ttisvector(rb) && ttisvector(rc))
+
+                VM_TYPEFEEDBACK(pc - 1, ttype(rb), ttype(rc));
+
+                if (ttisvector(rb) && ttisvector(rc))
                 {
                     const float* vb = vvalue(rb);
                     const float* vc = vvalue(rc);
@@ -1505,9 +1623,13 @@ reentry:
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
                 {
                     setnvalue(ra, nvalue(rb) - nvalue(rc));
+                    VM_FASTTYPEFEEDBACK(pc - 1, LUA_TNUMBER, LUA_TNUMBER);
                     VM_NEXT();
                 }
-                else if (ttisvector(rb) && ttisvector(rc))
+
+                VM_TYPEFEEDBACK(pc - 1, ttype(rb), ttype(rc));
+
+                if (ttisvector(rb) && ttisvector(rc))
                 {
                     const float* vb = vvalue(rb);
                     const float* vc = vvalue(rc);
@@ -1551,9 +1673,13 @@ reentry:
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
                 {
                     setnvalue(ra, nvalue(rb) * nvalue(rc));
+                    VM_FASTTYPEFEEDBACK(pc - 1, LUA_TNUMBER, LUA_TNUMBER);
                     VM_NEXT();
                 }
-                else if (ttisvector(rb) && ttisnumber(rc))
+
+                VM_TYPEFEEDBACK(pc - 1, ttype(rb), ttype(rc));
+
+                if (ttisvector(rb) && ttisnumber(rc))
                 {
                     const float* vb = vvalue(rb);
                     float vc = cast_to(float, nvalue(rc));
@@ -1612,9 +1738,13 @@ reentry:
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
                 {
                     setnvalue(ra, nvalue(rb) / nvalue(rc));
+                    VM_FASTTYPEFEEDBACK(pc - 1, LUA_TNUMBER, LUA_TNUMBER);
                     VM_NEXT();
                 }
-                else if (ttisvector(rb) && ttisnumber(rc))
+
+                VM_TYPEFEEDBACK(pc - 1, ttype(rb), ttype(rc));
+
+                if (ttisvector(rb) && ttisnumber(rc))
                 {
                     const float* vb = vvalue(rb);
                     float vc = cast_to(float, nvalue(rc));
@@ -1812,9 +1942,13 @@ reentry:
                 if (LUAU_LIKELY(ttisnumber(rb)))
                 {
                     setnvalue(ra, nvalue(rb) * nvalue(kv));
+                    VM_FASTTYPEFEEDBACK(pc - 1, LUA_TNUMBER, LUA_TNONE);
                     VM_NEXT();
                 }
-                else if (ttisvector(rb))
+
+                VM_TYPEFEEDBACK(pc - 1, ttype(rb), LUA_TNONE);
+
+                if (ttisvector(rb))
                 {
                     const float* vb = vvalue(rb);
                     float vc = cast_to(float, nvalue(kv));
@@ -1858,9 +1992,13 @@ reentry:
                 if (LUAU_LIKELY(ttisnumber(rb)))
                 {
                     setnvalue(ra, nvalue(rb) / nvalue(kv));
+                    VM_FASTTYPEFEEDBACK(pc - 1, LUA_TNUMBER, LUA_TNONE);
                     VM_NEXT();
                 }
-                else if (ttisvector(rb))
+
+                VM_TYPEFEEDBACK(pc - 1, ttype(rb), LUA_TNONE);
+
+                if (ttisvector(rb))
                 {
                     const float* vb = vvalue(rb);
                     float nc = cast_to(float, nvalue(kv));
@@ -2076,9 +2214,13 @@ reentry:
                 if (LUAU_LIKELY(ttisnumber(rb)))
                 {
                     setnvalue(ra, -nvalue(rb));
+                    VM_FASTTYPEFEEDBACK(pc - 1, LUA_TNUMBER, LUA_TNONE);
                     VM_NEXT();
                 }
-                else if (ttisvector(rb))
+
+                VM_TYPEFEEDBACK(pc - 1, ttype(rb), LUA_TNONE);
+
+                if (ttisvector(rb))
                 {
                     const float* vb = vvalue(rb);
                     setvvalue(ra, -vb[0], -vb[1], -vb[2], -vb[3]);
@@ -2238,6 +2380,7 @@ reentry:
             VM_CASE(LOP_FORNLOOP)
             {
                 VM_INTERRUPT();
+                VM_TIERUP();
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 LUAU_ASSERT(ttisnumber(ra + 0) && ttisnumber(ra + 1) && ttisnumber(ra + 2));
@@ -2253,6 +2396,7 @@ reentry:
                 {
                     pc += LUAU_INSN_D(insn);
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                    VM_OSR();
                     VM_NEXT();
                 }
                 else
@@ -2323,6 +2467,7 @@ reentry:
             VM_CASE(LOP_FORGLOOP)
             {
                 VM_INTERRUPT();
+                VM_TIERUP();
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 uint32_t aux = *pc;
@@ -2363,6 +2508,7 @@ reentry:
 
                             pc += LUAU_INSN_D(insn);
                             LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                            VM_OSR();
                             VM_NEXT();
                         }
 
@@ -2384,6 +2530,7 @@ reentry:
 
                             pc += LUAU_INSN_D(insn);
                             LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                            VM_OSR();
                             VM_NEXT();
                         }
 
@@ -2416,6 +2563,11 @@ reentry:
                     // note that we need to increment pc by 1 to exit the loop since we need to skip over aux
                     pc += ttisnil(ra + 3) ? 1 : LUAU_INSN_D(insn);
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+
+                    // loop exit doesn't necessarily start a block
+                    if (!ttisnil(ra + 3))
+                        VM_OSR();
+
                     VM_NEXT();
                 }
             }
@@ -2469,10 +2621,30 @@ reentry:
             VM_CASE(LOP_NATIVECALL)
             {
                 Proto* p = cl->l.p;
+
+#if VM_HAS_NATIVE
+                // functions marked for tier-up are entered through this instruction before they have native code, to count the calls
+                if (LUAU_UNLIKELY(!p->execdata))
+                {
+                    if (--p->tiercalls <= 0)
+                    {
+                        L->ci->savedpc = p->code;
+                        L->global->ecb.tierup(L, p);
+                    }
+
+                    // continue in the interpreter unless the function has just been compiled
+                    if (!p->execdata)
+                    {
+                        pc = p->code;
+                        VM_NEXT();
+                    }
+                }
+#endif
+
                 LUAU_ASSERT(p->execdata);
 
                 CallInfo* ci = L->ci;
-                ci->flags = LUA_CALLINFO_NATIVE;
+                ci->flags |= LUA_CALLINFO_NATIVE; // frames started from C (see reentry) also have LUA_CALLINFO_RETURN set
                 ci->savedpc = p->code;
 
 #if VM_HAS_NATIVE
@@ -2605,10 +2777,12 @@ reentry:
             VM_CASE(LOP_JUMPBACK)
             {
                 VM_INTERRUPT();
+                VM_TIERUP();
                 Instruction insn = *pc++;
 
                 pc += LUAU_INSN_D(insn);
                 LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                VM_OSR();
                 VM_NEXT();
             }
 
@@ -2626,10 +2800,12 @@ reentry:
             VM_CASE(LOP_JUMPX)
             {
                 VM_INTERRUPT();
+                VM_TIERUP();
                 Instruction insn = *pc++;
 
                 pc += LUAU_INSN_E(insn);
                 LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                VM_OSR();
                 VM_NEXT();
             }
 
@@ -0,0 +1,121 @@
+# This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+from tabulate import TablePrinter, Alignment
+
+scriptdir = os.path.dirname(os.path.realpath(__file__))
+defaultCompiler = 'luau-compile.exe' if os.name == "nt" else './luau-compile'
+
+argumentParser = argparse.ArgumentParser(description='Compare the number of IR instructions generated for benchmarks with and without an optimization')
+argumentParser.add_argument('--compiler', dest='compiler', default=defaultCompiler, help='luau-compile executable to use (' + defaultCompiler + ' by default)')
+argumentParser.add_argument('--folder', dest='folder', default=os.path.join(scriptdir, 'tests'), help='Folder with tests (tests by default)')
+argumentParser.add_argument('--run-test', action='store', default=None, help='Regex test filter')
+argumentParser.add_argument('--flag', dest='flag', default='DebugCodegenSkipCrossBlockPropagation', help='Flag that disables the optimization (DebugCodegenSkipCrossBlockPropagation by default)')
+argumentParser.add_argument('--opcodes', dest='opcodes', default='LOAD_TAG,CHECK_TAG,LOAD_POINTER,CHECK_NO_METATABLE,CHECK_READONLY,CHECK_SAFE_ENV', help='Comma-separated list of IR instructions to report separately')
+
+# IR dump lines have the form '#   [%N = ]CMD ops ; use info'
+irInstructionPattern = re.compile(r'^#   (?:%\d+ = )?([A-Z][A-Z_0-9]+)\b')
+
+def getIrCounts(compiler, filepath, flags):
+    cmd = [compiler, '--codegenir', '-O2']
+
+    if flags:
+        cmd.append('--fflags=' + flags)
+
+    cmd.append(filepath)
+
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True, errors="replace")
+
+    if result.returncode != 0:
+        print("Error: '{}' failed with code {}".format(' '.join(cmd), result.returncode))
+        sys.exit(1)
+
+    counts = {}
+
+    for line in result.stdout.splitlines():
+        match = irInstructionPattern.match(line)
+
+        if match:
+            counts[match.group(1)] = counts.get(match.group(1), 0) + 1
+
+    return counts
+
+def formatReduction(before, after):
+    if before == 0:
+        return "-"
+
+    return "{:.2f}%".format((before - after) * 100.0 / before)
+
+def main():
+    args = argumentParser.parse_args()
+
+    opcodes = [opcode for opcode in args.opcodes.split(',') if opcode]
+
+    columns = [
+        {'label': 'test', 'align': Alignment.LEFT},
+        {'label': 'before', 'align': Alignment.RIGHT},
+        {'label': 'after', 'align': Alignment.RIGHT},
+        {'label': 'reduction', 'align': Alignment.RIGHT},
+    ]
+
+    for opcode in opcodes:
+        columns.append({'label': opcode, 'align': Alignment.RIGHT})
+
+    table = TablePrinter(columns)
+
+    totalBefore = {}
+    totalAfter = {}
+
+    for subdir, dirs, files in os.walk(args.folder):
+        dirs.sort()
+
+        for filename in sorted(files):
+            if not filename.endswith(".lua") and not filename.endswith(".luau"):
+                continue
+
+            filepath = os.path.join(subdir, filename)
+            name = os.path.relpath(filepath, args.folder)
+
+            if args.run_test and not re.match(args.run_test, name):
+                continue
+
+            before = getIrCounts(args.compiler, filepath, args.flag)
+            after = getIrCounts(args.compiler, filepath, None)
+
+            for opcode, count in before.items():
+                totalBefore[opcode] = totalBefore.get(opcode, 0) + count
+
+            for opcode, count in after.items():
+                totalAfter[opcode] = totalAfter.get(opcode, 0) + count
+
+            row = {
+                'test': name,
+                'before': sum(before.values()),
+                'after': sum(after.values()),
+                'reduction': formatReduction(sum(before.values()), sum(after.values())),
+            }
+
+            for opcode in opcodes:
+                row[opcode] = "{} -> {}".format(before.get(opcode, 0), after.get(opcode, 0))
+
+            table.add_row(row)
+
+    row = {
+        'test': 'Total',
+        'before': sum(totalBefore.values()),
+        'after': sum(totalAfter.values()),
+        'reduction': formatReduction(sum(totalBefore.values()), sum(totalAfter.values())),
+    }
+
+    for opcode in opcodes:
+        row[opcode] = "{} -> {}".format(totalBefore.get(opcode, 0), totalAfter.get(opcode, 0))
+
+    table.add_row(row)
+    table.print()
+
+if __name__ == "__main__":
+    main()
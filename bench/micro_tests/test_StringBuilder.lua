@@ -0,0 +1,56 @@
+local function prequire(name) local success, result = pcall(require, name); return success and result end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+local rows = {}
+for i = 1, 100 do
+    rows[i] = { id = i, name = "item" .. i }
+end
+
+bench.runCode(function()
+    for j = 1, 1e3 do
+        local parts = {}
+        for _, row in rows do
+            parts[#parts + 1] = "<tr><td>"
+            parts[#parts + 1] = tostring(row.id)
+            parts[#parts + 1] = "</td><td>"
+            parts[#parts + 1] = row.name
+            parts[#parts + 1] = "</td></tr>\n"
+        end
+        local _ = table.concat(parts)
+    end
+end, "html: table.concat")
+
+bench.runCode(function()
+    for j = 1, 1e3 do
+        local s = ""
+        for _, row in rows do
+            s = s .. "<tr><td>" .. row.id .. "</td><td>" .. row.name .. "</td></tr>\n"
+        end
+        local _ = s
+    end
+end, "html: concat")
+
+bench.runCode(function()
+    for j = 1, 1e3 do
+        local sb = strbuf.create()
+        for _, row in rows do
+            sb:append("<tr><td>", row.id, "</td><td>", row.name, "</td></tr>\n")
+        end
+        local _ = sb:tostring()
+    end
+end, "html: strbuf method")
+
+bench.runCode(function()
+    local sb = strbuf.create()
+    for j = 1, 1e3 do
+        sb:reset()
+        for _, row in rows do
+            strbuf.append(sb, "<tr><td>")
+            strbuf.append(sb, row.id)
+            strbuf.append(sb, "</td><td>")
+            strbuf.append(sb, row.name)
+            strbuf.append(sb, "</td></tr>\n")
+        end
+        local _ = strbuf.tostring(sb)
+    end
+end, "html: strbuf fastcall")
@@ -0,0 +1,94 @@
+local function prequire(name) local success, result = pcall(require, name); return success and result end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+local function makestate()
+    local players = {}
+
+    for i=1,100 do
+        players[i] = {
+            name = "player" .. i,
+            level = i % 50,
+            health = 100 - i * 0.25,
+            position = {x = i * 1.5, y = 0, z = -i * 2.5},
+            inventory = {"sword", "shield", "potion", "potion", "arrow"},
+            online = i % 3 == 0,
+        }
+    end
+
+    return {version = 3, seed = 12345, players = players}
+end
+
+-- reference encoder written over buffer.write* that covers the subset of values in the state above
+local function luauencode(value)
+    local b = buffer.create(256)
+    local pos = 0
+
+    local function reserve(n)
+        if pos + n > buffer.len(b) then
+            local nb = buffer.create(math.max(buffer.len(b) * 2, pos + n))
+            buffer.copy(nb, 0, b, 0, pos)
+            b = nb
+        end
+    end
+
+    local function write(v)
+        local t = type(v)
+
+        if t == "number" then
+            reserve(9)
+            buffer.writeu8(b, pos, 4)
+            buffer.writef64(b, pos + 1, v)
+            pos += 9
+        elseif t == "string" then
+            reserve(5 + #v)
+            buffer.writeu8(b, pos, 5)
+            buffer.writeu32(b, pos + 1, #v)
+            buffer.writestring(b, pos + 5, v)
+            pos += 5 + #v
+        elseif t == "boolean" then
+            reserve(1)
+            buffer.writeu8(b, pos, v and 2 or 1)
+            pos += 1
+        elseif t == "table" then
+            local count = 0
+            for _ in v do count += 1 end
+
+            reserve(5)
+            buffer.writeu8(b, pos, 10)
+            buffer.writeu32(b, pos + 1, count)
+            pos += 5
+
+            for k, e in v do
+                write(k)
+                write(e)
+            end
+        end
+    end
+
+    write(value)
+
+    local result = buffer.create(pos)
+    buffer.copy(result, 0, b, 0, pos)
+    return result
+end
+
+local state = makestate()
+local data = serialize.encode(state)
+
+bench.runCode(function()
+    for i=1,200 do
+        local b = luauencode(state)
+    end
+end, "TableMarshal: buffer.write*")
+
+bench.runCode(function()
+    for i=1,200 do
+        local b = serialize.encode(state)
+    end
+end, "TableMarshal: serialize.encode")
+
+bench.runCode(function()
+    for i=1,200 do
+        local t = serialize.decode(data)
+    end
+end, "TableMarshal: serialize.decode")
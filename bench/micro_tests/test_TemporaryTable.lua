@@ -0,0 +1,29 @@
+local function prequire(name) local success, result = pcall(require, name); return success and result end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+local function length(x: number, y: number)
+	local p = {x = x, y = y}
+	return math.sqrt(p.x * p.x + p.y * p.y)
+end
+
+local function dot(a: number, b: number, c: number, d: number)
+	local u = {a, b}
+	local v = {c, d}
+	return u[1] * v[1] + u[2] * v[2]
+end
+
+function test()
+
+	local ts0 = os.clock()
+	local sum = 0
+	for i=1,1000000 do
+		sum += length(i, i + 1)
+		sum += dot(i, i + 1, i + 2, i + 3)
+	end
+	local ts1 = os.clock()
+
+	assert(sum > 0)
+	return ts1-ts0
+end
+
+bench.runCode(test, "TemporaryTable")
@@ -21,3 +21,41 @@ bench.runCode(function()
         tostring(j)
     end
 end, "tostring-gc")
+
+local decimals = {}
+for i=1,1000 do
+    decimals[i] = tostring(math.random() * 10 ^ math.random(-20, 20))
+end
+
+bench.runCode(function()
+    for j=1,1e3 do
+        for _, s in decimals do
+            tonumber(s)
+        end
+    end
+end, "tonumber-decimal")
+
+local longdecimals = {}
+for i=1,1000 do
+    longdecimals[i] = string.format("%.17g", math.random() * 10 ^ math.random(-20, 20))
+end
+
+bench.runCode(function()
+    for j=1,1e3 do
+        for _, s in longdecimals do
+            tonumber(s)
+        end
+    end
+end, "tonumber-17digits")
+
+bench.runCode(function()
+    for j=1,1e6 do
+        string.format("%g", j * 0.001)
+    end
+end, "format-g")
+
+bench.runCode(function()
+    for j=1,1e6 do
+        string.format("%.14g", j / 3)
+    end
+end, "format-g14")
@@ -0,0 +1,34 @@
+local function prequire(name) local success, result = pcall(require, name); return success and result end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+-- strings are rebuilt on every iteration so that the cached classification is not reused
+local ascii = string.rep("The quick brown fox jumps over the lazy dog. ", 100000)
+local mixed = string.rep("Съешь же ещё этих мягких французских булок, да выпей чаю. 日本語 ", 40000)
+
+bench.runCode(function()
+    for j = 1, 10 do
+        local s = ascii .. j
+        local _ = utf8.len(s)
+    end
+end, "utf8.len: ascii 4.5MB")
+
+bench.runCode(function()
+    for j = 1, 10 do
+        local s = mixed .. j
+        local _ = utf8.len(s)
+    end
+end, "utf8.len: mixed 4MB")
+
+bench.runCode(function()
+    for j = 1, 10 do
+        local _ = utf8.len(mixed)
+    end
+end, "utf8.len: mixed 4MB cached")
+
+bench.runCode(function()
+    local s = ascii .. "x"
+    local n = 0
+    for p, c in utf8.codes(s) do
+        n += c
+    end
+end, "utf8.codes: ascii 4.5MB")
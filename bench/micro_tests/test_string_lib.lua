@@ -38,3 +38,48 @@ bench.runCode(function()
 	end
 	assert(#str)
 end, "string: rep (large)")
+
+bench.runCode(function()
+	local src = string.rep("abcdefghijklmnopqrstuvwxyz", 100)
+	local sum = 0
+	for rep=1,100 do
+		for i=1,#src do
+			sum += string.byte(src, i)
+		end
+	end
+	assert(sum > 0)
+end, "string: byte")
+
+bench.runCode(function()
+	local src = string.rep("abcdefghijklmnopqrstuvwxyz", 100)
+	local count = 0
+	for rep=1,100 do
+		for i=1,#src do
+			if string.sub(src, i, i) == "a" then
+				count += 1
+			end
+		end
+	end
+	assert(count == 10000)
+end, "string: sub (single character)")
+
+bench.runCode(function()
+	local src = string.rep("abcdefghijklmnopqrstuvwxyz", 100)
+	local str = ""
+	for rep=1,100 do
+		for i=1,#src - 8 do
+			str = string.sub(src, i, i + 7)
+		end
+	end
+	assert(#str == 8)
+end, "string: sub")
+
+bench.runCode(function()
+	local str = ""
+	for rep=1,1000 do
+		for i=0,255 do
+			str = string.char(i)
+		end
+	end
+	assert(#str == 1)
+end, "string: char")
@@ -0,0 +1,84 @@
+local function prequire(name) local success, result = pcall(require, name); return success and result end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+-- documents modelled after common real-world JSON: API responses with many small objects and strings,
+-- geometry with long arrays of numbers, and configuration with deep nesting and escaped strings
+local function makefeed()
+    local statuses = {}
+
+    for i = 1, 200 do
+        statuses[i] = {
+            id = 1000000000 + i,
+            created_at = "Sun Aug 31 00:29:15 +0000 2014",
+            text = "status update number " .. i .. " with some text, a \"quote\" and a link https://example.com/" .. i,
+            truncated = false,
+            user = {
+                id = 5000 + i % 17,
+                name = "user" .. (i % 17),
+                screen_name = "screen_name_" .. (i % 17),
+                followers_count = i * 13,
+                verified = i % 5 == 0,
+                description = "Ünïcödé description for user " .. i,
+            },
+            entities = {hashtags = {"luau", "json"}, urls = {}, user_mentions = {}},
+            retweet_count = i % 7,
+            favorite_count = i % 11,
+            lang = "en",
+        }
+    end
+
+    return {statuses = statuses, search_metadata = {count = 200, completed_in = 0.087, query = "luau"}}
+end
+
+local function makegeometry()
+    local rings = {}
+
+    for r = 1, 20 do
+        local ring = {}
+        for i = 1, 250 do
+            ring[i] = {-65.613616999999977 + i * 0.0001234, 43.420273000000009 - r * 0.0004321}
+        end
+        rings[r] = ring
+    end
+
+    return {type = "FeatureCollection", features = {{type = "Feature", properties = {name = "Canada"}, geometry = {type = "Polygon", coordinates = rings}}}}
+end
+
+local function makeconfig()
+    local function node(depth)
+        if depth == 0 then
+            return {enabled = true, path = "C:\\Program Files\\App\\data\\file.txt", weight = 0.25, tags = {"a", "b", "c"}}
+        end
+
+        local result = {}
+        for i = 1, 4 do
+            result["child" .. i] = node(depth - 1)
+        end
+        return result
+    end
+
+    return node(5)
+end
+
+local documents = {
+    {"feed", json.encode(makefeed())},
+    {"geometry", json.encode(makegeometry())},
+    {"config", json.encode(makeconfig())},
+}
+
+for _, doc in documents do
+    local name, text = doc[1], doc[2]
+    local value = json.decode(text)
+
+    bench.runCode(function()
+        for i = 1, 20 do
+            json.decode(text)
+        end
+    end, "json.decode: " .. name)
+
+    bench.runCode(function()
+        for i = 1, 20 do
+            json.encode(value)
+        end
+    end, "json.encode: " .. name)
+end
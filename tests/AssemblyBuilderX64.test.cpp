@@ -25,9 +25,9 @@ static std::string bytecodeAsArray(const std::vector<uint8_t>& bytecode)
 class AssemblyBuilderX64Fixture
 {
 public:
-    bool check(void (*f)(AssemblyBuilderX64& build), std::vector<uint8_t> code, std::vector<uint8_t> data = {})
+    bool check(void (*f)(AssemblyBuilderX64& build), std::vector<uint8_t> code, std::vector<uint8_t> data = {}, unsigned int features = 0)
     {
-        AssemblyBuilderX64 build(/* logText= */ false);
+        AssemblyBuilderX64 build(/* logText= */ false, features);
 
         f(build);
 
@@ -555,6 +555,7 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXMoveInstructionForms")
     SINGLE_COMPARE(vmovaps(xmm8, xmmword[r9]), 0xc4, 0x41, 0x78, 0x28, 0x01);
     SINGLE_COMPARE(vmovaps(xmmword[r9], xmm10), 0xc4, 0x41, 0x78, 0x29, 0x11);
     SINGLE_COMPARE(vmovaps(ymm8, ymmword[r9]), 0xc4, 0x41, 0x7c, 0x28, 0x01);
+    SINGLE_COMPARE(vmovaps(xmm8, xmm10), 0xc4, 0x41, 0x78, 0x28, 0xc2);
     SINGLE_COMPARE(vmovupd(xmm8, xmmword[r9]), 0xc4, 0x41, 0x79, 0x10, 0x01);
     SINGLE_COMPARE(vmovupd(xmmword[r9], xmm10), 0xc4, 0x41, 0x79, 0x11, 0x11);
     SINGLE_COMPARE(vmovupd(ymm8, ymmword[r9]), 0xc4, 0x41, 0x7d, 0x10, 0x01);
@@ -598,6 +599,34 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXTernaryInstructionForms")
     SINGLE_COMPARE(vdpps(xmm7, xmm12, xmmword[rcx + r10], 2), 0xc4, 0xa3, 0x19, 0x40, 0x3c, 0x11, 0x02);
 }
 
+TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXFusedMultiplyAddInstructionForms")
+{
+    CHECK(check(
+        [](AssemblyBuilderX64& build)
+        {
+            build.vfmadd231sd(xmm0, xmm1, xmm2);
+            build.vfmadd231sd(xmm8, xmm10, xmm14);
+            build.vfmadd231sd(xmm8, xmm10, qword[r9]);
+            build.vfmadd231sd(xmm7, xmm12, qword[rcx + r10]);
+        },
+        {0xc4, 0xe2, 0xf1, 0xb9, 0xc2, 0xc4, 0x42, 0xa9, 0xb9, 0xc6, 0xc4, 0x42, 0xa9, 0xb9, 0x01, 0xc4, 0xa2, 0x99, 0xb9, 0x3c, 0x11},
+        {},
+        X64::Feature_FMA3
+    ));
+
+    CHECK(check(
+        [](AssemblyBuilderX64& build)
+        {
+            build.vfmadd231ps(xmm8, xmm10, xmm14);
+            build.vfmadd231ps(xmm8, xmm10, xmmword[r9]);
+            build.vfmadd231ps(xmm7, xmm12, xmmword[rcx + r10]);
+        },
+        {0xc4, 0x42, 0x29, 0xb8, 0xc6, 0xc4, 0x42, 0x29, 0xb8, 0x01, 0xc4, 0xa2, 0x19, 0xb8, 0x3c, 0x11},
+        {},
+        X64::Feature_FMA3
+    ));
+}
+
 TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "MiscInstructions")
 {
     SINGLE_COMPARE(int3(), 0xcc);
@@ -628,7 +657,7 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "LabelLea")
 
 TEST_CASE("LogTest")
 {
-    AssemblyBuilderX64 build(/* logText= */ true);
+    AssemblyBuilderX64 build(/* logText= */ true, X64::Feature_FMA3);
 
     build.push(r12);
     build.align(8);
@@ -659,6 +688,7 @@ TEST_CASE("LogTest")
     build.imul(rcx, rdx);
     build.imul(rcx, rdx, 8);
     build.vroundsd(xmm1, xmm2, xmm3, RoundingModeX64::RoundToNearestEven);
+    build.vfmadd231sd(xmm1, xmm2, qword[rcx + 8]);
     build.add(rdx, qword[rcx - 12]);
     build.pop(r12);
     build.cmov(ConditionX64::AboveEqual, rax, rbx);
@@ -705,6 +735,7 @@ TEST_CASE("LogTest")
  imul        rcx,rdx
  imul        rcx,rdx,8
  vroundsd    xmm1,xmm2,xmm3,8
+ vfmadd231sd xmm1,xmm2,qword ptr [rcx+8]
  add         rdx,qword ptr [rcx-0Ch]
  pop         r12
  cmovae      rax,rbx
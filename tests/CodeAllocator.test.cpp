@@ -181,6 +181,105 @@ TEST_CASE("CodeAllocationWithUnwindCallbacks")
     CHECK(info.destroyCalled);
 }
 
+TEST_CASE("CodeAllocationReclamation")
+{
+    size_t blockSize = 64 * 1024;
+    size_t maxTotalSize = 128 * 1024;
+    CodeAllocator allocator(blockSize, maxTotalSize);
+
+    uint8_t* nativeData[5] = {};
+    size_t sizeNativeData = 0;
+    uint8_t* nativeEntry[5] = {};
+
+    std::vector<uint8_t> code;
+    code.resize(blockSize / 2);
+
+    // two allocations fill a block
+    for (int i = 0; i < 4; i++)
+        REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[i], sizeNativeData, nativeEntry[i]));
+
+    REQUIRE(!allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[4], sizeNativeData, nativeEntry[4]));
+
+    CodeMemoryStats stats = allocator.getMemoryStats();
+    CHECK(stats.blockCount == 2);
+    CHECK(stats.liveCodeBytes == 4 * code.size());
+    CHECK(stats.deadCodeBytes == 0);
+
+    // allocation is kept alive by the additional references
+    allocator.addAllocationRefs(nativeEntry[0] + 16, 2);
+    allocator.releaseAllocation(nativeEntry[0]);
+    allocator.releaseAllocation(nativeEntry[0] + 8);
+    CHECK(allocator.getMemoryStats().liveCodeBytes == 4 * code.size());
+
+    // dead code can't be reclaimed while it shares a block with live code
+    allocator.releaseAllocation(nativeEntry[0] + 24);
+
+    stats = allocator.getMemoryStats();
+    CHECK(stats.blockCount == 2);
+    CHECK(stats.blocksReclaimed == 0);
+    CHECK(stats.liveCodeBytes == 3 * code.size());
+    CHECK(stats.deadCodeBytes == code.size());
+
+    allocator.releaseAllocation(nativeEntry[1] + code.size() - 1);
+
+    stats = allocator.getMemoryStats();
+    CHECK(stats.blockCount == 2);
+    CHECK(stats.blocksReclaimed == 1);
+    CHECK(stats.liveCodeBytes == 2 * code.size());
+    CHECK(stats.deadCodeBytes == 0);
+    CHECK(stats.reclaimedCodeBytes == 2 * code.size());
+
+    // reclaimed block is reused
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[4], sizeNativeData, nativeEntry[4]));
+    CHECK((nativeEntry[4] == nativeEntry[0] || nativeEntry[4] == nativeEntry[1]));
+
+    // when the current block is reclaimed, allocation continues in a new one
+    allocator.releaseAllocation(nativeEntry[4]);
+    allocator.releaseAllocation(nativeEntry[2]);
+    allocator.releaseAllocation(nativeEntry[3]);
+
+    stats = allocator.getMemoryStats();
+    CHECK(stats.blockCount == 1);
+    CHECK(stats.blocksReclaimed == 3);
+    CHECK(stats.liveCodeBytes == 0);
+    CHECK(stats.reclaimedCodeBytes == 5 * code.size());
+
+    for (int i = 0; i < 4; i++)
+        REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[i], sizeNativeData, nativeEntry[i]));
+
+    CHECK(allocator.getMemoryStats().blockCount == 2);
+}
+
+TEST_CASE("CodeAllocationSpareBlockLimit")
+{
+    size_t blockSize = 64 * 1024;
+    size_t maxTotalSize = 64 * 1024;
+    CodeAllocator allocator(blockSize, maxTotalSize);
+
+    uint8_t* nativeData = nullptr;
+    size_t sizeNativeData = 0;
+    uint8_t* nativeEntry = nullptr;
+
+    std::vector<uint8_t> code;
+    code.resize(blockSize / 2);
+
+    for (int i = 0; i < 3; i++)
+    {
+        // the block kept for reuse is counted against the limit, so only a single block is ever mapped
+        REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData, sizeNativeData, nativeEntry));
+        CHECK(allocator.getMemoryStats().blockCount == 1);
+
+        allocator.releaseAllocation(nativeEntry);
+
+        CodeMemoryStats stats = allocator.getMemoryStats();
+        CHECK(stats.blockCount == 1);
+        CHECK(stats.blockCount * blockSize <= maxTotalSize);
+        CHECK(stats.liveCodeBytes == 0);
+    }
+
+    CHECK(allocator.getMemoryStats().blocksReclaimed == 3);
+}
+
 #if !defined(LUAU_BIG_ENDIAN)
 TEST_CASE("WindowsUnwindCodesX64")
 {
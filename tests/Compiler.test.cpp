@@ -23,6 +23,8 @@ LUAU_FASTINT(LuauCompileInlineThresholdMaxBoost)
 LUAU_FASTINT(LuauCompileLoopUnrollThreshold)
 LUAU_FASTINT(LuauCompileLoopUnrollThresholdMaxBoost)
 LUAU_FASTINT(LuauRecursionLimit)
+LUAU_FASTFLAG(LuauCompileSuperinstructions)
+LUAU_FASTFLAG(LuauCompilePeephole)
 
 using namespace Luau;
 
@@ -148,6 +150,7 @@ TEST_CASE("BytecodeIsStable")
     // Bytecode ops (serialized & in-memory)
     CHECK(LOP_FASTCALL2K == 75); // bytecode v1
     CHECK(LOP_JUMPXEQKS == 80);  // bytecode v3
+    CHECK(LOP_MOVE2 == 83);      // bytecode v7
 
     // Bytecode fastcall ids (serialized & in-memory)
     // Note: these aren't strictly bound to specific bytecode versions, but must monotonically increase to keep backwards compat
@@ -402,6 +405,8 @@ L1: RETURN R0 0
 
 TEST_CASE("ForBytecode")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     // basic for loop: variable directly refers to internal iteration index (R2)
     CHECK_EQ("\n" + compileFunction0("for i=1,5 do print(i) end"), R"(
 LOADN R2 1
@@ -2512,6 +2517,8 @@ RETURN R1 1
 
 TEST_CASE("JumpFold")
 {
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, false};
+
     // jump-to-return folding to return
     CHECK_EQ("\n" + compileFunction0("return a and 1 or 0"), R"(
 GETIMPORT R1 1 [a]
@@ -2605,6 +2612,154 @@ RETURN R8 -1
     );
 }
 
+TEST_CASE("Superinstructions")
+{
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, true};
+
+    // consecutive moves on the same line are fused
+    CHECK_EQ("\n" + compileFunction0("local a, b = ... local x, y = b, a return x, y"), R"(
+GETVARARGS R0 2
+MOVE2 R2 R1 R3 R0
+RETURN R2 2
+)");
+
+    // moves on different lines are kept separate so that a breakpoint can be set on each line
+    CHECK_EQ("\n" + compileFunction0("local a, b = ...\nlocal x = b\nlocal y = a\nx = a\ny = b\nreturn x, y"), R"(
+GETVARARGS R0 2
+MOVE R2 R1
+MOVE R3 R0
+MOVE R2 R0
+MOVE R3 R1
+RETURN R2 2
+)");
+
+    // the second move can't be fused when it's a jump target
+    CHECK_EQ("\n" + compileFunction0("local a, b = ... local x = a if b then x = b end local y = x return x, y"), R"(
+GETVARARGS R0 2
+MOVE R2 R0
+JUMPIFNOT R1 L0
+MOVE R2 R1
+L0: MOVE R3 R2
+RETURN R2 2
+)");
+
+    // no fusion without optimizations
+    CHECK_EQ("\n" + compileFunction("local a, b = ... local x, y = b, a return x, y", 0, 0), R"(
+GETVARARGS R0 2
+MOVE R2 R1
+MOVE R3 R0
+RETURN R2 2
+)");
+}
+
+TEST_CASE("Peephole")
+{
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, true};
+
+    // jumps to the next instruction are removed, including jumps over other removed jumps
+    CHECK_EQ("\n" + compileFunction0("if a then if b then b() else end else end d()"), R"(
+GETIMPORT R0 1 [a]
+JUMPIFNOT R0 L0
+GETIMPORT R0 3 [b]
+JUMPIFNOT R0 L0
+GETIMPORT R0 3 [b]
+CALL R0 0 0
+L0: GETIMPORT R0 5 [d]
+CALL R0 0 0
+RETURN R0 0
+)");
+
+    // moving the value back into the source register is redundant
+    CHECK_EQ("\n" + compileFunction0("local a, b = ... b = a a = b return a, b"), R"(
+GETVARARGS R0 2
+MOVE R1 R0
+RETURN R0 2
+)");
+
+    // loads that are overwritten on all paths before they are read are removed with O2
+    const char* source = "local n = ... local r if n > 0 then r = 1 else r = 2 end return r";
+
+    CHECK_EQ("\n" + compileFunction(source, 0, 2), R"(
+GETVARARGS R0 1
+LOADN R2 0
+JUMPIFNOTLT R2 R0 L0
+LOADN R1 1
+RETURN R1 1
+L0: LOADN R1 2
+RETURN R1 1
+)");
+
+    CHECK_EQ("\n" + compileFunction(source, 0, 1), R"(
+GETVARARGS R0 1
+LOADNIL R1
+LOADN R2 0
+JUMPIFNOTLT R2 R0 L0
+LOADN R1 1
+RETURN R1 1
+L0: LOADN R1 2
+RETURN R1 1
+)");
+
+    CHECK_EQ("\n" + compileFunction("local t = ... local x = 1 x = nil x = t.y return x", 0, 2), R"(
+GETVARARGS R0 1
+GETTABLEKS R1 R0 K0 ['y']
+RETURN R1 1
+)");
+
+    // loads that are only overwritten on some paths are kept
+    CHECK_EQ("\n" + compileFunction("local n = ... local r if n > 0 then r = 1 end return r", 0, 2), R"(
+GETVARARGS R0 1
+LOADNIL R1
+LOADN R2 0
+JUMPIFNOTLT R2 R0 L0
+LOADN R1 1
+L0: RETURN R1 1
+)");
+
+    // registers captured by reference can be read through the upvalue before they are overwritten
+    CHECK_EQ("\n" + compileFunction("local t = ... local x = 1 local function get() return x end x = nil x = t.y return x, get", 1, 2), R"(
+GETVARARGS R0 1
+LOADN R1 1
+NEWCLOSURE R2 P0
+CAPTURE REF R1
+LOADNIL R1
+GETTABLEKS R1 R0 K0 ['y']
+CLOSEUPVALS R1
+RETURN R1 2
+)");
+}
+
+TEST_CASE("PeepholeLongJumps")
+{
+    std::string source;
+    source += "local sum = 0\n";
+    source += "for i=1,3 do\n";
+    for (int i = 0; i < 10000; ++i)
+    {
+        source += "sum = sum + i\n";
+        source += "if sum > 150000 then break end\n";
+    }
+    source += "end\n";
+    source += "return sum\n";
+
+    auto compile = [&](bool peephole)
+    {
+        ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, peephole};
+
+        Luau::BytecodeBuilder bcb;
+        bcb.setDumpFlags(Luau::BytecodeBuilder::Dump_Code | Luau::BytecodeBuilder::Dump_Locals);
+
+        Luau::CompileOptions options;
+        options.debugLevel = 2;
+        Luau::compileOrThrow(bcb, source.c_str(), options);
+
+        return bcb.dumpFunction(0);
+    };
+
+    // instructions are not removed from functions with jump trampolines, and the local ranges have to account for the trampolines
+    CHECK_EQ(compile(true), compile(false));
+}
+
 TEST_CASE("RecursionParse")
 {
     // The test forcibly pushes the stack limit during compilation; in NoOpt, the stack consumption is much larger so we need to reduce the limit to
@@ -2796,6 +2951,8 @@ RETURN R0 0
 
 TEST_CASE("NestedFunctionCalls")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     CHECK_EQ("\n" + compileFunction0("function clamp(t,a,b) return math.min(math.max(t,a),b) end"), R"(
 FASTCALL2 18 R0 R1 L0
 MOVE R5 R0
@@ -3012,6 +3169,8 @@ RETURN R0 -1
 
 TEST_CASE("DebugLineInfo")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     Luau::BytecodeBuilder bcb;
     bcb.setDumpFlags(Luau::BytecodeBuilder::Dump_Code | Luau::BytecodeBuilder::Dump_Lines);
     Luau::compileOrThrow(bcb, R"(
@@ -3244,6 +3403,8 @@ Foo
 
 TEST_CASE("DebugLineInfoFastCall")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     Luau::BytecodeBuilder bcb;
     bcb.setDumpFlags(Luau::BytecodeBuilder::Dump_Code | Luau::BytecodeBuilder::Dump_Lines);
     Luau::compileOrThrow(bcb, R"(
@@ -3297,6 +3458,8 @@ a
 
 TEST_CASE("DebugSource")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     const char* source = R"(
 local kSelectedBiomes = {
     ['Mountains'] = true,
@@ -3372,6 +3535,8 @@ RETURN R1 1
 
 TEST_CASE("DebugLocals")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     const char* source = R"(
 function foo(e, f)
     local a = 1
@@ -3779,6 +3944,8 @@ local b = test(2)
 
 TEST_CASE("AssignmentConflict")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     // assignments are left to right
     CHECK_EQ("\n" + compileFunction0("local a, b a, b = 1, 2"), R"(
 LOADNIL R0
@@ -3931,6 +4098,8 @@ RETURN R1 -1
 
 TEST_CASE("Fastcall3")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     CHECK_EQ(
         "\n" + compileFunction0(R"(
 local a, b, c = ...
@@ -5236,6 +5405,8 @@ L0: RETURN R0 -1
 
 TEST_CASE("VectorFastCall3")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     const char* source = R"(
 local a, b, c = ...
 return Vector3.new(a, b, c)
@@ -6011,6 +6182,8 @@ L3: RETURN R0 1
 
 TEST_CASE("LoopUnrollMutable")
 {
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, false};
+
     // can't unroll loops that mutate iteration variable
     CHECK_EQ(
         "\n" + compileFunction(
@@ -6678,6 +6851,11 @@ RETURN R1 1
 
 TEST_CASE("InlineCapture")
 {
+    ScopedFastFlag sff[]{
+        {FFlag::LuauCompileSuperinstructions, false},
+        {FFlag::LuauCompilePeephole, false},
+    };
+
     // if the argument is captured by a nested closure, normally we can rely on capture by value
     CHECK_EQ(
         "\n" + compileFunction(
@@ -6916,6 +7094,8 @@ RETURN R1 -1
 
 TEST_CASE("InlineArgMismatch")
 {
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, false};
+
     // when inlining a function, we must respect all the usual rules
 
     // caller might not have enough arguments
@@ -7238,6 +7418,8 @@ RETURN R3 1
 
 TEST_CASE("InlineRecurseArguments")
 {
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, false};
+
     // the example looks silly but we preserve it verbatim as it was found by fuzzer for a previous version of the compiler
     CHECK_EQ(
         "\n" + compileFunction(
@@ -7376,6 +7558,8 @@ L1: RETURN R0 0
 
 TEST_CASE("InlineExprIndexK")
 {
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, false};
+
     CHECK_EQ(
         "\n" + compileFunction(
                    R"(
@@ -7442,6 +7626,8 @@ L3: RETURN R0 0
 
 TEST_CASE("InlineHiddenMutation")
 {
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, false};
+
     // when the argument is assigned inside the function, we can't reuse the local
     CHECK_EQ(
         "\n" + compileFunction(
@@ -7646,6 +7832,8 @@ RETURN R0 0
 
 TEST_CASE("InlineNonConstInitializers2")
 {
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, false};
+
     CHECK_EQ(
         "\n" + compileFunction(
                    R"(
@@ -7681,6 +7869,8 @@ L3: RETURN R0 0
 
 TEST_CASE("ReturnConsecutive")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     // we can return a single local directly
     CHECK_EQ(
         "\n" + compileFunction0(R"(
@@ -8156,6 +8346,8 @@ RETURN R0 4
 
 TEST_CASE("LocalReassign")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     // locals can be re-assigned and the register gets reused
     CHECK_EQ(
         "\n" + compileFunction0(R"(
@@ -8259,6 +8451,8 @@ RETURN R2 1
 
 TEST_CASE("MultipleAssignments")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     // order of assignments is left to right
     CHECK_EQ(
         "\n" + compileFunction0(R"(
@@ -8629,6 +8823,8 @@ L3: RETURN R0 0
 
 TEST_CASE("BuiltinArity")
 {
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, false};
+
     // by default we can't assume that we know parameter/result count for builtins as they can be overridden at runtime
     CHECK_EQ(
         "\n" + compileFunction(
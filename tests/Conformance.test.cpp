@@ -23,6 +23,11 @@
 #include <vector>
 #include <math.h>
 
+#if defined(__linux__)
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
 extern bool verbose;
 extern bool codegen;
 extern int optimizationLevel;
@@ -38,12 +43,22 @@ LUAU_DYNAMIC_FASTFLAG(LuauXpcallContErrorHandling)
 LUAU_FASTFLAG(DebugLuauAbortingChecks)
 LUAU_FASTFLAG(LuauCodeGenDirectBtest)
 LUAU_FASTINT(CodegenHeuristicsInstructionLimit)
+LUAU_FASTINT(LuauCodeGenTierUpCalls)
+LUAU_FASTINT(LuauCodeGenTierUpLoops)
+LUAU_FASTINT(LuauCodeGenAsyncThreads)
+LUAU_FASTINT(LuauCodeGenSpeculationFailures)
 LUAU_FASTFLAG(LuauVectorLerp)
 LUAU_FASTFLAG(LuauCompileVectorLerp)
+LUAU_FASTFLAG(LuauCompileStrbufAppend)
+LUAU_FASTFLAG(LuauCompileSuperinstructions)
+LUAU_FASTFLAG(LuauCompilePeephole)
 LUAU_FASTFLAG(LuauTypeCheckerVectorLerp)
 LUAU_FASTFLAG(LuauCodeGenVectorLerp)
 LUAU_DYNAMIC_FASTFLAG(LuauXpcallContNoYield)
 LUAU_FASTFLAG(LuauCodeGenBetterBytecodeAnalysis)
+LUAU_FASTFLAG(LuauSerializeLibrary)
+LUAU_FASTFLAG(LuauJsonLibrary)
+LUAU_FASTFLAG(LuauStrbufLibrary)
 
 static lua_CompileOptions defaultOptions()
 {
@@ -650,11 +665,51 @@ TEST_CASE("Basic")
     runConformance("basic.luau");
 }
 
+TEST_CASE("Superinstructions")
+{
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, true};
+
+    runConformance("superinstructions.luau");
+}
+
+TEST_CASE("Peephole")
+{
+    ScopedFastFlag luauCompilePeephole{FFlag::LuauCompilePeephole, true};
+
+    // dead stores are only removed with O2
+    lua_CompileOptions copts = defaultOptions();
+    copts.optimizationLevel = 2;
+
+    runConformance("peephole.luau", nullptr, nullptr, nullptr, &copts);
+}
+
 TEST_CASE("Buffers")
 {
     runConformance("buffers.luau");
 }
 
+TEST_CASE("Serialize")
+{
+    ScopedFastFlag luauSerializeLibrary{FFlag::LuauSerializeLibrary, true};
+
+    runConformance("serialize.luau");
+}
+
+TEST_CASE("Json")
+{
+    ScopedFastFlag luauJsonLibrary{FFlag::LuauJsonLibrary, true};
+
+    runConformance("json.luau");
+}
+
+TEST_CASE("Strbuf")
+{
+    ScopedFastFlag luauStrbufLibrary{FFlag::LuauStrbufLibrary, true};
+    ScopedFastFlag luauCompileStrbufAppend{FFlag::LuauCompileStrbufAppend, true};
+
+    runConformance("strbuf.luau");
+}
+
 TEST_CASE("Math")
 {
     runConformance("math.luau");
@@ -3204,6 +3259,593 @@ TEST_CASE("Native")
     );
 }
 
+TEST_CASE("NativeTierUp")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    ScopedFastInt luauCodeGenTierUpCalls{FInt::LuauCodeGenTierUpCalls, 100};
+    ScopedFastInt luauCodeGenTierUpLoops{FInt::LuauCodeGenTierUpLoops, 1000};
+
+    Luau::CodeGen::CompilationOptions nativeOpts = defaultCodegenOptions();
+    nativeOpts.flags |= Luau::CodeGen::CodeGen_TierUp;
+
+    StateRef globalState = runConformance(
+        "native_tierup.luau",
+        [](lua_State* L)
+        {
+            setupNativeHelpers(L);
+        },
+        nullptr,
+        nullptr,
+        nullptr,
+        false,
+        &nativeOpts
+    );
+
+    Luau::CodeGen::TierUpStats stats = Luau::CodeGen::getTierUpStats(globalState.get());
+
+    // main chunk and all functions, out of which 'cold' and 'range' are called too rarely to be compiled
+    CHECK(stats.functionsMarked == 17);
+    CHECK(stats.functionsCompiled == 15);
+    CHECK(stats.functionsSkipped == 0);
+    CHECK(stats.nativeCodeSizeBytes > 0);
+}
+
+TEST_CASE("NativeTypeFeedback")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    ScopedFastInt luauCodeGenTierUpCalls{FInt::LuauCodeGenTierUpCalls, 100};
+    ScopedFastInt luauCodeGenTierUpLoops{FInt::LuauCodeGenTierUpLoops, 1000};
+    ScopedFastInt luauCodeGenSpeculationFailures{FInt::LuauCodeGenSpeculationFailures, 16};
+
+    Luau::CodeGen::CompilationOptions nativeOpts = defaultCodegenOptions();
+    nativeOpts.flags |= Luau::CodeGen::CodeGen_TierUp;
+
+    StateRef globalState = runConformance(
+        "native_feedback.luau",
+        [](lua_State* L)
+        {
+            setupNativeHelpers(L);
+        },
+        nullptr,
+        nullptr,
+        nullptr,
+        false,
+        &nativeOpts
+    );
+
+    Luau::CodeGen::TierUpStats stats = Luau::CodeGen::getTierUpStats(globalState.get());
+
+    // 'lerp' and 'accumulate' are recompiled after numbers show up, 'scale' has seen numbers before it was compiled, and 'dot' only sees a
+    // single table and keeps its vector specialization
+    CHECK(stats.functionsRecompiled == 2);
+    CHECK(stats.functionsSkipped == 0);
+}
+
+TEST_CASE("NativeInlining")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    ScopedFastInt luauCodeGenTierUpCalls{FInt::LuauCodeGenTierUpCalls, 100};
+    ScopedFastInt luauCodeGenTierUpLoops{FInt::LuauCodeGenTierUpLoops, 1000};
+
+    Luau::CodeGen::CompilationOptions nativeOpts = defaultCodegenOptions();
+    nativeOpts.flags |= Luau::CodeGen::CodeGen_TierUp;
+
+    StateRef globalState = runConformance(
+        "native_inline.luau",
+        [](lua_State* L)
+        {
+            setupNativeHelpers(L);
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L) -> int
+                {
+                    luaL_checktype(L, 1, LUA_TFUNCTION);
+
+                    Luau::CodeGen::CompilationOptions options = defaultCodegenOptions();
+                    options.flags |= Luau::CodeGen::CodeGen_TierUp;
+
+                    Luau::CodeGen::compile(L, 1, options);
+                    return 0;
+                },
+                "enable_tier_up"
+            );
+            lua_setglobal(L, "enable_tier_up");
+        },
+        nullptr,
+        nullptr,
+        nullptr,
+        false,
+        &nativeOpts
+    );
+
+    Luau::CodeGen::TierUpStats stats = Luau::CodeGen::getTierUpStats(globalState.get());
+
+    // 'add' in 'sum' and 'addany', five methods in 'measure', 'op' in 'fold', both calls in 'callers' and 'double' in 'twice'
+    CHECK(stats.callsInlined == 11);
+    CHECK(stats.functionsSkipped == 0);
+}
+
+TEST_CASE("NativeFusedMultiplyAdd")
+{
+    Luau::CodeGen::CompilationOptions nativeOpts = defaultCodegenOptions();
+    nativeOpts.flags |= Luau::CodeGen::CodeGen_FusedMultiplyAdd;
+
+    runConformance("native_fma.luau", nullptr, nullptr, nullptr, nullptr, false, &nativeOpts);
+}
+
+TEST_CASE("NativeStringBuiltins")
+{
+    runConformance("native_string.luau");
+}
+
+TEST_CASE("NativeEscapeAnalysis")
+{
+    runConformance("native_escape.luau");
+}
+
+TEST_CASE("NativeAsync")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    ScopedFastInt luauCodeGenAsyncThreads{FInt::LuauCodeGenAsyncThreads, 2};
+
+    runConformance(
+        "native_async.luau",
+        [](lua_State* L)
+        {
+            setupNativeHelpers(L);
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L) -> int
+                {
+                    luaL_checktype(L, 1, LUA_TFUNCTION);
+
+                    Luau::CodeGen::CompilationResult result = Luau::CodeGen::compileAsync(L, 1, defaultCodegenOptions());
+                    lua_pushboolean(L, result.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+                    return 1;
+                },
+                "compile_async"
+            );
+            lua_setglobal(L, "compile_async");
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L) -> int
+                {
+                    bool wait = luaL_checkboolean(L, 1);
+
+                    Luau::CodeGen::CompilationStats stats;
+                    uint32_t pending = Luau::CodeGen::installAsyncCompilations(L, wait, &stats);
+
+                    CHECK(stats.functionsBound == stats.functionsCompiled);
+
+                    lua_pushinteger(L, int(pending));
+                    return 1;
+                },
+                "install_async"
+            );
+            lua_setglobal(L, "install_async");
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L) -> int
+                {
+                    luaL_checktype(L, 1, LUA_TFUNCTION);
+                    int line = luaL_checkinteger(L, 2);
+
+                    lua_breakpoint(L, 1, line, true);
+                    return 0;
+                },
+                "breakpoint"
+            );
+            lua_setglobal(L, "breakpoint");
+        }
+    );
+}
+
+TEST_CASE("NativeCache")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    auto loadSource = [](const char* source)
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        luau_codegen_create(L);
+
+        size_t bytecodeSize = 0;
+        char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+        int result = luau_load(L, "=NativeCache", bytecode, bytecodeSize, 0);
+        free(bytecode);
+
+        REQUIRE(result == 0);
+        return globalState;
+    };
+
+    auto runLoaded = [](lua_State* L)
+    {
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+        return lua_tonumber(L, -1);
+    };
+
+    const char* source = R"(
+        local function fib(n) if n < 2 then return n end return fib(n - 1) + fib(n - 2) end
+        local function sum(t) local s = 0 for _, v in t do s += v end return s end
+        return fib(20) + sum({1, 2, 3})
+    )";
+
+    Luau::CodeGen::CompilationOptions options = defaultCodegenOptions();
+
+    std::string cache;
+
+    {
+        StateRef globalState = loadSource(source);
+
+        Luau::CodeGen::CompilationStats stats;
+        Luau::CodeGen::CompilationResult result = Luau::CodeGen::compileToCache(globalState.get(), -1, options, cache, &stats);
+        REQUIRE(result.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+        CHECK(stats.functionsCompiled == 3);
+        CHECK(stats.functionsBound == 3);
+        CHECK(!cache.empty());
+
+        CHECK(runLoaded(globalState.get()) == 6771);
+    }
+
+    // Cached code is bound without compiling the functions
+    {
+        StateRef globalState = loadSource(source);
+
+        Luau::CodeGen::CompilationStats stats;
+        Luau::CodeGen::CompilationResult result = Luau::CodeGen::loadFromCache(globalState.get(), -1, options, cache.data(), cache.size(), &stats);
+        REQUIRE(result.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+        CHECK(stats.functionsTotal == 3);
+        CHECK(stats.functionsCompiled == 0);
+        CHECK(stats.functionsBound == 3);
+
+        CHECK(runLoaded(globalState.get()) == 6771);
+    }
+
+    // Code generated for different bytecode, options or flags, or damaged data are rejected
+    auto checkMismatch = [&](const char* source, const Luau::CodeGen::CompilationOptions& options, const std::string& cache)
+    {
+        StateRef globalState = loadSource(source);
+
+        Luau::CodeGen::CompilationStats stats;
+        Luau::CodeGen::CompilationResult result = Luau::CodeGen::loadFromCache(globalState.get(), -1, options, cache.data(), cache.size(), &stats);
+        CHECK(result.result == Luau::CodeGen::CodeGenCompilationResult::CacheMismatch);
+        CHECK(stats.functionsBound == 0);
+
+        // The functions can be compiled instead
+        result = Luau::CodeGen::compile(globalState.get(), -1, options, &stats);
+        CHECK(result.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+        CHECK(stats.functionsBound != 0);
+    };
+
+    std::string otherSource = source;
+    otherSource.replace(otherSource.find("fib(20)"), 7, "fib(10)");
+    checkMismatch(otherSource.c_str(), options, cache);
+
+    Luau::CodeGen::CompilationOptions otherOptions = options;
+    otherOptions.flags &= ~Luau::CodeGen::CodeGen_ColdFunctions;
+    checkMismatch(source, otherOptions, cache);
+
+    checkMismatch(source, options, cache.substr(0, cache.size() - 1));
+
+    std::string damagedCache = cache;
+    damagedCache[damagedCache.size() / 2] ^= 1;
+    checkMismatch(source, options, damagedCache);
+
+    {
+        ScopedFastFlag luauCodeGenDirectBtest{FFlag::LuauCodeGenDirectBtest, !FFlag::LuauCodeGenDirectBtest};
+        checkMismatch(source, options, cache);
+    }
+}
+
+TEST_CASE("NativeCodeReclamation")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    // The limit only fits a few copies of the module, so reloading it has to reuse the memory of the previous ones
+    Luau::CodeGen::create(L, 64 * 1024, 128 * 1024, nullptr, nullptr);
+
+    const char* source = R"(
+        local function sum(t)
+            local s = 0
+            for _, v in t do s += v end
+            return s
+        end
+        local function scale(t, k)
+            local r = table.create(#t)
+            for i, v in t do r[i] = v * k end
+            return r
+        end
+        return sum(scale({1, 2, 3}, 2))
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+
+    for (int i = 0; i < 200; i++)
+    {
+        REQUIRE(luau_load(L, "=NativeCodeReclamation", bytecode, bytecodeSize, 0) == 0);
+
+        Luau::CodeGen::CompilationResult compileResult = Luau::CodeGen::compile(L, -1, defaultCodegenOptions());
+        REQUIRE(compileResult.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+        CHECK(lua_tonumber(L, -1) == 12);
+        lua_pop(L, 1);
+
+        lua_gc(L, LUA_GCCOLLECT, 0);
+    }
+
+    free(bytecode);
+
+    Luau::CodeGen::CodeMemoryStats stats = Luau::CodeGen::getCodeMemoryStats(L);
+
+    // Only the entry gate remains, in the block that can't be reclaimed
+    CHECK(stats.blockCount <= 2);
+    CHECK(stats.blocksReclaimed > 0);
+    CHECK(stats.liveCodeBytes > 0);
+    CHECK(stats.reclaimedCodeBytes > 0);
+}
+
+TEST_CASE("NativeInstrumentation")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+    luaL_sandbox(L);
+    Luau::CodeGen::create(L);
+
+    const char* source = R"(
+        local mt = {__index = {y = 2}}
+        local function get(t)
+            return t.y
+        end
+        local function abs(x)
+            return math.abs(x)
+        end
+        for i = 1, 5 do assert(get(setmetatable({}, mt)) == 2) end
+        for i = 1, 3 do assert(abs(-i) == i) end
+        getfenv()
+        for i = 1, 2 do assert(abs(-i) == i) end
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    REQUIRE(luau_load(L, "=NativeInstrumentation", bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    Luau::CodeGen::CompilationOptions options = defaultCodegenOptions();
+    options.flags |= Luau::CodeGen::CodeGen_Instrumentation;
+
+    Luau::CodeGen::CompilationResult compileResult = Luau::CodeGen::compile(L, -1, options);
+    REQUIRE(compileResult.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+    lua_pushvalue(L, -1);
+    REQUIRE(lua_pcall(L, 0, 0, 0) == LUA_OK);
+
+    std::vector<Luau::CodeGen::NativeFunctionStats> stats = Luau::CodeGen::getNativeFunctionStats(L, -1);
+
+    auto find = [&](const char* name) -> const Luau::CodeGen::NativeFunctionStats*
+    {
+        for (const Luau::CodeGen::NativeFunctionStats& function : stats)
+        {
+            if (function.name == name)
+                return &function;
+        }
+
+        return nullptr;
+    };
+
+    const Luau::CodeGen::NativeFunctionStats* top = find("[top level]");
+    REQUIRE(top);
+    CHECK(top->entries == 1);
+
+    // table lookups that go through __index are completed by the VM
+    const Luau::CodeGen::NativeFunctionStats* get = find("get");
+    REQUIRE(get);
+    CHECK(get->line == 3);
+    CHECK(get->entries == 5);
+    CHECK(get->fallbacks == 5);
+    CHECK(get->exits == 0);
+
+    // builtin calls continue in the interpreter once the environment is no longer safe
+    const Luau::CodeGen::NativeFunctionStats* abs = find("abs");
+    REQUIRE(abs);
+    CHECK(abs->entries == 5);
+    CHECK(abs->fallbacks == 0);
+    CHECK(abs->exits == 2);
+    REQUIRE(abs->exitLocations.size() == 1);
+    CHECK(abs->exitLocations[0].line == 7);
+    CHECK(abs->exitLocations[0].count == 2);
+}
+
+#if defined(__linux__)
+extern "C"
+{
+    struct jit_code_entry
+    {
+        jit_code_entry* next_entry;
+        jit_code_entry* prev_entry;
+        const char* symfile_addr;
+        uint64_t symfile_size;
+    };
+
+    struct jit_descriptor
+    {
+        uint32_t version;
+        uint32_t action_flag;
+        jit_code_entry* relevant_entry;
+        jit_code_entry* first_entry;
+    };
+
+    extern jit_descriptor __jit_debug_descriptor;
+}
+
+TEST_CASE("NativeDebugInfo")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    // Each run of the test writes to its own directory, since the dump file must not exist yet
+    char dir[] = "/tmp/luau-conformance-jit-XXXXXX";
+    REQUIRE(mkdtemp(dir));
+
+    std::string path = std::string(dir) + "/jit.dump";
+
+    REQUIRE(Luau::CodeGen::startJitDump(path.c_str()));
+    REQUIRE(Luau::CodeGen::setGdbJitRegistration(true));
+
+    jit_code_entry* lastEntry = __jit_debug_descriptor.first_entry;
+
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        luau_codegen_create(L);
+
+        const char* source = R"(
+            local function fib(n)
+                if n < 2 then
+                    return n
+                end
+                return fib(n - 1) + fib(n - 2)
+            end
+            return fib(10)
+        )";
+
+        size_t bytecodeSize = 0;
+        char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+        int result = luau_load(L, "=NativeDebugInfo", bytecode, bytecodeSize, 0);
+        free(bytecode);
+
+        REQUIRE(result == 0);
+
+        Luau::CodeGen::CompilationResult compileResult = Luau::CodeGen::compile(L, -1, defaultCodegenOptions());
+        REQUIRE(compileResult.result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+        // The module is described by an ELF object to the debugger
+        REQUIRE(__jit_debug_descriptor.first_entry != lastEntry);
+
+        jit_code_entry* entry = __jit_debug_descriptor.first_entry;
+        REQUIRE(entry->symfile_size > 64);
+        CHECK(memcmp(entry->symfile_addr, "\x7f" "ELF", 4) == 0);
+        CHECK(std::string(entry->symfile_addr, entry->symfile_size).find("<luau> NativeDebugInfo:2 fib") != std::string::npos);
+    }
+
+    // Objects are unregistered when the code memory is released
+    CHECK(__jit_debug_descriptor.first_entry == lastEntry);
+
+    Luau::CodeGen::stopJitDump();
+    Luau::CodeGen::setGdbJitRegistration(false);
+
+    std::ifstream file(path, std::ios::binary);
+    std::string dump((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    remove(path.c_str());
+    rmdir(dir);
+
+    auto readU32 = [&](size_t offset)
+    {
+        uint32_t value = 0;
+        REQUIRE(offset + sizeof(value) <= dump.size());
+        memcpy(&value, dump.data() + offset, sizeof(value));
+        return value;
+    };
+
+    auto readU64 = [&](size_t offset)
+    {
+        uint64_t value = 0;
+        REQUIRE(offset + sizeof(value) <= dump.size());
+        memcpy(&value, dump.data() + offset, sizeof(value));
+        return value;
+    };
+
+    REQUIRE(readU32(0) == 0x4a695444);
+    REQUIRE(readU32(8) == 40);
+
+    uint64_t fibAddress = 0;
+    std::vector<uint32_t> fibLines;
+    bool closed = false;
+
+    for (size_t offset = 40; offset < dump.size();)
+    {
+        uint32_t id = readU32(offset);
+        uint32_t size = readU32(offset + 4);
+        REQUIRE(size >= 16);
+
+        if (id == 0)
+        {
+            std::string name = dump.c_str() + offset + 56;
+
+            if (name == "<luau> NativeDebugInfo:2 fib")
+                CHECK(readU64(offset + 24) == fibAddress);
+        }
+        else if (id == 2)
+        {
+            uint64_t address = readU64(offset + 16);
+            uint64_t count = readU64(offset + 24);
+
+            std::vector<uint32_t> lines;
+            size_t entry = offset + 32;
+
+            for (uint64_t i = 0; i < count; i++)
+            {
+                CHECK(readU64(entry) >= address);
+                lines.push_back(readU32(entry + 8));
+                CHECK(std::string(dump.c_str() + entry + 16) == "NativeDebugInfo");
+                entry += 16 + strlen("NativeDebugInfo") + 1;
+            }
+
+            CHECK(entry == offset + size);
+
+            if (!lines.empty() && lines[0] == 3)
+            {
+                fibAddress = address;
+                fibLines = lines;
+            }
+        }
+        else if (id == 3)
+        {
+            closed = true;
+        }
+
+        offset += size;
+    }
+
+    CHECK(closed);
+    REQUIRE(fibAddress != 0);
+    CHECK(std::find(fibLines.begin(), fibLines.end(), 4) != fibLines.end());
+    CHECK(std::find(fibLines.begin(), fibLines.end(), 6) != fibLines.end());
+}
+#endif
+
 TEST_CASE("NativeTypeAnnotations")
 {
     // This tests requires code to run natively, otherwise all 'is_native' checks will fail
@@ -3311,6 +3953,137 @@ TEST_CASE("NativeUserdata")
     );
 }
 
+TEST_CASE("NativeUserdataCache")
+{
+    lua_CompileOptions copts = defaultOptions();
+
+    static const char* kUserdataCompileTypes[] = {"vec2", "color", "mat3", nullptr};
+    copts.userdataTypes = kUserdataCompileTypes;
+
+    SUBCASE("O1")
+    {
+        copts.optimizationLevel = 1;
+    }
+    SUBCASE("O2")
+    {
+        copts.optimizationLevel = 2;
+    }
+
+    runConformance(
+        "native_userdata_cache.luau",
+        [](lua_State* L)
+        {
+            constexpr int kTagColor = 13;
+            constexpr int kTagMat3 = 14;
+
+            // color has a readonly metatable with a readonly __index table
+            luaL_newmetatable(L, "color");
+
+            lua_newtable(L);
+            lua_pushstring(L, "color");
+            lua_setfield(L, -2, "Name");
+            lua_pushcfunction(
+                L,
+                [](lua_State* L)
+                {
+                    float* data = (float*)lua_touserdatatagged(L, 1, kTagColor);
+                    lua_pushnumber(L, data ? data[0] : 0.0);
+                    return 1;
+                },
+                "Brightness"
+            );
+            lua_setfield(L, -2, "Brightness");
+            lua_setreadonly(L, -1, true);
+            lua_setfield(L, -2, "__index");
+
+            lua_setreadonly(L, -1, true);
+            lua_setuserdatametatable(L, kTagColor);
+
+            // mat3 has a writable metatable with __namecall and a writable __index table
+            luaL_newmetatable(L, "mat3");
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L)
+                {
+                    float* data = (float*)lua_touserdatatagged(L, 1, kTagMat3);
+                    const char* name = lua_namecallatom(L, nullptr);
+
+                    if (!data || !name || strcmp(name, "Det") != 0)
+                        luaL_error(L, "invalid method call");
+
+                    lua_pushnumber(L, data[0] * data[0] * data[0]);
+                    return 1;
+                },
+                "__namecall"
+            );
+            lua_setfield(L, -2, "__namecall");
+
+            lua_newtable(L);
+            lua_pushnumber(L, 3);
+            lua_setfield(L, -2, "Size");
+            lua_setfield(L, -2, "__index");
+
+            lua_setuserdatametatable(L, kTagMat3);
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L)
+                {
+                    float* data = (float*)lua_newuserdatatagged(L, 3 * sizeof(float), kTagColor);
+
+                    for (int i = 0; i < 3; i++)
+                        data[i] = float(luaL_checknumber(L, i + 1));
+
+                    lua_getuserdatametatable(L, kTagColor);
+                    lua_setmetatable(L, -2);
+                    return 1;
+                },
+                "color"
+            );
+            lua_setglobal(L, "color");
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L)
+                {
+                    float* data = (float*)lua_newuserdatatagged(L, sizeof(float), kTagMat3);
+                    data[0] = float(luaL_checknumber(L, 1));
+
+                    lua_getuserdatametatable(L, kTagMat3);
+                    lua_setmetatable(L, -2);
+                    return 1;
+                },
+                "mat3"
+            );
+            lua_setglobal(L, "mat3");
+
+            lua_pushcfunction(
+                L,
+                [](lua_State* L)
+                {
+                    luaL_checkstring(L, 1);
+                    luaL_checkany(L, 2);
+
+                    lua_getuserdatametatable(L, kTagColor);
+                    lua_getfield(L, -1, "__index");
+
+                    lua_setreadonly(L, -1, false);
+                    lua_pushvalue(L, 2);
+                    lua_setfield(L, -2, lua_tostring(L, 1));
+                    lua_setreadonly(L, -1, true);
+                    return 0;
+                },
+                "setColorMember"
+            );
+            lua_setglobal(L, "setColorMember");
+        },
+        nullptr,
+        nullptr,
+        &copts
+    );
+}
+
 [[nodiscard]] static std::string makeHugeFunctionSource()
 {
     std::string source;
@@ -3581,26 +4354,26 @@ end
     CHECK_EQ(summaries[0].getLine(), 6);
     CHECK_EQ(summaries[0].getCounts(0), std::vector<unsigned>({0, 0, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0,
                                                                0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                                               0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+                                                               0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 
     CHECK_EQ(summaries[1].getName(), "first");
     CHECK_EQ(summaries[1].getLine(), 2);
     CHECK_EQ(summaries[1].getCounts(0), std::vector<unsigned>({0, 0, 1, 0, 2, 0, 3, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0,
                                                                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
-                                                               1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+                                                               1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 
 
     CHECK_EQ(summaries[2].getName(), "second");
     CHECK_EQ(summaries[2].getLine(), 15);
     CHECK_EQ(summaries[2].getCounts(0), std::vector<unsigned>({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
                                                                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                                               0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+                                                               0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 
     CHECK_EQ(summaries[3].getName(), "");
     CHECK_EQ(summaries[3].getLine(), 1);
     CHECK_EQ(summaries[3].getCounts(0), std::vector<unsigned>({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
                                                                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                                               0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+                                                               0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 }
 
 TEST_CASE("NativeAttribute")
@@ -17,11 +17,14 @@
 #include <string_view>
 
 LUAU_FASTFLAG(LuauCodeGenSimplifyImport2)
+LUAU_FASTFLAG(LuauCodeGenBetterBytecodeAnalysis)
 LUAU_FASTFLAG(LuauCodeGenDirectBtest)
 LUAU_FASTFLAG(LuauVectorLerp)
 LUAU_FASTFLAG(LuauCompileVectorLerp)
+LUAU_FASTFLAG(LuauCompileStrbufAppend)
 LUAU_FASTFLAG(LuauTypeCheckerVectorLerp)
 LUAU_FASTFLAG(LuauCodeGenVectorLerp)
+LUAU_FASTFLAG(DebugCodegenSkipLoopVersioning)
 
 static void luauLibraryConstantLookup(const char* library, const char* member, Luau::CompileConstant* constant)
 {
@@ -141,7 +144,7 @@ static void initializeCodegen(lua_State* L)
     }
 }
 
-static std::string getCodegenAssembly(const char* source, bool includeIrTypes = false, int debugLevel = 1)
+static std::string getCodegenAssembly(const char* source, bool includeIrTypes = false, int debugLevel = 1, unsigned int codegenFlags = 0)
 {
     Luau::Allocator allocator;
     Luau::AstNameTable names(allocator);
@@ -183,6 +186,7 @@ static std::string getCodegenAssembly(const char* source, bool includeIrTypes =
 
         // Runtime mapping is specifically created to NOT match the compilation mapping
         options.compilationOptions.userdataTypes = kUserdataRunTypes;
+        options.compilationOptions.flags = codegenFlags;
 
         return Luau::CodeGen::getAssembly(L, -1, options, nullptr);
     }
@@ -507,6 +511,190 @@ bb_bytecode_1:
     );
 }
 
+TEST_CASE("FusedMultiplyAdd")
+{
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(
+                   R"(
+local function step(p: vector, v: vector, dt: number)
+    return p + v * dt
+end
+
+local function lerp(a: number, b: number, t: number)
+    return a + (b - a) * t
+end
+
+local function dot2(ax: number, ay: number, bx: number, by: number)
+    return ax * bx + ay * by
+end
+)",
+                   /* includeIrTypes */ false,
+                   /* debugLevel */ 1,
+                   Luau::CodeGen::CodeGen_FusedMultiplyAdd
+               ),
+        R"(
+; function step($arg0, $arg1, $arg2) line 2
+bb_0:
+  CHECK_TAG R0, tvector, exit(entry)
+  CHECK_TAG R1, tvector, exit(entry)
+  CHECK_TAG R2, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  %12 = LOAD_TVALUE R1
+  %13 = LOAD_DOUBLE R2
+  %14 = NUM_TO_VEC %13
+  %22 = LOAD_TVALUE R0
+  %24 = MULADD_VEC %12, %14, %22
+  %25 = TAG_VECTOR %24
+  STORE_TVALUE R3, %25
+  INTERRUPT 2u
+  RETURN R3, 1i
+; function lerp($arg0, $arg1, $arg2) line 6
+bb_0:
+  CHECK_TAG R0, tnumber, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  CHECK_TAG R2, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  %12 = LOAD_DOUBLE R1
+  %13 = LOAD_DOUBLE R0
+  %14 = SUB_NUM %12, %13
+  %32 = MULADD_NUM %14, R2, %13
+  STORE_DOUBLE R3, %32
+  STORE_TAG R3, tnumber
+  INTERRUPT 3u
+  RETURN R3, 1i
+; function dot2($arg0, $arg1, $arg2, $arg3) line 10
+bb_0:
+  CHECK_TAG R0, tnumber, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  CHECK_TAG R2, tnumber, exit(entry)
+  CHECK_TAG R3, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  %14 = LOAD_DOUBLE R0
+  %23 = LOAD_DOUBLE R1
+  %25 = MUL_NUM %23, R3
+  %34 = MULADD_NUM %14, R2, %25
+  STORE_DOUBLE R4, %34
+  STORE_TAG R4, tnumber
+  INTERRUPT 3u
+  RETURN R4, 1i
+)"
+    );
+}
+
+TEST_CASE("StrbufAppend")
+{
+    ScopedFastFlag sff[]{
+        {FFlag::LuauCompileStrbufAppend, true},
+        {FFlag::LuauCodeGenSimplifyImport2, true},
+    };
+
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(R"(
+local function build(sb, s: string)
+    strbuf.append(sb, s)
+    strbuf.append(sb, "!")
+end
+)"),
+        R"(
+; function build($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R1, tstring, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  CHECK_SAFE_ENV exit(2)
+  CHECK_TAG R0, tuserdata, bb_fallback_3
+  %7 = LOAD_POINTER R0
+  CHECK_USERDATA_TAG %7, 130i, bb_fallback_3
+  %11 = LOAD_POINTER R1
+  SET_SAVEDPC 2u
+  STRBUF_APPEND %7, %11
+  CHECK_GC
+  JUMP bb_4
+bb_4:
+  CHECK_SAFE_ENV exit(9)
+  CHECK_TAG R0, tuserdata, bb_fallback_5
+  %29 = LOAD_POINTER R0
+  CHECK_USERDATA_TAG %29, 130i, bb_fallback_5
+  CHECK_TAG K3 ('!'), tstring, bb_fallback_5
+  %33 = LOAD_POINTER K3 ('!')
+  SET_SAVEDPC 9u
+  STRBUF_APPEND %29, %33
+  CHECK_GC
+  JUMP bb_6
+bb_6:
+  INTERRUPT 14u
+  RETURN R0, 0i
+)"
+    );
+}
+
+TEST_CASE("StringBuiltins")
+{
+    ScopedFastFlag luauCodeGenSimplifyImport{FFlag::LuauCodeGenSimplifyImport2, true};
+
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(R"(
+local function chars(s: string, i: number)
+    return #s, string.byte(s, i), string.sub(s, i, i)
+end
+)"),
+        R"(
+; function chars($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, tstring, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  %8 = LOAD_POINTER R0
+  %9 = STRING_LEN %8
+  %10 = INT_TO_NUM %9
+  STORE_DOUBLE R2, %10
+  STORE_TAG R2, tnumber
+  CHECK_SAFE_ENV exit(3)
+  %20 = LOAD_DOUBLE R1
+  %21 = NUM_TO_INT %20
+  %22 = SUB_INT %21, 1i
+  JUMP_CMP_INT %22, %9, u_lt, bb_4, bb_fallback_3
+bb_4:
+  %24 = BUFFER_READU8 %8, %22, tstring
+  %25 = INT_TO_NUM %24
+  STORE_DOUBLE R3, %25
+  STORE_TAG R3, tnumber
+  JUMP bb_5
+bb_5:
+  CHECK_SAFE_ENV exit(10)
+  %42 = LOAD_POINTER R0
+  %43 = STRING_LEN %42
+  %46 = LOAD_DOUBLE R1
+  %47 = NUM_TO_INT %46
+  %48 = SUB_INT %47, 1i
+  JUMP_CMP_INT %48, %43, u_lt, bb_7, bb_fallback_6
+bb_7:
+  %50 = BUFFER_READU8 %42, %48, tstring
+  %51 = STRING_CHAR %50, bb_fallback_6
+  STORE_POINTER R4, %51
+  STORE_TAG R4, tstring
+  JUMP bb_8
+bb_8:
+  INTERRUPT 16u
+  RETURN R2, 3i
+)"
+    );
+}
+
 TEST_CASE("ExtraMathMemoryOperands")
 {
     CHECK_EQ(
@@ -681,7 +869,6 @@ bb_bytecode_1:
   STORE_TAG R2, tnumber
   JUMP bb_4
 bb_4:
-  CHECK_TAG R0, tvector, exit(5)
   FALLBACK_GETTABLEKS 5u, R3, R0, K2 ('ZZ')
   CHECK_TAG R2, tnumber, bb_fallback_5
   CHECK_TAG R3, tnumber, bb_fallback_5
@@ -909,7 +1096,6 @@ bb_4:
   %16 = LOAD_TVALUE R1
   STORE_TVALUE R5, %16
   CHECK_TAG R3, tvector, exit(3)
-  CHECK_TAG R5, tvector, exit(3)
   %22 = LOAD_FLOAT R3, 0i
   %23 = LOAD_FLOAT R5, 0i
   %24 = LOAD_FLOAT R3, 4i
@@ -926,7 +1112,6 @@ bb_4:
   %35 = MUL_NUM %24, %23
   %36 = SUB_NUM %34, %35
   STORE_VECTOR R3, %30, %33, %36
-  CHECK_TAG R0, ttable, exit(6)
   %41 = LOAD_POINTER R0
   %42 = GET_SLOT_NODE_ADDR %41, 6u, K3 ('b')
   CHECK_SLOT_MATCH %42, K3 ('b'), bb_fallback_5
@@ -934,7 +1119,6 @@ bb_4:
   STORE_TVALUE R5, %44
   JUMP bb_6
 bb_6:
-  CHECK_TAG R3, tvector, exit(8)
   CHECK_TAG R5, tvector, exit(8)
   %53 = LOAD_FLOAT R3, 0i
   %54 = LOAD_FLOAT R5, 0i
@@ -972,16 +1156,38 @@ bb_0:
 bb_2:
   JUMP bb_bytecode_1
 bb_bytecode_1:
-  FALLBACK_GETTABLEKS 0u, R2, R0, K0 ('x')
-  FALLBACK_GETTABLEKS 2u, R3, R0, K1 ('y')
-  CHECK_TAG R2, tnumber, bb_fallback_3
-  CHECK_TAG R3, tnumber, bb_fallback_3
-  %14 = LOAD_DOUBLE R2
-  %16 = ADD_NUM %14, R3
-  STORE_DOUBLE R1, %16
+  %6 = LOAD_POINTER R0
+  %7 = GET_USERDATA_CACHE_ADDR %6, 0u, bb_fallback_3, undef
+  %8 = LOAD_TVALUE %7
+  STORE_TVALUE R2, %8
+  JUMP bb_linear_9
+bb_linear_9:
+  %38 = GET_USERDATA_CACHE_ADDR %6, 2u, bb_fallback_5, undef
+  %39 = LOAD_TVALUE %38
+  STORE_TVALUE R3, %39
+  CHECK_TAG R2, tnumber, bb_fallback_7
+  CHECK_TAG R3, tnumber, bb_fallback_7
+  %46 = LOAD_DOUBLE R2
+  %48 = ADD_NUM %46, R3
+  STORE_DOUBLE R1, %48
   STORE_TAG R1, tnumber
-  JUMP bb_4
+  INTERRUPT 5u
+  RETURN R1, 1i
 bb_4:
+  %15 = LOAD_POINTER R0
+  %16 = GET_USERDATA_CACHE_ADDR %15, 2u, bb_fallback_5, undef
+  %17 = LOAD_TVALUE %16
+  STORE_TVALUE R3, %17
+  JUMP bb_6
+bb_6:
+  CHECK_TAG R2, tnumber, bb_fallback_7
+  CHECK_TAG R3, tnumber, bb_fallback_7
+  %26 = LOAD_DOUBLE R2
+  %28 = ADD_NUM %26, R3
+  STORE_DOUBLE R1, %28
+  STORE_TAG R1, tnumber
+  JUMP bb_8
+bb_8:
   INTERRUPT 5u
   RETURN R1, 1i
 )"
@@ -1032,22 +1238,54 @@ bb_0:
 bb_2:
   JUMP bb_bytecode_1
 bb_bytecode_1:
-  FALLBACK_NAMECALL 0u, R2, R0, K0 ('GetX')
+  %6 = LOAD_POINTER R0
+  %7 = GET_USERDATA_CACHE_ADDR %6, 0u, bb_fallback_4, K0 ('GetX')
+  STORE_SPLIT_TVALUE R3, tuserdata, %6
+  %10 = LOAD_TVALUE %7
+  STORE_TVALUE R2, %10
+  JUMP bb_linear_9
+bb_linear_9:
   INTERRUPT 2u
   SET_SAVEDPC 3u
   CALL R2, 1i, 1i
-  FALLBACK_NAMECALL 3u, R3, R0, K1 ('GetY')
+  %50 = LOAD_POINTER R0
+  %51 = GET_USERDATA_CACHE_ADDR %50, 3u, bb_fallback_6, K1 ('GetY')
+  STORE_SPLIT_TVALUE R4, tuserdata, %50
+  %53 = LOAD_TVALUE %51
+  STORE_TVALUE R3, %53
   INTERRUPT 5u
   SET_SAVEDPC 6u
   CALL R3, 1i, 1i
-  CHECK_TAG R2, tnumber, bb_fallback_3
-  CHECK_TAG R3, tnumber, bb_fallback_3
-  %20 = LOAD_DOUBLE R2
-  %22 = ADD_NUM %20, R3
-  STORE_DOUBLE R1, %22
+  CHECK_TAG R2, tnumber, bb_fallback_7
+  CHECK_TAG R3, tnumber, bb_fallback_7
+  %63 = LOAD_DOUBLE R2
+  %65 = ADD_NUM %63, R3
+  STORE_DOUBLE R1, %65
   STORE_TAG R1, tnumber
-  JUMP bb_4
-bb_4:
+  INTERRUPT 7u
+  RETURN R1, 1i
+bb_3:
+  INTERRUPT 2u
+  SET_SAVEDPC 3u
+  CALL R2, 1i, 1i
+  %20 = LOAD_POINTER R0
+  %21 = GET_USERDATA_CACHE_ADDR %20, 3u, bb_fallback_6, K1 ('GetY')
+  STORE_SPLIT_TVALUE R4, tuserdata, %20
+  %24 = LOAD_TVALUE %21
+  STORE_TVALUE R3, %24
+  JUMP bb_5
+bb_5:
+  INTERRUPT 5u
+  SET_SAVEDPC 6u
+  CALL R3, 1i, 1i
+  CHECK_TAG R2, tnumber, bb_fallback_7
+  CHECK_TAG R3, tnumber, bb_fallback_7
+  %36 = LOAD_DOUBLE R2
+  %38 = ADD_NUM %36, R3
+  STORE_DOUBLE R1, %38
+  STORE_TAG R1, tnumber
+  JUMP bb_8
+bb_8:
   INTERRUPT 7u
   RETURN R1, 1i
 )"
@@ -1131,7 +1369,6 @@ bb_bytecode_0:
   STORE_TAG R2, tvector
   JUMP_IF_FALSY R1, bb_bytecode_1, bb_3
 bb_3:
-  CHECK_TAG R2, tvector, exit(9)
   %19 = LOAD_FLOAT R2, 0i
   %24 = LOAD_FLOAT R2, 4i
   %33 = ADD_NUM %19, %24
@@ -1140,7 +1377,6 @@ bb_3:
   INTERRUPT 14u
   RETURN R3, 1i
 bb_bytecode_1:
-  CHECK_TAG R2, tvector, exit(15)
   %40 = LOAD_FLOAT R2, 8i
   STORE_DOUBLE R3, %40
   STORE_TAG R3, tnumber
@@ -1245,7 +1481,7 @@ bb_bytecode_0:
   STORE_TAG R3, tnumber
   CHECK_TAG R2, tnumber, exit(4)
   %12 = LOAD_DOUBLE R2
-  JUMP_CMP_NUM 1, %12, not_le, bb_bytecode_4, bb_bytecode_1
+  JUMP_CMP_NUM 1, %12, not_le, bb_bytecode_4, bb_7
 bb_bytecode_1:
   INTERRUPT 5u
   STORE_DOUBLE R5, 10
@@ -1275,6 +1511,237 @@ bb_bytecode_3:
 bb_bytecode_4:
   INTERRUPT 12u
   RETURN R1, 1i
+bb_7:
+  CHECK_TAG R4, tnumber, bb_bytecode_1
+  CHECK_TAG R1, tnumber, bb_bytecode_1
+  JUMP bb_8
+bb_8:
+  INTERRUPT 5u
+  STORE_DOUBLE R5, 10
+  STORE_TAG R5, tnumber
+  JUMP_CMP_NUM R4, 10, not_lt, bb_9, bb_11
+bb_11:
+  %69 = LOAD_DOUBLE R1
+  %71 = ADD_NUM %69, R4
+  STORE_DOUBLE R1, %71
+  JUMP bb_10
+bb_9:
+  %76 = LOAD_DOUBLE R1
+  %78 = MUL_NUM %76, R4
+  STORE_DOUBLE R1, %78
+  JUMP bb_10
+bb_10:
+  %81 = LOAD_DOUBLE R2
+  %82 = LOAD_DOUBLE R4
+  %83 = ADD_NUM %82, 1
+  STORE_DOUBLE R4, %83
+  JUMP_CMP_NUM %83, %81, le, bb_8, bb_bytecode_4
+)"
+    );
+}
+
+TEST_CASE("LoopVersioningArrayAccess")
+{
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(
+                   R"(
+local function sum(t: {number}, n: number)
+    local s = 0
+    for i = 1, n do
+        s += t[i]
+    end
+    return s
+end
+)",
+                   /* includeIrTypes */ true
+               ),
+        R"(
+; function sum($arg0, $arg1) line 2
+; R0: table [argument]
+; R1: number [argument]
+; R2: number from 0 to 9
+; R5: number from 1 to 7
+bb_0:
+  CHECK_TAG R0, ttable, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_4
+bb_4:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  STORE_DOUBLE R2, 0
+  STORE_TAG R2, tnumber
+  STORE_DOUBLE R5, 1
+  STORE_TAG R5, tnumber
+  %10 = LOAD_TVALUE R1
+  STORE_TVALUE R3, %10
+  STORE_DOUBLE R4, 1
+  STORE_TAG R4, tnumber
+  %18 = LOAD_DOUBLE R3
+  JUMP_CMP_NUM 1, %18, not_le, bb_bytecode_3, bb_9
+bb_bytecode_2:
+  INTERRUPT 5u
+  CHECK_TAG R0, ttable, exit(5)
+  CHECK_TAG R5, tnumber, exit(5)
+  %26 = LOAD_POINTER R0
+  %27 = LOAD_DOUBLE R5
+  %28 = TRY_NUM_TO_INDEX %27, bb_fallback_5
+  %29 = SUB_INT %28, 1i
+  CHECK_ARRAY_SIZE %26, %29, bb_fallback_5
+  CHECK_NO_METATABLE %26, bb_fallback_5
+  %32 = GET_ARR_ADDR %26, %29
+  %33 = LOAD_TVALUE %32
+  STORE_TVALUE R6, %33
+  JUMP bb_6
+bb_6:
+  CHECK_TAG R2, tnumber, exit(6)
+  CHECK_TAG R6, tnumber, bb_fallback_7
+  %43 = LOAD_DOUBLE R2
+  %45 = ADD_NUM %43, R6
+  STORE_DOUBLE R2, %45
+  JUMP bb_8
+bb_8:
+  %51 = LOAD_DOUBLE R3
+  %52 = LOAD_DOUBLE R5
+  %53 = ADD_NUM %52, 1
+  STORE_DOUBLE R5, %53
+  JUMP_CMP_NUM %53, %51, le, bb_bytecode_2, bb_bytecode_3
+bb_bytecode_3:
+  INTERRUPT 8u
+  RETURN R2, 1i
+bb_9:
+  CHECK_TAG R0, ttable, bb_bytecode_2
+  CHECK_TAG R5, tnumber, bb_bytecode_2
+  CHECK_TAG R2, tnumber, bb_bytecode_2
+  CHECK_TAG R3, tnumber, bb_bytecode_2
+  %66 = LOAD_POINTER R0
+  CHECK_NO_METATABLE %66, bb_bytecode_2
+  %68 = LOAD_DOUBLE R3
+  %69 = TRY_NUM_TO_INDEX %68, bb_bytecode_2
+  %70 = SUB_INT %69, 1i
+  CHECK_ARRAY_SIZE %66, %70, bb_bytecode_2
+  %72 = LOAD_DOUBLE R5
+  %73 = TRY_NUM_TO_INDEX %72, bb_bytecode_2
+  %74 = SUB_INT %73, 1i
+  CHECK_ARRAY_SIZE %66, %74, bb_bytecode_2
+  JUMP bb_linear_15
+bb_linear_15:
+  INTERRUPT 5u, bb_14
+  %115 = GET_ARR_ADDR %66, %74
+  %116 = LOAD_TVALUE %115
+  STORE_TVALUE R6, %116
+  CHECK_TAG R6, tnumber, bb_fallback_7
+  %121 = LOAD_DOUBLE R2
+  %123 = ADD_NUM %121, R6
+  STORE_DOUBLE R2, %123
+  %128 = ADD_NUM %72, 1
+  STORE_DOUBLE R5, %128
+  JUMP_CMP_NUM %128, %68, le, bb_10, bb_bytecode_3
+bb_10:
+  INTERRUPT 5u, bb_14
+  JUMP bb_11
+bb_11:
+  %81 = LOAD_POINTER R0
+  %82 = LOAD_DOUBLE R5
+  %83 = TRY_NUM_TO_INDEX %82, bb_fallback_5
+  %84 = SUB_INT %83, 1i
+  %85 = GET_ARR_ADDR %81, %84
+  %86 = LOAD_TVALUE %85
+  STORE_TVALUE R6, %86
+  JUMP bb_12
+bb_12:
+  CHECK_TAG R6, tnumber, bb_fallback_7
+  %92 = LOAD_DOUBLE R2
+  %94 = ADD_NUM %92, R6
+  STORE_DOUBLE R2, %94
+  JUMP bb_13
+bb_13:
+  %97 = LOAD_DOUBLE R3
+  %98 = LOAD_DOUBLE R5
+  %99 = ADD_NUM %98, 1
+  STORE_DOUBLE R5, %99
+  JUMP_CMP_NUM %99, %97, le, bb_10, bb_bytecode_3
+bb_14:
+  %102 = LOAD_POINTER R0
+  CHECK_NO_METATABLE %102, bb_bytecode_2
+  %104 = LOAD_DOUBLE R3
+  %105 = TRY_NUM_TO_INDEX %104, bb_bytecode_2
+  %106 = SUB_INT %105, 1i
+  CHECK_ARRAY_SIZE %102, %106, bb_bytecode_2
+  JUMP bb_11
+)"
+    );
+}
+
+TEST_CASE("LoopVersioningSkipped")
+{
+    ScopedFastFlag debugCodegenSkipLoopVersioning{FFlag::DebugCodegenSkipLoopVersioning, true};
+
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(
+                   R"(
+local function sum(t: {number}, n: number)
+    local s = 0
+    for i = 1, n do
+        s += t[i]
+    end
+    return s
+end
+)",
+                   /* includeIrTypes */ true
+               ),
+        R"(
+; function sum($arg0, $arg1) line 2
+; R0: table [argument]
+; R1: number [argument]
+; R2: number from 0 to 9
+; R5: number from 1 to 7
+bb_0:
+  CHECK_TAG R0, ttable, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_4
+bb_4:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  STORE_DOUBLE R2, 0
+  STORE_TAG R2, tnumber
+  STORE_DOUBLE R5, 1
+  STORE_TAG R5, tnumber
+  %10 = LOAD_TVALUE R1
+  STORE_TVALUE R3, %10
+  STORE_DOUBLE R4, 1
+  STORE_TAG R4, tnumber
+  %18 = LOAD_DOUBLE R3
+  JUMP_CMP_NUM 1, %18, not_le, bb_bytecode_3, bb_bytecode_2
+bb_bytecode_2:
+  INTERRUPT 5u
+  CHECK_TAG R0, ttable, exit(5)
+  CHECK_TAG R5, tnumber, exit(5)
+  %26 = LOAD_POINTER R0
+  %27 = LOAD_DOUBLE R5
+  %28 = TRY_NUM_TO_INDEX %27, bb_fallback_5
+  %29 = SUB_INT %28, 1i
+  CHECK_ARRAY_SIZE %26, %29, bb_fallback_5
+  CHECK_NO_METATABLE %26, bb_fallback_5
+  %32 = GET_ARR_ADDR %26, %29
+  %33 = LOAD_TVALUE %32
+  STORE_TVALUE R6, %33
+  JUMP bb_6
+bb_6:
+  CHECK_TAG R2, tnumber, exit(6)
+  CHECK_TAG R6, tnumber, bb_fallback_7
+  %43 = LOAD_DOUBLE R2
+  %45 = ADD_NUM %43, R6
+  STORE_DOUBLE R2, %45
+  JUMP bb_8
+bb_8:
+  %51 = LOAD_DOUBLE R3
+  %52 = LOAD_DOUBLE R5
+  %53 = ADD_NUM %52, 1
+  STORE_DOUBLE R5, %53
+  JUMP_CMP_NUM %53, %51, le, bb_bytecode_2, bb_bytecode_3
+bb_bytecode_3:
+  INTERRUPT 8u
+  RETURN R2, 1i
 )"
     );
 }
@@ -1663,7 +2130,7 @@ bb_6:
   STORE_POINTER R4, 0i
   STORE_EXTRA R4, 128i
   STORE_TAG R4, tlightuserdata
-  JUMP bb_bytecode_3
+  JUMP bb_12
 bb_bytecode_2:
   CHECK_TAG R6, ttable, exit(6)
   %28 = LOAD_POINTER R6
@@ -1703,6 +2170,43 @@ bb_11:
 bb_9:
   INTERRUPT 13u
   RETURN R1, 1i
+bb_12:
+  CHECK_TAG R2, tnil, bb_bytecode_3
+  JUMP bb_14
+bb_13:
+  CHECK_TAG R6, ttable, exit(6)
+  %78 = LOAD_POINTER R6
+  %79 = GET_SLOT_NODE_ADDR %78, 6u, K2 ('pos')
+  CHECK_SLOT_MATCH %79, K2 ('pos'), bb_fallback_7
+  %81 = LOAD_TVALUE %79, 0i
+  STORE_TVALUE R8, %81
+  JUMP bb_15
+bb_15:
+  CHECK_TAG R8, tvector, exit(8)
+  %86 = LOAD_FLOAT R8, 0i
+  STORE_DOUBLE R7, %86
+  STORE_TAG R7, tnumber
+  %92 = LOAD_DOUBLE R1
+  %94 = ADD_NUM %92, %86
+  STORE_DOUBLE R1, %94
+  JUMP bb_14
+bb_14:
+  INTERRUPT 11u
+  %99 = LOAD_POINTER R3
+  %100 = LOAD_INT R4
+  %101 = GET_ARR_ADDR %99, %100
+  CHECK_ARRAY_SIZE %99, %100, bb_9
+  %103 = LOAD_TAG %101
+  JUMP_EQ_TAG %103, tnil, bb_9, bb_16
+bb_16:
+  %105 = ADD_INT %100, 1i
+  STORE_INT R4, %105
+  %107 = INT_TO_NUM %105
+  STORE_DOUBLE R5, %107
+  STORE_TAG R5, tnumber
+  %110 = LOAD_TVALUE %101
+  STORE_TVALUE R6, %110
+  JUMP bb_13
 )"
     );
 }
@@ -1869,15 +2373,25 @@ bb_0:
 bb_2:
   JUMP bb_bytecode_1
 bb_bytecode_1:
-  FALLBACK_GETTABLEKS 0u, R2, R0, K0 ('Row1')
-  FALLBACK_GETTABLEKS 2u, R3, R0, K1 ('Row2')
+  %6 = LOAD_POINTER R0
+  %7 = GET_USERDATA_CACHE_ADDR %6, 0u, bb_fallback_3, undef
+  %8 = LOAD_TVALUE %7
+  STORE_TVALUE R2, %8
+  JUMP bb_4
+bb_4:
+  %15 = LOAD_POINTER R0
+  %16 = GET_USERDATA_CACHE_ADDR %15, 2u, bb_fallback_5, undef
+  %17 = LOAD_TVALUE %16
+  STORE_TVALUE R3, %17
+  JUMP bb_6
+bb_6:
   CHECK_TAG R2, tvector, exit(4)
   CHECK_TAG R3, tvector, exit(4)
-  %14 = LOAD_TVALUE R2
-  %15 = LOAD_TVALUE R3
-  %16 = MUL_VEC %14, %15
-  %17 = TAG_VECTOR %16
-  STORE_TVALUE R1, %17
+  %26 = LOAD_TVALUE R2
+  %27 = LOAD_TVALUE R3
+  %28 = MUL_VEC %26, %27
+  %29 = TAG_VECTOR %28
+  STORE_TVALUE R1, %29
   INTERRUPT 5u
   RETURN R1, 1i
 )"
@@ -2283,4 +2797,218 @@ bb_bytecode_1:
     );
 }
 
+TEST_CASE("ScalarReplacementOfTemporaryTables")
+{
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(R"(
+local function length(a: number, b: number)
+    local p = {x = a, y = b}
+    return p.x * p.x + p.y * p.y
+end
+)"),
+        R"(
+; function length($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, tnumber, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  SET_SAVEDPC 1u
+  CHECK_GC
+  %18 = LOAD_TVALUE R0
+  JUMP bb_linear_21
+bb_linear_21:
+  %121 = LOAD_TVALUE R1
+  STORE_TVALUE R5, %18
+  STORE_TVALUE R6, %18
+  CHECK_TAG R5, tnumber, bb_fallback_22
+  CHECK_TAG R6, tnumber, bb_fallback_23
+  %140 = LOAD_DOUBLE R5
+  %142 = MUL_NUM %140, R6
+  STORE_DOUBLE R4, %142
+  STORE_TAG R4, tnumber
+  STORE_TVALUE R6, %121
+  STORE_TVALUE R7, %121
+  CHECK_TAG R6, tnumber, bb_fallback_17
+  CHECK_TAG R7, tnumber, bb_fallback_17
+  %162 = LOAD_DOUBLE R6
+  %164 = MUL_NUM %162, R7
+  %174 = ADD_NUM %142, %164
+  STORE_DOUBLE R3, %174
+  STORE_TAG R3, tnumber
+  INTERRUPT 16u
+  RETURN R3, 1i
+bb_12:
+  %71 = LOAD_POINTER R2
+  %72 = GET_SLOT_NODE_ADDR %71, 10u, K1 ('y')
+  CHECK_SLOT_MATCH %72, K1 ('y'), bb_fallback_13
+  %74 = LOAD_TVALUE %72, 0i
+  STORE_TVALUE R6, %74
+  JUMP bb_14
+bb_14:
+  %81 = LOAD_POINTER R2
+  %82 = GET_SLOT_NODE_ADDR %81, 12u, K1 ('y')
+  CHECK_SLOT_MATCH %82, K1 ('y'), bb_fallback_15
+  %84 = LOAD_TVALUE %82, 0i
+  STORE_TVALUE R7, %84
+  JUMP bb_16
+bb_16:
+  CHECK_TAG R6, tnumber, bb_fallback_17
+  CHECK_TAG R7, tnumber, bb_fallback_17
+  %93 = LOAD_DOUBLE R6
+  %95 = MUL_NUM %93, R7
+  STORE_DOUBLE R5, %95
+  STORE_TAG R5, tnumber
+  JUMP bb_18
+bb_18:
+  CHECK_TAG R4, tnumber, bb_fallback_19
+  CHECK_TAG R5, tnumber, bb_fallback_19
+  %106 = LOAD_DOUBLE R4
+  %108 = ADD_NUM %106, R5
+  STORE_DOUBLE R3, %108
+  STORE_TAG R3, tnumber
+  JUMP bb_20
+bb_20:
+  INTERRUPT 16u
+  RETURN R3, 1i
+)"
+    );
+}
+
+TEST_CASE("ScalarReplacementOfTemporaryArrays")
+{
+    ScopedFastFlag luauCodeGenBetterBytecodeAnalysis{FFlag::LuauCodeGenBetterBytecodeAnalysis, true};
+
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(R"(
+local function product(a: number, b: number)
+    local p = {a, b}
+    return p[1] * p[2]
+end
+)"),
+        R"(
+; function product($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, tnumber, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  SET_SAVEDPC 1u
+  CHECK_GC
+  %11 = LOAD_TVALUE R0
+  STORE_TVALUE R3, %11
+  %13 = LOAD_TVALUE R1
+  STORE_TVALUE R4, %11
+  JUMP bb_4
+bb_4:
+  STORE_TVALUE R5, %13
+  JUMP bb_6
+bb_6:
+  CHECK_TAG R4, tnumber, bb_fallback_7
+  CHECK_TAG R5, tnumber, bb_fallback_7
+  %44 = LOAD_DOUBLE R4
+  %46 = MUL_NUM %44, R5
+  STORE_DOUBLE R3, %46
+  JUMP bb_8
+bb_8:
+  INTERRUPT 9u
+  RETURN R3, 1i
+)"
+    );
+}
+
+TEST_CASE("ScalarReplacementEscape")
+{
+    CHECK_EQ(
+        "\n" + getCodegenAssembly(R"(
+local function make(a: number, b: number)
+    local p = {x = a, y = b}
+    return p.x + p.y, p
+end
+)"),
+        R"(
+; function make($arg0, $arg1) line 2
+bb_0:
+  CHECK_TAG R0, tnumber, exit(entry)
+  CHECK_TAG R1, tnumber, exit(entry)
+  JUMP bb_2
+bb_2:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  SET_SAVEDPC 1u
+  %7 = LOAD_POINTER K2 ()
+  %8 = DUP_TABLE %7
+  STORE_POINTER R2, %8
+  STORE_TAG R2, ttable
+  CHECK_GC
+  %15 = GET_SLOT_NODE_ADDR %8, 1u, K0 ('x')
+  CHECK_SLOT_MATCH %15, K0 ('x'), bb_fallback_3
+  CHECK_READONLY %8, bb_fallback_3
+  %18 = LOAD_TVALUE R0
+  STORE_TVALUE %15, %18, 0i
+  JUMP bb_linear_13
+bb_linear_13:
+  %74 = GET_SLOT_NODE_ADDR %8, 3u, K1 ('y')
+  CHECK_SLOT_MATCH %74, K1 ('y'), bb_fallback_5
+  CHECK_READONLY %8, bb_fallback_5
+  %77 = LOAD_TVALUE R1
+  STORE_TVALUE %74, %77, 0i
+  CHECK_NODE_VALUE %15, bb_fallback_7
+  %83 = LOAD_TVALUE %15, 0i
+  STORE_TVALUE R4, %83
+  CHECK_NODE_VALUE %74, bb_fallback_9
+  %89 = LOAD_TVALUE %74, 0i
+  STORE_TVALUE R5, %89
+  CHECK_TAG R4, tnumber, bb_fallback_11
+  CHECK_TAG R5, tnumber, bb_fallback_11
+  %96 = LOAD_DOUBLE R4
+  %98 = ADD_NUM %96, R5
+  STORE_DOUBLE R3, %98
+  STORE_TAG R3, tnumber
+  STORE_SPLIT_TVALUE R4, ttable, %8
+  INTERRUPT 11u
+  RETURN R3, 2i
+bb_4:
+  %26 = LOAD_POINTER R2
+  %27 = GET_SLOT_NODE_ADDR %26, 3u, K1 ('y')
+  CHECK_SLOT_MATCH %27, K1 ('y'), bb_fallback_5
+  CHECK_READONLY %26, bb_fallback_5
+  %30 = LOAD_TVALUE R1
+  STORE_TVALUE %27, %30, 0i
+  JUMP bb_6
+bb_6:
+  %38 = LOAD_POINTER R2
+  %39 = GET_SLOT_NODE_ADDR %38, 5u, K0 ('x')
+  CHECK_SLOT_MATCH %39, K0 ('x'), bb_fallback_7
+  %41 = LOAD_TVALUE %39, 0i
+  STORE_TVALUE R4, %41
+  JUMP bb_8
+bb_8:
+  %48 = LOAD_POINTER R2
+  %49 = GET_SLOT_NODE_ADDR %48, 7u, K1 ('y')
+  CHECK_SLOT_MATCH %49, K1 ('y'), bb_fallback_9
+  %51 = LOAD_TVALUE %49, 0i
+  STORE_TVALUE R5, %51
+  JUMP bb_10
+bb_10:
+  CHECK_TAG R4, tnumber, bb_fallback_11
+  CHECK_TAG R5, tnumber, bb_fallback_11
+  %60 = LOAD_DOUBLE R4
+  %62 = ADD_NUM %60, R5
+  STORE_DOUBLE R3, %62
+  STORE_TAG R3, tnumber
+  JUMP bb_12
+bb_12:
+  %69 = LOAD_TVALUE R2
+  STORE_TVALUE R4, %69
+  INTERRUPT 11u
+  RETURN R3, 2i
+)"
+    );
+}
+
 TEST_SUITE_END();
@@ -452,3 +452,51 @@ TEST_CASE("SharedAllocation")
     REQUIRE(nativeStats1.functionsBound == 3);
     REQUIRE(nativeStats2.functionsBound == 3);
 }
+
+TEST_CASE("SharedModuleUnload")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    UniqueSharedCodeGenContext sharedCodeGenContext = createSharedCodeGenContext(64 * 1024, 128 * 1024, nullptr, nullptr);
+
+    std::string source = R"(
+        function add(x, y) return x + y end
+        function sub(x, y) return x - y end
+    )";
+
+    size_t bytecodeSize = 0;
+    std::unique_ptr<char[], void (*)(void*)> bytecode{luau_compile(source.data(), source.size(), nullptr, &bytecodeSize), free};
+
+    CompilationOptions options;
+    options.flags = CodeGen_ColdFunctions;
+
+    std::unique_ptr<lua_State, void (*)(lua_State*)> L1{luaL_newstate(), lua_close};
+    create(L1.get(), sharedCodeGenContext.get());
+
+    // Each module gets a new id, like it would after a script is edited; the memory limit only fits a few of them
+    for (uint8_t i = 0; i < 200; i++)
+    {
+        std::unique_ptr<lua_State, void (*)(lua_State*)> L2{luaL_newstate(), lua_close};
+        create(L2.get(), sharedCodeGenContext.get());
+
+        const ModuleId moduleId = {i};
+
+        REQUIRE(luau_load(L1.get(), "=Functions", bytecode.get(), bytecodeSize, 0) == 0);
+        REQUIRE(luau_load(L2.get(), "=Functions", bytecode.get(), bytecodeSize, 0) == 0);
+        REQUIRE(Luau::CodeGen::compile(moduleId, L1.get(), -1, options).result == CodeGenCompilationResult::Success);
+        REQUIRE(Luau::CodeGen::compile(moduleId, L2.get(), -1, options).result == CodeGenCompilationResult::Success);
+
+        // The module stays alive while its functions are still used by the other VM
+        L2.reset();
+        CHECK(getCodeMemoryStats(L1.get()).liveCodeBytes > 0);
+
+        lua_pop(L1.get(), 1);
+        lua_gc(L1.get(), LUA_GCCOLLECT, 0);
+    }
+
+    CodeMemoryStats stats = getCodeMemoryStats(L1.get());
+    CHECK(stats.blockCount <= 2);
+    CHECK(stats.blocksReclaimed > 0);
+    CHECK(stats.reclaimedCodeBytes > 0);
+}
@@ -0,0 +1,101 @@
+#!/usr/bin/python3
+# This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+
+# Mines frequencies of adjacent bytecode instruction pairs, which is used to pick sequences that are worth fusing into superinstructions.
+# Each script is compiled with luau-compile --text, and every pair is weighted by the number of times the source line of its second
+# instruction was executed, as reported by luau --coverage; with --static, every pair is counted once instead.
+#
+# Example: python3 tools/opcodepairs.py --luau build/luau --compiler build/luau-compile bench/tests/*.lua bench/tests/sunspider/*.lua
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from collections import defaultdict
+
+# 30:   local x1 = From.V[1];
+re_source = re.compile(r'^\s*(\d+): ')
+# L1: GETTABLEKS R3 R0 K0 ['V']
+re_insn = re.compile(r'^(L\d+: )?([A-Z][A-Z0-9_]+)\b')
+# Function 1 (DrawLine):
+re_function = re.compile(r'^Function \d+ ')
+
+def getArgs():
+    parser = argparse.ArgumentParser(description='Mine bytecode instruction pair frequencies')
+    parser.add_argument('--luau', default='luau', help='path to the luau executable used to collect line hit counts')
+    parser.add_argument('--compiler', default='luau-compile', help='path to the luau-compile executable')
+    parser.add_argument('-O', dest='optimize', default='2', help='optimization level (2 by default)')
+    parser.add_argument('--static', action='store_true', help='count pairs in the bytecode without running the scripts')
+    parser.add_argument('--limit', type=int, default=40, help='number of pairs to display (40 by default)')
+    parser.add_argument('files', nargs='+', help='scripts to analyze')
+    return parser.parse_args()
+
+def getLineHits(args, path):
+    with tempfile.TemporaryDirectory() as cwd:
+        subprocess.run([os.path.abspath(args.luau), '--coverage', '-O' + args.optimize, os.path.abspath(path)], cwd=cwd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+        hits = defaultdict(int)
+
+        try:
+            with open(os.path.join(cwd, 'coverage.out')) as f:
+                for line in f:
+                    if line.startswith('DA:'):
+                        lineno, count = line[3:].split(',')
+                        hits[int(lineno)] = max(hits[int(lineno)], int(count))
+        except FileNotFoundError:
+            print(f'Warning: no coverage for {path}', file=sys.stderr)
+
+        return hits
+
+def countPairs(args, path, pairs, singles):
+    text = subprocess.run([args.compiler, '--text', '-O' + args.optimize, path], capture_output=True).stdout.decode('utf-8', errors='ignore')
+    hits = None if args.static else getLineHits(args, path)
+
+    prev = None
+    prevweight = 0
+    lineno = 0
+
+    for line in text.splitlines():
+        if re_function.match(line):
+            prev = None
+        elif m := re_source.match(line):
+            lineno = int(m[1])
+        elif (m := re_insn.match(line)) and m[2] != 'REMARK':
+            op = m[2]
+
+            # the line hit count is used as an estimate of how many times the instruction was executed
+            weight = 1 if hits is None else hits.get(lineno, 0)
+
+            singles[op] += weight
+
+            # a jump target can be reached from elsewhere, but falling through into it is still the common case
+            if prev:
+                pairs[(prev, op)] += min(prevweight, weight)
+
+            prev = None if op in ('RETURN', 'JUMP', 'JUMPBACK', 'JUMPX') else op
+            prevweight = weight
+
+def main():
+    args = getArgs()
+
+    pairs = defaultdict(int)
+    singles = defaultdict(int)
+
+    for path in args.files:
+        countPairs(args, path, pairs, singles)
+
+    total = sum(singles.values())
+
+    if total == 0:
+        print('No instructions were counted')
+        return
+
+    print(f'{"Pair":40} {"Count":>14} {"% of all":>9} {"% of first":>11}')
+
+    for (first, second), count in sorted(pairs.items(), key=lambda p: p[1], reverse=True)[:args.limit]:
+        print(f'{first + " " + second:40} {count:14} {count * 100 / total:8.2f}% {count * 100 / singles[first]:10.2f}%')
+
+if __name__ == '__main__':
+    main()